@@ -921,9 +921,26 @@ macro(CheckPTHREAD)
                   sem_timedwait(NULL, NULL);
                   return 0;
               }" HAVE_SEM_TIMEDWAIT)
+          check_c_source_compiles("
+              #include <pthread.h>
+              #include <semaphore.h>
+              #include <time.h>
+              int main(int argc, char **argv) {
+                  sem_clockwait(NULL, CLOCK_MONOTONIC, NULL);
+                  return 0;
+              }" HAVE_SEM_CLOCKWAIT)
         endif()
       endif()
 
+      check_c_source_compiles("
+          #include <pthread.h>
+          #include <time.h>
+          int main(int argc, char **argv) {
+              pthread_condattr_t attr;
+              pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+              return 0;
+          }" HAVE_PTHREAD_CONDATTR_SETCLOCK)
+
       check_c_source_compiles("
           #include <pthread.h>
           #include <pthread_np.h>
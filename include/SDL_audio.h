@@ -436,6 +436,71 @@ extern DECLSPEC SDL_AudioSpec *SDLCALL SDL_LoadWAV_RW(SDL_RWops * src,
  */
 extern DECLSPEC void SDLCALL SDL_FreeWAV(Uint8 * audio_buf);
 
+/**
+ *  \brief An open WAVE file that is decoded a piece at a time.
+ *
+ *  \sa SDL_OpenWAV_RW
+ *  \sa SDL_ReadWAV
+ *  \sa SDL_CloseWAV
+ */
+struct SDL_WAVReader;
+typedef struct SDL_WAVReader SDL_WAVReader;
+
+/**
+ *  This function opens a WAVE from the data source for incremental reading,
+ *  automatically freeing that source when the reader is closed if
+ *  \c freesrc is non-zero.
+ *
+ *  Unlike SDL_LoadWAV_RW(), this only reads the header. The samples are
+ *  read and decoded as you ask for them with SDL_ReadWAV(), so a long file
+ *  costs no more memory or startup time than a short one. This makes it a
+ *  good fit for SDL_QueueAudio() or an audio callback.
+ *
+ *  If this function succeeds, \c spec (if not NULL) is filled in just like
+ *  SDL_LoadWAV_RW() would fill it in.
+ *
+ *  \return A new reader, or NULL on error (call SDL_GetError() for details).
+ *           On error, \c src is freed if \c freesrc is non-zero.
+ */
+extern DECLSPEC SDL_WAVReader *SDLCALL SDL_OpenWAV_RW(SDL_RWops * src,
+                                                      int freesrc,
+                                                      SDL_AudioSpec * spec);
+
+/**
+ *  Opens a WAV file for incremental reading.
+ */
+#define SDL_OpenWAV(file, spec) \
+    SDL_OpenWAV_RW(SDL_RWFromFile(file, "rb"),1, spec)
+
+/**
+ *  Reads and decodes up to \c len bytes of audio from a WAVE reader, in the
+ *  format given by SDL_OpenWAV_RW(). Only whole sample frames are returned.
+ *
+ *  \return The number of bytes read, 0 at the end of the data, or -1 on
+ *           error (call SDL_GetError() for details).
+ */
+extern DECLSPEC int SDLCALL SDL_ReadWAV(SDL_WAVReader * reader, void *buf,
+                                        int len);
+
+/**
+ *  Goes back to the start of the audio data, if the data source can seek.
+ *
+ *  \return 0 on success, or -1 on error (call SDL_GetError() for details).
+ */
+extern DECLSPEC int SDLCALL SDL_RewindWAV(SDL_WAVReader * reader);
+
+/**
+ *  Gets the total size of the decoded audio, in bytes. This is what
+ *  SDL_LoadWAV_RW() would put in \c audio_len for the same file.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetWAVLength(SDL_WAVReader * reader);
+
+/**
+ *  Closes a WAVE reader, and its data source if it was opened with
+ *  \c freesrc set.
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWAV(SDL_WAVReader * reader);
+
 /**
  *  This function takes a source format and rate and a destination format
  *  and rate, and initializes the \c cvt structure with information needed
@@ -486,6 +551,31 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
                                                 SDL_AudioFormat format,
                                                 Uint32 len, int volume);
 
+/**
+ *  Mix several buffers into \c dst in a single pass.
+ *
+ *  This is like calling SDL_MixAudioFormat() once for each of the \c num_srcs
+ *  buffers in \c srcs, but \c dst is only read and written once, and clipping
+ *  is applied to the final sum instead of after each source. The result only
+ *  differs from the one-at-a-time version where an intermediate sum clipped.
+ *
+ *  \param dst      The buffer to mix into; it is also the first input.
+ *  \param srcs     An array of \c num_srcs buffers, each at least \c len bytes.
+ *  \param volumes  The volume of each source (0 - ::SDL_MIX_MAXVOLUME), or
+ *                  NULL to mix every source at full volume.
+ *  \param num_srcs The number of source buffers.
+ *  \param format   The audio format of all the buffers.
+ *  \param len      The length of each buffer, in bytes.
+ *
+ *  \return 0 on success, or -1 on error (call SDL_GetError() for details).
+ */
+extern DECLSPEC int SDLCALL SDL_MixAudioFormatMulti(Uint8 * dst,
+                                                    const Uint8 ** srcs,
+                                                    const int *volumes,
+                                                    int num_srcs,
+                                                    SDL_AudioFormat format,
+                                                    Uint32 len);
+
 /**
  *  Queue more audio on non-callback devices.
  *
@@ -646,6 +736,124 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
 
+/**
+ *  \name Audio device statistics
+ *
+ *  Counters describing how well an audio device keeps up, for tuning buffer
+ *  sizes. They are collected by the audio thread of every opened device.
+ *
+ *  The histograms have one bucket per power of two: bucket \c i counts the
+ *  times up to 2^i microseconds, the last bucket counts everything longer.
+ */
+/* @{ */
+#define SDL_AUDIO_STATS_BUCKETS 24
+
+typedef struct SDL_AudioDeviceStats
+{
+    Uint32 callbacks;           /**< Times the audio callback ran */
+    Uint64 callback_total_us;   /**< Time spent in the callback */
+    Uint32 callback_max_us;     /**< Longest callback */
+    Uint32 callback_histogram[SDL_AUDIO_STATS_BUCKETS]; /**< Callback durations */
+    Uint32 period_us;           /**< Expected time between callbacks */
+    Uint32 late_wakeups;        /**< Callbacks which started more than a period late */
+    Uint32 jitter_max_us;       /**< Largest difference from the expected period */
+    Uint32 jitter_histogram[SDL_AUDIO_STATS_BUCKETS]; /**< Differences from the expected period */
+    Uint32 paused_silence;      /**< Buffers filled with silence because the device was paused */
+    Uint32 underrun_silence;    /**< Buffers filled with silence because the converter ran short */
+    Uint32 queued_bytes;        /**< Audio queued with SDL_QueueAudio() and not yet played */
+    int device_latency_ms;      /**< Audio buffered by the device, or -1 if the driver can't tell */
+} SDL_AudioDeviceStats;
+
+/**
+ *  Get the statistics of an opened audio device.
+ *
+ *  \param dev The device ID to query.
+ *  \param stats Filled in with the statistics since the device was opened
+ *               or SDL_ResetAudioDeviceStats() was last called.
+ *
+ *  \return 0 on success, or -1 if the device ID or \c stats is invalid.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID dev,
+                                                    SDL_AudioDeviceStats * stats);
+
+/**
+ *  Reset the statistics of an opened audio device to zero.
+ */
+extern DECLSPEC void SDLCALL SDL_ResetAudioDeviceStats(SDL_AudioDeviceID dev);
+/* @} *//* Audio device statistics */
+
+
+/**
+ *  \name Audio timestamps
+ *
+ *  These line up audio buffers with a monotonic clock, for example to
+ *  measure the round trip from playback to capture for echo cancellation.
+ *  Frames are counted in the format the app asked for when opening the
+ *  device, and times are SDL_GetPerformanceCounter() values.
+ */
+/* @{ */
+typedef struct SDL_AudioTimestamp
+{
+    Uint64 frame;   /**< Sample frames before the first one of the buffer */
+    Uint64 time;    /**< When the first sample was captured, or will be heard */
+} SDL_AudioTimestamp;
+
+/**
+ *  Get the timestamp of the buffer most recently passed to the audio
+ *  callback of an opened device.
+ *
+ *  Called from inside the callback, this describes the buffer being
+ *  delivered: for capture devices, the time its first sample was captured;
+ *  for playback devices, the estimated time its first sample will be heard.
+ *  Capture devices count every frame they record, playback devices count
+ *  the frames the callback has produced.
+ *
+ *  \param dev The device ID to query.
+ *  \param timestamp Filled in with the buffer's timestamp. Both fields are
+ *                   zero if the callback hasn't run yet.
+ *
+ *  \return 0 on success, or -1 if the device ID or \c timestamp is invalid.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceTimestamp(SDL_AudioDeviceID dev,
+                                                        SDL_AudioTimestamp * timestamp);
+
+/**
+ *  This works like SDL_QueueAudio(), but also reports when the first
+ *  sample of \c data is expected to be heard, from the audio already
+ *  queued and buffered by the device.
+ *
+ *  \param dev The device ID to which we will queue audio.
+ *  \param data The data to queue to the device for later playback.
+ *  \param len The number of bytes (not samples!) to which (data) points.
+ *  \param timestamp Filled in with the timestamp of the first queued sample.
+ *                   May be NULL.
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_QueueAudio
+ */
+extern DECLSPEC int SDLCALL SDL_QueueAudioTimestamped(SDL_AudioDeviceID dev,
+                                                      const void *data, Uint32 len,
+                                                      SDL_AudioTimestamp * timestamp);
+
+/**
+ *  This works like SDL_DequeueAudio(), but also reports when the first
+ *  sample returned in \c data was captured.
+ *
+ *  \param dev The device ID from which we will dequeue audio.
+ *  \param data A pointer into where audio data should be copied.
+ *  \param len The number of bytes (not samples!) to which (data) points.
+ *  \param timestamp Filled in with the timestamp of the first dequeued
+ *                   sample, if any bytes were dequeued. May be NULL.
+ *  \return number of bytes dequeued, which could be less than requested.
+ *
+ *  \sa SDL_DequeueAudio
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_DequeueAudioTimestamped(SDL_AudioDeviceID dev,
+                                                           void *data, Uint32 len,
+                                                           SDL_AudioTimestamp * timestamp);
+/* @} *//* Audio timestamps */
+
+
 /**
  *  \name Audio lock functions
  *
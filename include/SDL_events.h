@@ -734,6 +734,28 @@ extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint32 type, int state);
 /* @} */
 #define SDL_GetEventState(type) SDL_EventState(type, SDL_QUERY)
 
+/**
+ *  This function allows you to merge high frequency motion events in the
+ *  queue, so a fast mouse or touch panel can't flood it with stale positions.
+ *
+ *  While coalescing is enabled for a type, a new event of that type which
+ *  matches the event at the tail of the queue replaces its position or value,
+ *  and relative motion is added to the motion already queued. Events match
+ *  when they come from the same device and window, finger, axis or ball.
+ *
+ *  The types which can be coalesced are ::SDL_MOUSEMOTION,
+ *  ::SDL_FINGERMOTION, ::SDL_JOYAXISMOTION, ::SDL_JOYBALLMOTION,
+ *  ::SDL_CONTROLLERAXISMOTION and ::SDL_WINDOWEVENT, for which only moved
+ *  and resized events are merged. Coalescing is disabled by default.
+ *
+ *  \param type The event type
+ *  \param state ::SDL_ENABLE, ::SDL_DISABLE or ::SDL_QUERY
+ *
+ *  \return The previous state, which is always ::SDL_DISABLE for types that
+ *          can't be coalesced.
+ */
+extern DECLSPEC Uint8 SDLCALL SDL_EventCoalescing(Uint32 type, int state);
+
 /**
  *  This function allocates a set of user-defined events, and returns
  *  the beginning event number for that set of events.
@@ -743,6 +765,63 @@ extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint32 type, int state);
  */
 extern DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
 
+/**
+ *  \brief Counters for one event type, since the event loop started or
+ *         SDL_ResetEventQueueStats() was called.
+ */
+typedef struct SDL_EventTypeStats
+{
+    Uint32 pushed;      /**< Events added to the queue */
+    Uint32 filtered;    /**< Events rejected by the event filter or SDL_FilterEvents() */
+    Uint32 dropped;     /**< Events lost because the queue was full */
+    Uint32 consumed;    /**< Events removed from the queue by the application */
+    Uint32 coalesced;   /**< Events merged into one already queued, see SDL_EventCoalescing() */
+} SDL_EventTypeStats;
+
+/**
+ *  \brief Statistics for the whole event queue, since the event loop
+ *         started or SDL_ResetEventQueueStats() was called.
+ *
+ *  The latency is the time an event spent in the queue before the
+ *  application removed it. Percentiles are rounded up to a power of two.
+ */
+typedef struct SDL_EventQueueStats
+{
+    int depth;              /**< Events in the queue now */
+    int max_depth;          /**< Most events in the queue at once */
+    float mean_depth;       /**< Queue depth averaged over every added event */
+    Uint32 watcher_calls;   /**< Events passed to the event filter and watchers */
+    Uint64 watcher_ns;      /**< Time spent in the event filter and watchers */
+    Uint32 latency_count;   /**< Events the latency was measured for */
+    Uint32 latency_p50_us;  /**< Median time in the queue, in microseconds */
+    Uint32 latency_p90_us;  /**< 90th percentile time in the queue */
+    Uint32 latency_p99_us;  /**< 99th percentile time in the queue */
+    Uint32 latency_max_us;  /**< Longest time in the queue */
+} SDL_EventQueueStats;
+
+/**
+ *  Get the counters for one event type.
+ *
+ *  The counters are always collected, and are cheap enough to leave on.
+ *  Looking at every type up to ::SDL_LASTEVENT shows which input sources
+ *  are flooding the queue.
+ *
+ *  \return 0 on success, or -1 if \c stats is NULL.
+ */
+extern DECLSPEC int SDLCALL SDL_GetEventTypeStats(Uint32 type, SDL_EventTypeStats * stats);
+
+/**
+ *  Get the queue depth, watcher time and latency statistics.
+ *
+ *  \return 0 on success, or -1 if \c stats is NULL.
+ */
+extern DECLSPEC int SDLCALL SDL_GetEventQueueStats(SDL_EventQueueStats * stats);
+
+/**
+ *  Reset all the event queue statistics to zero.
+ */
+extern DECLSPEC void SDLCALL SDL_ResetEventQueueStats(void);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -141,6 +141,42 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling where the OpenGL ES 2 render driver keeps linked shader programs between runs.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Link the programs every run
+ *    "1"       - Keep the programs in SDL_GetPrefPath("libsdl", "programs")
+ *    A path    - Keep the programs in this directory, which must exist
+ *
+ *  Programs can only be kept if the driver supports GL_OES_get_program_binary or
+ *  OpenGL ES 3.0. By default the programs are linked every run.
+ */
+#define SDL_HINT_RENDER_PROGRAM_CACHE       "SDL_RENDER_PROGRAM_CACHE"
+
+/**
+ *  \brief  A variable controlling whether renderers prepare their common shaders when they're created.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Prepare shaders the first time they're used
+ *    "1"       - Prepare the common shaders with SDL_RenderWarmUp() when the renderer is created
+ *
+ *  By default shaders are prepared the first time they're used.
+ */
+#define SDL_HINT_RENDER_WARMUP              "SDL_RENDER_WARMUP"
+
+/**
+ *  \brief  A variable controlling whether renderers are profiled from the start.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't profile renderers
+ *    "1"       - Profile renderers, see SDL_RenderSetProfiling()
+ *    Any other value is the name of a file to also write a Chrome trace to
+ *
+ *  By default renderers aren't profiled.
+ */
+#define SDL_HINT_RENDER_PROFILE             "SDL_RENDER_PROFILE"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -199,6 +235,20 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_NET_WM_PING      "SDL_VIDEO_X11_NET_WM_PING"
 
+/**
+ *  \brief  A variable naming the files the offscreen video driver captures frames to.
+ *
+ *  When this is set, every frame presented in a window is appended to the
+ *  file named by the variable's value, followed by "-window" and the window ID
+ *  and ".rgba". The frames are raw SDL_PIXELFORMAT_RGBA32 pixels, top row
+ *  first, with no header or padding, so a window's file holds frames of
+ *  width * height * 4 bytes for as long as the window keeps its size.
+ *
+ *  By default frames are not captured. The hint is checked when a window is
+ *  created.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_CAPTURE    "SDL_VIDEO_OFFSCREEN_CAPTURE"
+
 /**
  *  \brief  A variable controlling whether the window frame and title bar are interactive when the cursor is hidden 
  *
@@ -801,6 +851,33 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
+/**
+ *  \brief  A variable controlling whether the ALSA audio driver writes to
+ *          playback devices through a memory mapped buffer.
+ *
+ *  With memory mapped access the audio callback mixes straight into the
+ *  device's ring buffer, instead of into a separate buffer which is then
+ *  copied with snd_pcm_writei(). If the device doesn't support it, SDL
+ *  falls back to normal access.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Copy audio to the device with snd_pcm_writei() (default)
+ *    "1"       - Use memory mapped access if the device supports it
+ */
+#define SDL_HINT_AUDIO_ALSA_MMAP   "SDL_AUDIO_ALSA_MMAP"
+
+/**
+ *  \brief  A variable setting the number of periods in the ALSA playback
+ *          buffer, each the size of the requested audio buffer.
+ *
+ *  Fewer periods lower the output latency, more periods give the audio
+ *  thread more time to be scheduled before the device runs dry.
+ *
+ *  This variable is checked when an audio device is opened. It can be set
+ *  to a number from 2 (the default) to 16.
+ */
+#define SDL_HINT_AUDIO_ALSA_PERIODS   "SDL_AUDIO_ALSA_PERIODS"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
@@ -48,6 +48,11 @@ extern "C" {
  */
 #define SDL_MUTEX_MAXWAIT   (~(Uint32)0)
 
+/**
+ *  This is the nanosecond timeout value which corresponds to never time out.
+ */
+#define SDL_MUTEX_MAXWAIT_NS    (~(Uint64)0)
+
 
 /**
  *  \name Mutex functions
@@ -142,6 +147,20 @@ extern DECLSPEC int SDLCALL SDL_SemTryWait(SDL_sem * sem);
  */
 extern DECLSPEC int SDLCALL SDL_SemWaitTimeout(SDL_sem * sem, Uint32 ms);
 
+/**
+ *  Variant of SDL_SemWait() with a timeout in nanoseconds.
+ *
+ *  The timeout is measured against a monotonic clock where the platform
+ *  provides one, so it is not affected by changes to the wall clock time.
+ *
+ *  \return 0 if the wait succeeds, ::SDL_MUTEX_TIMEDOUT if the wait does not
+ *          succeed in the allotted time, and -1 on error.
+ *
+ *  \warning Platforms without a nanosecond wait primitive round the timeout
+ *           up to their native granularity.
+ */
+extern DECLSPEC int SDLCALL SDL_SemWaitTimeoutNS(SDL_sem * sem, Uint64 ns);
+
 /**
  *  Atomically increases the semaphore's count (not blocking).
  *
@@ -237,6 +256,20 @@ extern DECLSPEC int SDLCALL SDL_CondWait(SDL_cond * cond, SDL_mutex * mutex);
 extern DECLSPEC int SDLCALL SDL_CondWaitTimeout(SDL_cond * cond,
                                                 SDL_mutex * mutex, Uint32 ms);
 
+/**
+ *  Waits for at most \c ns nanoseconds, and returns 0 if the condition
+ *  variable is signaled, ::SDL_MUTEX_TIMEDOUT if the condition is not
+ *  signaled in the allotted time, and -1 on error.
+ *
+ *  The timeout is measured against a monotonic clock where the platform
+ *  provides one, so it is not affected by changes to the wall clock time.
+ *
+ *  \warning Platforms without a nanosecond wait primitive round the timeout
+ *           up to their native granularity.
+ */
+extern DECLSPEC int SDLCALL SDL_CondWaitTimeoutNS(SDL_cond * cond,
+                                                  SDL_mutex * mutex, Uint64 ns);
+
 /* @} *//* Condition variable functions */
 
 
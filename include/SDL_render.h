@@ -257,6 +257,97 @@ extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTexture(SDL_Renderer * renderer,
  */
 extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface);
 
+/**
+ *  \brief Create a small static texture that shares a texture atlas page with
+ *         others.
+ *
+ *  \param renderer The renderer.
+ *  \param format The format of the texture.
+ *  \param w      The width of the texture in pixels.
+ *  \param h      The height of the texture in pixels.
+ *
+ *  \return The created texture is returned, or NULL on error.
+ *
+ *  The texture is used like one created with ::SDL_TEXTUREACCESS_STATIC, but
+ *  is packed into a page with other small textures of the same format, so
+ *  copies from them can be drawn without the renderer switching textures.
+ *  Textures too large for a page, and in formats the renderer can't draw
+ *  directly, get a texture of their own.
+ *
+ *  Textures in an atlas can't be bound with SDL_GL_BindTexture(), and are
+ *  filtered with the scale quality that was set when their page was created.
+ *
+ *  \sa SDL_CreateAtlasTextureFromSurface()
+ *  \sa SDL_GetRenderAtlasStats()
+ *  \sa SDL_CompactRenderAtlas()
+ */
+extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateAtlasTexture(SDL_Renderer * renderer,
+                                                             Uint32 format,
+                                                             int w, int h);
+
+/**
+ *  \brief Create a texture in a texture atlas from an existing surface.
+ *
+ *  \param renderer The renderer.
+ *  \param surface The surface containing pixel data used to fill the texture.
+ *
+ *  \return The created texture is returned, or NULL on error.
+ *
+ *  \note The surface is not modified or freed by this function.
+ *
+ *  \sa SDL_CreateAtlasTexture()
+ *  \sa SDL_CreateTextureFromSurface()
+ */
+extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateAtlasTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface);
+
+/**
+ *  \brief How full the pages of a renderer's texture atlas are.
+ */
+typedef struct SDL_RenderAtlasStats
+{
+    int pages;              /**< The number of pages */
+    int page_w;             /**< The width of each page */
+    int page_h;             /**< The height of each page */
+    int textures;           /**< The number of textures packed into the pages */
+    Uint64 used_area;       /**< The pixels covered by the textures */
+    Uint64 total_area;      /**< The pixels in all the pages */
+    int free_rects;         /**< The separate free areas left in the pages */
+} SDL_RenderAtlasStats;
+
+/**
+ *  \brief Get the statistics of a renderer's texture atlas.
+ *
+ *  \param renderer The renderer.
+ *  \param stats    A pointer filled in with the statistics.
+ *
+ *  \return 0 on success, or -1 if the renderer is not valid.
+ *
+ *  Pages are freed as soon as the last texture on them is destroyed. The
+ *  space freed on pages still in use can be pieced back together with
+ *  SDL_CompactRenderAtlas() when the used area falls well below the total.
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderAtlasStats(SDL_Renderer * renderer,
+                                                    SDL_RenderAtlasStats * stats);
+
+/**
+ *  \brief Repack the textures in a renderer's atlas into as few pages as
+ *         possible.
+ *
+ *  \param renderer The renderer.
+ *
+ *  \return 0 on success, or -1 if the renderer doesn't support render
+ *          targets, or the repacking failed.
+ *
+ *  The textures keep their handles and contents; only their places in the
+ *  pages change. This draws into the pages as render targets, so it should
+ *  be called between frames.
+ *
+ *  \note The pages are render targets whenever the renderer supports them,
+ *        so with renderers that send ::SDL_RENDER_TARGETS_RESET, the
+ *        textures in the atlas have to be updated again after that event.
+ */
+extern DECLSPEC int SDLCALL SDL_CompactRenderAtlas(SDL_Renderer * renderer);
+
 /**
  *  \brief Query the attributes of a texture
  *
@@ -830,6 +921,44 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
                                            const SDL_Point *center,
                                            const SDL_RendererFlip flip);
 
+/**
+ *  \brief A vertex of the triangles drawn by SDL_RenderGeometry().
+ */
+typedef struct SDL_Vertex
+{
+    float x, y;         /**< Position, in the same coordinates as SDL_RenderCopy() */
+    SDL_Color color;    /**< Color, modulating the texture if there is one */
+    float u, v;         /**< Texture coordinates, from 0 to 1 across the texture */
+} SDL_Vertex;
+
+/**
+ *  \brief Draw a list of triangles to the current rendering target, with the
+ *         texture and colors given at their corners.
+ *
+ *  \param renderer     The renderer.
+ *  \param texture      The texture to draw with, or NULL to draw with the
+ *                      vertex colors alone.
+ *  \param vertices     The vertices.
+ *  \param num_vertices The number of vertices.
+ *  \param indices      The indices into the vertices, three per triangle, or
+ *                      NULL to take each three vertices in turn as a triangle.
+ *  \param num_indices  The number of indices.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  Colors and texture coordinates are interpolated across each triangle.
+ *  Textured triangles use the texture's blend mode and color and alpha
+ *  modulation, and untextured ones use the renderer's draw blend mode.
+ *  A whole mesh is drawn at once, which is much cheaper than a separate
+ *  call for each shape.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer * renderer,
+                                               SDL_Texture * texture,
+                                               const SDL_Vertex * vertices,
+                                               int num_vertices,
+                                               const int * indices,
+                                               int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -850,11 +979,205 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
                                                  Uint32 format,
                                                  void *pixels, int pitch);
 
+/**
+ *  \brief A pixel read started with SDL_RenderReadPixelsAsync().
+ */
+struct SDL_RenderReadback;
+typedef struct SDL_RenderReadback SDL_RenderReadback;
+
+/**
+ *  \brief Start reading pixels from the current rendering target, without
+ *         waiting for the rendering so far to finish.
+ *
+ *  The pixels are those the target holds once everything rendered before
+ *  this call is done, whatever is rendered afterwards. Renderers that
+ *  can't read asynchronously read the pixels right away.
+ *
+ *  \param renderer The renderer from which pixels should be read.
+ *  \param rect     A pointer to the rectangle to read, or NULL for the entire
+ *                  render target.
+ *
+ *  \return A readback to pass to SDL_FinishRenderReadback(), or NULL on error.
+ *
+ *  \note Readbacks that haven't been finished are discarded when the
+ *        renderer is destroyed.
+ *
+ *  \sa SDL_RenderReadbackReady()
+ *  \sa SDL_FinishRenderReadback()
+ */
+extern DECLSPEC SDL_RenderReadback * SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer * renderer,
+                                                                       const SDL_Rect * rect);
+
+/**
+ *  \brief Check whether SDL_FinishRenderReadback() can run without waiting
+ *         for the GPU.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_RenderReadbackReady(SDL_RenderReadback * readback);
+
+/**
+ *  \brief Wait for a readback if it's still pending, write its pixels out and
+ *         free it.
+ *
+ *  The pixels are converted and put the right way up in a single pass
+ *  straight into \c pixels, laid out as for SDL_RenderReadPixels().
+ *
+ *  \param readback The readback from SDL_RenderReadPixelsAsync().
+ *  \param format   The desired format of the pixel data, or 0 to use the
+ *                  format of the rendering target.
+ *  \param pixels   A pointer to be filled in with the pixel data, or NULL to
+ *                  discard the readback.
+ *  \param pitch    The pitch of the pixels parameter.
+ *
+ *  \return 0 on success, or -1 on error. The readback is freed either way.
+ */
+extern DECLSPEC int SDLCALL SDL_FinishRenderReadback(SDL_RenderReadback * readback,
+                                                     Uint32 format,
+                                                     void *pixels, int pitch);
+
 /**
  *  \brief Update the screen with rendering performed.
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief How much of the output the renderer's presents have updated.
+ */
+typedef struct SDL_RenderPresentStats
+{
+    Uint32 frames;              /**< Frames presented since the statistics were reset */
+    int rects;                  /**< Rectangles updated by the last present */
+    Uint32 damaged_pixels;      /**< Pixels updated by the last present */
+    Uint32 total_pixels;        /**< Pixels in the output at the last present */
+    float damaged_ratio;        /**< damaged_pixels / total_pixels, from 0 to 1 */
+    Uint64 damaged_pixels_sum;  /**< damaged_pixels over all the frames */
+    Uint64 total_pixels_sum;    /**< total_pixels over all the frames */
+} SDL_RenderPresentStats;
+
+/**
+ *  \brief Get the statistics of a renderer's presents.
+ *
+ *  \param renderer The renderer.
+ *  \param stats    A pointer filled in with the statistics.
+ *
+ *  \return 0 on success, or -1 if the renderer is not valid.
+ *
+ *  The software renderer only updates the parts of the window drawn to since
+ *  the last present. Other renderers always update the whole output.
+ *
+ *  \sa SDL_ResetRenderPresentStats()
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderPresentStats(SDL_Renderer * renderer,
+                                                      SDL_RenderPresentStats * stats);
+
+/**
+ *  \brief Reset the statistics of a renderer's presents to zero.
+ *
+ *  \sa SDL_GetRenderPresentStats()
+ */
+extern DECLSPEC void SDLCALL SDL_ResetRenderPresentStats(SDL_Renderer * renderer);
+
+/**
+ *  \brief Prepare the shaders the renderer commonly uses, so the first frames
+ *         drawn with them don't stall.
+ *
+ *  \param renderer The renderer.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  Renderers without shaders, or that prepare them up front anyway, do
+ *  nothing. Setting ::SDL_HINT_RENDER_WARMUP does this when the renderer is
+ *  created.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderWarmUp(SDL_Renderer * renderer);
+
+/**
+ *  \brief The driver calls timed by the render profiler.
+ *
+ *  \sa SDL_RenderFrameProfile
+ */
+typedef enum
+{
+    SDL_RENDER_CALL_CLEAR,
+    SDL_RENDER_CALL_DRAW_POINTS,
+    SDL_RENDER_CALL_DRAW_LINES,
+    SDL_RENDER_CALL_FILL_RECTS,
+    SDL_RENDER_CALL_COPY,
+    SDL_RENDER_CALL_COPY_EX,
+    SDL_RENDER_CALL_GEOMETRY,
+    SDL_RENDER_CALL_UPDATE_TEXTURE,     /**< Including unlocking streaming textures */
+    SDL_RENDER_CALL_SET_TARGET,
+    SDL_RENDER_CALL_READ_PIXELS,
+    SDL_RENDER_CALL_PRESENT,
+    SDL_RENDER_CALL_COUNT
+} SDL_RenderCall;
+
+/**
+ *  \brief How often a driver call was made in a frame and how long it took.
+ */
+typedef struct SDL_RenderCallProfile
+{
+    Uint32 calls;
+    Uint64 ns;
+} SDL_RenderCallProfile;
+
+/**
+ *  \brief Where the time of a frame went, see SDL_RenderGetFrameProfile().
+ *
+ *  A frame ends when SDL_RenderPresent() returns. Only the time spent in the
+ *  renderer's driver is counted, so the difference between \c frame_ns and
+ *  the sum of the calls is time the application spent elsewhere.
+ */
+typedef struct SDL_RenderFrameProfile
+{
+    Uint32 frame;               /**< Frames presented since profiling was enabled */
+    Uint64 frame_ns;            /**< Time since the end of the previous frame */
+    SDL_RenderCallProfile calls[SDL_RENDER_CALL_COUNT];
+    Uint32 blend_changes;       /**< Blend state changes made by the driver */
+    Uint32 program_changes;     /**< Shader program switches made by the driver */
+    Uint32 texture_binds;       /**< Textures bound by the driver to draw */
+    Uint64 bytes_uploaded;      /**< Texture pixels sent to the driver */
+    Uint64 gpu_wait_ns;         /**< Time the buffer swap waited for the GPU to finish */
+    Uint64 vsync_wait_ns;       /**< Time the buffer swap waited for vertical sync */
+} SDL_RenderFrameProfile;
+
+/**
+ *  \brief Turn the render profiler on or off.
+ *
+ *  \param renderer   The renderer.
+ *  \param enabled    SDL_TRUE to count and time the driver calls of every
+ *                    frame, SDL_FALSE to stop.
+ *  \param trace_file The name of a file to write the calls to in the Chrome
+ *                    trace event format, or NULL. It's complete once profiling
+ *                    is turned off or the renderer is destroyed, and can be
+ *                    loaded into chrome://tracing.
+ *
+ *  \return 0 on success, or -1 if the trace file couldn't be opened.
+ *
+ *  Setting ::SDL_HINT_RENDER_PROFILE does this when the renderer is created.
+ *  The counts of state changes come from the drivers that keep them, which
+ *  is currently the OpenGL ES 2 renderer, and the waits from video drivers
+ *  that measure them.
+ *
+ *  \sa SDL_RenderGetFrameProfile()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderSetProfiling(SDL_Renderer * renderer,
+                                                   SDL_bool enabled,
+                                                   const char *trace_file);
+
+/**
+ *  \brief Get the profile of the last frame presented.
+ *
+ *  \param renderer The renderer.
+ *  \param profile  A pointer filled in with the profile, which is all zero
+ *                  until a frame has been presented with profiling on.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_RenderSetProfiling()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetFrameProfile(SDL_Renderer * renderer,
+                                                      SDL_RenderFrameProfile * profile);
+
 /**
  *  \brief Destroy the specified texture.
  *
@@ -70,6 +70,14 @@ extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceFrequency(void);
  */
 extern DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
 
+/**
+ * \brief Wait a specified number of nanoseconds before returning.
+ *
+ * \note Platforms without a high resolution sleep round the delay up to
+ *       their native granularity.
+ */
+extern DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
+
 /**
  *  Function prototype for the timer callback function.
  *
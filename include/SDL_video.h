@@ -1197,6 +1197,59 @@ extern DECLSPEC int SDLCALL SDL_GL_GetSwapInterval(void);
  */
 extern DECLSPEC void SDLCALL SDL_GL_SwapWindow(SDL_Window * window);
 
+/**
+ *  \brief Presentation timing for an OpenGL window.
+ *
+ *  Times are taken when SDL_GL_SwapWindow() returns from the video driver's
+ *  buffer swap, which is as close to the actual present as SDL can see.
+ *
+ *  \sa SDL_GL_GetFrameTiming()
+ */
+typedef struct SDL_GLFrameTiming
+{
+    Uint64 frame;           /**< Frames swapped since the window was created */
+    Uint64 present_time;    /**< SDL_GetPerformanceCounter() at the last present */
+    Uint64 interval_ns;     /**< Time between the last two presents */
+    Uint64 gpu_wait_ns;     /**< Time the last swap waited for the GPU to catch up */
+    Uint32 missed_frames;   /**< Frame intervals that passed without a present */
+    int frames_in_flight;   /**< Swapped frames the GPU hasn't finished yet */
+} SDL_GLFrameTiming;
+
+/**
+ *  \brief Set how SDL_GL_SwapWindow() paces the frames of a window.
+ *
+ *  \param window The window, which must have its OpenGL context current.
+ *  \param frames_in_flight How many frames may be in progress at once,
+ *                          counting the one the CPU is building, from 1 to 8.
+ *                          1 keeps the CPU and GPU in lockstep, and with 2
+ *                          the CPU builds the next frame while the GPU
+ *                          renders the last one. 0 leaves GPU
+ *                          synchronization to the video driver.
+ *  \param target_interval_ns The time to hold each frame for before it is
+ *                            swapped, or 0 to swap as soon as possible.
+ *
+ *  \return 0 on success, or -1 if the video driver can't track GPU progress.
+ *
+ *  Frames in flight are tracked with GPU fences, which replace the
+ *  glFinish() some video drivers do on every swap.
+ *
+ *  \sa SDL_GL_GetFrameTiming()
+ */
+extern DECLSPEC int SDLCALL SDL_GL_SetFramePacing(SDL_Window * window, int frames_in_flight, Uint64 target_interval_ns);
+
+/**
+ *  \brief Get the presentation timing for an OpenGL window.
+ *
+ *  Frames are counted as missed against the target interval given to
+ *  SDL_GL_SetFramePacing(), or otherwise against the display refresh rate
+ *  when the swap is synchronized with the vertical retrace.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_GL_SetFramePacing()
+ */
+extern DECLSPEC int SDLCALL SDL_GL_GetFrameTiming(SDL_Window * window, SDL_GLFrameTiming * timing);
+
 /**
  *  \brief Delete an OpenGL context.
  *
@@ -310,5 +310,159 @@ SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
     return packet->data;
 }
 
+
+struct SDL_RingBuffer
+{
+    SDL_atomic_t head;  /* bytes read so far; only the consumer changes this. */
+    Uint8 pad1[SDL_CACHELINE_SIZE - sizeof (SDL_atomic_t)];
+    SDL_atomic_t tail;  /* bytes written so far; only the producer changes this. */
+    Uint8 pad2[SDL_CACHELINE_SIZE - sizeof (SDL_atomic_t)];
+    Uint32 mask;
+    Uint8 *data;
+};
+
+/* head and tail count forever and wrap at 2^32; since the capacity is a power
+   of two no larger than 2^30, (tail - head) is always the fill level. */
+
+SDL_RingBuffer *
+SDL_NewRingBuffer(const size_t capacity)
+{
+    SDL_RingBuffer *ring;
+    Uint32 size = 1024;
+
+    if (capacity > (1 << 30)) {
+        SDL_InvalidParamError("capacity");
+        return NULL;
+    }
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    ring = (SDL_RingBuffer *) SDL_calloc(1, sizeof (SDL_RingBuffer));
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->data = (Uint8 *) SDL_malloc(size);
+    if (!ring->data) {
+        SDL_free(ring);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->mask = size - 1;
+    return ring;
+}
+
+void
+SDL_FreeRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+size_t
+SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *_data, const size_t len)
+{
+    const Uint8 *data = (const Uint8 *) _data;
+    Uint32 head, tail, pos, towrite, first;
+
+    if (!ring) {
+        return 0;
+    }
+
+    tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    head = (Uint32) SDL_AtomicGet(&ring->head);
+    SDL_MemoryBarrierAcquire();  /* the consumer is done with the space it released. */
+
+    towrite = (Uint32) SDL_min(len, (size_t) ((ring->mask + 1) - (tail - head)));
+    pos = tail & ring->mask;
+    first = SDL_min(towrite, (ring->mask + 1) - pos);
+    SDL_memcpy(ring->data + pos, data, first);
+    SDL_memcpy(ring->data, data + first, towrite - first);
+
+    SDL_MemoryBarrierRelease();  /* the data lands before the consumer can see it. */
+    SDL_AtomicSet(&ring->tail, (int) (tail + towrite));
+    return towrite;
+}
+
+size_t
+SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *_buf, const size_t len)
+{
+    Uint8 *buf = (Uint8 *) _buf;
+    Uint32 head, tail, pos, toread, first;
+
+    if (!ring) {
+        return 0;
+    }
+
+    head = (Uint32) SDL_AtomicGet(&ring->head);
+    tail = (Uint32) SDL_AtomicGet(&ring->tail);
+    SDL_MemoryBarrierAcquire();  /* see the data the producer published. */
+
+    toread = (Uint32) SDL_min(len, (size_t) (tail - head));
+    pos = head & ring->mask;
+    first = SDL_min(toread, (ring->mask + 1) - pos);
+    SDL_memcpy(buf, ring->data + pos, first);
+    SDL_memcpy(buf + first, ring->data, toread - first);
+
+    SDL_MemoryBarrierRelease();  /* finish reading before the producer reuses the space. */
+    SDL_AtomicSet(&ring->head, (int) (head + toread));
+    return toread;
+}
+
+void
+SDL_ClearRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        SDL_AtomicSet(&ring->head, SDL_AtomicGet(&ring->tail));
+    }
+}
+
+size_t
+SDL_CountRingBuffer(SDL_RingBuffer *ring)
+{
+    if (!ring) {
+        return 0;
+    }
+    return (size_t) ((Uint32) SDL_AtomicGet(&ring->tail) - (Uint32) SDL_AtomicGet(&ring->head));
+}
+
+size_t
+SDL_MoveDataQueueToRingBuffer(SDL_DataQueue *queue, SDL_RingBuffer *ring)
+{
+    SDL_DataQueuePacket *packet;
+    size_t moved = 0;
+
+    if (!queue || !ring) {
+        return 0;
+    }
+
+    while ((packet = queue->head) != NULL) {
+        const size_t avail = packet->datalen - packet->startpos;
+        const size_t cpy = SDL_WriteToRingBuffer(ring, packet->data + packet->startpos, avail);
+
+        packet->startpos += cpy;
+        queue->queued_bytes -= cpy;
+        moved += cpy;
+
+        if (packet->startpos < packet->datalen) {
+            break;  /* the ring is full. */
+        }
+
+        /* packet is done, put it in the pool. */
+        queue->head = packet->next;
+        packet->next = queue->pool;
+        queue->pool = packet;
+    }
+
+    if (queue->head == NULL) {
+        queue->tail = NULL;
+    }
+
+    return moved;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
 
@@ -48,6 +48,35 @@ size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 */
 void *SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len);
 
+/* A fixed-size byte ring for one producer thread and one consumer thread.
+   Neither side ever blocks or takes a lock: the producer only moves the write
+   position and the consumer only moves the read position. Anything more than
+   one producer or one consumer needs its own serialization. Capacity is
+   rounded up to a power of two. */
+struct SDL_RingBuffer;
+typedef struct SDL_RingBuffer SDL_RingBuffer;
+
+SDL_RingBuffer *SDL_NewRingBuffer(const size_t capacity);
+void SDL_FreeRingBuffer(SDL_RingBuffer *ring);
+
+/* Producer side. Returns the number of bytes written, which is less than
+   len if the ring fills up. */
+size_t SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *data, const size_t len);
+
+/* Consumer side. Returns the number of bytes read. */
+size_t SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *buf, const size_t len);
+
+/* Consumer side; throws away everything currently in the ring. */
+void SDL_ClearRingBuffer(SDL_RingBuffer *ring);
+
+/* Either side. This is only a snapshot if the other side is running. */
+size_t SDL_CountRingBuffer(SDL_RingBuffer *ring);
+
+/* Moves as much of the front of a data queue into a ring as will fit. This is
+   a read from the queue and a producer-side write to the ring. Returns the
+   number of bytes moved. */
+size_t SDL_MoveDataQueueToRingBuffer(SDL_DataQueue *queue, SDL_RingBuffer *ring);
+
 #endif /* SDL_dataqueue_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
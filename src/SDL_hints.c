@@ -22,10 +22,17 @@
 
 #include "SDL_hints.h"
 #include "SDL_error.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_hints_c.h"
 
 
-/* Assuming there aren't many hints set and they aren't being queried in
-   critical performance paths, we'll just use linked lists here.
+/* Hints are interned in a hash table by name and never move until they're
+   cleared, so internal code can hold on to one through an SDL_HintCache.
+   The last few values a hint has had are kept as well, so a string returned
+   by SDL_GetHint() stays valid for a while after another thread changes the
+   hint, instead of being freed right away. Everything is guarded by
+   SDL_hint_lock, which is never held while calling a hint callback.
  */
 typedef struct SDL_HintWatch {
     SDL_HintCallback callback;
@@ -33,23 +40,228 @@ typedef struct SDL_HintWatch {
     struct SDL_HintWatch *next;
 } SDL_HintWatch;
 
+typedef struct SDL_HintValue {
+    struct SDL_HintValue *next;
+    char value[SDL_VARIABLE_LENGTH_ARRAY];
+} SDL_HintValue;
+
 typedef struct SDL_Hint {
     char *name;
-    char *value;
+    const char *value;          /* one of values, or NULL */
+    SDL_HintValue *values;
     SDL_HintPriority priority;
+    SDL_atomic_t generation;    /* bumped whenever value or priority changes */
     SDL_HintWatch *callbacks;
     struct SDL_Hint *next;
 } SDL_Hint;
 
-static SDL_Hint *SDL_hints;
+#define SDL_HINT_BUCKETS    64
+
+/* The current value and the ones before it that are kept, per hint */
+#define SDL_HINT_VALUES_KEPT    8
+
+static SDL_Hint *SDL_hints[SDL_HINT_BUCKETS];
+static SDL_mutex *SDL_hint_lock;
+static SDL_SpinLock SDL_hint_lock_lock;
+
+/* Bumped when the hints are cleared or the environment changes, which
+   affects every hint at once */
+static SDL_atomic_t SDL_hint_epoch;
+
+static void
+SDL_LockHints(void)
+{
+    if (!SDL_hint_lock) {
+        SDL_AtomicLock(&SDL_hint_lock_lock);
+        if (!SDL_hint_lock) {
+            SDL_hint_lock = SDL_CreateMutex();
+        }
+        SDL_AtomicUnlock(&SDL_hint_lock_lock);
+    }
+    if (SDL_hint_lock) {
+        SDL_LockMutex(SDL_hint_lock);
+    }
+}
+
+static void
+SDL_UnlockHints(void)
+{
+    if (SDL_hint_lock) {
+        SDL_UnlockMutex(SDL_hint_lock);
+    }
+}
+
+static SDL_Hint **
+SDL_GetHintBucket(const char *name)
+{
+    Uint32 hash = 2166136261u;
+
+    while (*name) {
+        hash = (hash ^ (Uint8)*name++) * 16777619u;
+    }
+    return &SDL_hints[hash % SDL_HINT_BUCKETS];
+}
+
+/* Must be called with the hints locked */
+static SDL_Hint *
+SDL_FindHint(const char *name, SDL_bool create)
+{
+    SDL_Hint **bucket = SDL_GetHintBucket(name);
+    SDL_Hint *hint;
+
+    for (hint = *bucket; hint; hint = hint->next) {
+        if (SDL_strcmp(name, hint->name) == 0) {
+            return hint;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    hint = (SDL_Hint *)SDL_calloc(1, sizeof(*hint));
+    if (!hint) {
+        return NULL;
+    }
+    hint->name = SDL_strdup(name);
+    if (!hint->name) {
+        SDL_free(hint);
+        return NULL;
+    }
+    hint->priority = SDL_HINT_DEFAULT;
+    SDL_AtomicSet(&hint->generation, 1);
+    hint->next = *bucket;
+    *bucket = hint;
+    return hint;
+}
+
+/* Must be called with the hints locked. The values are kept most recently
+   used first, so the current one is never among those dropped. */
+static const char *
+SDL_InternHintValue(SDL_Hint *hint, const char *value)
+{
+    SDL_HintValue *entry, **prev;
+    size_t len;
+    int kept;
+
+    for (prev = &hint->values; *prev; prev = &(*prev)->next) {
+        entry = *prev;
+        if (SDL_strcmp(entry->value, value) == 0) {
+            *prev = entry->next;
+            entry->next = hint->values;
+            hint->values = entry;
+            return entry->value;
+        }
+    }
+
+    len = SDL_strlen(value) + 1;
+    entry = (SDL_HintValue *)SDL_malloc(sizeof(*entry) + len);
+    if (!entry) {
+        return NULL;
+    }
+    SDL_memcpy(entry->value, value, len);
+    entry->next = hint->values;
+    hint->values = entry;
+
+    /* Drop the oldest values, so a hint that keeps changing stays bounded */
+    for (kept = 1; entry->next && kept < SDL_HINT_VALUES_KEPT; ++kept) {
+        entry = entry->next;
+    }
+    while (entry->next) {
+        SDL_HintValue *freeable = entry->next;
+        entry->next = freeable->next;
+        SDL_free(freeable);
+    }
+    return hint->values->value;
+}
+
+/* Must be called with the hints locked. Copies the hint's watches into
+   watches, or into a new allocation if there are more than maxwatches. */
+static SDL_HintWatch *
+SDL_CopyHintWatches(const SDL_Hint *hint, SDL_HintWatch *watches, int maxwatches, int *count)
+{
+    const SDL_HintWatch *entry;
+    int i = 0;
+
+    for (entry = hint->callbacks; entry; entry = entry->next) {
+        ++i;
+    }
+    if (i > maxwatches) {
+        watches = (SDL_HintWatch *)SDL_malloc(i * sizeof(*watches));
+        if (!watches) {
+            SDL_OutOfMemory();
+            *count = 0;
+            return NULL;
+        }
+    }
+    *count = i;
+
+    i = 0;
+    for (entry = hint->callbacks; entry; entry = entry->next) {
+        watches[i++] = *entry;
+    }
+    return watches;
+}
+
+static SDL_bool
+SDL_IsHintWatched(const char *name, SDL_HintCallback callback, void *userdata)
+{
+    SDL_Hint *hint;
+    SDL_HintWatch *entry;
+    SDL_bool watched = SDL_FALSE;
+
+    SDL_LockHints();
+    hint = SDL_FindHint(name, SDL_FALSE);
+    if (hint) {
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                watched = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_UnlockHints();
+    return watched;
+}
+
+/* Called without the hints locked, so callbacks may do anything, including
+   waiting on another thread that uses hints. A watch deleted by an earlier
+   callback is skipped. */
+static void
+SDL_CallHintWatches(const char *name, const SDL_HintWatch *watches, int count,
+                    const char *oldValue, const char *newValue)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (SDL_IsHintWatched(name, watches[i].callback, watches[i].userdata)) {
+            watches[i].callback(watches[i].userdata, name, oldValue, newValue);
+        }
+    }
+}
+
+/* Must be called with the hints locked */
+static const char *
+SDL_GetHintValue(const char *name, SDL_Hint *hint)
+{
+    const char *env = SDL_getenv(name);
+
+    if (hint && (!env || hint->priority == SDL_HINT_OVERRIDE)) {
+        return hint->value;
+    }
+    return env;
+}
 
 SDL_bool
 SDL_SetHintWithPriority(const char *name, const char *value,
                         SDL_HintPriority priority)
 {
     const char *env;
+    const char *interned;
+    const char *old_value = NULL;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HintWatch local_watches[8];
+    SDL_HintWatch *watches = NULL;
+    int num_watches = 0;
 
     if (!name || !value) {
         return SDL_FALSE;
@@ -60,37 +272,40 @@ SDL_SetHintWithPriority(const char *name, const char *value,
         return SDL_FALSE;
     }
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
-            }
-            if (!hint->value || !value || SDL_strcmp(hint->value, value) != 0) {
-                for (entry = hint->callbacks; entry; ) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, value);
-                    entry = next;
-                }
-                SDL_free(hint->value);
-                hint->value = value ? SDL_strdup(value) : NULL;
-            }
-            hint->priority = priority;
-            return SDL_TRUE;
-        }
-    }
-
-    /* Couldn't find the hint, add a new one */
-    hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
+    SDL_LockHints();
+    hint = SDL_FindHint(name, SDL_TRUE);
     if (!hint) {
+        SDL_UnlockHints();
         return SDL_FALSE;
     }
-    hint->name = SDL_strdup(name);
-    hint->value = value ? SDL_strdup(value) : NULL;
-    hint->priority = priority;
-    hint->callbacks = NULL;
-    hint->next = SDL_hints;
-    SDL_hints = hint;
+    /* A hint created here or by a callback has the lowest priority */
+    if (priority < hint->priority) {
+        SDL_UnlockHints();
+        return SDL_FALSE;
+    }
+    interned = SDL_InternHintValue(hint, value);
+    if (!interned) {
+        SDL_UnlockHints();
+        return SDL_FALSE;
+    }
+    if (hint->value != interned) {
+        old_value = hint->value;
+        hint->value = interned;
+        SDL_AtomicAdd(&hint->generation, 1);
+        watches = SDL_CopyHintWatches(hint, local_watches, SDL_arraysize(local_watches), &num_watches);
+    }
+    if (hint->priority != priority) {
+        hint->priority = priority;
+        SDL_AtomicAdd(&hint->generation, 1);
+    }
+    SDL_UnlockHints();
+
+    if (watches) {
+        SDL_CallHintWatches(name, watches, num_watches, old_value, interned);
+        if (watches != local_watches) {
+            SDL_free(watches);
+        }
+    }
     return SDL_TRUE;
 }
 
@@ -103,25 +318,17 @@ SDL_SetHint(const char *name, const char *value)
 const char *
 SDL_GetHint(const char *name)
 {
-    const char *env;
-    SDL_Hint *hint;
+    const char *value;
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (!env || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
-    }
-    return env;
+    SDL_LockHints();
+    value = SDL_GetHintValue(name, SDL_FindHint(name, SDL_FALSE));
+    SDL_UnlockHints();
+    return value;
 }
 
-SDL_bool
-SDL_GetHintBoolean(const char *name, SDL_bool default_value)
+static SDL_bool
+SDL_HintValueBoolean(const char *hint, SDL_bool default_value)
 {
-    const char *hint = SDL_GetHint(name);
     if (!hint) {
         return default_value;
     }
@@ -131,6 +338,62 @@ SDL_GetHintBoolean(const char *name, SDL_bool default_value)
     return SDL_TRUE;
 }
 
+SDL_bool
+SDL_GetHintBoolean(const char *name, SDL_bool default_value)
+{
+    return SDL_HintValueBoolean(SDL_GetHint(name), default_value);
+}
+
+const char *
+SDL_GetCachedHint(SDL_HintCache *cache)
+{
+    SDL_Hint *hint;
+    const char *value;
+    int epoch, generation;
+
+    /* Plain reads are enough here: a stale epoch or generation only sends
+       us down the slow path, and every value we could return is still
+       allocated. */
+    hint = cache->hint;
+    if (hint && cache->epoch == SDL_hint_epoch.value &&
+        cache->generation == hint->generation.value) {
+        SDL_MemoryBarrierAcquire();
+        return cache->value;
+    }
+
+    SDL_LockHints();
+    epoch = SDL_hint_epoch.value;
+    hint = SDL_FindHint(cache->name, SDL_TRUE);
+    if (!hint) {
+        /* Out of memory, so don't cache anything */
+        value = SDL_getenv(cache->name);
+        SDL_UnlockHints();
+        return value;
+    }
+    generation = hint->generation.value;
+    value = SDL_GetHintValue(cache->name, hint);
+
+    cache->value = value;
+    SDL_MemoryBarrierRelease();
+    cache->hint = hint;
+    cache->epoch = epoch;
+    cache->generation = generation;
+    SDL_UnlockHints();
+    return value;
+}
+
+SDL_bool
+SDL_GetCachedHintBoolean(SDL_HintCache *cache, SDL_bool default_value)
+{
+    return SDL_HintValueBoolean(SDL_GetCachedHint(cache), default_value);
+}
+
+void
+SDL_HintsEnvironmentChanged(void)
+{
+    SDL_AtomicAdd(&SDL_hint_epoch, 1);
+}
+
 void
 SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 {
@@ -147,35 +410,25 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
         return;
     }
 
+    SDL_LockHints();
     SDL_DelHintCallback(name, callback, userdata);
 
     entry = (SDL_HintWatch *)SDL_malloc(sizeof(*entry));
     if (!entry) {
+        SDL_UnlockHints();
         SDL_OutOfMemory();
         return;
     }
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
-    }
+    /* Need a hint entry for this watcher */
+    hint = SDL_FindHint(name, SDL_TRUE);
     if (!hint) {
-        /* Need to add a hint entry for this watcher */
-        hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-        if (!hint) {
-            SDL_OutOfMemory();
-            SDL_free(entry);
-            return;
-        }
-        hint->name = SDL_strdup(name);
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
-        hint->callbacks = NULL;
-        hint->next = SDL_hints;
-        SDL_hints = hint;
+        SDL_UnlockHints();
+        SDL_OutOfMemory();
+        SDL_free(entry);
+        return;
     }
 
     /* Add it to the callbacks for this hint */
@@ -183,7 +436,8 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
     hint->callbacks = entry;
 
     /* Now call it with the current value */
-    value = SDL_GetHint(name);
+    value = SDL_GetHintValue(name, hint);
+    SDL_UnlockHints();
     callback(userdata, name, value, value);
 }
 
@@ -193,44 +447,55 @@ SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
     SDL_Hint *hint;
     SDL_HintWatch *entry, *prev;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
+    SDL_LockHints();
+    hint = SDL_FindHint(name, SDL_FALSE);
+    if (hint) {
+        prev = NULL;
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                if (prev) {
+                    prev->next = entry->next;
+                } else {
+                    hint->callbacks = entry->next;
                 }
-                prev = entry;
+                SDL_free(entry);
+                break;
             }
-            return;
+            prev = entry;
         }
     }
+    SDL_UnlockHints();
 }
 
 void SDL_ClearHints(void)
 {
     SDL_Hint *hint;
+    SDL_HintValue *value;
     SDL_HintWatch *entry;
+    int i;
 
-    while (SDL_hints) {
-        hint = SDL_hints;
-        SDL_hints = hint->next;
+    SDL_LockHints();
+    SDL_AtomicAdd(&SDL_hint_epoch, 1);
+    for (i = 0; i < SDL_HINT_BUCKETS; ++i) {
+        while (SDL_hints[i]) {
+            hint = SDL_hints[i];
+            SDL_hints[i] = hint->next;
 
-        SDL_free(hint->name);
-        SDL_free(hint->value);
-        for (entry = hint->callbacks; entry; ) {
-            SDL_HintWatch *freeable = entry;
-            entry = entry->next;
-            SDL_free(freeable);
+            SDL_free(hint->name);
+            for (value = hint->values; value; ) {
+                SDL_HintValue *freeable = value;
+                value = value->next;
+                SDL_free(freeable);
+            }
+            for (entry = hint->callbacks; entry; ) {
+                SDL_HintWatch *freeable = entry;
+                entry = entry->next;
+                SDL_free(freeable);
+            }
+            SDL_free(hint);
         }
-        SDL_free(hint);
     }
+    SDL_UnlockHints();
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
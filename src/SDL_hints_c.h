@@ -0,0 +1,59 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "./SDL_internal.h"
+
+/* Internal hint functions for code that looks hints up at runtime */
+
+#ifndef SDL_hints_c_h_
+#define SDL_hints_c_h_
+
+#include "SDL_hints.h"
+
+/* A hint that is read often enough to be worth caching. Declare it static
+   with only the name filled in:
+
+       static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+
+   The value is looked up again only after the hint is set, the hints are
+   cleared, or the environment is changed with SDL_setenv(). Changes made
+   with the C library's setenv() aren't noticed.
+ */
+typedef struct SDL_HintCache
+{
+    const char *name;
+    struct SDL_Hint *hint;  /* the interned hint, once it has been looked up */
+    int epoch;              /* SDL_hint_epoch when value was read */
+    int generation;         /* hint->generation when value was read */
+    const char *value;
+} SDL_HintCache;
+
+/* Like SDL_GetHint(), but returns the cached value while it's current */
+extern const char *SDL_GetCachedHint(SDL_HintCache *cache);
+
+/* Like SDL_GetHintBoolean(), but returns the cached value while it's current */
+extern SDL_bool SDL_GetCachedHintBoolean(SDL_HintCache *cache, SDL_bool default_value);
+
+/* Called by SDL_setenv(), since any hint may come from the environment */
+extern void SDL_HintsEnvironmentChanged(void);
+
+#endif /* SDL_hints_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
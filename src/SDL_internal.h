@@ -35,6 +35,19 @@
 #define SDL_VARIABLE_LENGTH_ARRAY
 #endif
 
+/* Code for CPU features that SDL isn't compiled for by default is marked
+   with SDL_TARGETING_AVX2, so it can be built and then picked at runtime
+   after checking SDL_HasAVX2(). HAVE_AVX2_INTRINSICS says whether it's
+   available at all. */
+#if defined(__AVX2__)
+#define HAVE_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2
+#elif (defined(__i386__) || defined(__x86_64__)) && \
+      (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define HAVE_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2 __attribute__((target("avx2")))
+#endif
+
 #include "dynapi/SDL_dynapi.h"
 
 #if SDL_DYNAMIC_API
@@ -27,6 +27,7 @@
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
 #include "../thread/SDL_systhread.h"
+#include "../timer/SDL_timer_c.h"
 
 #define _THIS SDL_AudioDevice *_this
 
@@ -509,6 +510,79 @@ SDL_RemoveAudioDevice(const int iscapture, void *handle)
 
 /* buffer queueing support... */
 
+/* The side of the queue that runs on the app's threads (the producer for
+   playback, the consumer for capture) always holds buffer_queue_lock, so
+   several app threads can share a device. The audio thread takes nothing
+   while the ring has what it needs, and only try-locks the overflow queue
+   otherwise, so a busy app thread can never stall it. */
+
+static void
+update_buffer_queue_bytes(SDL_AudioDevice *device)
+{
+    SDL_AtomicSet(&device->buffer_queue_bytes, (int) SDL_CountDataQueue(device->buffer_queue));
+}
+
+static size_t
+read_queued_audio(SDL_AudioDevice *device, Uint8 *data, size_t len, const SDL_bool audio_thread)
+{
+    size_t retval = SDL_ReadFromRingBuffer(device->buffer_ring, data, len);
+
+    if ((retval < len) && SDL_AtomicGet(&device->buffer_queue_bytes)) {
+        if (audio_thread && (SDL_TryLockMutex(device->buffer_queue_lock) != 0)) {
+            return retval;  /* the app is busy with the queue; try again next time. */
+        }
+        /* the producer may have moved data into the ring since we looked. */
+        retval += SDL_ReadFromRingBuffer(device->buffer_ring, data + retval, len - retval);
+        retval += SDL_ReadFromDataQueue(device->buffer_queue, data + retval, len - retval);
+        update_buffer_queue_bytes(device);
+        if (audio_thread) {
+            SDL_UnlockMutex(device->buffer_queue_lock);
+        }
+    }
+    return retval;
+}
+
+static int
+write_queued_audio(SDL_AudioDevice *device, const Uint8 *data, size_t len, const SDL_bool audio_thread)
+{
+    int rc = 0;
+
+    /* Nothing else adds to the overflow queue, so if it's empty now it stays
+       empty, and it's safe to go straight to the ring without reordering. */
+    if (SDL_AtomicGet(&device->buffer_queue_bytes) == 0) {
+        const size_t written = SDL_WriteToRingBuffer(device->buffer_ring, data, len);
+        data += written;
+        len -= written;
+        if (len == 0) {
+            return 0;
+        }
+    }
+
+    if (audio_thread && (SDL_TryLockMutex(device->buffer_queue_lock) != 0)) {
+        return 0;  /* we have no choice but to quietly drop the data. */
+    }
+    SDL_MoveDataQueueToRingBuffer(device->buffer_queue, device->buffer_ring);
+    if (SDL_CountDataQueue(device->buffer_queue) == 0) {
+        const size_t written = SDL_WriteToRingBuffer(device->buffer_ring, data, len);
+        data += written;
+        len -= written;
+    }
+    if (len > 0) {
+        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
+    }
+    update_buffer_queue_bytes(device);
+    if (audio_thread) {
+        SDL_UnlockMutex(device->buffer_queue_lock);
+    }
+    return rc;
+}
+
+static Uint32
+count_queued_audio(SDL_AudioDevice *device)
+{
+    return (Uint32) (SDL_CountRingBuffer(device->buffer_ring) + SDL_AtomicGet(&device->buffer_queue_bytes));
+}
+
 static void SDLCALL
 SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
@@ -520,12 +594,11 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    dequeued = read_queued_audio(device, stream, len, SDL_TRUE);
     stream += dequeued;
     len -= (int) dequeued;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
         SDL_memset(stream, device->spec.silence, len);
     }
 }
@@ -541,9 +614,10 @@ SDL_BufferQueueFillCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
     /* note that if this needs to allocate more space and run out of memory,
-       we have no choice but to quietly drop the data and hope it works out
-       later, but you probably have bigger problems in this case anyhow. */
-    SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+       or the app is holding the overflow queue, we have no choice but to
+       quietly drop the data and hope it works out later, but you probably
+       have bigger problems in this case anyhow. */
+    write_queued_audio(device, stream, len, SDL_TRUE);
 }
 
 int
@@ -561,9 +635,9 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
-        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+        SDL_LockMutex(device->buffer_queue_lock);
+        rc = write_queued_audio(device, (const Uint8 *) data, len, SDL_FALSE);
+        SDL_UnlockMutex(device->buffer_queue_lock);
     }
 
     return rc;
@@ -582,9 +656,9 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;  /* just report zero bytes dequeued. */
     }
 
-    current_audio.impl.LockDevice(device);
-    rc = (Uint32) SDL_ReadFromDataQueue(device->buffer_queue, data, len);
-    current_audio.impl.UnlockDevice(device);
+    SDL_LockMutex(device->buffer_queue_lock);
+    rc = (Uint32) read_queued_audio(device, (Uint8 *) data, len, SDL_FALSE);
+    SDL_UnlockMutex(device->buffer_queue_lock);
     return rc;
 }
 
@@ -600,13 +674,14 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
 
     /* Nothing to do unless we're set up for queueing. */
     if (device->spec.callback == SDL_BufferQueueDrainCallback) {
-        current_audio.impl.LockDevice(device);
-        retval = ((Uint32) SDL_CountDataQueue(device->buffer_queue)) + current_audio.impl.GetPendingBytes(device);
-        current_audio.impl.UnlockDevice(device);
+        retval = count_queued_audio(device);
+        if (current_audio.impl.GetPendingBytes != SDL_AudioGetPendingBytes_Default) {
+            current_audio.impl.LockDevice(device);
+            retval += current_audio.impl.GetPendingBytes(device);
+            current_audio.impl.UnlockDevice(device);
+        }
     } else if (device->spec.callback == SDL_BufferQueueFillCallback) {
-        current_audio.impl.LockDevice(device);
-        retval = (Uint32) SDL_CountDataQueue(device->buffer_queue);
-        current_audio.impl.UnlockDevice(device);
+        retval = count_queued_audio(device);
     }
 
     return retval;
@@ -617,20 +692,297 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 {
     SDL_AudioDevice *device = get_audio_device(devid);
 
-    if (!device) {
+    if (!device || !device->buffer_queue_lock) {
         return;  /* nothing to do. */
     }
 
-    /* Blank out the device and release the mutex. Free it afterwards. */
+    /* Blank out the device and release the mutex. Free it afterwards.
+       Holding the device lock keeps the audio thread out of the ring. */
     current_audio.impl.LockDevice(device);
+    SDL_LockMutex(device->buffer_queue_lock);
+
+    SDL_ClearRingBuffer(device->buffer_ring);
 
     /* Keep up to two packets in the pool to reduce future malloc pressure. */
     SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+    update_buffer_queue_bytes(device);
 
+    SDL_UnlockMutex(device->buffer_queue_lock);
     current_audio.impl.UnlockDevice(device);
 }
 
 
+static Uint32
+audio_ticks_to_us(Uint64 ticks)
+{
+    const Uint64 us = SDL_TicksToMicroseconds(ticks);
+    return (Uint32) SDL_min(us, 0xFFFFFFFF);
+}
+
+static int
+audio_stats_bucket(Uint32 us)
+{
+    int bucket = 0;
+    while ((bucket < (SDL_AUDIO_STATS_BUCKETS - 1)) && (((Uint32) 1 << bucket) < us)) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+/* Record a callback run, with start and end from SDL_GetPerformanceCounter() */
+static void
+record_audio_callback(SDL_AudioDevice *device, const Uint64 start, const Uint64 end)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint32 duration = audio_ticks_to_us(end - start);
+
+    SDL_AtomicLock(&device->stats_lock);
+    ++stats->callbacks;
+    stats->callback_total_us += duration;
+    stats->callback_max_us = SDL_max(stats->callback_max_us, duration);
+    ++stats->callback_histogram[audio_stats_bucket(duration)];
+
+    if (device->last_callback) {
+        const Uint32 interval = audio_ticks_to_us(start - device->last_callback);
+        const Uint32 jitter = (interval > stats->period_us) ?
+                                  (interval - stats->period_us) : (stats->period_us - interval);
+        if (interval > (2 * stats->period_us)) {
+            ++stats->late_wakeups;
+        }
+        stats->jitter_max_us = SDL_max(stats->jitter_max_us, jitter);
+        ++stats->jitter_histogram[audio_stats_bucket(jitter)];
+    }
+    device->last_callback = start;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+static void
+record_audio_silence(SDL_AudioDevice *device, Uint32 *counter)
+{
+    SDL_AtomicLock(&device->stats_lock);
+    ++*counter;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+int
+SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats * stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_AtomicLock(&device->stats_lock);
+    *stats = device->stats;
+    SDL_AtomicUnlock(&device->stats_lock);
+
+    stats->queued_bytes = 0;
+    stats->device_latency_ms = -1;
+
+    if (device->spec.callback == SDL_BufferQueueDrainCallback ||
+        device->spec.callback == SDL_BufferQueueFillCallback) {
+        stats->queued_bytes = count_queued_audio(device);
+    }
+
+    current_audio.impl.LockDevice(device);
+    if (!device->iscapture && current_audio.impl.GetPendingBytes != SDL_AudioGetPendingBytes_Default) {
+        const int frame_size = (SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels;
+        const int pending = current_audio.impl.GetPendingBytes(device);
+        stats->device_latency_ms = (int) ((((Sint64) pending / frame_size) * 1000) / device->spec.freq);
+    }
+    current_audio.impl.UnlockDevice(device);
+
+    return 0;
+}
+
+void
+SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (device) {
+        SDL_AtomicLock(&device->stats_lock);
+        {
+            const Uint32 period_us = device->stats.period_us;
+            SDL_zero(device->stats);
+            device->stats.period_us = period_us;
+        }
+        device->last_callback = 0;
+        SDL_AtomicUnlock(&device->stats_lock);
+    }
+}
+
+
+static int
+audio_frame_size(const SDL_AudioSpec *spec)
+{
+    return (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+}
+
+static Uint64
+audio_frames_to_ticks(Uint64 frames, int freq)
+{
+    return (frames * SDL_GetPerformanceFrequency()) / freq;
+}
+
+/* Stamp the buffer the playback callback is about to fill. It will be heard
+   once the converter and the device have played everything they hold. */
+static void
+stamp_playback_buffer(SDL_AudioDevice *device)
+{
+    const int frame_size = audio_frame_size(&device->spec);
+    Uint64 pending = 0;
+    Uint64 now;
+
+    if (device->stream) {
+        pending += SDL_AudioStreamAvailable(device->stream) / frame_size;
+    }
+    if (current_audio.impl.GetPendingBytes != SDL_AudioGetPendingBytes_Default) {
+        const int bytes = current_audio.impl.GetPendingBytes(device);
+        if (bytes > 0) {
+            pending += bytes / frame_size;
+        }
+    }
+    now = SDL_GetPerformanceCounter();
+
+    SDL_AtomicLock(&device->stats_lock);
+    device->timestamp.frame = device->callback_frames;
+    device->timestamp.time = now + audio_frames_to_ticks(pending, device->spec.freq);
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+/* Stamp the buffer about to go to the capture callback. Its first frame was
+   read from the device some number of frames before the latest one arrived,
+   which is however much the converter is still holding. */
+static void
+stamp_capture_buffer(SDL_AudioDevice *device)
+{
+    const Uint64 first = (device->callback_frames * device->spec.freq) / device->callbackspec.freq;
+    const Uint64 behind = (device->device_frames > first) ? (device->device_frames - first) : 0;
+    const Uint64 time = device->device_frames_time - audio_frames_to_ticks(behind, device->spec.freq);
+
+    SDL_AtomicLock(&device->stats_lock);
+    device->timestamp.frame = device->callback_frames;
+    device->timestamp.time = time;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+int
+SDL_GetAudioDeviceTimestamp(SDL_AudioDeviceID devid, SDL_AudioTimestamp * timestamp)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;
+    }
+    if (!timestamp) {
+        return SDL_InvalidParamError("timestamp");
+    }
+
+    SDL_AtomicLock(&device->stats_lock);
+    *timestamp = device->timestamp;
+    SDL_AtomicUnlock(&device->stats_lock);
+    return 0;
+}
+
+/* Counts the queued frames along with the timestamp of the last buffer given
+   to the callback. The audio thread changes both while timestamp_seq is odd,
+   so try again until the two are read between buffers. */
+static Uint64
+count_queued_frames_at(SDL_AudioDevice *device, SDL_AudioTimestamp *last)
+{
+    const int frame_size = audio_frame_size(&device->callbackspec);
+    Uint64 queued;
+    int seq;
+
+    for (;;) {
+        seq = SDL_AtomicGet(&device->timestamp_seq);
+        if (seq & 1) {
+            SDL_Delay(0);  /* the callback is running; let it finish. */
+            continue;
+        }
+        queued = count_queued_audio(device) / frame_size;
+        SDL_AtomicLock(&device->stats_lock);
+        *last = device->timestamp;
+        SDL_AtomicUnlock(&device->stats_lock);
+        if (SDL_AtomicGet(&device->timestamp_seq) == seq) {
+            return queued;
+        }
+    }
+}
+
+int
+SDL_QueueAudioTimestamped(SDL_AudioDeviceID devid, const void *data, Uint32 len,
+                          SDL_AudioTimestamp * timestamp)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    SDL_AudioTimestamp last;
+    Uint64 ahead;
+    int rc;
+
+    if (!device) {
+        return -1;
+    } else if (!timestamp) {
+        return SDL_QueueAudio(devid, data, len);
+    }
+
+    /* Our data goes after whatever is queued now. The callback may drain
+       some of that before it's added, but that doesn't move where it lands. */
+    ahead = count_queued_frames_at(device, &last);
+    rc = SDL_QueueAudio(devid, data, len);
+
+    if (rc == 0) {
+        const Uint64 now = SDL_GetPerformanceCounter();
+        if (last.time != 0) {
+            /* the last buffer has already left the queue, so ours follows it */
+            ahead += device->callbackspec.samples;
+        }
+        timestamp->frame = last.frame + ahead;
+        timestamp->time = last.time + audio_frames_to_ticks(ahead, device->callbackspec.freq);
+        if (timestamp->time < now) {  /* paused, or the queue ran dry */
+            timestamp->time = now + audio_frames_to_ticks(ahead, device->callbackspec.freq);
+        }
+    }
+    return rc;
+}
+
+Uint32
+SDL_DequeueAudioTimestamped(SDL_AudioDeviceID devid, void *data, Uint32 len,
+                            SDL_AudioTimestamp * timestamp)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    SDL_AudioTimestamp last;
+    Uint64 queued, end;
+    Uint32 rc;
+
+    if (!device || !timestamp) {
+        return SDL_DequeueAudio(devid, data, len);
+    }
+
+    /* What we dequeue is the oldest of what is queued now, however much
+       the callback adds before we get to it. */
+    queued = count_queued_frames_at(device, &last);
+    rc = SDL_DequeueAudio(devid, data, len);
+
+    if (rc > 0) {
+        /* The queue ends with the last buffer given to the callback. */
+        end = last.frame + device->callbackspec.samples;
+        queued = SDL_min(queued, end);
+        timestamp->frame = end - queued;
+        if (timestamp->frame >= last.frame) {
+            timestamp->time = last.time + audio_frames_to_ticks(timestamp->frame - last.frame, device->callbackspec.freq);
+        } else {
+            timestamp->time = last.time - audio_frames_to_ticks(last.frame - timestamp->frame, device->callbackspec.freq);
+        }
+    }
+    return rc;
+}
+
+
 /* The general mixing thread function */
 static int SDLCALL
 SDL_RunAudio(void *devicep)
@@ -676,8 +1028,17 @@ SDL_RunAudio(void *devicep)
         SDL_LockMutex(device->mixer_lock);
         if (SDL_AtomicGet(&device->paused)) {
             SDL_memset(data, silence, data_len);
+            record_audio_silence(device, &device->stats.paused_silence);
+            device->last_callback = 0;  /* don't count the pause as jitter */
         } else {
+            Uint64 start;
+            SDL_AtomicIncRef(&device->timestamp_seq);
+            stamp_playback_buffer(device);
+            start = SDL_GetPerformanceCounter();
             callback(udata, data, data_len);
+            record_audio_callback(device, start, SDL_GetPerformanceCounter());
+            device->callback_frames += device->callbackspec.samples;
+            SDL_AtomicIncRef(&device->timestamp_seq);
         }
         SDL_UnlockMutex(device->mixer_lock);
 
@@ -697,6 +1058,7 @@ SDL_RunAudio(void *devicep)
                 } else {
                     if (got != device->spec.size) {
                         SDL_memset(data, device->spec.silence, device->spec.size);
+                        record_audio_silence(device, &device->stats.underrun_silence);
                     }
                     current_audio.impl.PlayDevice(device);
                     current_audio.impl.WaitDevice(device);
@@ -754,6 +1116,8 @@ SDL_CaptureAudio(void *devicep)
                 SDL_AudioStreamClear(device->stream);
             }
             current_audio.impl.FlushCapture(device);  /* dump anything pending. */
+            /* the converter is empty again, so line the device count back up */
+            device->device_frames = (device->callback_frames * device->spec.freq) / device->callbackspec.freq;
             continue;
         }
 
@@ -791,6 +1155,9 @@ SDL_CaptureAudio(void *devicep)
             SDL_memset(ptr, silence, still_need);
         }
 
+        device->device_frames += device->spec.samples;
+        device->device_frames_time = SDL_GetPerformanceCounter();
+
         if (device->stream) {
             /* if this fails...oh well. */
             SDL_AudioStreamPut(device->stream, data, data_len);
@@ -805,17 +1172,31 @@ SDL_CaptureAudio(void *devicep)
                 /* !!! FIXME: this should be LockDevice. */
                 SDL_LockMutex(device->mixer_lock);
                 if (!SDL_AtomicGet(&device->paused)) {
+                    Uint64 start;
+                    SDL_AtomicIncRef(&device->timestamp_seq);
+                    stamp_capture_buffer(device);
+                    start = SDL_GetPerformanceCounter();
                     callback(udata, device->work_buffer, device->callbackspec.size);
+                    record_audio_callback(device, start, SDL_GetPerformanceCounter());
+                    SDL_AtomicIncRef(&device->timestamp_seq);
                 }
                 SDL_UnlockMutex(device->mixer_lock);
+                device->callback_frames += device->callbackspec.samples;
             }
         } else {  /* feeding user callback directly without streaming. */
             /* !!! FIXME: this should be LockDevice. */
             SDL_LockMutex(device->mixer_lock);
             if (!SDL_AtomicGet(&device->paused)) {
+                Uint64 start;
+                SDL_AtomicIncRef(&device->timestamp_seq);
+                stamp_capture_buffer(device);
+                start = SDL_GetPerformanceCounter();
                 callback(udata, data, device->callbackspec.size);
+                record_audio_callback(device, start, SDL_GetPerformanceCounter());
+                SDL_AtomicIncRef(&device->timestamp_seq);
             }
             SDL_UnlockMutex(device->mixer_lock);
+            device->callback_frames += device->callbackspec.samples;
         }
     }
 
@@ -869,6 +1250,7 @@ SDL_GetAudioDriver(int index)
 }
 
 extern void SDL_ChooseAudioConverters(void);
+extern void SDL_ChooseAudioMixers(void);
 
 int
 SDL_AudioInit(const char *driver_name)
@@ -885,6 +1267,7 @@ SDL_AudioInit(const char *driver_name)
     SDL_zero(open_devices);
 
     SDL_ChooseAudioConverters();
+    SDL_ChooseAudioMixers();
 
     /* Select the proper audio driver */
     if (driver_name == NULL) {
@@ -1069,7 +1452,11 @@ close_audio_device(SDL_AudioDevice * device)
         current_audio.impl.CloseDevice(device);
     }
 
+    SDL_FreeRingBuffer(device->buffer_ring);
     SDL_FreeDataQueue(device->buffer_queue);
+    if (device->buffer_queue_lock != NULL) {
+        SDL_DestroyMutex(device->buffer_queue_lock);
+    }
 
     SDL_free(device);
 }
@@ -1150,7 +1537,9 @@ open_audio_device(const char *devname, int iscapture,
     void *handle = NULL;
     int i = 0;
 
-    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+    /* SDL_AudioQuit() may have been called directly, leaving the subsystem
+       flagged as initialized with no driver behind it. */
+    if (!SDL_WasInit(SDL_INIT_AUDIO) || !current_audio.name) {
         SDL_SetError("Audio subsystem is not initialized");
         return 0;
     }
@@ -1317,6 +1706,7 @@ open_audio_device(const char *devname, int iscapture,
     SDL_CalculateAudioSpec(obtained);  /* recalc after possible changes. */
 
     device->callbackspec = *obtained;
+    device->stats.period_us = (Uint32) (((Uint64) obtained->samples * 1000000) / obtained->freq);
 
     if (build_stream) {
         if (iscapture) {
@@ -1336,9 +1726,11 @@ open_audio_device(const char *devname, int iscapture,
     }
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
-        /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
-        if (!device->buffer_queue) {
+        device->buffer_ring = SDL_NewRingBuffer(SDL_max(SDL_AUDIOBUFFERQUEUE_RINGLEN, obtained->size * 4));
+        /* the ring takes the usual case, so the overflow starts empty. */
+        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, 0);
+        device->buffer_queue_lock = SDL_CreateMutex();
+        if (!device->buffer_ring || !device->buffer_queue || !device->buffer_queue_lock) {
             close_audio_device(device);
             SDL_SetError("Couldn't create audio buffer queue");
             return 0;
@@ -85,6 +85,660 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+/* The AVX2 kernels are built for AVX2 with SDL_TARGETING_AVX2, and only
+   used when SDL_HasAVX2() finds it at runtime. */
+#if HAVE_AVX2_INTRINSICS
+#include <immintrin.h>
+#endif
+
+/* A SIMD kernel mixes as many whole vectors as fit in len and returns the
+   number of bytes it consumed. The scalar code in SDL_MixAudioFormat()
+   finishes off whatever is left. Every kernel gives the same results as the
+   scalar code, including the round-toward-zero volume scaling. */
+typedef Uint32 (*SDL_MixFunc)(Uint8 *dst, const Uint8 *src, Uint32 len, int volume);
+
+/* Function pointers set to a CPU-specific implementation, or NULL. */
+static SDL_MixFunc SDL_Mix_U8 = NULL;
+static SDL_MixFunc SDL_Mix_S8 = NULL;
+static SDL_MixFunc SDL_Mix_S16LSB = NULL;
+static SDL_MixFunc SDL_Mix_S16MSB = NULL;
+static SDL_MixFunc SDL_Mix_S32LSB = NULL;
+static SDL_MixFunc SDL_Mix_S32MSB = NULL;
+static SDL_MixFunc SDL_Mix_F32LSB = NULL;
+static SDL_MixFunc SDL_Mix_F32MSB = NULL;
+
+/* SDL_MixAudioFormatMulti() kernels add scaled samples to a block of wide
+   accumulators, or clip a block of accumulators back to samples. They return
+   the number of samples they did, the scalar code does the rest. Only the
+   little endian formats have them, which are native wherever SSE2 is. */
+typedef Uint32 (*SDL_MixAccumulateS16Func)(Sint32 *acc, const Uint8 *src, Uint32 num, int volume);
+typedef Uint32 (*SDL_MixStoreS16Func)(Uint8 *dst, const Sint32 *acc, Uint32 num);
+typedef Uint32 (*SDL_MixAccumulateF32Func)(double *acc, const Uint8 *src, Uint32 num, int volume);
+typedef Uint32 (*SDL_MixStoreF32Func)(Uint8 *dst, const double *acc, Uint32 num);
+
+static SDL_MixAccumulateS16Func SDL_MixAccumulate_S16LSB = NULL;
+static SDL_MixStoreS16Func SDL_MixStore_S16LSB = NULL;
+static SDL_MixAccumulateF32Func SDL_MixAccumulate_F32LSB = NULL;
+static SDL_MixStoreF32Func SDL_MixStore_F32LSB = NULL;
+
+#define MIX_SWAP_LSB (SDL_BYTEORDER != SDL_LIL_ENDIAN)
+#define MIX_SWAP_MSB (SDL_BYTEORDER != SDL_BIG_ENDIAN)
+
+#if HAVE_SSE2_INTRINSICS
+/* (s * volume) / SDL_MIX_MAXVOLUME for sixteen Sint8, rounding toward zero. */
+static SDL_INLINE __m128i
+MixAdjustVolume_S8_SSE2(const __m128i s, const __m128i vol)
+{
+    /* sign-extend to Sint16; the products fit since volume <= 128. */
+    __m128i lo = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(s, s), 8), vol);
+    __m128i hi = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(s, s), 8), vol);
+    /* add 127 to negative products so the shift truncates instead of flooring. */
+    lo = _mm_srai_epi16(_mm_add_epi16(lo, _mm_srli_epi16(_mm_srai_epi16(lo, 15), 9)), 7);
+    hi = _mm_srai_epi16(_mm_add_epi16(hi, _mm_srli_epi16(_mm_srai_epi16(hi, 15), 9)), 7);
+    return _mm_packs_epi16(lo, hi);
+}
+
+/* (s * volume) / SDL_MIX_MAXVOLUME for eight Sint16, rounding toward zero. */
+static SDL_INLINE __m128i
+MixAdjustVolume_S16_SSE2(const __m128i s, const __m128i vol)
+{
+    const __m128i plo = _mm_mullo_epi16(s, vol);
+    const __m128i phi = _mm_mulhi_epi16(s, vol);
+    __m128i lo = _mm_unpacklo_epi16(plo, phi);
+    __m128i hi = _mm_unpackhi_epi16(plo, phi);
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_srli_epi32(_mm_srai_epi32(lo, 31), 25)), 7);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_srli_epi32(_mm_srai_epi32(hi, 31), 25)), 7);
+    return _mm_packs_epi32(lo, hi);
+}
+
+/* SSE2 has no 32-bit multiply; build one from the two 32x32->64 ones. */
+static SDL_INLINE __m128i
+MixMullo_epi32_SSE2(const __m128i a, const __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* (s * volume) / SDL_MIX_MAXVOLUME for four Sint32 without a 64-bit product:
+   split s into (s >> 7) * 128 + (s & 127) and scale the two parts separately. */
+static SDL_INLINE __m128i
+MixAdjustVolume_S32_SSE2(const __m128i s, const __m128i vol)
+{
+    const __m128i low7 = _mm_set1_epi32(127);
+    const __m128i rv = _mm_mullo_epi16(_mm_and_si128(s, low7), vol);
+    const __m128i floored = _mm_add_epi32(MixMullo_epi32_SSE2(_mm_srai_epi32(s, 7), vol), _mm_srli_epi32(rv, 7));
+    /* negative inexact results are one below the truncated value. */
+    const __m128i inexact = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(rv, low7), _mm_setzero_si128()), _mm_srai_epi32(s, 31));
+    return _mm_sub_epi32(floored, inexact);
+}
+
+static SDL_INLINE __m128i
+MixAdds_epi32_SSE2(const __m128i a, const __m128i b)
+{
+    const __m128i sum = _mm_add_epi32(a, b);
+    const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+    const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFFFFFF));
+    return _mm_or_si128(_mm_andnot_si128(overflow, sum), _mm_and_si128(overflow, limit));
+}
+
+static SDL_INLINE __m128i
+MixSwap16_SSE2(const __m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+static SDL_INLINE __m128i
+MixSwap32_SSE2(const __m128i x)
+{
+    const __m128i words = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    return MixSwap16_SSE2(words);
+}
+
+static Uint32
+SDL_Mix_S8_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S8_SSE2(s, vol);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_adds_epi8(d, s));
+    }
+    return i;
+}
+
+/* U8 is S8 with a bias, except that mix8[] pins the top at 0xFE. */
+static Uint32
+SDL_Mix_U8_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    const __m128i bias = _mm_set1_epi8((char) 0x80);
+    const __m128i limit = _mm_set1_epi8((char) 0xFE);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (src + i)), bias);
+        const __m128i d = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (dst + i)), bias);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S8_SSE2(s, vol);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_min_epu8(_mm_xor_si128(_mm_adds_epi8(d, s), bias), limit));
+    }
+    return i;
+}
+
+static SDL_INLINE Uint32
+Mix_S16_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = MixSwap16_SSE2(s);
+            d = MixSwap16_SSE2(d);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S16_SSE2(s, vol);
+        }
+        d = _mm_adds_epi16(d, s);
+        if (swap) {
+            d = MixSwap16_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_Mix_S16LSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S16_SSE2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static Uint32
+SDL_Mix_S16MSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S16_SSE2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+
+static SDL_INLINE Uint32
+Mix_S32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = MixSwap32_SSE2(s);
+            d = MixSwap32_SSE2(d);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S32_SSE2(s, vol);
+        }
+        d = MixAdds_epi32_SSE2(d, s);
+        if (swap) {
+            d = MixSwap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_Mix_S32LSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S32_SSE2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static Uint32
+SDL_Mix_S32MSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S32_SSE2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+
+/* The scalar code adds in double and clamps to +/-FLT_MAX; a float add
+   followed by the same clamp rounds to the same value. The operand order
+   of min/max keeps NaNs as they are, like the scalar comparisons do. */
+static SDL_INLINE Uint32
+Mix_F32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 max_audioval = _mm_set1_ps(3.402823466e+38F);
+    const __m128 min_audioval = _mm_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128 sum;
+        if (swap) {
+            s = MixSwap32_SSE2(s);
+            d = MixSwap32_SSE2(d);
+        }
+        sum = _mm_mul_ps(_mm_mul_ps(_mm_castsi128_ps(s), fvolume), fmaxvolume);
+        sum = _mm_add_ps(sum, _mm_castsi128_ps(d));
+        sum = _mm_max_ps(min_audioval, _mm_min_ps(max_audioval, sum));
+        d = _mm_castps_si128(sum);
+        if (swap) {
+            d = MixSwap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_Mix_F32LSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_F32_SSE2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static Uint32
+SDL_Mix_F32MSB_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_F32_SSE2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+
+/* (s * volume) / SDL_MIX_MAXVOLUME for eight Sint16, added to Sint32. */
+static Uint32
+SDL_MixAccumulate_S16LSB_SSE2(Sint32 *acc, const Uint8 *src, Uint32 num, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 8 <= num; i += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i * 2));
+        const __m128i plo = _mm_mullo_epi16(s, vol);
+        const __m128i phi = _mm_mulhi_epi16(s, vol);
+        __m128i lo = _mm_unpacklo_epi16(plo, phi);
+        __m128i hi = _mm_unpackhi_epi16(plo, phi);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_srli_epi32(_mm_srai_epi32(lo, 31), 25)), 7);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_srli_epi32(_mm_srai_epi32(hi, 31), 25)), 7);
+        _mm_storeu_si128((__m128i *) (acc + i), _mm_add_epi32(_mm_loadu_si128((const __m128i *) (acc + i)), lo));
+        _mm_storeu_si128((__m128i *) (acc + i + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *) (acc + i + 4)), hi));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixStore_S16LSB_SSE2(Uint8 *dst, const Sint32 *acc, Uint32 num)
+{
+    Uint32 i;
+
+    for (i = 0; i + 8 <= num; i += 8) {
+        const __m128i lo = _mm_loadu_si128((const __m128i *) (acc + i));
+        const __m128i hi = _mm_loadu_si128((const __m128i *) (acc + i + 4));
+        _mm_storeu_si128((__m128i *) (dst + i * 2), _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+/* The products are rounded to float before they're widened, like the
+   scalar code does. */
+static Uint32
+SDL_MixAccumulate_F32LSB_SSE2(double *acc, const Uint8 *src, Uint32 num, int volume)
+{
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    Uint32 i;
+
+    for (i = 0; i + 4 <= num; i += 4) {
+        const __m128 s = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps((const float *) (src + i * 4)), fvolume), fmaxvolume);
+        _mm_storeu_pd(acc + i, _mm_add_pd(_mm_loadu_pd(acc + i), _mm_cvtps_pd(s)));
+        _mm_storeu_pd(acc + i + 2, _mm_add_pd(_mm_loadu_pd(acc + i + 2), _mm_cvtps_pd(_mm_movehl_ps(s, s))));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixStore_F32LSB_SSE2(Uint8 *dst, const double *acc, Uint32 num)
+{
+    const __m128d max_audioval = _mm_set1_pd(3.402823466e+38F);
+    const __m128d min_audioval = _mm_set1_pd(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= num; i += 4) {
+        const __m128d lo = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, _mm_loadu_pd(acc + i)));
+        const __m128d hi = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, _mm_loadu_pd(acc + i + 2)));
+        _mm_storeu_ps((float *) (dst + i * 4), _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+    }
+    return i;
+}
+#endif
+
+
+#if HAVE_AVX2_INTRINSICS
+/* Same as the SSE2 kernels, 32 bytes at a time. The unpack/pack pairs work
+   within each 128-bit lane, so they keep samples in order. */
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+MixAdjustVolume_S8_AVX2(const __m256i s, const __m256i vol)
+{
+    __m256i lo = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(s, s), 8), vol);
+    __m256i hi = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(s, s), 8), vol);
+    lo = _mm256_srai_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(_mm256_srai_epi16(lo, 15), 9)), 7);
+    hi = _mm256_srai_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(_mm256_srai_epi16(hi, 15), 9)), 7);
+    return _mm256_packs_epi16(lo, hi);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+MixAdjustVolume_S16_AVX2(const __m256i s, const __m256i vol)
+{
+    const __m256i plo = _mm256_mullo_epi16(s, vol);
+    const __m256i phi = _mm256_mulhi_epi16(s, vol);
+    __m256i lo = _mm256_unpacklo_epi16(plo, phi);
+    __m256i hi = _mm256_unpackhi_epi16(plo, phi);
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, _mm256_srli_epi32(_mm256_srai_epi32(lo, 31), 25)), 7);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, _mm256_srli_epi32(_mm256_srai_epi32(hi, 31), 25)), 7);
+    return _mm256_packs_epi32(lo, hi);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+MixAdjustVolume_S32_AVX2(const __m256i s, const __m256i vol)
+{
+    const __m256i low7 = _mm256_set1_epi32(127);
+    const __m256i rv = _mm256_mullo_epi32(_mm256_and_si256(s, low7), vol);
+    const __m256i floored = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol), _mm256_srli_epi32(rv, 7));
+    const __m256i inexact = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(rv, low7), _mm256_setzero_si256()), _mm256_srai_epi32(s, 31));
+    return _mm256_sub_epi32(floored, inexact);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+MixAdds_epi32_AVX2(const __m256i a, const __m256i b)
+{
+    const __m256i sum = _mm256_add_epi32(a, b);
+    const __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, sum), _mm256_xor_si256(b, sum)), 31);
+    const __m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7FFFFFFF));
+    return _mm256_blendv_epi8(sum, limit, overflow);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+MixSwap_AVX2(const __m256i x, const int bytes)
+{
+    const __m256i swap16 = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+    const __m256i swap32 = _mm256_broadcastsi128_si256(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+    return _mm256_shuffle_epi8(x, (bytes == 2) ? swap16 : swap32);
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_S8_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        const __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S8_AVX2(s, vol);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_adds_epi8(d, s));
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_U8_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    const __m256i bias = _mm256_set1_epi8((char) 0x80);
+    const __m256i limit = _mm256_set1_epi8((char) 0xFE);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (src + i)), bias);
+        const __m256i d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (dst + i)), bias);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S8_AVX2(s, vol);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_min_epu8(_mm256_xor_si256(_mm256_adds_epi8(d, s), bias), limit));
+    }
+    return i;
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 Uint32
+Mix_S16_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (swap) {
+            s = MixSwap_AVX2(s, 2);
+            d = MixSwap_AVX2(d, 2);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S16_AVX2(s, vol);
+        }
+        d = _mm256_adds_epi16(d, s);
+        if (swap) {
+            d = MixSwap_AVX2(d, 2);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_S16LSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S16_AVX2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_S16MSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S16_AVX2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 Uint32
+Mix_S32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (swap) {
+            s = MixSwap_AVX2(s, 4);
+            d = MixSwap_AVX2(d, 4);
+        }
+        if (volume != SDL_MIX_MAXVOLUME) {
+            s = MixAdjustVolume_S32_AVX2(s, vol);
+        }
+        d = MixAdds_epi32_AVX2(d, s);
+        if (swap) {
+            d = MixSwap_AVX2(d, 4);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_S32LSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S32_AVX2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_S32MSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_S32_AVX2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 Uint32
+Mix_F32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, const int swap)
+{
+    const __m256 fvolume = _mm256_set1_ps((float) volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m256 max_audioval = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 min_audioval = _mm256_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256 sum;
+        if (swap) {
+            s = MixSwap_AVX2(s, 4);
+            d = MixSwap_AVX2(d, 4);
+        }
+        sum = _mm256_mul_ps(_mm256_mul_ps(_mm256_castsi256_ps(s), fvolume), fmaxvolume);
+        sum = _mm256_add_ps(sum, _mm256_castsi256_ps(d));
+        sum = _mm256_max_ps(min_audioval, _mm256_min_ps(max_audioval, sum));
+        d = _mm256_castps_si256(sum);
+        if (swap) {
+            d = MixSwap_AVX2(d, 4);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_F32LSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_F32_AVX2(dst, src, len, volume, MIX_SWAP_LSB);
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_Mix_F32MSB_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    return Mix_F32_AVX2(dst, src, len, volume, MIX_SWAP_MSB);
+}
+static SDL_TARGETING_AVX2 Uint32
+SDL_MixAccumulate_S16LSB_AVX2(Sint32 *acc, const Uint8 *src, Uint32 num, int volume)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    Uint32 i;
+
+    for (i = 0; i + 8 <= num; i += 8) {
+        const __m256i s = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (src + i * 2)));
+        __m256i p = _mm256_mullo_epi32(s, vol);
+        p = _mm256_srai_epi32(_mm256_add_epi32(p, _mm256_srli_epi32(_mm256_srai_epi32(p, 31), 25)), 7);
+        _mm256_storeu_si256((__m256i *) (acc + i), _mm256_add_epi32(_mm256_loadu_si256((const __m256i *) (acc + i)), p));
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_MixStore_S16LSB_AVX2(Uint8 *dst, const Sint32 *acc, Uint32 num)
+{
+    Uint32 i;
+
+    for (i = 0; i + 16 <= num; i += 16) {
+        const __m256i lo = _mm256_loadu_si256((const __m256i *) (acc + i));
+        const __m256i hi = _mm256_loadu_si256((const __m256i *) (acc + i + 8));
+        /* the pack interleaves the 128-bit lanes, put them back in order */
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i *) (dst + i * 2), packed);
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_MixAccumulate_F32LSB_AVX2(double *acc, const Uint8 *src, Uint32 num, int volume)
+{
+    const __m256 fvolume = _mm256_set1_ps((float) volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    Uint32 i;
+
+    for (i = 0; i + 8 <= num; i += 8) {
+        const __m256 s = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps((const float *) (src + i * 4)), fvolume), fmaxvolume);
+        _mm256_storeu_pd(acc + i, _mm256_add_pd(_mm256_loadu_pd(acc + i), _mm256_cvtps_pd(_mm256_castps256_ps128(s))));
+        _mm256_storeu_pd(acc + i + 4, _mm256_add_pd(_mm256_loadu_pd(acc + i + 4), _mm256_cvtps_pd(_mm256_extractf128_ps(s, 1))));
+    }
+    return i;
+}
+
+static SDL_TARGETING_AVX2 Uint32
+SDL_MixStore_F32LSB_AVX2(Uint8 *dst, const double *acc, Uint32 num)
+{
+    const __m256d max_audioval = _mm256_set1_pd(3.402823466e+38F);
+    const __m256d min_audioval = _mm256_set1_pd(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= num; i += 4) {
+        const __m256d sample = _mm256_max_pd(min_audioval, _mm256_min_pd(max_audioval, _mm256_loadu_pd(acc + i)));
+        _mm_storeu_ps((float *) (dst + i * 4), _mm256_cvtpd_ps(sample));
+    }
+    return i;
+}
+#endif
+
+
+void
+SDL_ChooseAudioMixers(void)
+{
+    static SDL_bool mixers_chosen = SDL_FALSE;
+
+    if (mixers_chosen) {
+        return;
+    }
+
+    #define SET_MIXER_FUNCS(fntype) \
+        SDL_Mix_U8 = SDL_Mix_U8_##fntype; \
+        SDL_Mix_S8 = SDL_Mix_S8_##fntype; \
+        SDL_Mix_S16LSB = SDL_Mix_S16LSB_##fntype; \
+        SDL_Mix_S16MSB = SDL_Mix_S16MSB_##fntype; \
+        SDL_Mix_S32LSB = SDL_Mix_S32LSB_##fntype; \
+        SDL_Mix_S32MSB = SDL_Mix_S32MSB_##fntype; \
+        SDL_Mix_F32LSB = SDL_Mix_F32LSB_##fntype; \
+        SDL_Mix_F32MSB = SDL_Mix_F32MSB_##fntype; \
+        SDL_MixAccumulate_S16LSB = SDL_MixAccumulate_S16LSB_##fntype; \
+        SDL_MixStore_S16LSB = SDL_MixStore_S16LSB_##fntype; \
+        SDL_MixAccumulate_F32LSB = SDL_MixAccumulate_F32LSB_##fntype; \
+        SDL_MixStore_F32LSB = SDL_MixStore_F32LSB_##fntype; \
+        mixers_chosen = SDL_TRUE
+
+    #if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+        return;
+    }
+    #endif
+
+    #if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+        return;
+    }
+    #endif
+
+    #undef SET_MIXER_FUNCS
+
+    /* No SIMD available; the scalar code does everything. */
+    mixers_chosen = SDL_TRUE;
+}
+
+/* Let the SIMD kernel (if any) take the bulk of the buffer. */
+#define MIX_SIMD(mixer) \
+    if (mixer) { \
+        const Uint32 done = mixer(dst, src, len, volume); \
+        dst += done; \
+        src += done; \
+        len -= done; \
+    }
+
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
@@ -94,6 +748,8 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         return;
     }
 
+    SDL_ChooseAudioMixers();
+
     switch (format) {
 
     case AUDIO_U8:
@@ -105,6 +761,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 #else
             Uint8 src_sample;
 
+            MIX_SIMD(SDL_Mix_U8);
             while (len--) {
                 src_sample = *src;
                 ADJUST_VOLUME_U8(src_sample, volume);
@@ -124,6 +781,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const int max_audioval = ((1 << (8 - 1)) - 1);
             const int min_audioval = -(1 << (8 - 1));
 
+            MIX_SIMD(SDL_Mix_S8);
             src8 = (Sint8 *) src;
             dst8 = (Sint8 *) dst;
             while (len--) {
@@ -150,6 +808,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const int max_audioval = ((1 << (16 - 1)) - 1);
             const int min_audioval = -(1 << (16 - 1));
 
+            MIX_SIMD(SDL_Mix_S16LSB);
             len /= 2;
             while (len--) {
                 src1 = ((src[1]) << 8 | src[0]);
@@ -181,6 +840,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
             const int max_audioval = ((1 << (16 - 1)) - 1);
             const int min_audioval = -(1 << (16 - 1));
 
+            MIX_SIMD(SDL_Mix_S16MSB);
             len /= 2;
             while (len--) {
                 src1 = ((src[0]) << 8 | src[1]);
@@ -252,13 +912,16 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
     case AUDIO_S32LSB:
         {
-            const Uint32 *src32 = (Uint32 *) src;
-            Uint32 *dst32 = (Uint32 *) dst;
+            const Uint32 *src32;
+            Uint32 *dst32;
             Sint64 src1, src2;
             Sint64 dst_sample;
             const Sint64 max_audioval = ((((Sint64) 1) << (32 - 1)) - 1);
             const Sint64 min_audioval = -(((Sint64) 1) << (32 - 1));
 
+            MIX_SIMD(SDL_Mix_S32LSB);
+            src32 = (const Uint32 *) src;
+            dst32 = (Uint32 *) dst;
             len /= 4;
             while (len--) {
                 src1 = (Sint64) ((Sint32) SDL_SwapLE32(*src32));
@@ -278,13 +941,16 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
     case AUDIO_S32MSB:
         {
-            const Uint32 *src32 = (Uint32 *) src;
-            Uint32 *dst32 = (Uint32 *) dst;
+            const Uint32 *src32;
+            Uint32 *dst32;
             Sint64 src1, src2;
             Sint64 dst_sample;
             const Sint64 max_audioval = ((((Sint64) 1) << (32 - 1)) - 1);
             const Sint64 min_audioval = -(((Sint64) 1) << (32 - 1));
 
+            MIX_SIMD(SDL_Mix_S32MSB);
+            src32 = (const Uint32 *) src;
+            dst32 = (Uint32 *) dst;
             len /= 4;
             while (len--) {
                 src1 = (Sint64) ((Sint32) SDL_SwapBE32(*src32));
@@ -306,14 +972,17 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         {
             const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
             const float fvolume = (float) volume;
-            const float *src32 = (float *) src;
-            float *dst32 = (float *) dst;
+            const float *src32;
+            float *dst32;
             float src1, src2;
             double dst_sample;
             /* !!! FIXME: are these right? */
             const double max_audioval = 3.402823466e+38F;
             const double min_audioval = -3.402823466e+38F;
 
+            MIX_SIMD(SDL_Mix_F32LSB);
+            src32 = (const float *) src;
+            dst32 = (float *) dst;
             len /= 4;
             while (len--) {
                 src1 = ((SDL_SwapFloatLE(*src32) * fvolume) * fmaxvolume);
@@ -335,14 +1004,17 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         {
             const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
             const float fvolume = (float) volume;
-            const float *src32 = (float *) src;
-            float *dst32 = (float *) dst;
+            const float *src32;
+            float *dst32;
             float src1, src2;
             double dst_sample;
             /* !!! FIXME: are these right? */
             const double max_audioval = 3.402823466e+38F;
             const double min_audioval = -3.402823466e+38F;
 
+            MIX_SIMD(SDL_Mix_F32MSB);
+            src32 = (const float *) src;
+            dst32 = (float *) dst;
             len /= 4;
             while (len--) {
                 src1 = ((SDL_SwapFloatBE(*src32) * fvolume) * fmaxvolume);
@@ -366,4 +1038,280 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
     }
 }
 
+/* SDL_MixAudioFormatMulti() sums into a block of wide accumulators and only
+   clips once per block, so each output sample is read and written once no
+   matter how many sources there are. */
+#define MIX_BLOCK_SAMPLES 256
+
+static void
+MixAccumulate_Int(Sint32 *acc, const Uint8 *src, SDL_AudioFormat format, Uint32 num, int volume)
+{
+    Uint32 i;
+
+    if (format == AUDIO_S16LSB && SDL_MixAccumulate_S16LSB) {
+        i = SDL_MixAccumulate_S16LSB(acc, src, num, volume);
+        acc += i;
+        src += i * 2;
+        num -= i;
+    }
+
+    switch (format) {
+    case AUDIO_U8:
+        for (i = 0; i < num; ++i) {
+            acc[i] += ((src[i] - 128) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+
+    case AUDIO_S8:
+        for (i = 0; i < num; ++i) {
+            acc[i] += (((Sint8) src[i]) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+
+    case AUDIO_S16LSB:
+        for (i = 0; i < num; ++i, src += 2) {
+            acc[i] += (((Sint16) (src[1] << 8 | src[0])) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+
+    case AUDIO_S16MSB:
+        for (i = 0; i < num; ++i, src += 2) {
+            acc[i] += (((Sint16) (src[0] << 8 | src[1])) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+
+    case AUDIO_U16LSB:
+        for (i = 0; i < num; ++i, src += 2) {
+            acc[i] += ((src[1] << 8 | src[0]) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+
+    case AUDIO_U16MSB:
+        for (i = 0; i < num; ++i, src += 2) {
+            acc[i] += ((src[0] << 8 | src[1]) * volume) / SDL_MIX_MAXVOLUME;
+        }
+        break;
+    }
+}
+
+static void
+MixStore_Int(Uint8 *dst, const Sint32 *acc, SDL_AudioFormat format, Uint32 num)
+{
+    Uint32 i;
+
+    if (format == AUDIO_S16LSB && SDL_MixStore_S16LSB) {
+        i = SDL_MixStore_S16LSB(dst, acc, num);
+        dst += i * 2;
+        acc += i;
+        num -= i;
+    }
+
+    switch (format) {
+    case AUDIO_U8:  /* pinned at 0xFE, like mix8[] */
+        for (i = 0; i < num; ++i) {
+            dst[i] = (Uint8) (SDL_max(SDL_min(acc[i], 0x7E), -128) + 128);
+        }
+        break;
+
+    case AUDIO_S8:
+        for (i = 0; i < num; ++i) {
+            dst[i] = (Uint8) SDL_max(SDL_min(acc[i], 127), -128);
+        }
+        break;
+
+    case AUDIO_S16LSB:
+    case AUDIO_S16MSB:
+    case AUDIO_U16LSB:
+    case AUDIO_U16MSB:
+        {
+            const int max_audioval = SDL_AUDIO_ISSIGNED(format) ? 32767 : 0xFFFF;
+            const int min_audioval = SDL_AUDIO_ISSIGNED(format) ? -32768 : 0;
+            const int hi = SDL_AUDIO_ISBIGENDIAN(format) ? 0 : 1;
+
+            for (i = 0; i < num; ++i, dst += 2) {
+                const int sample = SDL_max(SDL_min(acc[i], max_audioval), min_audioval);
+                dst[hi] = (Uint8) ((sample >> 8) & 0xFF);
+                dst[1 - hi] = (Uint8) (sample & 0xFF);
+            }
+        }
+        break;
+    }
+}
+
+static void
+MixAccumulate_S32(Sint64 *acc, const Uint8 *src, SDL_AudioFormat format, Uint32 num, int volume)
+{
+    const Uint32 *src32 = (const Uint32 *) src;
+    Uint32 i;
+
+    if (SDL_AUDIO_ISBIGENDIAN(format)) {
+        for (i = 0; i < num; ++i) {
+            acc[i] += (((Sint64) ((Sint32) SDL_SwapBE32(src32[i]))) * volume) / SDL_MIX_MAXVOLUME;
+        }
+    } else {
+        for (i = 0; i < num; ++i) {
+            acc[i] += (((Sint64) ((Sint32) SDL_SwapLE32(src32[i]))) * volume) / SDL_MIX_MAXVOLUME;
+        }
+    }
+}
+
+static void
+MixStore_S32(Uint8 *dst, const Sint64 *acc, SDL_AudioFormat format, Uint32 num)
+{
+    const Sint64 max_audioval = ((((Sint64) 1) << (32 - 1)) - 1);
+    const Sint64 min_audioval = -(((Sint64) 1) << (32 - 1));
+    Uint32 *dst32 = (Uint32 *) dst;
+    Uint32 i;
+
+    for (i = 0; i < num; ++i) {
+        const Uint32 sample = (Uint32) ((Sint32) SDL_max(SDL_min(acc[i], max_audioval), min_audioval));
+        dst32[i] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE32(sample) : SDL_SwapLE32(sample);
+    }
+}
+
+static void
+MixAccumulate_F32(double *acc, const Uint8 *src, SDL_AudioFormat format, Uint32 num, int volume)
+{
+    const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
+    const float fvolume = (float) volume;
+    const float *src32;
+    Uint32 i;
+
+    if (format == AUDIO_F32LSB && SDL_MixAccumulate_F32LSB) {
+        i = SDL_MixAccumulate_F32LSB(acc, src, num, volume);
+        acc += i;
+        src += i * 4;
+        num -= i;
+    }
+    src32 = (const float *) src;
+
+    if (SDL_AUDIO_ISBIGENDIAN(format)) {
+        for (i = 0; i < num; ++i) {
+            acc[i] += (double) ((SDL_SwapFloatBE(src32[i]) * fvolume) * fmaxvolume);
+        }
+    } else {
+        for (i = 0; i < num; ++i) {
+            acc[i] += (double) ((SDL_SwapFloatLE(src32[i]) * fvolume) * fmaxvolume);
+        }
+    }
+}
+
+static void
+MixStore_F32(Uint8 *dst, const double *acc, SDL_AudioFormat format, Uint32 num)
+{
+    const double max_audioval = 3.402823466e+38F;
+    const double min_audioval = -3.402823466e+38F;
+    float *dst32;
+    Uint32 i;
+
+    if (format == AUDIO_F32LSB && SDL_MixStore_F32LSB) {
+        i = SDL_MixStore_F32LSB(dst, acc, num);
+        dst += i * 4;
+        acc += i;
+        num -= i;
+    }
+    dst32 = (float *) dst;
+
+    for (i = 0; i < num; ++i) {
+        double sample = acc[i];
+        if (sample > max_audioval) {
+            sample = max_audioval;
+        } else if (sample < min_audioval) {
+            sample = min_audioval;
+        }
+        dst32[i] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapFloatBE((float) sample) : SDL_SwapFloatLE((float) sample);
+    }
+}
+
+int
+SDL_MixAudioFormatMulti(Uint8 * dst, const Uint8 ** srcs, const int *volumes,
+                        int num_srcs, SDL_AudioFormat format, Uint32 len)
+{
+    union {
+        Sint32 i32[MIX_BLOCK_SAMPLES];
+        Sint64 i64[MIX_BLOCK_SAMPLES];
+        double f64[MIX_BLOCK_SAMPLES];
+    } acc;
+    const Uint32 sample_size = SDL_AUDIO_BITSIZE(format) / 8;
+    Uint32 offset;
+    int i;
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    } else if (num_srcs < 0) {
+        return SDL_InvalidParamError("num_srcs");
+    } else if (num_srcs > 0 && !srcs) {
+        return SDL_InvalidParamError("srcs");
+    }
+
+    switch (format) {
+    case AUDIO_U8: case AUDIO_S8:
+    case AUDIO_U16LSB: case AUDIO_S16LSB: case AUDIO_U16MSB: case AUDIO_S16MSB:
+    case AUDIO_S32LSB: case AUDIO_S32MSB:
+    case AUDIO_F32LSB: case AUDIO_F32MSB:
+        break;
+    default:
+        return SDL_SetError("SDL_MixAudioFormatMulti(): unknown audio format");
+    }
+
+    for (i = 0; i < num_srcs; ++i) {
+        if (!srcs[i]) {
+            return SDL_InvalidParamError("srcs");
+        }
+    }
+
+    if (num_srcs == 0) {
+        return 0;
+    }
+
+    /* One source is just SDL_MixAudioFormat(), which has SIMD paths. */
+    if (num_srcs == 1) {
+        SDL_MixAudioFormat(dst, srcs[0], format, len, volumes ? volumes[0] : SDL_MIX_MAXVOLUME);
+        return 0;
+    }
+
+    SDL_ChooseAudioMixers();
+
+    len -= len % sample_size;
+    for (offset = 0; offset < len; offset += MIX_BLOCK_SAMPLES * sample_size) {
+        const Uint32 num = SDL_min(len - offset, MIX_BLOCK_SAMPLES * sample_size) / sample_size;
+        Uint8 *out = dst + offset;
+
+        if (format == AUDIO_F32LSB || format == AUDIO_F32MSB) {
+            SDL_memset(acc.f64, 0, num * sizeof (double));
+            MixAccumulate_F32(acc.f64, out, format, num, SDL_MIX_MAXVOLUME);
+        } else if (format == AUDIO_S32LSB || format == AUDIO_S32MSB) {
+            SDL_memset(acc.i64, 0, num * sizeof (Sint64));
+            MixAccumulate_S32(acc.i64, out, format, num, SDL_MIX_MAXVOLUME);
+        } else {
+            SDL_memset(acc.i32, 0, num * sizeof (Sint32));
+            MixAccumulate_Int(acc.i32, out, format, num, SDL_MIX_MAXVOLUME);
+        }
+
+        for (i = 0; i < num_srcs; ++i) {
+            const int volume = volumes ? volumes[i] : SDL_MIX_MAXVOLUME;
+            const Uint8 *in = srcs[i] + offset;
+            if (volume == 0) {
+                continue;
+            } else if (format == AUDIO_F32LSB || format == AUDIO_F32MSB) {
+                MixAccumulate_F32(acc.f64, in, format, num, volume);
+            } else if (format == AUDIO_S32LSB || format == AUDIO_S32MSB) {
+                MixAccumulate_S32(acc.i64, in, format, num, volume);
+            } else {
+                MixAccumulate_Int(acc.i32, in, format, num, volume);
+            }
+        }
+
+        if (format == AUDIO_F32LSB || format == AUDIO_F32MSB) {
+            MixStore_F32(out, acc.f64, format, num);
+        } else if (format == AUDIO_S32LSB || format == AUDIO_S32MSB) {
+            MixStore_S32(out, acc.i64, format, num);
+        } else {
+            MixStore_Int(out, acc.i32, format, num);
+        }
+    }
+
+    return 0;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -62,6 +62,12 @@ extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
    The system preallocates enough packets for 2 callbacks' worth of data. */
 #define SDL_AUDIOBUFFERQUEUE_PACKETLEN (8 * 1024)
 
+/* Queued audio passes between the app and the audio thread through a
+   lock-free ring of at least this many bytes (rounded up to a power of two,
+   and never less than four device buffers). The buffer queue above only
+   holds what doesn't fit in the ring. */
+#define SDL_AUDIOBUFFERQUEUE_RINGLEN (64 * 1024)
+
 typedef struct SDL_AudioDriverImpl
 {
     void (*DetectDevices) (void);
@@ -160,8 +166,27 @@ struct SDL_AudioDevice
     SDL_Thread *thread;
     SDL_threadID threadid;
 
-    /* Queued buffers (if app not using callback). */
+    /* Queued buffers (if app not using callback). The ring is the fast path;
+       buffer_queue is the overflow and is guarded by buffer_queue_lock, which
+       the app side always holds and the audio thread only ever try-locks. */
+    SDL_RingBuffer *buffer_ring;
     SDL_DataQueue *buffer_queue;
+    SDL_mutex *buffer_queue_lock;
+    SDL_atomic_t buffer_queue_bytes;  /* SDL_CountDataQueue(buffer_queue), readable without the lock. */
+
+    /* Statistics for SDL_GetAudioDeviceStats(), updated by the audio thread */
+    SDL_AudioDeviceStats stats;
+    SDL_SpinLock stats_lock;
+    Uint64 last_callback;
+
+    /* Timing for SDL_GetAudioDeviceTimestamp(). timestamp describes the last
+       buffer given to the callback and is guarded by stats_lock; the rest
+       belongs to the audio thread. */
+    SDL_AudioTimestamp timestamp;
+    SDL_atomic_t timestamp_seq; /* odd while a buffer is being stamped and run through the callback */
+    Uint64 callback_frames;     /* frames through the callback, in callbackspec */
+    Uint64 device_frames;       /* capture: frames read from the device, in spec */
+    Uint64 device_frames_time;  /* capture: when the last of those arrived */
 
     /* * * */
     /* Data private to this driver */
@@ -27,379 +27,316 @@
 
 
 static int ReadChunk(SDL_RWops * src, Chunk * chunk);
+static int ReadChunkHeader(SDL_RWops * src, Chunk * chunk);
+static int ReadChunkData(SDL_RWops * src, Chunk * chunk);
 
-struct MS_ADPCM_decodestate
+/* Everything needed to turn the data chunk into samples. This lives in the
+   SDL_WAVReader, or on the stack in SDL_LoadWAV_RW(), so decoding has no
+   global state. */
+typedef struct WaveDecoder
 {
-    Uint8 hPredictor;
-    Uint16 iDelta;
-    Sint16 iSamp1;
-    Sint16 iSamp2;
-};
-static struct MS_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    Uint16 wNumCoef;
-    Sint16 aCoeff[7][2];
-    /* * * */
-    struct MS_ADPCM_decodestate state[2];
-} MS_ADPCM_state;
+    Uint16 encoding;            /* PCM_CODE, IEEE_FLOAT_CODE, or one of the ADPCMs */
+    Uint16 channels;
+    Uint16 blockalign;          /* Bytes per encoded ADPCM block */
+    Uint16 wSamplesPerBlock;    /* Sample frames per decoded ADPCM block */
+    Sint16 aCoeff[7][2];        /* MS ADPCM predictor coefficients */
+} WaveDecoder;
+
+#define MS_ADPCM_NUM_COEFS  7
 
 static int
-InitMS_ADPCM(WaveFMT * format)
+InitMS_ADPCM(WaveDecoder * decoder, const WaveFMT * format)
 {
-    Uint8 *rogue_feel;
+    const Uint8 *rogue_feel;
+    Uint16 wNumCoef;
     int i;
 
     /* Set the rogue pointer to the MS_ADPCM specific data */
-    MS_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    MS_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    MS_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    MS_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    MS_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    MS_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
+    rogue_feel = (const Uint8 *) format + sizeof(*format);
     if (sizeof(*format) == 16) {
         /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
         rogue_feel += sizeof(Uint16);
     }
-    MS_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    MS_ADPCM_state.wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    if (MS_ADPCM_state.wNumCoef != 7) {
+    if (wNumCoef != MS_ADPCM_NUM_COEFS) {
         SDL_SetError("Unknown set of MS_ADPCM coefficients");
         return (-1);
     }
-    for (i = 0; i < MS_ADPCM_state.wNumCoef; ++i) {
-        MS_ADPCM_state.aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    for (i = 0; i < MS_ADPCM_NUM_COEFS; ++i) {
+        decoder->aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
-        MS_ADPCM_state.aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+        decoder->aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
     }
+
+    /* The block decoder trusts these, so check them once here */
+    if (decoder->channels < 1 || decoder->channels > 2) {
+        return SDL_SetError("MS ADPCM decoder can only handle 1 or 2 channels");
+    }
+    if (decoder->wSamplesPerBlock < 2 ||
+        decoder->blockalign < (7 * decoder->channels) +
+            (((decoder->wSamplesPerBlock - 2) * decoder->channels) + 1) / 2) {
+        return SDL_SetError("Invalid MS ADPCM block size");
+    }
     return (0);
 }
 
-static Sint32
-MS_ADPCM_nibble(struct MS_ADPCM_decodestate *state,
-                Uint8 nybble, Sint16 * coeff)
+/* Per-nybble tables for the MS ADPCM decoder */
+static const Sint32 MS_ADPCM_adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+static const Sint32 MS_ADPCM_signed[16] = {
+    0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1
+};
+
+typedef struct MS_ADPCM_ChannelState
+{
+    Sint32 iDelta;
+    Sint32 iSamp1;
+    Sint32 iSamp2;
+    Sint32 coeff1;
+    Sint32 coeff2;
+} MS_ADPCM_ChannelState;
+
+static SDL_INLINE Sint16
+MS_ADPCM_DecodeNybble(MS_ADPCM_ChannelState * state, const Uint8 nybble)
 {
-    const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
-    const Sint32 min_audioval = -(1 << (16 - 1));
-    const Sint32 adaptive[] = {
-        230, 230, 230, 230, 307, 409, 512, 614,
-        768, 614, 512, 409, 307, 230, 230, 230
-    };
     Sint32 new_sample, delta;
 
-    new_sample = ((state->iSamp1 * coeff[0]) +
-                  (state->iSamp2 * coeff[1])) / 256;
-    if (nybble & 0x08) {
-        new_sample += state->iDelta * (nybble - 0x10);
-    } else {
-        new_sample += state->iDelta * nybble;
-    }
-    if (new_sample < min_audioval) {
-        new_sample = min_audioval;
-    } else if (new_sample > max_audioval) {
-        new_sample = max_audioval;
-    }
-    delta = ((Sint32) state->iDelta * adaptive[nybble]) / 256;
-    if (delta < 16) {
-        delta = 16;
+    new_sample = ((state->iSamp1 * state->coeff1) + (state->iSamp2 * state->coeff2)) / 256;
+    new_sample += state->iDelta * MS_ADPCM_signed[nybble];
+    if (new_sample < -32768) {
+        new_sample = -32768;
+    } else if (new_sample > 32767) {
+        new_sample = 32767;
     }
-    state->iDelta = (Uint16) delta;
+    /* iDelta is 16 bits in the stream, and wraps like it */
+    delta = (state->iDelta * MS_ADPCM_adaptive[nybble]) / 256;
+    state->iDelta = (Uint16) ((delta < 16) ? 16 : delta);
     state->iSamp2 = state->iSamp1;
-    state->iSamp1 = (Sint16) new_sample;
-    return (new_sample);
+    state->iSamp1 = new_sample;
+    return (Sint16) SDL_SwapLE16((Uint16) new_sample);
 }
 
+/* Decodes one block of decoder->wSamplesPerBlock sample frames */
 static int
-MS_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+MS_ADPCM_DecodeBlock(const WaveDecoder * decoder, const Uint8 * encoded, Sint16 * decoded)
 {
-    struct MS_ADPCM_decodestate *state[2];
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    Sint8 nybble;
-    Uint8 stereo;
-    Sint16 *coeff[2];
-    Sint32 new_sample;
+    const int channels = decoder->channels;
+    MS_ADPCM_ChannelState state[2];
+    int c, nybbles;
+
+    /* Grab the initial information for this block */
+    for (c = 0; c < channels; ++c) {
+        const Uint8 hPredictor = encoded[c];
+        if (hPredictor >= MS_ADPCM_NUM_COEFS) {
+            return SDL_SetError("Invalid MS ADPCM predictor");
+        }
+        state[c].coeff1 = decoder->aCoeff[hPredictor][0];
+        state[c].coeff2 = decoder->aCoeff[hPredictor][1];
+    }
+    encoded += channels;
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iDelta = (Uint16) ((encoded[1] << 8) | encoded[0]);
+    }
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iSamp1 = (Sint16) ((encoded[1] << 8) | encoded[0]);
+    }
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iSamp2 = (Sint16) ((encoded[1] << 8) | encoded[0]);
+    }
 
-    /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
-    freeable = *audio_buf;
-    *audio_len = (encoded_len / MS_ADPCM_state.wavefmt.blockalign) *
-        MS_ADPCM_state.wSamplesPerBlock *
-        MS_ADPCM_state.wavefmt.channels * sizeof(Sint16);
-    *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
-        return SDL_OutOfMemory();
+    /* Store the two initial samples we start with */
+    for (c = 0; c < channels; ++c) {
+        decoded[c] = (Sint16) SDL_SwapLE16((Uint16) state[c].iSamp2);
+        decoded[channels + c] = (Sint16) SDL_SwapLE16((Uint16) state[c].iSamp1);
     }
-    decoded = *audio_buf;
-
-    /* Get ready... Go! */
-    stereo = (MS_ADPCM_state.wavefmt.channels == 2);
-    state[0] = &MS_ADPCM_state.state[0];
-    state[1] = &MS_ADPCM_state.state[stereo];
-    while (encoded_len >= MS_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        state[0]->hPredictor = *encoded++;
-        if (stereo) {
-            state[1]->hPredictor = *encoded++;
-        }
-        state[0]->iDelta = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iDelta = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
+    decoded += 2 * channels;
+
+    /* Decode the other samples; the high nybble comes first, and in stereo
+       the two nybbles of a byte belong to the two channels. */
+    nybbles = (decoder->wSamplesPerBlock - 2) * channels;
+    if (channels == 2) {
+        for (; nybbles >= 2; nybbles -= 2) {
+            const Uint8 byte = *encoded++;
+            *decoded++ = MS_ADPCM_DecodeNybble(&state[0], byte >> 4);
+            *decoded++ = MS_ADPCM_DecodeNybble(&state[1], byte & 0x0F);
         }
-        state[0]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        coeff[0] = MS_ADPCM_state.aCoeff[state[0]->hPredictor];
-        coeff[1] = MS_ADPCM_state.aCoeff[state[1]->hPredictor];
-
-        /* Store the two initial samples we start with */
-        decoded[0] = state[0]->iSamp2 & 0xFF;
-        decoded[1] = state[0]->iSamp2 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp2 & 0xFF;
-            decoded[1] = state[1]->iSamp2 >> 8;
-            decoded += 2;
-        }
-        decoded[0] = state[0]->iSamp1 & 0xFF;
-        decoded[1] = state[0]->iSamp1 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp1 & 0xFF;
-            decoded[1] = state[1]->iSamp1 >> 8;
-            decoded += 2;
+    } else {
+        for (; nybbles >= 2; nybbles -= 2) {
+            const Uint8 byte = *encoded++;
+            *decoded++ = MS_ADPCM_DecodeNybble(&state[0], byte >> 4);
+            *decoded++ = MS_ADPCM_DecodeNybble(&state[0], byte & 0x0F);
         }
-
-        /* Decode and store the other samples in this block */
-        samplesleft = (MS_ADPCM_state.wSamplesPerBlock - 2) *
-            MS_ADPCM_state.wavefmt.channels;
-        while (samplesleft > 0) {
-            nybble = (*encoded) >> 4;
-            new_sample = MS_ADPCM_nibble(state[0], nybble, coeff[0]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            nybble = (*encoded) & 0x0F;
-            new_sample = MS_ADPCM_nibble(state[1], nybble, coeff[1]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            ++encoded;
-            samplesleft -= 2;
+        if (nybbles) {
+            *decoded++ = MS_ADPCM_DecodeNybble(&state[0], *encoded >> 4);
         }
-        encoded_len -= MS_ADPCM_state.wavefmt.blockalign;
     }
-    SDL_free(freeable);
     return (0);
 }
 
-struct IMA_ADPCM_decodestate
-{
-    Sint32 sample;
-    Sint8 index;
-};
-static struct IMA_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    /* * * */
-    struct IMA_ADPCM_decodestate state[2];
-} IMA_ADPCM_state;
-
 static int
-InitIMA_ADPCM(WaveFMT * format)
+InitIMA_ADPCM(WaveDecoder * decoder, const WaveFMT * format)
 {
-    Uint8 *rogue_feel;
+    const Uint8 *rogue_feel;
 
     /* Set the rogue pointer to the IMA_ADPCM specific data */
-    IMA_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    IMA_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    IMA_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    IMA_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    IMA_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    IMA_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
+    rogue_feel = (const Uint8 *) format + sizeof(*format);
     if (sizeof(*format) == 16) {
         /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
         rogue_feel += sizeof(Uint16);
     }
-    IMA_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+
+    /* The block decoder trusts these, so check them once here */
+    if (decoder->channels < 1) {
+        return SDL_SetError("Invalid number of IMA ADPCM channels");
+    }
+    if (decoder->wSamplesPerBlock < 1 || ((decoder->wSamplesPerBlock - 1) % 8) != 0 ||
+        decoder->blockalign < (4 * decoder->channels) +
+            ((decoder->wSamplesPerBlock - 1) / 2) * decoder->channels) {
+        return SDL_SetError("Invalid IMA ADPCM block size");
+    }
     return (0);
 }
 
-static Sint32
-IMA_ADPCM_nibble(struct IMA_ADPCM_decodestate *state, Uint8 nybble)
+static const Sint8 IMA_ADPCM_index_table[16] = {
+    -1, -1, -1, -1,
+    2, 4, 6, 8,
+    -1, -1, -1, -1,
+    2, 4, 6, 8
+};
+
+static const Sint32 IMA_ADPCM_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+    1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+    22385, 24623, 27086, 29794, 32767
+};
+
+static SDL_INLINE Sint16
+IMA_ADPCM_DecodeNybble(Sint32 * sample, int * index, const Uint8 nybble)
 {
-    const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
-    const Sint32 min_audioval = -(1 << (16 - 1));
-    const int index_table[16] = {
-        -1, -1, -1, -1,
-        2, 4, 6, 8,
-        -1, -1, -1, -1,
-        2, 4, 6, 8
-    };
-    const Sint32 step_table[89] = {
-        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
-        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
-        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
-        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
-        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
-        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
-        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
-        22385, 24623, 27086, 29794, 32767
-    };
-    Sint32 delta, step;
-
-    /* Compute difference and new sample value */
-    if (state->index > 88) {
-        state->index = 88;
-    } else if (state->index < 0) {
-        state->index = 0;
-    }
-    /* explicit cast to avoid gcc warning about using 'char' as array index */
-    step = step_table[(int)state->index];
-    delta = step >> 3;
-    if (nybble & 0x04)
-        delta += step;
-    if (nybble & 0x02)
-        delta += (step >> 1);
-    if (nybble & 0x01)
-        delta += (step >> 2);
-    if (nybble & 0x08)
-        delta = -delta;
-    state->sample += delta;
-
-    /* Update index value */
-    state->index += index_table[nybble];
-
-    /* Clamp output sample */
-    if (state->sample > max_audioval) {
-        state->sample = max_audioval;
-    } else if (state->sample < min_audioval) {
-        state->sample = min_audioval;
-    }
-    return (state->sample);
+    const Sint32 step = IMA_ADPCM_step_table[*index];
+    const Sint32 sign = -(Sint32) (nybble >> 3);
+    Sint32 delta;
+
+    /* step/8 + step*b2 + step/2*b1 + step/4*b0, without branches */
+    delta = (step >> 3) +
+            (step & -(Sint32) ((nybble >> 2) & 1)) +
+            ((step >> 1) & -(Sint32) ((nybble >> 1) & 1)) +
+            ((step >> 2) & -(Sint32) (nybble & 1));
+    *sample += (delta ^ sign) - sign;
+    if (*sample > 32767) {
+        *sample = 32767;
+    } else if (*sample < -32768) {
+        *sample = -32768;
+    }
+
+    *index += IMA_ADPCM_index_table[nybble];
+    if (*index > 88) {
+        *index = 88;
+    } else if (*index < 0) {
+        *index = 0;
+    }
+    return (Sint16) SDL_SwapLE16((Uint16) *sample);
 }
 
-/* Fill the decode buffer with a channel block of data (8 samples) */
-static void
-Fill_IMA_ADPCM_block(Uint8 * decoded, Uint8 * encoded,
-                     int channel, int numchannels,
-                     struct IMA_ADPCM_decodestate *state)
+/* Decodes one block of decoder->wSamplesPerBlock sample frames. Each channel
+   is independent, so this runs through the block one channel at a time. */
+static int
+IMA_ADPCM_DecodeBlock(const WaveDecoder * decoder, const Uint8 * encoded, Sint16 * decoded)
 {
-    int i;
-    Sint8 nybble;
-    Sint32 new_sample;
-
-    decoded += (channel * 2);
-    for (i = 0; i < 4; ++i) {
-        nybble = (*encoded) & 0x0F;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        nybble = (*encoded) >> 4;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        ++encoded;
+    const int channels = decoder->channels;
+    const int groups = (decoder->wSamplesPerBlock - 1) / 8;
+    int c, g, i;
+
+    for (c = 0; c < channels; ++c) {
+        const Uint8 *header = encoded + (c * 4);
+        const Uint8 *data = encoded + (channels * 4) + (c * 4);
+        Sint16 *out = decoded + c;
+        Sint32 sample = (Sint16) ((header[1] << 8) | header[0]);
+        int index = (Sint8) header[2];
+
+        /* header[3] is reserved, and should be 0 */
+        if (index > 88) {
+            index = 88;
+        } else if (index < 0) {
+            index = 0;
+        }
+
+        /* Store the initial sample we start with */
+        *out = (Sint16) SDL_SwapLE16((Uint16) sample);
+        out += channels;
+
+        /* Each channel gets 4 bytes (8 nybbles, low one first) per group */
+        for (g = 0; g < groups; ++g, data += channels * 4) {
+            for (i = 0; i < 4; ++i) {
+                *out = IMA_ADPCM_DecodeNybble(&sample, &index, data[i] & 0x0F);
+                out += channels;
+                *out = IMA_ADPCM_DecodeNybble(&sample, &index, data[i] >> 4);
+                out += channels;
+            }
+        }
     }
+    return (0);
+}
+
+static SDL_bool
+WaveIsADPCM(const WaveDecoder * decoder)
+{
+    return (decoder->encoding == MS_ADPCM_CODE) || (decoder->encoding == IMA_ADPCM_CODE);
 }
 
 static int
-IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+WaveDecodeBlock(const WaveDecoder * decoder, const Uint8 * encoded, Sint16 * decoded)
 {
-    struct IMA_ADPCM_decodestate *state;
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    unsigned int c, channels;
-
-    /* Check to make sure we have enough variables in the state array */
-    channels = IMA_ADPCM_state.wavefmt.channels;
-    if (channels > SDL_arraysize(IMA_ADPCM_state.state)) {
-        SDL_SetError("IMA ADPCM decoder can only handle %u channels",
-                     (unsigned int)SDL_arraysize(IMA_ADPCM_state.state));
-        return (-1);
+    if (decoder->encoding == MS_ADPCM_CODE) {
+        return MS_ADPCM_DecodeBlock(decoder, encoded, decoded);
     }
-    state = IMA_ADPCM_state.state;
+    return IMA_ADPCM_DecodeBlock(decoder, encoded, decoded);
+}
+
+static Uint32
+WaveDecodedBlockSize(const WaveDecoder * decoder)
+{
+    return (Uint32) decoder->wSamplesPerBlock * decoder->channels * sizeof(Sint16);
+}
+
+/* Decode a whole data chunk of ADPCM blocks into one new buffer */
+static int
+WaveDecodeADPCM(const WaveDecoder * decoder, Uint8 ** audio_buf, Uint32 * audio_len)
+{
+    const Uint32 blocks = *audio_len / decoder->blockalign;
+    const Uint32 blocksize = WaveDecodedBlockSize(decoder);
+    const Uint8 *encoded = *audio_buf;
+    Uint8 *decoded;
+    Uint32 i;
 
     /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
-    freeable = *audio_buf;
-    *audio_len = (encoded_len / IMA_ADPCM_state.wavefmt.blockalign) *
-        IMA_ADPCM_state.wSamplesPerBlock *
-        IMA_ADPCM_state.wavefmt.channels * sizeof(Sint16);
-    *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
+    decoded = (Uint8 *) SDL_malloc(blocks * blocksize);
+    if (decoded == NULL && blocks > 0) {
         return SDL_OutOfMemory();
     }
-    decoded = *audio_buf;
-
-    /* Get ready... Go! */
-    while (encoded_len >= IMA_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        for (c = 0; c < channels; ++c) {
-            /* Fill the state information for this block */
-            state[c].sample = ((encoded[1] << 8) | encoded[0]);
-            encoded += 2;
-            if (state[c].sample & 0x8000) {
-                state[c].sample -= 0x10000;
-            }
-            state[c].index = *encoded++;
-            /* Reserved byte in buffer header, should be 0 */
-            if (*encoded++ != 0) {
-                /* Uh oh, corrupt data?  Buggy code? */ ;
-            }
-
-            /* Store the initial sample we start with */
-            decoded[0] = (Uint8) (state[c].sample & 0xFF);
-            decoded[1] = (Uint8) (state[c].sample >> 8);
-            decoded += 2;
+    for (i = 0; i < blocks; ++i) {
+        if (WaveDecodeBlock(decoder, encoded + (i * decoder->blockalign),
+                            (Sint16 *) (decoded + (i * blocksize))) < 0) {
+            SDL_free(decoded);
+            return (-1);
         }
-
-        /* Decode and store the other samples in this block */
-        samplesleft = (IMA_ADPCM_state.wSamplesPerBlock - 1) * channels;
-        while (samplesleft > 0) {
-            for (c = 0; c < channels; ++c) {
-                Fill_IMA_ADPCM_block(decoded, encoded,
-                                     c, channels, &state[c]);
-                encoded += 4;
-                samplesleft -= 8;
-            }
-            decoded += (channels * 8 * 2);
-        }
-        encoded_len -= IMA_ADPCM_state.wavefmt.blockalign;
     }
-    SDL_free(freeable);
+
+    SDL_free(*audio_buf);
+    *audio_buf = decoded;
+    *audio_len = blocks * blocksize;
     return (0);
 }
 
@@ -407,27 +344,28 @@ IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
 static const Uint8 extensible_pcm_guid[16] = { 1, 0, 0, 0, 0, 0, 16, 0, 128, 0, 0, 170, 0, 56, 155, 113 };
 static const Uint8 extensible_ieee_guid[16] = { 3, 0, 0, 0, 0, 0, 16, 0, 128, 0, 0, 170, 0, 56, 155, 113 };
 
-SDL_AudioSpec *
-SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
-               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+/* Reads everything up to the start of the data chunk's contents, and leaves
+   the data chunk header in *chunk. *wavelen and *headerDiff let the caller
+   find the end of the RIFF chunk later. */
+static int
+WaveReadHeader(SDL_RWops * src, WaveDecoder * decoder, SDL_AudioSpec * spec,
+               Chunk * chunk, Uint32 * wavelen, Uint32 * headerDiff)
 {
     int was_error;
-    Chunk chunk;
     int lenread;
-    int IEEE_float_encoded, MS_ADPCM_encoded, IMA_ADPCM_encoded;
-    int samplesize;
+    int IEEE_float_encoded;
 
     /* WAV magic header */
     Uint32 RIFFchunk;
-    Uint32 wavelen = 0;
     Uint32 WAVEmagic;
-    Uint32 headerDiff = 0;
 
     /* FMT chunk */
     WaveFMT *format = NULL;
     WaveExtensibleFMT *ext = NULL;
 
-    SDL_zero(chunk);
+    SDL_zerop(decoder);
+    *wavelen = 0;
+    *headerDiff = 0;
 
     /* Make sure we are passed a valid data source */
     was_error = 0;
@@ -438,10 +376,10 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
 
     /* Check the magic header */
     RIFFchunk = SDL_ReadLE32(src);
-    wavelen = SDL_ReadLE32(src);
-    if (wavelen == WAVE) {      /* The RIFFchunk has already been read */
-        WAVEmagic = wavelen;
-        wavelen = RIFFchunk;
+    *wavelen = SDL_ReadLE32(src);
+    if (*wavelen == WAVE) {     /* The RIFFchunk has already been read */
+        WAVEmagic = *wavelen;
+        *wavelen = RIFFchunk;
         RIFFchunk = RIFF;
     } else {
         WAVEmagic = SDL_ReadLE32(src);
@@ -451,31 +389,35 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         was_error = 1;
         goto done;
     }
-    headerDiff += sizeof(Uint32);       /* for WAVE */
+    *headerDiff += sizeof(Uint32);      /* for WAVE */
 
     /* Read the audio data format chunk */
-    chunk.data = NULL;
+    chunk->data = NULL;
     do {
-        SDL_free(chunk.data);
-        chunk.data = NULL;
-        lenread = ReadChunk(src, &chunk);
+        SDL_free(chunk->data);
+        chunk->data = NULL;
+        lenread = ReadChunk(src, chunk);
         if (lenread < 0) {
             was_error = 1;
             goto done;
         }
         /* 2 Uint32's for chunk header+len, plus the lenread */
-        headerDiff += lenread + 2 * sizeof(Uint32);
-    } while ((chunk.magic == FACT) || (chunk.magic == LIST) || (chunk.magic == BEXT) || (chunk.magic == JUNK));
+        *headerDiff += lenread + 2 * sizeof(Uint32);
+    } while ((chunk->magic == FACT) || (chunk->magic == LIST) || (chunk->magic == BEXT) || (chunk->magic == JUNK));
 
     /* Decode the audio data format */
-    format = (WaveFMT *) chunk.data;
-    if (chunk.magic != FMT) {
+    format = (WaveFMT *) chunk->data;
+    chunk->data = NULL;
+    if (chunk->magic != FMT) {
         SDL_SetError("Complex WAVE files not supported");
         was_error = 1;
         goto done;
     }
-    IEEE_float_encoded = MS_ADPCM_encoded = IMA_ADPCM_encoded = 0;
-    switch (SDL_SwapLE16(format->encoding)) {
+    decoder->encoding = SDL_SwapLE16(format->encoding);
+    decoder->channels = SDL_SwapLE16(format->channels);
+    decoder->blockalign = SDL_SwapLE16(format->blockalign);
+    IEEE_float_encoded = 0;
+    switch (decoder->encoding) {
     case PCM_CODE:
         /* We can understand this */
         break;
@@ -485,19 +427,17 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         break;
     case MS_ADPCM_CODE:
         /* Try to understand this */
-        if (InitMS_ADPCM(format) < 0) {
+        if (InitMS_ADPCM(decoder, format) < 0) {
             was_error = 1;
             goto done;
         }
-        MS_ADPCM_encoded = 1;
         break;
     case IMA_ADPCM_CODE:
         /* Try to understand this */
-        if (InitIMA_ADPCM(format) < 0) {
+        if (InitIMA_ADPCM(decoder, format) < 0) {
             was_error = 1;
             goto done;
         }
-        IMA_ADPCM_encoded = 1;
         break;
     case EXTENSIBLE_CODE:
         /* note that this ignores channel masks, smaller valid bit counts
@@ -510,9 +450,11 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
             was_error = 1;
             goto done;
         }
+        decoder->encoding = PCM_CODE;
         if (SDL_memcmp(ext->subformat, extensible_pcm_guid, 16) == 0) {
             break;  /* cool. */
         } else if (SDL_memcmp(ext->subformat, extensible_ieee_guid, 16) == 0) {
+            decoder->encoding = IEEE_FLOAT_CODE;
             IEEE_float_encoded = 1;
             break;
         }
@@ -539,7 +481,7 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     } else {
         switch (SDL_SwapLE16(format->bitspersample)) {
         case 4:
-            if (MS_ADPCM_encoded || IMA_ADPCM_encoded) {
+            if (WaveIsADPCM(decoder)) {
                 spec->format = AUDIO_S16;
             } else {
                 was_error = 1;
@@ -568,31 +510,61 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     spec->channels = (Uint8) SDL_SwapLE16(format->channels);
     spec->samples = 4096;       /* Good default buffer size */
 
-    /* Read the audio data chunk */
-    *audio_buf = NULL;
-    do {
-        SDL_free(*audio_buf);
-        *audio_buf = NULL;
-        lenread = ReadChunk(src, &chunk);
-        if (lenread < 0) {
+    /* Find the audio data chunk, skipping over anything else */
+    for (;;) {
+        if (ReadChunkHeader(src, chunk) < 0) {
             was_error = 1;
             goto done;
         }
-        *audio_len = lenread;
-        *audio_buf = chunk.data;
-        if (chunk.magic != DATA)
-            headerDiff += lenread + 2 * sizeof(Uint32);
-    } while (chunk.magic != DATA);
-    headerDiff += 2 * sizeof(Uint32);   /* for the data chunk and len */
-
-    if (MS_ADPCM_encoded) {
-        if (MS_ADPCM_decode(audio_buf, audio_len) < 0) {
+        if (chunk->magic == DATA) {
+            break;
+        }
+        lenread = ReadChunkData(src, chunk);
+        SDL_free(chunk->data);
+        chunk->data = NULL;
+        if (lenread < 0) {
             was_error = 1;
             goto done;
         }
+        *headerDiff += lenread + 2 * sizeof(Uint32);
+    }
+    *headerDiff += 2 * sizeof(Uint32);  /* for the data chunk and len */
+
+  done:
+    SDL_free(format);
+    return was_error ? -1 : 0;
+}
+
+SDL_AudioSpec *
+SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
+               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+{
+    int was_error;
+    Chunk chunk;
+    int samplesize;
+    WaveDecoder decoder;
+    Uint32 wavelen = 0;
+    Uint32 headerDiff = 0;
+
+    SDL_zero(chunk);
+
+    was_error = (WaveReadHeader(src, &decoder, spec, &chunk, &wavelen, &headerDiff) < 0);
+    if (was_error) {
+        goto done;
+    }
+
+    /* Read the audio data chunk */
+    if (ReadChunkData(src, &chunk) < 0) {
+        was_error = 1;
+        goto done;
     }
-    if (IMA_ADPCM_encoded) {
-        if (IMA_ADPCM_decode(audio_buf, audio_len) < 0) {
+    *audio_len = chunk.length;
+    *audio_buf = chunk.data;
+
+    if (WaveIsADPCM(&decoder)) {
+        if (WaveDecodeADPCM(&decoder, audio_buf, audio_len) < 0) {
+            SDL_free(*audio_buf);
+            *audio_buf = NULL;
             was_error = 1;
             goto done;
         }
@@ -603,7 +575,6 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     *audio_len &= ~(samplesize - 1);
 
   done:
-    SDL_free(format);
     if (src) {
         if (freesrc) {
             SDL_RWclose(src);
@@ -627,11 +598,206 @@ SDL_FreeWAV(Uint8 * audio_buf)
     SDL_free(audio_buf);
 }
 
+
+/* Incremental reading: only one encoded and one decoded block are ever in
+   memory, no matter how long the file is. */
+struct SDL_WAVReader
+{
+    SDL_RWops *src;
+    int freesrc;
+    WaveDecoder decoder;
+    Sint64 data_start;          /* where the samples start in src, or -1 if src can't seek */
+    Uint32 data_len;            /* size of the data chunk */
+    Uint32 data_pos;            /* bytes of the data chunk consumed so far */
+    Uint32 frame_size;          /* bytes per decoded sample frame */
+    Uint8 *block;               /* one encoded ADPCM block */
+    Uint8 *decoded;             /* one decoded ADPCM block */
+    Uint32 decoded_len;         /* bytes in decoded */
+    Uint32 decoded_pos;         /* bytes of decoded already handed out */
+};
+
+SDL_WAVReader *
+SDL_OpenWAV_RW(SDL_RWops * src, int freesrc, SDL_AudioSpec * spec)
+{
+    SDL_WAVReader *reader;
+    SDL_AudioSpec dummy;
+    Chunk chunk;
+    Uint32 wavelen, headerDiff;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (!spec) {
+        spec = &dummy;
+    }
+
+    reader = (SDL_WAVReader *) SDL_calloc(1, sizeof (SDL_WAVReader));
+    if (!reader) {
+        SDL_OutOfMemory();
+        goto failed;
+    }
+    reader->src = src;
+    reader->freesrc = freesrc;
+
+    SDL_zero(chunk);
+    if (WaveReadHeader(src, &reader->decoder, spec, &chunk, &wavelen, &headerDiff) < 0) {
+        goto failed;
+    }
+    reader->data_len = chunk.length;
+    reader->data_start = SDL_RWtell(src);
+    reader->frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    if (reader->frame_size == 0) {
+        SDL_SetError("Invalid number of channels");
+        goto failed;
+    }
+
+    if (WaveIsADPCM(&reader->decoder)) {
+        reader->block = (Uint8 *) SDL_malloc(reader->decoder.blockalign);
+        reader->decoded = (Uint8 *) SDL_malloc(WaveDecodedBlockSize(&reader->decoder));
+        if (!reader->block || !reader->decoded) {
+            SDL_OutOfMemory();
+            goto failed;
+        }
+    }
+    return reader;
+
+  failed:
+    if (reader) {
+        reader->freesrc = 0;
+        SDL_CloseWAV(reader);
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+Uint32
+SDL_GetWAVLength(SDL_WAVReader * reader)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return 0;
+    }
+    if (WaveIsADPCM(&reader->decoder)) {
+        return (reader->data_len / reader->decoder.blockalign) * WaveDecodedBlockSize(&reader->decoder);
+    }
+    return reader->data_len - (reader->data_len % reader->frame_size);
+}
+
+int
+SDL_ReadWAV(SDL_WAVReader * reader, void *buf, int len)
+{
+    Uint8 *out = (Uint8 *) buf;
+    int total = 0;
+
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    /* Only ever hand out whole sample frames */
+    len -= len % reader->frame_size;
+
+    if (!WaveIsADPCM(&reader->decoder)) {
+        Uint32 want = SDL_min((Uint32) len, reader->data_len - reader->data_pos);
+        size_t got;
+
+        want -= want % reader->frame_size;
+        if (want == 0) {
+            return 0;
+        }
+        got = SDL_RWread(reader->src, out, 1, want);
+        if (got < want) {
+            reader->data_pos = reader->data_len;  /* truncated file; stop here. */
+        } else {
+            reader->data_pos += (Uint32) got;
+        }
+        return (int) got;
+    }
+
+    while (total < len) {
+        const Uint32 blocksize = WaveDecodedBlockSize(&reader->decoder);
+
+        if (reader->decoded_pos < reader->decoded_len) {
+            const Uint32 cpy = SDL_min((Uint32) (len - total), reader->decoded_len - reader->decoded_pos);
+            SDL_memcpy(out + total, reader->decoded + reader->decoded_pos, cpy);
+            reader->decoded_pos += cpy;
+            total += (int) cpy;
+            continue;
+        }
+
+        if ((reader->data_len - reader->data_pos) < reader->decoder.blockalign) {
+            break;  /* end of the data; a partial block can't be decoded. */
+        }
+        if (SDL_RWread(reader->src, reader->block, reader->decoder.blockalign, 1) != 1) {
+            reader->data_pos = reader->data_len;  /* truncated file; stop here. */
+            break;
+        }
+        reader->data_pos += reader->decoder.blockalign;
+
+        /* Decode straight into the caller's buffer when a whole block fits */
+        if (((Uint32) (len - total) >= blocksize) && ((((size_t) (out + total)) & 1) == 0)) {
+            if (WaveDecodeBlock(&reader->decoder, reader->block, (Sint16 *) (out + total)) < 0) {
+                return -1;
+            }
+            total += (int) blocksize;
+        } else {
+            if (WaveDecodeBlock(&reader->decoder, reader->block, (Sint16 *) reader->decoded) < 0) {
+                return -1;
+            }
+            reader->decoded_len = blocksize;
+            reader->decoded_pos = 0;
+        }
+    }
+    return total;
+}
+
+int
+SDL_RewindWAV(SDL_WAVReader * reader)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (reader->data_start < 0 ||
+               SDL_RWseek(reader->src, reader->data_start, RW_SEEK_SET) < 0) {
+        return SDL_SetError("Can't rewind a WAVE data source that can't seek");
+    }
+    reader->data_pos = 0;
+    reader->decoded_len = 0;
+    reader->decoded_pos = 0;
+    return 0;
+}
+
+void
+SDL_CloseWAV(SDL_WAVReader * reader)
+{
+    if (reader) {
+        if (reader->freesrc) {
+            SDL_RWclose(reader->src);
+        }
+        SDL_free(reader->block);
+        SDL_free(reader->decoded);
+        SDL_free(reader);
+    }
+}
+
 static int
-ReadChunk(SDL_RWops * src, Chunk * chunk)
+ReadChunkHeader(SDL_RWops * src, Chunk * chunk)
 {
     chunk->magic = SDL_ReadLE32(src);
     chunk->length = SDL_ReadLE32(src);
+    chunk->data = NULL;
+    return (0);
+}
+
+/* Reads the contents of the chunk whose header is already in *chunk */
+static int
+ReadChunkData(SDL_RWops * src, Chunk * chunk)
+{
     chunk->data = (Uint8 *) SDL_malloc(chunk->length);
     if (chunk->data == NULL) {
         return SDL_OutOfMemory();
@@ -644,4 +810,11 @@ ReadChunk(SDL_RWops * src, Chunk * chunk)
     return (chunk->length);
 }
 
+static int
+ReadChunk(SDL_RWops * src, Chunk * chunk)
+{
+    ReadChunkHeader(src, chunk);
+    return ReadChunkData(src, chunk);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -32,6 +32,7 @@
 #include "SDL_assert.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_hints.h"
 #include "../SDL_audio_c.h"
 #include "SDL_alsa_audio.h"
 
@@ -88,6 +89,14 @@ static int (*ALSA_snd_pcm_wait)(snd_pcm_t *, int);
 static int (*ALSA_snd_pcm_sw_params_set_avail_min)
   (snd_pcm_t *, snd_pcm_sw_params_t *, snd_pcm_uframes_t);
 static int (*ALSA_snd_pcm_reset)(snd_pcm_t *);
+static int (*ALSA_snd_pcm_mmap_begin)
+  (snd_pcm_t *, const snd_pcm_channel_area_t **, snd_pcm_uframes_t *, snd_pcm_uframes_t *);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_commit)
+  (snd_pcm_t *, snd_pcm_uframes_t, snd_pcm_uframes_t);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_writei)
+  (snd_pcm_t *, const void *, snd_pcm_uframes_t);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_avail_update) (snd_pcm_t *);
+static int (*ALSA_snd_pcm_delay) (snd_pcm_t *, snd_pcm_sframes_t *);
 static int (*ALSA_snd_device_name_hint) (int, const char *, void ***);
 static char* (*ALSA_snd_device_name_get_hint) (const void *, const char *);
 static int (*ALSA_snd_device_name_free_hint) (void **);
@@ -156,6 +165,11 @@ load_alsa_syms(void)
     SDL_ALSA_SYM(snd_pcm_wait);
     SDL_ALSA_SYM(snd_pcm_sw_params_set_avail_min);
     SDL_ALSA_SYM(snd_pcm_reset);
+    SDL_ALSA_SYM(snd_pcm_mmap_begin);
+    SDL_ALSA_SYM(snd_pcm_mmap_commit);
+    SDL_ALSA_SYM(snd_pcm_mmap_writei);
+    SDL_ALSA_SYM(snd_pcm_avail_update);
+    SDL_ALSA_SYM(snd_pcm_delay);
     SDL_ALSA_SYM(snd_device_name_hint);
     SDL_ALSA_SYM(snd_device_name_get_hint);
     SDL_ALSA_SYM(snd_device_name_free_hint);
@@ -240,11 +254,52 @@ get_audio_device(void *handle, const int channels)
 }
 
 
+/* Wait until a full period can be written to the mmap buffer */
+static int
+ALSA_mmap_wait(_THIS)
+{
+    snd_pcm_t *pcm_handle = this->hidden->pcm_handle;
+
+    while (SDL_AtomicGet(&this->enabled)) {
+        snd_pcm_sframes_t avail = ALSA_snd_pcm_avail_update(pcm_handle);
+        int status;
+
+        if (avail >= (snd_pcm_sframes_t) this->spec.samples) {
+            return 0;
+        }
+
+        if (avail >= 0) {
+            /* See ALSA_PlayDevice() for why there is a timeout */
+            status = ALSA_snd_pcm_wait(pcm_handle, 1000);
+            if (status == 0) {
+                SDL_OpenedAudioDeviceDisconnected(this);
+                return -1;
+            }
+        } else {
+            status = (int) avail;
+        }
+
+        if (status < 0) {
+            status = ALSA_snd_pcm_recover(pcm_handle, status, 0);
+            if (status < 0) {
+                fprintf(stderr, "ALSA wait failed (unrecoverable): %s\n",
+                        ALSA_snd_strerror(status));
+                SDL_OpenedAudioDeviceDisconnected(this);
+                return -1;
+            }
+        }
+    }
+    return -1;
+}
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 ALSA_WaitDevice(_THIS)
 {
-    /* We're in blocking mode, so there's nothing to do here */
+    /* In blocking mode there's nothing to do here, the write waits */
+    if (this->hidden->mmap) {
+        ALSA_mmap_wait(this);
+    }
 }
 
 
@@ -328,6 +383,27 @@ ALSA_PlayDevice(_THIS)
                                 this->spec.channels;
     snd_pcm_uframes_t frames_left = ((snd_pcm_uframes_t) this->spec.samples);
 
+    if (this->hidden->mmap_buf) {
+        /* The callback mixed straight into the device, hand it over */
+        snd_pcm_sframes_t status;
+
+        this->hidden->swizzle_func(this, this->hidden->mmap_buf, frames_left);
+        this->hidden->mmap_buf = NULL;
+
+        status = ALSA_snd_pcm_mmap_commit(this->hidden->pcm_handle,
+                                          this->hidden->mmap_offset, frames_left);
+        if (status != (snd_pcm_sframes_t) frames_left) {
+            int err = (status < 0) ? (int) status : -EPIPE;
+            err = ALSA_snd_pcm_recover(this->hidden->pcm_handle, err, 0);
+            if (err < 0) {
+                fprintf(stderr, "ALSA commit failed (unrecoverable): %s\n",
+                        ALSA_snd_strerror(err));
+                SDL_OpenedAudioDeviceDisconnected(this);
+            }
+        }
+        return;
+    }
+
     this->hidden->swizzle_func(this, this->hidden->mixbuf, frames_left);
 
     while ( frames_left > 0 && SDL_AtomicGet(&this->enabled) ) {
@@ -344,8 +420,13 @@ ALSA_PlayDevice(_THIS)
             return;
         }
 
-        status = ALSA_snd_pcm_writei(this->hidden->pcm_handle,
+        if (this->hidden->mmap) {
+            status = ALSA_snd_pcm_mmap_writei(this->hidden->pcm_handle,
+                                              sample_buf, frames_left);
+        } else {
+            status = ALSA_snd_pcm_writei(this->hidden->pcm_handle,
                                          sample_buf, frames_left);
+        }
 
         if (status < 0) {
             if (status == -EAGAIN) {
@@ -379,9 +460,42 @@ ALSA_PlayDevice(_THIS)
 static Uint8 *
 ALSA_GetDeviceBuf(_THIS)
 {
+    if (this->hidden->mmap && ALSA_mmap_wait(this) == 0) {
+        const snd_pcm_channel_area_t *areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = this->spec.samples;
+
+        if (ALSA_snd_pcm_mmap_begin(this->hidden->pcm_handle, &areas, &offset, &frames) >= 0) {
+            if (frames == this->spec.samples) {
+                /* Interleaved, so every channel is in the area of the first one */
+                this->hidden->mmap_offset = offset;
+                this->hidden->mmap_buf = (Uint8 *) areas[0].addr +
+                                         (areas[0].first / 8) + (offset * (areas[0].step / 8));
+                return this->hidden->mmap_buf;
+            }
+            /* The period wraps around the end of the ring buffer, so mix it
+               separately and copy it in with snd_pcm_mmap_writei(). Every
+               begin needs a commit, even of nothing, before the next one. */
+            ALSA_snd_pcm_mmap_commit(this->hidden->pcm_handle, offset, 0);
+        }
+    }
     return (this->hidden->mixbuf);
 }
 
+/* Audio the device has buffered but not played yet */
+static int
+ALSA_GetPendingBytes(_THIS)
+{
+    const int frame_size = (((int) SDL_AUDIO_BITSIZE(this->spec.format)) / 8) *
+                                this->spec.channels;
+    snd_pcm_sframes_t delay = 0;
+
+    if (ALSA_snd_pcm_delay(this->hidden->pcm_handle, &delay) < 0 || delay < 0) {
+        return 0;
+    }
+    return (int) delay * frame_size;
+}
+
 static int
 ALSA_CaptureFromDevice(_THIS, void *buffer, int buflen)
 {
@@ -465,12 +579,12 @@ ALSA_finalize_hardware(_THIS, snd_pcm_hw_params_t *hwparams, int override)
     if ( status < 0 ) {
         return(-1);
     }
-    if ( !override && bufsize != this->spec.samples * 2 ) {
+    if ( !override && bufsize != this->spec.samples * this->hidden->periods ) {
         return(-1);
     }
 
     /* !!! FIXME: Is this safe to do? */
-    this->spec.samples = bufsize / 2;
+    this->spec.samples = bufsize / this->hidden->periods;
 
     /* This is useful for debugging */
     if ( SDL_getenv("SDL_AUDIO_ALSA_DEBUG") ) {
@@ -481,8 +595,8 @@ ALSA_finalize_hardware(_THIS, snd_pcm_hw_params_t *hwparams, int override)
         ALSA_snd_pcm_hw_params_get_periods(hwparams, &periods, NULL);
 
         fprintf(stderr,
-            "ALSA: period size = %ld, periods = %u, buffer size = %lu\n",
-            persize, periods, bufsize);
+            "ALSA: period size = %ld, periods = %u, buffer size = %lu, %s access\n",
+            persize, periods, bufsize, this->hidden->mmap ? "mmap" : "read/write");
     }
 
     return(0);
@@ -518,7 +632,7 @@ ALSA_set_period_size(_THIS, snd_pcm_hw_params_t *params, int override)
         return(-1);
     }
 
-    periods = 2;
+    periods = this->hidden->periods;
     status = ALSA_snd_pcm_hw_params_set_periods_near(
                 this->hidden->pcm_handle, hwparams, &periods, NULL);
     if ( status < 0 ) {
@@ -550,7 +664,7 @@ ALSA_set_buffer_size(_THIS, snd_pcm_hw_params_t *params, int override)
         }
     }
 
-    frames = this->spec.samples * 2;
+    frames = this->spec.samples * this->hidden->periods;
     status = ALSA_snd_pcm_hw_params_set_buffer_size_near(
                     this->hidden->pcm_handle, hwparams, &frames);
     if ( status < 0 ) {
@@ -571,6 +685,7 @@ ALSA_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     SDL_AudioFormat test_format = 0;
     unsigned int rate = 0;
     unsigned int channels = 0;
+    const char *hint;
 #ifdef SND_CHMAP_API_VERSION
     snd_pcm_chmap_t *chmap;
     char chmap_str[64];
@@ -607,8 +722,16 @@ ALSA_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     }
 
     /* SDL only uses interleaved sample output */
-    status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
-                                               SND_PCM_ACCESS_RW_INTERLEAVED);
+    status = -1;
+    if (!iscapture && SDL_GetHintBoolean(SDL_HINT_AUDIO_ALSA_MMAP, SDL_FALSE)) {
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+                                                   SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        this->hidden->mmap = (status >= 0) ? SDL_TRUE : SDL_FALSE;
+    }
+    if (status < 0) {
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+                                                   SND_PCM_ACCESS_RW_INTERLEAVED);
+    }
     if (status < 0) {
         return SDL_SetError("ALSA: Couldn't set interleaved access: %s",
                      ALSA_snd_strerror(status));
@@ -706,6 +829,11 @@ ALSA_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     this->spec.freq = rate;
 
     /* Set the buffer size, in samples */
+    this->hidden->periods = 2;
+    hint = SDL_GetHint(SDL_HINT_AUDIO_ALSA_PERIODS);
+    if (hint) {
+        this->hidden->periods = SDL_max(2, SDL_min(SDL_atoi(hint), 16));
+    }
     if ( ALSA_set_period_size(this, hwparams, 0) < 0 &&
          ALSA_set_buffer_size(this, hwparams, 0) < 0 ) {
         /* Failed to set desired buffer size, do the best you can... */
@@ -1023,6 +1151,7 @@ ALSA_Init(SDL_AudioDriverImpl * impl)
     impl->OpenDevice = ALSA_OpenDevice;
     impl->WaitDevice = ALSA_WaitDevice;
     impl->GetDeviceBuf = ALSA_GetDeviceBuf;
+    impl->GetPendingBytes = ALSA_GetPendingBytes;
     impl->PlayDevice = ALSA_PlayDevice;
     impl->CloseDevice = ALSA_CloseDevice;
     impl->Deinitialize = ALSA_Deinitialize;
@@ -41,6 +41,14 @@ struct SDL_PrivateAudioData
 
     /* swizzle function */
     void (*swizzle_func)(_THIS, void *buffer, Uint32 bufferlen);
+
+    /* Number of periods of spec.samples frames in the device buffer */
+    unsigned int periods;
+
+    /* Memory mapped access, the period being mixed if mmap_buf is set */
+    SDL_bool mmap;
+    Uint8 *mmap_buf;
+    snd_pcm_uframes_t mmap_offset;
 };
 
 #endif /* SDL_ALSA_audio_h_ */
@@ -34,6 +34,7 @@
 #include "../SDL_audio_c.h"
 #include "SDL_diskaudio.h"
 #include "SDL_log.h"
+#include "../SDL_wave.h"
 
 /* !!! FIXME: these should be SDL hints, not environment variables. */
 /* environment variables and defaults. */
@@ -42,27 +43,62 @@
 #define DISKENVR_INFILE         "SDL_DISKAUDIOFILEIN"
 #define DISKDEFAULT_INFILE      "sdlaudio-in.raw"
 #define DISKENVR_IODELAY      "SDL_DISKAUDIODELAY"
+#define DISKENVR_FREQ         "SDL_DISKAUDIOFREQ"
+
+/* Playback collects about this much audio before writing it to the file. */
+#define DISKIO_BUFFER_SIZE    (64 * 1024)
+
+/* Size of the header written by DISKAUDIO_WriteWAVHeader() */
+#define WAV_HEADER_SIZE       44
 
 /* This function waits until it is possible to write a full sound buffer */
 static void
 DISKAUDIO_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->io_delay);
+    /* with no delay, run the callback as fast as the CPU allows */
+    if (this->hidden->io_delay) {
+        SDL_Delay(this->hidden->io_delay);
+    } else if (SDL_AtomicGet(&this->paused)) {
+        SDL_Delay((this->spec.samples * 1000) / this->spec.freq);
+    }
+}
+
+static int
+DISKAUDIO_FlushOutput(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    const size_t written = SDL_RWwrite(h->io, h->iobuf, 1, h->iobuf_used);
+    const int rc = (written == (size_t) h->iobuf_used) ? 0 : -1;
+
+    h->wav_data_len += (Uint32) written;
+    h->iobuf_used = 0;
+    h->mixbuf = h->iobuf;
+    return rc;
 }
 
 static void
 DISKAUDIO_PlayDevice(_THIS)
 {
-    const size_t written = SDL_RWwrite(this->hidden->io,
-                                       this->hidden->mixbuf,
-                                       1, this->spec.size);
+    struct SDL_PrivateAudioData *h = this->hidden;
 
-    /* If we couldn't write, assume fatal error for now */
-    if (written != this->spec.size) {
-        SDL_OpenedAudioDeviceDisconnected(this);
+    /* Running free, there's no timeline to keep up with the pauses. */
+    if (!h->io_delay && SDL_AtomicGet(&this->paused)) {
+        return;
+    }
+
+    /* The buffer was mixed in place, just keep it and move along. */
+    h->iobuf_used += this->spec.size;
+    h->mixbuf = h->iobuf + h->iobuf_used;
+    h->frames += this->spec.samples;
+
+    if ((h->iobuf_used + this->spec.size) > (Uint32) h->iobuf_len) {
+        /* If we couldn't write, assume fatal error for now */
+        if (DISKAUDIO_FlushOutput(this) < 0) {
+            SDL_OpenedAudioDeviceDisconnected(this);
+        }
     }
 #ifdef DEBUG_AUDIO
-    fprintf(stderr, "Wrote %d bytes of audio data\n", written);
+    fprintf(stderr, "Wrote %d bytes of audio data\n", this->spec.size);
 #endif
 }
 
@@ -78,7 +114,12 @@ DISKAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
     struct SDL_PrivateAudioData *h = this->hidden;
     const int origbuflen = buflen;
 
-    SDL_Delay(h->io_delay);
+    if (h->io_delay) {
+        SDL_Delay(h->io_delay);
+    } else if (h->io == NULL) {
+        /* Running free, but the file is done: pace the silence at realtime. */
+        SDL_Delay((this->spec.samples * 1000) / this->spec.freq);
+    }
 
     if (h->io) {
         const size_t br = SDL_RWread(h->io, buffer, 1, buflen);
@@ -93,6 +134,7 @@ DISKAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
     /* if we ran out of file, just write silence. */
     SDL_memset(buffer, this->spec.silence, buflen);
 
+    h->frames += origbuflen / ((SDL_AUDIO_BITSIZE(this->spec.format) / 8) * this->spec.channels);
     return origbuflen;
 }
 
@@ -103,14 +145,58 @@ DISKAUDIO_FlushCapture(_THIS)
 }
 
 
+static int
+DISKAUDIO_WriteWAVHeader(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    const Uint16 bits = SDL_AUDIO_BITSIZE(this->spec.format);
+    const Uint16 blockalign = (bits / 8) * this->spec.channels;
+    size_t ok = 1;
+
+    ok &= SDL_WriteLE32(h->io, RIFF);
+    ok &= SDL_WriteLE32(h->io, WAV_HEADER_SIZE - 8 + h->wav_data_len);
+    ok &= SDL_WriteLE32(h->io, WAVE);
+    ok &= SDL_WriteLE32(h->io, FMT);
+    ok &= SDL_WriteLE32(h->io, 16);
+    ok &= SDL_WriteLE16(h->io, SDL_AUDIO_ISFLOAT(this->spec.format) ? IEEE_FLOAT_CODE : PCM_CODE);
+    ok &= SDL_WriteLE16(h->io, this->spec.channels);
+    ok &= SDL_WriteLE32(h->io, this->spec.freq);
+    ok &= SDL_WriteLE32(h->io, this->spec.freq * blockalign);
+    ok &= SDL_WriteLE16(h->io, blockalign);
+    ok &= SDL_WriteLE16(h->io, bits);
+    ok &= SDL_WriteLE32(h->io, DATA);
+    ok &= SDL_WriteLE32(h->io, h->wav_data_len);
+    return ok ? 0 : -1;
+}
+
 static void
 DISKAUDIO_CloseDevice(_THIS)
 {
-    if (this->hidden->io != NULL) {
-        SDL_RWclose(this->hidden->io);
+    struct SDL_PrivateAudioData *h = this->hidden;
+
+    if (h->io != NULL) {
+        if (!this->iscapture) {
+            DISKAUDIO_FlushOutput(this);
+            if (h->wav && SDL_RWseek(h->io, 0, RW_SEEK_SET) == 0) {
+                DISKAUDIO_WriteWAVHeader(this);
+            }
+        }
+        SDL_RWclose(h->io);
+    }
+
+    if (h->start) {
+        const double seconds = (double) (SDL_GetPerformanceCounter() - h->start) /
+                               (double) SDL_GetPerformanceFrequency();
+        if (seconds > 0.0) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO,
+                        " %.0f frames in %.3f seconds: %.0f frames per second, %.2fx realtime.\n",
+                        (double) h->frames, seconds, (double) h->frames / seconds,
+                        ((double) h->frames / seconds) / this->spec.freq);
+        }
     }
-    SDL_free(this->hidden->mixbuf);
-    SDL_free(this->hidden);
+
+    SDL_free(h->iobuf);
+    SDL_free(h);
 }
 
 
@@ -126,12 +212,20 @@ get_filename(const int iscapture, const char *devname)
     return devname;
 }
 
+static SDL_bool
+is_wav_filename(const char *fname)
+{
+    const size_t len = SDL_strlen(fname);
+    return ((len > 4) && (SDL_strcasecmp(fname + len - 4, ".wav") == 0)) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
 {
     /* handle != NULL means "user specified the placeholder name on the fake detected device list" */
     const char *fname = get_filename(iscapture, handle ? NULL : devname);
     const char *envr = SDL_getenv(DISKENVR_IODELAY);
+    const char *freq = SDL_getenv(DISKENVR_FREQ);
 
     this->hidden = (struct SDL_PrivateAudioData *)
         SDL_malloc(sizeof(*this->hidden));
@@ -140,7 +234,29 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     }
     SDL_zerop(this->hidden);
 
-    if (envr != NULL) {
+    /* Let the device run at its own rate, to exercise the resampler. */
+    if (freq != NULL && SDL_atoi(freq) > 0) {
+        this->spec.freq = SDL_atoi(freq);
+    }
+
+    /* WAV files are little endian, and 8-bit data is unsigned. */
+    if (!iscapture && is_wav_filename(fname)) {
+        this->hidden->wav = SDL_TRUE;
+        switch (SDL_AUDIO_BITSIZE(this->spec.format)) {
+            case 8:
+                this->spec.format = AUDIO_U8;
+                break;
+            case 16:
+                this->spec.format = AUDIO_S16LSB;
+                break;
+            default:
+                this->spec.format = SDL_AUDIO_ISFLOAT(this->spec.format) ? AUDIO_F32LSB : AUDIO_S32LSB;
+                break;
+        }
+    }
+    SDL_CalculateAudioSpec(&this->spec);
+
+    if (envr != NULL && *envr) {
         this->hidden->io_delay = SDL_atoi(envr);
     } else {
         this->hidden->io_delay = ((this->spec.samples * 1000) / this->spec.freq);
@@ -152,13 +268,21 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
         return -1;
     }
 
-    /* Allocate mixing buffer */
+    /* Allocate the output buffer; buffers are mixed straight into it. */
     if (!iscapture) {
-        this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->spec.size);
-        if (this->hidden->mixbuf == NULL) {
+        const int buffers = SDL_max(DISKIO_BUFFER_SIZE / (int) this->spec.size, 1);
+        this->hidden->iobuf_len = buffers * this->spec.size;
+        this->hidden->iobuf = (Uint8 *) SDL_malloc(this->hidden->iobuf_len);
+        if (this->hidden->iobuf == NULL) {
             return SDL_OutOfMemory();
         }
-        SDL_memset(this->hidden->mixbuf, this->spec.silence, this->spec.size);
+        SDL_memset(this->hidden->iobuf, this->spec.silence, this->hidden->iobuf_len);
+        this->hidden->mixbuf = this->hidden->iobuf;
+
+        /* Leave room for the header, it's written for real on close */
+        if (this->hidden->wav && DISKAUDIO_WriteWAVHeader(this) < 0) {
+            return -1;
+        }
     }
 
     SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO,
@@ -167,6 +291,8 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
                 " %s file [%s].\n", iscapture ? "Reading from" : "Writing to",
                 fname);
 
+    this->hidden->start = SDL_GetPerformanceCounter();
+
     /* We're ready to rock and roll. :-) */
     return 0;
 }
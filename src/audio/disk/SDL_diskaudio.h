@@ -33,8 +33,21 @@ struct SDL_PrivateAudioData
 {
     /* The file descriptor for the audio device */
     SDL_RWops *io;
-    Uint32 io_delay;
-    Uint8 *mixbuf;
+    Uint32 io_delay;    /* 0 means run as fast as the CPU allows */
+    Uint8 *mixbuf;      /* the buffer being mixed, inside iobuf */
+
+    /* Playback collects several buffers in iobuf before writing them out */
+    Uint8 *iobuf;
+    int iobuf_len;
+    int iobuf_used;
+
+    /* Output is a WAV file; its header is fixed up on close */
+    SDL_bool wav;
+    Uint32 wav_data_len;
+
+    /* Throughput, reported on close */
+    Uint64 frames;
+    Uint64 start;
 };
 
 #endif /* SDL_diskaudio_h_ */
@@ -35,7 +35,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <linux/input.h>
 
 #include "SDL.h"
@@ -99,6 +102,8 @@ typedef struct SDL_evdevlist_item
         } * slots;
     } * touchscreen_data;
 
+    SDL_bool ready;  /* epoll reported input, read it in SDL_EVDEV_Poll() */
+
     struct SDL_evdevlist_item *next;
 } SDL_evdevlist_item;
 
@@ -109,11 +114,23 @@ typedef struct SDL_EVDEV_PrivateData
     SDL_evdevlist_item *first;
     SDL_evdevlist_item *last;
     SDL_EVDEV_keyboard_state *kbd;
+
+    /* One epoll set covers every device, the udev monitor and the wakeup fd,
+       so pumping only reads what is ready and waiting can block on all of it */
+    int epoll_fd;
+    int wakeup_fd;
+    int udev_fd;
 } SDL_EVDEV_PrivateData;
 
 #define _THIS SDL_EVDEV_PrivateData *_this
 static _THIS = NULL;
 
+/* epoll user data for the fds that aren't devices */
+static char SDL_EVDEV_wakeup_tag;
+static char SDL_EVDEV_udev_tag;
+
+#define SDL_EVDEV_MAX_READY 32
+
 static SDL_Scancode SDL_EVDEV_translate_keycode(int keycode);
 static void SDL_EVDEV_sync_device(SDL_evdevlist_item *item);
 static int SDL_EVDEV_device_removed(const char *dev_path);
@@ -139,13 +156,37 @@ int
 SDL_EVDEV_Init(void)
 {
     if (_this == NULL) {
+        struct epoll_event ev;
+
         _this = (SDL_EVDEV_PrivateData*)SDL_calloc(1, sizeof(*_this));
         if (_this == NULL) {
             return SDL_OutOfMemory();
         }
 
+        _this->udev_fd = -1;
+        _this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_this->epoll_fd < 0) {
+            SDL_free(_this);
+            _this = NULL;
+            return SDL_SetError("epoll_create1() failed: %s", strerror(errno));
+        }
+
+        _this->wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_this->wakeup_fd < 0) {
+            close(_this->epoll_fd);
+            SDL_free(_this);
+            _this = NULL;
+            return SDL_SetError("eventfd() failed: %s", strerror(errno));
+        }
+        SDL_zero(ev);
+        ev.events = EPOLLIN;
+        ev.data.ptr = &SDL_EVDEV_wakeup_tag;
+        epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, _this->wakeup_fd, &ev);
+
 #if SDL_USE_LIBUDEV
         if (SDL_UDEV_Init() < 0) {
+            close(_this->wakeup_fd);
+            close(_this->epoll_fd);
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -154,11 +195,22 @@ SDL_EVDEV_Init(void)
         /* Set up the udev callback */
         if (SDL_UDEV_AddCallback(SDL_EVDEV_udev_callback) < 0) {
             SDL_UDEV_Quit();
+            close(_this->wakeup_fd);
+            close(_this->epoll_fd);
             SDL_free(_this);
             _this = NULL;
             return -1;
         }
 
+        /* Watch for hotplug events along with the devices */
+        _this->udev_fd = SDL_UDEV_GetMonitorFd();
+        if (_this->udev_fd >= 0) {
+            SDL_zero(ev);
+            ev.events = EPOLLIN;
+            ev.data.ptr = &SDL_EVDEV_udev_tag;
+            epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, _this->udev_fd, &ev);
+        }
+
         /* Force a scan to build the initial device list */
         SDL_UDEV_Scan();
 #else
@@ -199,6 +251,8 @@ SDL_EVDEV_Quit(void)
         SDL_assert(_this->last == NULL);
         SDL_assert(_this->num_devices == 0);
 
+        close(_this->wakeup_fd);
+        close(_this->epoll_fd);
         SDL_free(_this);
         _this = NULL;
     }
@@ -232,25 +286,57 @@ void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_class,
 void 
 SDL_EVDEV_Poll(void)
 {
+    struct epoll_event ready[SDL_EVDEV_MAX_READY];
     struct input_event events[32];
-    int i, j, len;
+    int i, j, len, num_ready;
     SDL_evdevlist_item *item;
     SDL_Scancode scan_code;
     int mouse_button;
     SDL_Mouse *mouse;
     float norm_x, norm_y;
+    Uint64 wakeups;
 
     if (!_this) {
         return;
     }
 
+    num_ready = epoll_wait(_this->epoll_fd, ready, SDL_arraysize(ready), 0);
+
 #if SDL_USE_LIBUDEV
-    SDL_UDEV_Poll();
+    if (_this->udev_fd < 0) {
+        SDL_UDEV_Poll();
+    } else {
+        for (i = 0; i < num_ready; ++i) {
+            if (ready[i].data.ptr == &SDL_EVDEV_udev_tag) {
+                /* Hotplug may close devices we were just told about, so
+                   handle it first and then ask again for what's ready */
+                SDL_UDEV_Poll();
+                num_ready = epoll_wait(_this->epoll_fd, ready, SDL_arraysize(ready), 0);
+                break;
+            }
+        }
+    }
 #endif
 
+    /* Only the devices epoll reports as ready get a read() */
+    for (i = 0; i < num_ready; ++i) {
+        if (ready[i].data.ptr == &SDL_EVDEV_wakeup_tag) {
+            while (read(_this->wakeup_fd, &wakeups, sizeof(wakeups)) > 0) {
+                continue;
+            }
+        } else if (ready[i].data.ptr != &SDL_EVDEV_udev_tag) {
+            ((SDL_evdevlist_item *) ready[i].data.ptr)->ready = SDL_TRUE;
+        }
+    }
+
     mouse = SDL_GetMouse();
 
     for (item = _this->first; item != NULL; item = item->next) {
+        if (!item->ready) {
+            continue;
+        }
+        item->ready = SDL_FALSE;
+
         while ((len = read(item->fd, events, (sizeof events))) > 0) {
             len /= sizeof(events[0]);
             for (i = 0; i < len; ++i) {
@@ -444,6 +530,49 @@ SDL_EVDEV_Poll(void)
     }
 }
 
+/* Block until a device, the hotplug monitor or a wakeup has input, or the
+   timeout in milliseconds expires (-1 waits forever).
+   Returns 1 if something is ready, 0 on timeout, and -1 on error. */
+int
+SDL_EVDEV_WaitEvents(int timeout)
+{
+    struct epoll_event ev;
+    int retval;
+
+    if (!_this) {
+        return SDL_SetError("evdev is not initialized");
+    }
+
+    retval = epoll_wait(_this->epoll_fd, &ev, 1, timeout);
+    if (retval < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        return SDL_SetError("epoll_wait() failed: %s", strerror(errno));
+    }
+    return (retval > 0) ? 1 : 0;
+}
+
+/* A file descriptor which is readable when SDL_EVDEV_Poll() has input */
+int
+SDL_EVDEV_GetWaitFd(void)
+{
+    return _this ? _this->epoll_fd : -1;
+}
+
+/* Interrupt SDL_EVDEV_WaitEvents(), safe to call from any thread */
+void
+SDL_EVDEV_SendWakeup(void)
+{
+    const Uint64 one = 1;
+
+    if (_this) {
+        if (write(_this->wakeup_fd, &one, sizeof(one)) < 0) {
+            /* The counter is saturated, so a wakeup is pending anyway */
+        }
+    }
+}
+
 static SDL_Scancode
 SDL_EVDEV_translate_keycode(int keycode)
 {
@@ -669,6 +798,7 @@ SDL_EVDEV_device_added(const char *dev_path, int udev_class)
     char name[256];
 #endif /* SDL_VIDEO_DRIVER_DREAMBOX */
     SDL_evdevlist_item *item;
+    struct epoll_event ev;
 
     /* Check to make sure it's not already in list. */
     for (item = _this->first; item != NULL; item = item->next) {
@@ -705,6 +835,17 @@ SDL_EVDEV_device_added(const char *dev_path, int udev_class)
         }
     }
 
+    SDL_zero(ev);
+    ev.events = EPOLLIN;
+    ev.data.ptr = item;
+    if (epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, item->fd, &ev) < 0) {
+        SDL_EVDEV_destroy_touchscreen(item);
+        close(item->fd);
+        SDL_free(item->path);
+        SDL_free(item);
+        return SDL_SetError("Unable to watch %s", dev_path);
+    }
+
     if (_this->last == NULL) {
         _this->first = _this->last = item;
     } else {
@@ -764,6 +905,7 @@ SDL_EVDEV_device_removed(const char *dev_path)
             if (item->is_touchscreen) {
                 SDL_EVDEV_destroy_touchscreen(item);
             }
+            epoll_ctl(_this->epoll_fd, EPOLL_CTL_DEL, item->fd, NULL);
             close(item->fd);
             SDL_free(item->path);
             SDL_free(item);
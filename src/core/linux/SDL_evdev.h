@@ -31,6 +31,9 @@
 extern int SDL_EVDEV_Init(void);
 extern void SDL_EVDEV_Quit(void);
 extern void SDL_EVDEV_Poll(void);
+extern int SDL_EVDEV_WaitEvents(int timeout);
+extern void SDL_EVDEV_SendWakeup(void);
+extern int SDL_EVDEV_GetWaitFd(void);
 
 #endif /* SDL_INPUT_LINUXEV */
 
@@ -119,6 +119,15 @@ SDL_UDEV_hotplug_update_available(void)
     return SDL_FALSE;
 }
 
+/* Returns the hotplug monitor fd so callers can block on it, or -1 */
+int
+SDL_UDEV_GetMonitorFd(void)
+{
+    if (_this == NULL || _this->udev_mon == NULL) {
+        return -1;
+    }
+    return _this->udev_monitor_get_fd(_this->udev_mon);
+}
 
 int
 SDL_UDEV_Init(void)
@@ -107,6 +107,7 @@ extern void SDL_UDEV_Quit(void);
 extern void SDL_UDEV_UnloadLibrary(void);
 extern int SDL_UDEV_LoadLibrary(void);
 extern void SDL_UDEV_Poll(void);
+extern int SDL_UDEV_GetMonitorFd(void);
 extern void SDL_UDEV_Scan(void);
 extern int SDL_UDEV_AddCallback(SDL_UDEV_Callback cb);
 extern void SDL_UDEV_DelCallback(SDL_UDEV_Callback cb);
@@ -624,3 +624,36 @@
 #define SDL_MemoryBarrierReleaseFunction SDL_MemoryBarrierReleaseFunction_REAL
 #define SDL_MemoryBarrierAcquireFunction SDL_MemoryBarrierAcquireFunction_REAL
 #define SDL_JoystickGetDeviceInstanceID SDL_JoystickGetDeviceInstanceID_REAL
+#define SDL_SemWaitTimeoutNS SDL_SemWaitTimeoutNS_REAL
+#define SDL_CondWaitTimeoutNS SDL_CondWaitTimeoutNS_REAL
+#define SDL_DelayNS SDL_DelayNS_REAL
+#define SDL_GetEventTypeStats SDL_GetEventTypeStats_REAL
+#define SDL_GetEventQueueStats SDL_GetEventQueueStats_REAL
+#define SDL_ResetEventQueueStats SDL_ResetEventQueueStats_REAL
+#define SDL_EventCoalescing SDL_EventCoalescing_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_ResetAudioDeviceStats SDL_ResetAudioDeviceStats_REAL
+#define SDL_MixAudioFormatMulti SDL_MixAudioFormatMulti_REAL
+#define SDL_OpenWAV_RW SDL_OpenWAV_RW_REAL
+#define SDL_ReadWAV SDL_ReadWAV_REAL
+#define SDL_RewindWAV SDL_RewindWAV_REAL
+#define SDL_GetWAVLength SDL_GetWAVLength_REAL
+#define SDL_CloseWAV SDL_CloseWAV_REAL
+#define SDL_GetAudioDeviceTimestamp SDL_GetAudioDeviceTimestamp_REAL
+#define SDL_QueueAudioTimestamped SDL_QueueAudioTimestamped_REAL
+#define SDL_DequeueAudioTimestamped SDL_DequeueAudioTimestamped_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_RenderReadbackReady SDL_RenderReadbackReady_REAL
+#define SDL_FinishRenderReadback SDL_FinishRenderReadback_REAL
+#define SDL_CreateAtlasTexture SDL_CreateAtlasTexture_REAL
+#define SDL_CreateAtlasTextureFromSurface SDL_CreateAtlasTextureFromSurface_REAL
+#define SDL_GetRenderAtlasStats SDL_GetRenderAtlasStats_REAL
+#define SDL_CompactRenderAtlas SDL_CompactRenderAtlas_REAL
+#define SDL_RenderWarmUp SDL_RenderWarmUp_REAL
+#define SDL_GetRenderPresentStats SDL_GetRenderPresentStats_REAL
+#define SDL_ResetRenderPresentStats SDL_ResetRenderPresentStats_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_RenderSetProfiling SDL_RenderSetProfiling_REAL
+#define SDL_RenderGetFrameProfile SDL_RenderGetFrameProfile_REAL
+#define SDL_GL_SetFramePacing SDL_GL_SetFramePacing_REAL
+#define SDL_GL_GetFrameTiming SDL_GL_GetFrameTiming_REAL
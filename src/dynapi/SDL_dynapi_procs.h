@@ -656,3 +656,36 @@ SDL_DYNAPI_PROC(SDL_JoystickType,SDL_JoystickGetType,(SDL_Joystick *a),(a),retur
 SDL_DYNAPI_PROC(void,SDL_MemoryBarrierReleaseFunction,(void),(),)
 SDL_DYNAPI_PROC(void,SDL_MemoryBarrierAcquireFunction,(void),(),)
 SDL_DYNAPI_PROC(SDL_JoystickID,SDL_JoystickGetDeviceInstanceID,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SemWaitTimeoutNS,(SDL_sem *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_CondWaitTimeoutNS,(SDL_cond *a, SDL_mutex *b, Uint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DelayNS,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetEventTypeStats,(Uint32 a, SDL_EventTypeStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetEventQueueStats,(SDL_EventQueueStats *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetEventQueueStats,(void),(),)
+SDL_DYNAPI_PROC(Uint8,SDL_EventCoalescing,(Uint32 a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetAudioDeviceStats,(SDL_AudioDeviceID a),(a),)
+SDL_DYNAPI_PROC(int,SDL_MixAudioFormatMulti,(Uint8 *a, const Uint8 **b, const int *c, int d, SDL_AudioFormat e, Uint32 f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAV_RW,(SDL_RWops *a, int b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWAV,(SDL_WAVReader *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RewindWAV,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetWAVLength,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAV,(SDL_WAVReader *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceTimestamp,(SDL_AudioDeviceID a, SDL_AudioTimestamp *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_QueueAudioTimestamped,(SDL_AudioDeviceID a, const void *b, Uint32 c, SDL_AudioTimestamp *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(Uint32,SDL_DequeueAudioTimestamped,(SDL_AudioDeviceID a, void *b, Uint32 c, SDL_AudioTimestamp *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_RenderReadback*,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_RenderReadbackReady,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_FinishRenderReadback,(SDL_RenderReadback *a, Uint32 b, void *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateAtlasTexture,(SDL_Renderer *a, Uint32 b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateAtlasTextureFromSurface,(SDL_Renderer *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderAtlasStats,(SDL_Renderer *a, SDL_RenderAtlasStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_CompactRenderAtlas,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderWarmUp,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderPresentStats,(SDL_Renderer *a, SDL_RenderPresentStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetRenderPresentStats,(SDL_Renderer *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderSetProfiling,(SDL_Renderer *a, SDL_bool b, const char *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetFrameProfile,(SDL_Renderer *a, SDL_RenderFrameProfile *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GL_SetFramePacing,(SDL_Window *a, int b, Uint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GL_GetFrameTiming,(SDL_Window *a, SDL_GLFrameTiming *b),(a,b),return)
@@ -33,6 +33,13 @@
 #endif
 #include "../video/SDL_sysvideo.h"
 
+#if HAVE_POLL
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 /*#define SDL_DEBUG_EVENTS 1*/
 
 /* An arbitrary limit so we don't have unbounded growth */
@@ -55,6 +62,20 @@ typedef struct {
 } SDL_DisabledEventBlock;
 
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
+
+/* Event types which SDL_EventCoalescing() can merge in the queue */
+static struct
+{
+    Uint32 type;
+    SDL_bool enabled;
+} SDL_coalesced_events[] = {
+    { SDL_MOUSEMOTION, SDL_FALSE },
+    { SDL_FINGERMOTION, SDL_FALSE },
+    { SDL_JOYAXISMOTION, SDL_FALSE },
+    { SDL_JOYBALLMOTION, SDL_FALSE },
+    { SDL_CONTROLLERAXISMOTION, SDL_FALSE },
+    { SDL_WINDOWEVENT, SDL_FALSE }
+};
 static Uint32 SDL_userevents = SDL_USEREVENT;
 
 /* Private data -- event queue */
@@ -62,6 +83,7 @@ typedef struct _SDL_EventEntry
 {
     SDL_Event event;
     SDL_SysWMmsg msg;
+    Uint64 queued;
     struct _SDL_EventEntry *prev;
     struct _SDL_EventEntry *next;
 } SDL_EventEntry;
@@ -77,13 +99,70 @@ static struct
     SDL_mutex *lock;
     SDL_atomic_t active;
     SDL_atomic_t count;
+    SDL_atomic_t waiting;
     int max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+} SDL_EventQ = { NULL, { 1 }, { 0 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+
+/* Private data -- queue statistics
+
+   The per-type counters are atomic, since events are filtered outside the
+   queue lock, and are allocated in blocks of 256 types like the disabled
+   event bits. The rest is updated with the queue locked, except for the
+   watcher time which has its own spinlock.
+ */
+typedef struct
+{
+    SDL_atomic_t pushed;
+    SDL_atomic_t filtered;
+    SDL_atomic_t dropped;
+    SDL_atomic_t consumed;
+    SDL_atomic_t coalesced;
+} SDL_EventTypeCounters;
+
+static SDL_EventTypeCounters *SDL_event_counters[256];
+
+#define SDL_NUM_LATENCY_BUCKETS 32
+
+static struct
+{
+    Uint64 depth_total;
+    Uint32 depth_samples;
+    int max_depth;
+    SDL_SpinLock watcher_lock;
+    Uint32 watcher_calls;
+    Uint64 watcher_ticks;
+    Uint32 latency_buckets[SDL_NUM_LATENCY_BUCKETS];
+    Uint32 latency_count;
+    Uint64 latency_max;
+} SDL_EventStats;
+
+/* Private data -- waiting for events
+
+   With poll() the waiter sleeps on a pipe, which pushers write to, along
+   with any file descriptors the video driver registered. Otherwise it
+   sleeps on a condition variable signaled with the queue locked.
+ */
+static struct
+{
+#if HAVE_POLL
+    int wakeup_pipe[2];
+    struct pollfd *fds;
+    int num_fds;
+#else
+    SDL_cond *cond;
+#endif
+} SDL_EventWait = {
+#if HAVE_POLL
+    { -1, -1 }, NULL, 0
+#else
+    NULL
+#endif
+};
 
 
 #ifdef SDL_DEBUG_EVENTS
@@ -310,6 +389,104 @@ SDL_DebugPrintEvent(const SDL_Event *event)
 
 
 
+static SDL_EventTypeCounters *
+SDL_GetEventTypeCounters(Uint32 type)
+{
+    void **slot = (void **) &SDL_event_counters[(type >> 8) & 0xFF];
+    SDL_EventTypeCounters *block = (SDL_EventTypeCounters *) SDL_AtomicGetPtr(slot);
+
+    if (!block) {
+        block = (SDL_EventTypeCounters *) SDL_calloc(256, sizeof(*block));
+        if (!block) {
+            return NULL;
+        }
+        if (!SDL_AtomicCASPtr(slot, NULL, block)) {
+            /* Another thread got there first */
+            SDL_free(block);
+            block = (SDL_EventTypeCounters *) SDL_AtomicGetPtr(slot);
+        }
+    }
+    return &block[type & 0xFF];
+}
+
+#define SDL_CountEvent(type, counter) \
+    do { \
+        SDL_EventTypeCounters *counters = SDL_GetEventTypeCounters(type); \
+        if (counters) { \
+            SDL_AtomicIncRef(&counters->counter); \
+        } \
+    } while (0)
+
+/* Record how long an event was queued -- called with the queue locked */
+static void
+SDL_RecordEventLatency(Uint64 ticks)
+{
+    const Uint64 us = SDL_TicksToMicroseconds(ticks);
+    int bucket = 0;
+
+    while (bucket < (SDL_NUM_LATENCY_BUCKETS - 1) && ((Uint64) 1 << bucket) < us) {
+        ++bucket;
+    }
+    ++SDL_EventStats.latency_buckets[bucket];
+    ++SDL_EventStats.latency_count;
+    if (ticks > SDL_EventStats.latency_max) {
+        SDL_EventStats.latency_max = ticks;
+    }
+}
+
+static Uint32
+SDL_GetEventLatencyPercentile(int percent)
+{
+    const Uint32 max_us = (Uint32) SDL_TicksToMicroseconds(SDL_EventStats.latency_max);
+    const Uint32 target = (Uint32) (((Uint64) SDL_EventStats.latency_count * percent + 99) / 100);
+    Uint32 total = 0;
+    int i;
+
+    if (SDL_EventStats.latency_count == 0) {
+        return 0;
+    }
+    for (i = 0; i < SDL_NUM_LATENCY_BUCKETS; ++i) {
+        total += SDL_EventStats.latency_buckets[i];
+        if (total >= target) {
+            return SDL_min((Uint32) 1 << i, max_us);
+        }
+    }
+    return max_us;
+}
+
+static void
+SDL_LogEventQueueStats(void)
+{
+    SDL_EventQueueStats stats;
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_counters); ++i) {
+        if (!SDL_event_counters[i]) {
+            continue;
+        }
+        for (j = 0; j < 256; ++j) {
+            SDL_EventTypeStats type_stats;
+            const Uint32 type = (Uint32) ((i << 8) | j);
+
+            SDL_GetEventTypeStats(type, &type_stats);
+            if (type_stats.pushed || type_stats.filtered || type_stats.dropped || type_stats.coalesced) {
+                SDL_Log("SDL EVENT QUEUE: type 0x%.4x: %u pushed, %u filtered, %u dropped, %u consumed, %u coalesced\n",
+                        (unsigned int) type, (unsigned int) type_stats.pushed,
+                        (unsigned int) type_stats.filtered, (unsigned int) type_stats.dropped,
+                        (unsigned int) type_stats.consumed, (unsigned int) type_stats.coalesced);
+            }
+        }
+    }
+
+    SDL_GetEventQueueStats(&stats);
+    SDL_Log("SDL EVENT QUEUE: Mean depth %.1f, watchers took %u us for %u events\n",
+            stats.mean_depth, (unsigned int) (stats.watcher_ns / 1000),
+            (unsigned int) stats.watcher_calls);
+    SDL_Log("SDL EVENT QUEUE: Time in queue p50 %u us, p90 %u us, p99 %u us, max %u us\n",
+            (unsigned int) stats.latency_p50_us, (unsigned int) stats.latency_p90_us,
+            (unsigned int) stats.latency_p99_us, (unsigned int) stats.latency_max_us);
+}
+
 /* Public functions */
 
 void
@@ -329,6 +506,7 @@ SDL_StopEventLoop(void)
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
                 SDL_EventQ.max_events_seen);
+        SDL_LogEventQueueStats();
     }
 
     /* Clean out EventQ */
@@ -366,6 +544,9 @@ SDL_StopEventLoop(void)
         SDL_free(SDL_disabled_events[i]);
         SDL_disabled_events[i] = NULL;
     }
+    for (i = 0; i < SDL_arraysize(SDL_coalesced_events); ++i) {
+        SDL_coalesced_events[i].enabled = SDL_FALSE;
+    }
 
     while (SDL_event_watchers) {
         SDL_EventWatcher *tmp = SDL_event_watchers;
@@ -374,11 +555,31 @@ SDL_StopEventLoop(void)
     }
     SDL_EventOK = NULL;
 
+    /* Clear the statistics */
+    for (i = 0; i < SDL_arraysize(SDL_event_counters); ++i) {
+        SDL_free(SDL_event_counters[i]);
+        SDL_event_counters[i] = NULL;
+    }
+    SDL_zero(SDL_EventStats);
+
     if (SDL_EventQ.lock) {
         SDL_UnlockMutex(SDL_EventQ.lock);
         SDL_DestroyMutex(SDL_EventQ.lock);
         SDL_EventQ.lock = NULL;
     }
+
+#if HAVE_POLL
+    if (SDL_EventWait.wakeup_pipe[0] >= 0) {
+        close(SDL_EventWait.wakeup_pipe[0]);
+        close(SDL_EventWait.wakeup_pipe[1]);
+        SDL_EventWait.wakeup_pipe[0] = SDL_EventWait.wakeup_pipe[1] = -1;
+    }
+#else
+    if (SDL_EventWait.cond) {
+        SDL_DestroyCond(SDL_EventWait.cond);
+        SDL_EventWait.cond = NULL;
+    }
+#endif
 }
 
 /* This function (and associated calls) may be called more than once */
@@ -401,6 +602,27 @@ SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    /* Create the wakeup for SDL_WaitEvent(), which falls back to polling
+       the queue if this fails */
+#if HAVE_POLL
+    if (SDL_EventWait.wakeup_pipe[0] < 0) {
+        if (pipe(SDL_EventWait.wakeup_pipe) == 0) {
+            int i;
+            for (i = 0; i < 2; ++i) {
+                const int fd = SDL_EventWait.wakeup_pipe[i];
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+        } else {
+            SDL_EventWait.wakeup_pipe[0] = SDL_EventWait.wakeup_pipe[1] = -1;
+        }
+    }
+#elif !SDL_THREADS_DISABLED
+    if (!SDL_EventWait.cond) {
+        SDL_EventWait.cond = SDL_CreateCond();
+    }
+#endif
+
     /* Process most event types */
     SDL_EventState(SDL_TEXTINPUT, SDL_DISABLE);
     SDL_EventState(SDL_TEXTEDITING, SDL_DISABLE);
@@ -412,6 +634,124 @@ SDL_StartEventLoop(void)
 }
 
 
+static SDL_bool *
+SDL_GetEventCoalescingFlag(Uint32 type)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_coalesced_events); ++i) {
+        if (SDL_coalesced_events[i].type == type) {
+            return &SDL_coalesced_events[i].enabled;
+        }
+    }
+    return NULL;
+}
+
+static Sint16
+SDL_AddRelativeMotion16(Sint16 a, Sint16 b)
+{
+    const int sum = (int) a + b;
+    return (Sint16) SDL_max(-32768, SDL_min(sum, 32767));
+}
+
+/* Merge a motion event into the tail of the queue, if it's from the same
+   source -- called with the queue locked */
+static SDL_bool
+SDL_CoalesceEvent(const SDL_Event * event)
+{
+    const SDL_bool *enabled;
+    SDL_Event *tail;
+
+    if (!SDL_EventQ.tail || SDL_EventQ.tail->event.type != event->type) {
+        return SDL_FALSE;
+    }
+    enabled = SDL_GetEventCoalescingFlag(event->type);
+    if (!enabled || !*enabled) {
+        return SDL_FALSE;
+    }
+
+    tail = &SDL_EventQ.tail->event;
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        if (tail->motion.windowID != event->motion.windowID ||
+            tail->motion.which != event->motion.which) {
+            return SDL_FALSE;
+        } else {
+            const Sint32 xrel = tail->motion.xrel + event->motion.xrel;
+            const Sint32 yrel = tail->motion.yrel + event->motion.yrel;
+            tail->motion = event->motion;
+            tail->motion.xrel = xrel;
+            tail->motion.yrel = yrel;
+        }
+        break;
+
+    case SDL_FINGERMOTION:
+        if (tail->tfinger.touchId != event->tfinger.touchId ||
+            tail->tfinger.fingerId != event->tfinger.fingerId) {
+            return SDL_FALSE;
+        } else {
+            const float dx = tail->tfinger.dx + event->tfinger.dx;
+            const float dy = tail->tfinger.dy + event->tfinger.dy;
+            tail->tfinger = event->tfinger;
+            tail->tfinger.dx = dx;
+            tail->tfinger.dy = dy;
+        }
+        break;
+
+    case SDL_JOYAXISMOTION:
+        if (tail->jaxis.which != event->jaxis.which ||
+            tail->jaxis.axis != event->jaxis.axis) {
+            return SDL_FALSE;
+        }
+        tail->jaxis = event->jaxis;
+        break;
+
+    case SDL_JOYBALLMOTION:
+        if (tail->jball.which != event->jball.which ||
+            tail->jball.ball != event->jball.ball) {
+            return SDL_FALSE;
+        } else {
+            const Sint16 xrel = SDL_AddRelativeMotion16(tail->jball.xrel, event->jball.xrel);
+            const Sint16 yrel = SDL_AddRelativeMotion16(tail->jball.yrel, event->jball.yrel);
+            tail->jball = event->jball;
+            tail->jball.xrel = xrel;
+            tail->jball.yrel = yrel;
+        }
+        break;
+
+    case SDL_CONTROLLERAXISMOTION:
+        if (tail->caxis.which != event->caxis.which ||
+            tail->caxis.axis != event->caxis.axis) {
+            return SDL_FALSE;
+        }
+        tail->caxis = event->caxis;
+        break;
+
+    case SDL_WINDOWEVENT:
+        if (tail->window.windowID != event->window.windowID ||
+            tail->window.event != event->window.event) {
+            return SDL_FALSE;
+        }
+        switch (event->window.event) {
+        case SDL_WINDOWEVENT_MOVED:
+        case SDL_WINDOWEVENT_RESIZED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+            tail->window = event->window;
+            break;
+        default:
+            return SDL_FALSE;
+        }
+        break;
+
+    default:
+        return SDL_FALSE;
+    }
+
+    /* The entry keeps the time it was queued, so latency covers the oldest motion */
+    SDL_CountEvent(event->type, coalesced);
+    return SDL_TRUE;
+}
+
 /* Add an event to the event queue -- called with the queue locked */
 static int
 SDL_AddEvent(SDL_Event * event)
@@ -420,14 +760,20 @@ SDL_AddEvent(SDL_Event * event)
     const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
     int final_count;
 
+    if (SDL_CoalesceEvent(event)) {
+        return 1;
+    }
+
     if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
         SDL_SetError("Event queue is full (%d events)", initial_count);
+        SDL_CountEvent(event->type, dropped);
         return 0;
     }
 
     if (SDL_EventQ.free == NULL) {
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
         if (!entry) {
+            SDL_CountEvent(event->type, dropped);
             return 0;
         }
     } else {
@@ -440,6 +786,7 @@ SDL_AddEvent(SDL_Event * event)
     #endif
 
     entry->event = *event;
+    entry->queued = SDL_GetPerformanceCounter();
     if (event->type == SDL_SYSWMEVENT) {
         entry->msg = *event->syswm.msg;
         entry->event.syswm.msg = &entry->msg;
@@ -463,6 +810,13 @@ SDL_AddEvent(SDL_Event * event)
         SDL_EventQ.max_events_seen = final_count;
     }
 
+    SDL_CountEvent(event->type, pushed);
+    SDL_EventStats.depth_total += final_count;
+    ++SDL_EventStats.depth_samples;
+    if (final_count > SDL_EventStats.max_depth) {
+        SDL_EventStats.max_depth = final_count;
+    }
+
     return 1;
 }
 
@@ -492,6 +846,69 @@ SDL_CutEvent(SDL_EventEntry *entry)
     SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
 
+/* Wake up a thread waiting for events after one has been added */
+static void
+SDL_SendWakeupEvent(void)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+
+    if (_this && _this->WaitEventTimeout && _this->SendWakeupEvent) {
+        _this->SendWakeupEvent(_this);
+        return;
+    }
+#if HAVE_POLL
+    if (SDL_EventWait.wakeup_pipe[1] >= 0) {
+        const char c = 0;
+        if (write(SDL_EventWait.wakeup_pipe[1], &c, 1) < 0) {
+            /* The pipe is full, so the waiter will wake up anyway */
+        }
+    }
+#endif
+}
+
+/* These should only be called from the thread waiting for events */
+int
+SDL_AddEventWaitFd(int fd)
+{
+#if HAVE_POLL
+    /* Slot 0 is filled in with the wakeup pipe when waiting */
+    struct pollfd *fds = (struct pollfd *) SDL_realloc(SDL_EventWait.fds, (SDL_EventWait.num_fds + 2) * sizeof(*fds));
+    if (!fds) {
+        return SDL_OutOfMemory();
+    }
+    SDL_EventWait.fds = fds;
+    ++SDL_EventWait.num_fds;
+
+    fds[SDL_EventWait.num_fds].fd = fd;
+    fds[SDL_EventWait.num_fds].events = POLLIN;
+    fds[SDL_EventWait.num_fds].revents = 0;
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+void
+SDL_DelEventWaitFd(int fd)
+{
+#if HAVE_POLL
+    int i;
+
+    for (i = 1; i <= SDL_EventWait.num_fds; ++i) {
+        if (SDL_EventWait.fds[i].fd == fd) {
+            SDL_memmove(&SDL_EventWait.fds[i], &SDL_EventWait.fds[i + 1],
+                        (SDL_EventWait.num_fds - i) * sizeof(*SDL_EventWait.fds));
+            --SDL_EventWait.num_fds;
+            break;
+        }
+    }
+    if (SDL_EventWait.num_fds == 0) {
+        SDL_free(SDL_EventWait.fds);
+        SDL_EventWait.fds = NULL;
+    }
+#endif
+}
+
 /* Lock the event queue, take a peep at it, and unlock it */
 int
 SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
@@ -518,8 +935,11 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
             SDL_EventEntry *entry, *next;
             SDL_SysWMEntry *wmmsg, *wmmsg_next;
             Uint32 type;
+            Uint64 now = 0;
 
             if (action == SDL_GETEVENT) {
+                now = SDL_GetPerformanceCounter();
+
                 /* Clean out any used wmmsg data
                    FIXME: Do we want to retain the data for some period of time?
                  */
@@ -555,6 +975,8 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
                         }
 
                         if (action == SDL_GETEVENT) {
+                            SDL_CountEvent(type, consumed);
+                            SDL_RecordEventLatency(now - entry->queued);
                             SDL_CutEvent(entry);
                         }
                     }
@@ -562,12 +984,23 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
                 }
             }
         }
+#if !HAVE_POLL
+        /* The waiter checks the queue with it locked, so this can't be lost */
+        if (action == SDL_ADDEVENT && used > 0 && SDL_EventWait.cond &&
+            SDL_AtomicGet(&SDL_EventQ.waiting)) {
+            SDL_CondSignal(SDL_EventWait.cond);
+        }
+#endif
         if (SDL_EventQ.lock) {
             SDL_UnlockMutex(SDL_EventQ.lock);
         }
     } else {
         return SDL_SetError("Couldn't lock event queue");
     }
+
+    if (action == SDL_ADDEVENT && used > 0 && SDL_AtomicGet(&SDL_EventQ.waiting)) {
+        SDL_SendWakeupEvent();
+    }
     return (used);
 }
 
@@ -654,10 +1087,98 @@ SDL_WaitEvent(SDL_Event * event)
     return SDL_WaitEventTimeout(event, -1);
 }
 
+/* Joysticks, and video drivers which can't wake us up, are only polled,
+   so we can't sleep until they have input */
+static SDL_bool
+SDL_EventsNeedPolling(SDL_VideoDevice *_this)
+{
+    if (_this && !(_this->WaitEventTimeout && _this->SendWakeupEvent)) {
+#if HAVE_POLL
+        if (SDL_EventWait.num_fds == 0) {
+            return SDL_TRUE;
+        }
+#else
+        return SDL_TRUE;
+#endif
+    }
+#if !SDL_JOYSTICK_DISABLED
+    if (SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_NumJoysticks() > 0 &&
+        (!SDL_disabled_events[SDL_JOYAXISMOTION >> 8] || SDL_JoystickEventState(SDL_QUERY))) {
+        return SDL_TRUE;
+    }
+#endif
+    return SDL_FALSE;
+}
+
+/* Sleep in the video driver until it has input, an event is pushed or the
+   timeout in milliseconds expires */
+static void
+SDL_WaitEventsOnDevice(SDL_VideoDevice *_this, int timeout)
+{
+    SDL_AtomicSet(&SDL_EventQ.waiting, 1);
+
+    /* Check the queue again now that pushers will wake us up, so an event
+       added just before we set the flag isn't left waiting for the timeout */
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        _this->WaitEventTimeout(_this, timeout);
+    }
+
+    SDL_AtomicSet(&SDL_EventQ.waiting, 0);
+}
+
+/* Sleep until an event is pushed, a registered file descriptor has input
+   or the timeout in milliseconds expires */
+static void
+SDL_WaitEventsOnQueue(int timeout)
+{
+#if HAVE_POLL
+    struct pollfd wakeup;
+    struct pollfd *fds = &wakeup;
+    char buf[64];
+
+    if (SDL_EventWait.wakeup_pipe[0] < 0) {
+        SDL_Delay((timeout < 0 || timeout > 10) ? 10 : timeout);
+        return;
+    }
+    if (SDL_EventWait.num_fds > 0) {
+        fds = SDL_EventWait.fds;
+    }
+    fds[0].fd = SDL_EventWait.wakeup_pipe[0];
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+
+    SDL_AtomicSet(&SDL_EventQ.waiting, 1);
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        poll(fds, SDL_EventWait.num_fds + 1, timeout);
+    }
+    SDL_AtomicSet(&SDL_EventQ.waiting, 0);
+
+    while (read(SDL_EventWait.wakeup_pipe[0], buf, sizeof(buf)) > 0) {
+        continue;
+    }
+#else
+    if (!SDL_EventQ.lock || !SDL_EventWait.cond) {
+        SDL_Delay((timeout < 0 || timeout > 10) ? 10 : timeout);
+        return;
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    SDL_AtomicSet(&SDL_EventQ.waiting, 1);
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        SDL_CondWaitTimeout(SDL_EventWait.cond, SDL_EventQ.lock,
+                            (timeout < 0) ? SDL_MUTEX_MAXWAIT : (Uint32) timeout);
+    }
+    SDL_AtomicSet(&SDL_EventQ.waiting, 0);
+    SDL_UnlockMutex(SDL_EventQ.lock);
+#endif
+}
+
 int
 SDL_WaitEventTimeout(SDL_Event * event, int timeout)
 {
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
     Uint32 expiration = 0;
+    int remaining;
 
     if (timeout > 0)
         expiration = SDL_GetTicks() + timeout;
@@ -676,7 +1197,15 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
                 /* Timeout expired and no events */
                 return 0;
             }
-            SDL_Delay(10);
+            remaining = (timeout > 0) ? SDL_max((int) (expiration - SDL_GetTicks()), 0) : -1;
+            if (SDL_EventsNeedPolling(_this) && (remaining < 0 || remaining > 10)) {
+                remaining = 10;
+            }
+            if (_this && _this->WaitEventTimeout && _this->SendWakeupEvent) {
+                SDL_WaitEventsOnDevice(_this, remaining);
+            } else {
+                SDL_WaitEventsOnQueue(remaining);
+            }
             break;
         default:
             /* Has events */
@@ -685,14 +1214,34 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
     }
 }
 
+/* Record the time spent in the event filter and watchers */
+static void
+SDL_RecordWatcherTime(Uint64 start)
+{
+    const Uint64 ticks = SDL_GetPerformanceCounter() - start;
+
+    SDL_AtomicLock(&SDL_EventStats.watcher_lock);
+    ++SDL_EventStats.watcher_calls;
+    SDL_EventStats.watcher_ticks += ticks;
+    SDL_AtomicUnlock(&SDL_EventStats.watcher_lock);
+}
+
 int
 SDL_PushEvent(SDL_Event * event)
 {
     SDL_EventWatcher *curr;
+    const SDL_bool timed = (SDL_EventOK || SDL_event_watchers) ? SDL_TRUE : SDL_FALSE;
+    Uint64 start = 0;
 
     event->common.timestamp = SDL_GetTicks();
 
+    if (timed) {
+        start = SDL_GetPerformanceCounter();
+    }
+
     if (SDL_EventOK && !SDL_EventOK(SDL_EventOKParam, event)) {
+        SDL_RecordWatcherTime(start);
+        SDL_CountEvent(event->type, filtered);
         return 0;
     }
 
@@ -700,6 +1249,10 @@ SDL_PushEvent(SDL_Event * event)
         curr->callback(curr->userdata, event);
     }
 
+    if (timed) {
+        SDL_RecordWatcherTime(start);
+    }
+
     if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
         return -1;
     }
@@ -787,6 +1340,7 @@ SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
+                SDL_CountEvent(entry->event.type, filtered);
                 SDL_CutEvent(entry);
             }
         }
@@ -794,6 +1348,102 @@ SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     }
 }
 
+int
+SDL_GetEventTypeStats(Uint32 type, SDL_EventTypeStats * stats)
+{
+    const SDL_EventTypeCounters *block;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+    block = (const SDL_EventTypeCounters *) SDL_AtomicGetPtr((void **) &SDL_event_counters[(type >> 8) & 0xFF]);
+    if (block) {
+        const SDL_EventTypeCounters *counters = &block[type & 0xFF];
+        stats->pushed = (Uint32) SDL_AtomicGet((SDL_atomic_t *) &counters->pushed);
+        stats->filtered = (Uint32) SDL_AtomicGet((SDL_atomic_t *) &counters->filtered);
+        stats->dropped = (Uint32) SDL_AtomicGet((SDL_atomic_t *) &counters->dropped);
+        stats->consumed = (Uint32) SDL_AtomicGet((SDL_atomic_t *) &counters->consumed);
+        stats->coalesced = (Uint32) SDL_AtomicGet((SDL_atomic_t *) &counters->coalesced);
+    }
+    return 0;
+}
+
+int
+SDL_GetEventQueueStats(SDL_EventQueueStats * stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+    if (SDL_EventQ.lock) {
+        SDL_LockMutex(SDL_EventQ.lock);
+    }
+
+    stats->depth = SDL_AtomicGet(&SDL_EventQ.count);
+    stats->max_depth = SDL_EventStats.max_depth;
+    if (SDL_EventStats.depth_samples) {
+        stats->mean_depth = (float) SDL_EventStats.depth_total / SDL_EventStats.depth_samples;
+    }
+    stats->latency_count = SDL_EventStats.latency_count;
+    stats->latency_p50_us = SDL_GetEventLatencyPercentile(50);
+    stats->latency_p90_us = SDL_GetEventLatencyPercentile(90);
+    stats->latency_p99_us = SDL_GetEventLatencyPercentile(99);
+    stats->latency_max_us = (Uint32) SDL_TicksToMicroseconds(SDL_EventStats.latency_max);
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+
+    SDL_AtomicLock(&SDL_EventStats.watcher_lock);
+    stats->watcher_calls = SDL_EventStats.watcher_calls;
+    stats->watcher_ns = SDL_TicksToMicroseconds(SDL_EventStats.watcher_ticks) * 1000;
+    SDL_AtomicUnlock(&SDL_EventStats.watcher_lock);
+
+    return 0;
+}
+
+void
+SDL_ResetEventQueueStats(void)
+{
+    int i, j;
+
+    if (SDL_EventQ.lock) {
+        SDL_LockMutex(SDL_EventQ.lock);
+    }
+
+    for (i = 0; i < SDL_arraysize(SDL_event_counters); ++i) {
+        SDL_EventTypeCounters *block = SDL_event_counters[i];
+        if (block) {
+            for (j = 0; j < 256; ++j) {
+                SDL_AtomicSet(&block[j].pushed, 0);
+                SDL_AtomicSet(&block[j].filtered, 0);
+                SDL_AtomicSet(&block[j].dropped, 0);
+                SDL_AtomicSet(&block[j].consumed, 0);
+                SDL_AtomicSet(&block[j].coalesced, 0);
+            }
+        }
+    }
+
+    SDL_EventStats.depth_total = 0;
+    SDL_EventStats.depth_samples = 0;
+    SDL_EventStats.max_depth = SDL_AtomicGet(&SDL_EventQ.count);
+    SDL_zero(SDL_EventStats.latency_buckets);
+    SDL_EventStats.latency_count = 0;
+    SDL_EventStats.latency_max = 0;
+
+    SDL_AtomicLock(&SDL_EventStats.watcher_lock);
+    SDL_EventStats.watcher_calls = 0;
+    SDL_EventStats.watcher_ticks = 0;
+    SDL_AtomicUnlock(&SDL_EventStats.watcher_lock);
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+}
+
 Uint8
 SDL_EventState(Uint32 type, int state)
 {
@@ -835,6 +1485,23 @@ SDL_EventState(Uint32 type, int state)
     return current_state;
 }
 
+Uint8
+SDL_EventCoalescing(Uint32 type, int state)
+{
+    SDL_bool *enabled = SDL_GetEventCoalescingFlag(type);
+    Uint8 current_state;
+
+    if (!enabled) {
+        return SDL_DISABLE;
+    }
+
+    current_state = *enabled ? SDL_ENABLE : SDL_DISABLE;
+    if (state == SDL_ENABLE || state == SDL_DISABLE) {
+        *enabled = (state == SDL_ENABLE) ? SDL_TRUE : SDL_FALSE;
+    }
+    return current_state;
+}
+
 Uint32
 SDL_RegisterEvents(int numevents)
 {
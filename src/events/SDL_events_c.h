@@ -46,6 +46,10 @@ extern void SDL_QuitQuit(void);
 
 extern void SDL_SendPendingQuit(void);
 
+/* Let SDL_WaitEvent() sleep until a video driver file descriptor has input */
+extern int SDL_AddEventWaitFd(int fd);
+extern void SDL_DelEventWaitFd(int fd);
+
 /* The event filter function */
 extern SDL_EventFilter SDL_EventOK;
 extern void *SDL_EventOKParam;
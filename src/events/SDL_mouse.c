@@ -29,6 +29,7 @@
 #include "SDL_events_c.h"
 #include "default_cursor.h"
 #include "../video/SDL_sysvideo.h"
+#include "../SDL_hints_c.h"
 
 /* #define DEBUG_MOUSE */
 
@@ -624,11 +625,13 @@ SDL_WarpMouseGlobal(int x, int y)
 static SDL_bool
 ShouldUseRelativeModeWarp(SDL_Mouse *mouse)
 {
+    static SDL_HintCache relative_mode_warp = { SDL_HINT_MOUSE_RELATIVE_MODE_WARP };
+
     if (!mouse->SetRelativeMouseMode) {
         return SDL_TRUE;
     }
 
-    return SDL_GetHintBoolean(SDL_HINT_MOUSE_RELATIVE_MODE_WARP, SDL_FALSE);
+    return SDL_GetCachedHintBoolean(&relative_mode_warp, SDL_FALSE);
 }
 
 int
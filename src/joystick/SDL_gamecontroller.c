@@ -38,6 +38,11 @@
 /* a list of currently opened game controllers */
 static SDL_GameController *SDL_gamecontrollers = NULL;
 
+/* Opened controllers are also hashed by joystick instance id, so the event
+   watcher finds the one an event belongs to without walking the list */
+#define SDL_CONTROLLER_INSTANCE_BUCKETS 16
+static SDL_GameController *SDL_gamecontrollerbuckets[SDL_CONTROLLER_INSTANCE_BUCKETS];
+
 typedef struct
 {
     SDL_GameControllerBindType inputType;
@@ -84,14 +89,22 @@ typedef enum
 typedef struct _ControllerMapping_t
 {
     SDL_JoystickGUID guid;
-    char *name;
-    char *mapping;
+    char *name;             /* copied out of source the first time it's needed */
+    const char *mapping;    /* the bindings, pointing into source */
+    const char *source;     /* the whole mapping string */
+    SDL_bool free_source;   /* source is our own copy, rather than built in */
     SDL_ControllerMappingPriority priority;
     struct _ControllerMapping_t *next;
+    struct _ControllerMapping_t *hash_next;
 } ControllerMapping_t;
 
+/* Mappings are also hashed by GUID, so finding one doesn't walk the list */
+#define SDL_CONTROLLER_MAPPING_BUCKETS  512
+
 static SDL_JoystickGUID s_zeroGUID;
 static ControllerMapping_t *s_pSupportedControllers = NULL;
+static ControllerMapping_t *s_pLastSupportedController = NULL;
+static ControllerMapping_t *s_pMappingBuckets[SDL_CONTROLLER_MAPPING_BUCKETS];
 static ControllerMapping_t *s_pXInputMapping = NULL;
 static ControllerMapping_t *s_pEmscriptenMapping = NULL;
 
@@ -108,7 +121,17 @@ struct _SDL_GameController
     SDL_ExtendedGameControllerBind **last_match_axis;
     Uint8 *last_hat_mask;
 
+    /* The bindings grouped by the joystick input that drives them, rebuilt
+       with the mapping. Everything lives in the one binding_index block. */
+    void *binding_index;
+    SDL_ExtendedGameControllerBind **button_binding;  /* first binding per button, or NULL */
+    SDL_ExtendedGameControllerBind **axis_bindings;   /* axis i uses axis_first[i] up to axis_first[i + 1] */
+    SDL_ExtendedGameControllerBind **hat_bindings;    /* hat i uses hat_first[i] up to hat_first[i + 1] */
+    int *axis_first;
+    int *hat_first;
+
     struct _SDL_GameController *next; /* pointer to next game controller we have allocated */
+    struct _SDL_GameController *instance_next; /* next controller in the same instance id bucket */
 };
 
 
@@ -169,25 +192,23 @@ static void ResetOutput(SDL_GameController *gamecontroller, SDL_ExtendedGameCont
 static void HandleJoystickAxis(SDL_GameController *gamecontroller, int axis, int value)
 {
     int i;
+    const int last = gamecontroller->axis_first[axis + 1];
     SDL_ExtendedGameControllerBind *last_match = gamecontroller->last_match_axis[axis];
     SDL_ExtendedGameControllerBind *match = NULL;
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_AXIS &&
-            axis == binding->input.axis.axis) {
-            if (binding->input.axis.axis_min < binding->input.axis.axis_max) {
-                if (value >= binding->input.axis.axis_min &&
-                    value <= binding->input.axis.axis_max) {
-                    match = binding;
-                    break;
-                }
-            } else {
-                if (value >= binding->input.axis.axis_max &&
-                    value <= binding->input.axis.axis_min) {
-                    match = binding;
-                    break;
-                }
+    for (i = gamecontroller->axis_first[axis]; i < last; ++i) {
+        SDL_ExtendedGameControllerBind *binding = gamecontroller->axis_bindings[i];
+        if (binding->input.axis.axis_min < binding->input.axis.axis_max) {
+            if (value >= binding->input.axis.axis_min &&
+                value <= binding->input.axis.axis_max) {
+                match = binding;
+                break;
+            }
+        } else {
+            if (value >= binding->input.axis.axis_max &&
+                value <= binding->input.axis.axis_min) {
+                match = binding;
+                break;
             }
         }
     }
@@ -220,19 +241,14 @@ static void HandleJoystickAxis(SDL_GameController *gamecontroller, int axis, int
 
 static void HandleJoystickButton(SDL_GameController *gamecontroller, int button, Uint8 state)
 {
-    int i;
+    SDL_ExtendedGameControllerBind *binding = gamecontroller->button_binding[button];
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_BUTTON &&
-            button == binding->input.button) {
-            if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
-                int value = state ? binding->output.axis.axis_max : binding->output.axis.axis_min;
-                SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)value);
-            } else {
-                SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, state);
-            }
-            break;
+    if (binding) {
+        if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
+            int value = state ? binding->output.axis.axis_max : binding->output.axis.axis_min;
+            SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)value);
+        } else {
+            SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, state);
         }
     }
 }
@@ -240,69 +256,68 @@ static void HandleJoystickButton(SDL_GameController *gamecontroller, int button,
 static void HandleJoystickHat(SDL_GameController *gamecontroller, int hat, Uint8 value)
 {
     int i;
+    const int last = gamecontroller->hat_first[hat + 1];
     Uint8 last_mask = gamecontroller->last_hat_mask[hat];
     Uint8 changed_mask = (last_mask ^ value);
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_HAT && hat == binding->input.hat.hat) {
-            if ((changed_mask & binding->input.hat.hat_mask) != 0) {
-                if (value & binding->input.hat.hat_mask) {
-                    if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
-                        SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)binding->output.axis.axis_max);
-                    } else {
-                        SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, SDL_PRESSED);
-                    }
+    for (i = gamecontroller->hat_first[hat]; i < last; ++i) {
+        SDL_ExtendedGameControllerBind *binding = gamecontroller->hat_bindings[i];
+        if ((changed_mask & binding->input.hat.hat_mask) != 0) {
+            if (value & binding->input.hat.hat_mask) {
+                if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
+                    SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)binding->output.axis.axis_max);
                 } else {
-                    ResetOutput(gamecontroller, binding);
+                    SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, SDL_PRESSED);
                 }
+            } else {
+                ResetOutput(gamecontroller, binding);
             }
         }
     }
     gamecontroller->last_hat_mask[hat] = value;
 }
 
+/*
+ * Find the opened controller for a joystick instance id, or NULL
+ */
+static SDL_GameController *SDL_PrivateGetGameControllerForInstance(SDL_JoystickID instance_id)
+{
+    SDL_GameController *gamecontroller = SDL_gamecontrollerbuckets[(Uint32)instance_id % SDL_CONTROLLER_INSTANCE_BUCKETS];
+
+    while (gamecontroller && gamecontroller->joystick->instance_id != instance_id) {
+        gamecontroller = gamecontroller->instance_next;
+    }
+    return gamecontroller;
+}
+
 /*
  * Event filter to fire controller events from joystick ones
  */
 static int SDL_GameControllerEventWatcher(void *userdata, SDL_Event * event)
 {
+    SDL_GameController *gamecontroller;
+
     switch(event->type) {
     case SDL_JOYAXISMOTION:
-        {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jaxis.which) {
-                    HandleJoystickAxis(controllerlist, event->jaxis.axis, event->jaxis.value);
-                    break;
-                }
-                controllerlist = controllerlist->next;
-            }
+        gamecontroller = SDL_PrivateGetGameControllerForInstance(event->jaxis.which);
+        if (gamecontroller && gamecontroller->binding_index &&
+            event->jaxis.axis < gamecontroller->joystick->naxes) {
+            HandleJoystickAxis(gamecontroller, event->jaxis.axis, event->jaxis.value);
         }
         break;
     case SDL_JOYBUTTONDOWN:
     case SDL_JOYBUTTONUP:
-        {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jbutton.which) {
-                    HandleJoystickButton(controllerlist, event->jbutton.button, event->jbutton.state);
-                    break;
-                }
-                controllerlist = controllerlist->next;
-            }
+        gamecontroller = SDL_PrivateGetGameControllerForInstance(event->jbutton.which);
+        if (gamecontroller && gamecontroller->binding_index &&
+            event->jbutton.button < gamecontroller->joystick->nbuttons) {
+            HandleJoystickButton(gamecontroller, event->jbutton.button, event->jbutton.state);
         }
         break;
     case SDL_JOYHATMOTION:
-        {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jhat.which) {
-                    HandleJoystickHat(controllerlist, event->jhat.hat, event->jhat.value);
-                    break;
-                }
-                controllerlist = controllerlist->next;
-            }
+        gamecontroller = SDL_PrivateGetGameControllerForInstance(event->jhat.which);
+        if (gamecontroller && gamecontroller->binding_index &&
+            event->jhat.hat < gamecontroller->joystick->nhats) {
+            HandleJoystickHat(gamecontroller, event->jhat.hat, event->jhat.value);
         }
         break;
     case SDL_JOYDEVICEADDED:
@@ -316,21 +331,14 @@ static int SDL_GameControllerEventWatcher(void *userdata, SDL_Event * event)
         }
         break;
     case SDL_JOYDEVICEREMOVED:
-        {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jdevice.which) {
-                    SDL_Event deviceevent;
+        if (SDL_PrivateGetGameControllerForInstance(event->jdevice.which)) {
+            SDL_Event deviceevent;
 
-                    deviceevent.type = SDL_CONTROLLERDEVICEREMOVED;
-                    deviceevent.cdevice.which = event->jdevice.which;
-                    SDL_PushEvent(&deviceevent);
+            deviceevent.type = SDL_CONTROLLERDEVICEREMOVED;
+            deviceevent.cdevice.which = event->jdevice.which;
+            SDL_PushEvent(&deviceevent);
 
-                    UpdateEventsForDeviceRemoval();
-                    break;
-                }
-                controllerlist = controllerlist->next;
-            }
+            UpdateEventsForDeviceRemoval();
         }
         break;
     default:
@@ -340,17 +348,32 @@ static int SDL_GameControllerEventWatcher(void *userdata, SDL_Event * event)
     return 1;
 }
 
+/*
+ * Helper function to pick the hash bucket for a GUID (FNV-1a)
+ */
+static ControllerMapping_t **SDL_PrivateGetControllerMappingBucket(const SDL_JoystickGUID *guid)
+{
+    Uint32 hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(guid->data); ++i) {
+        hash ^= guid->data[i];
+        hash *= 16777619u;
+    }
+    return &s_pMappingBuckets[hash & (SDL_CONTROLLER_MAPPING_BUCKETS - 1)];
+}
+
 /*
  * Helper function to scan the mappings database for a controller with the specified GUID
  */
 static ControllerMapping_t *SDL_PrivateGetControllerMappingForGUID(SDL_JoystickGUID *guid)
 {
-    ControllerMapping_t *pSupportedController = s_pSupportedControllers;
+    ControllerMapping_t *pSupportedController = *SDL_PrivateGetControllerMappingBucket(guid);
     while (pSupportedController) {
         if (SDL_memcmp(guid, &pSupportedController->guid, sizeof(*guid)) == 0) {
             return pSupportedController;
         }
-        pSupportedController = pSupportedController->next;
+        pSupportedController = pSupportedController->hash_next;
     }
     return NULL;
 }
@@ -589,6 +612,80 @@ SDL_PrivateGameControllerParseControllerConfigString(SDL_GameController *gamecon
 
 }
 
+/*
+ * Group the bindings by the joystick input that drives them, keeping the
+ * order they were parsed in, so each joystick event only looks at its own
+ */
+static void SDL_PrivateIndexBindings(SDL_GameController *gamecontroller)
+{
+    const SDL_Joystick *joystick = gamecontroller->joystick;
+    int num_axis_bindings = 0, num_hat_bindings = 0;
+    size_t num_pointers, size;
+    Uint8 *block;
+    int i, j;
+
+    SDL_free(gamecontroller->binding_index);
+    gamecontroller->binding_index = NULL;
+
+    for (i = 0; i < gamecontroller->num_bindings; ++i) {
+        const SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
+        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
+            ++num_axis_bindings;
+        } else if (binding->inputType == SDL_CONTROLLER_BINDTYPE_HAT) {
+            ++num_hat_bindings;
+        }
+    }
+
+    /* The pointers go first, so the ints after them stay aligned */
+    num_pointers = joystick->nbuttons + num_axis_bindings + num_hat_bindings;
+    size = num_pointers * sizeof(SDL_ExtendedGameControllerBind *) +
+           (joystick->naxes + 1 + joystick->nhats + 1) * sizeof(int);
+    block = (Uint8 *)SDL_calloc(1, size);
+    if (!block) {
+        SDL_OutOfMemory();
+        return;
+    }
+    gamecontroller->button_binding = (SDL_ExtendedGameControllerBind **)block;
+    gamecontroller->axis_bindings = gamecontroller->button_binding + joystick->nbuttons;
+    gamecontroller->hat_bindings = gamecontroller->axis_bindings + num_axis_bindings;
+    gamecontroller->axis_first = (int *)(gamecontroller->hat_bindings + num_hat_bindings);
+    gamecontroller->hat_first = gamecontroller->axis_first + joystick->naxes + 1;
+
+    for (i = gamecontroller->num_bindings - 1; i >= 0; --i) {
+        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
+        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_BUTTON &&
+            binding->input.button >= 0 && binding->input.button < joystick->nbuttons) {
+            gamecontroller->button_binding[binding->input.button] = binding;
+        }
+    }
+
+    num_axis_bindings = 0;
+    for (i = 0; i < joystick->naxes; ++i) {
+        gamecontroller->axis_first[i] = num_axis_bindings;
+        for (j = 0; j < gamecontroller->num_bindings; ++j) {
+            SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[j];
+            if (binding->inputType == SDL_CONTROLLER_BINDTYPE_AXIS && binding->input.axis.axis == i) {
+                gamecontroller->axis_bindings[num_axis_bindings++] = binding;
+            }
+        }
+    }
+    gamecontroller->axis_first[joystick->naxes] = num_axis_bindings;
+
+    num_hat_bindings = 0;
+    for (i = 0; i < joystick->nhats; ++i) {
+        gamecontroller->hat_first[i] = num_hat_bindings;
+        for (j = 0; j < gamecontroller->num_bindings; ++j) {
+            SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[j];
+            if (binding->inputType == SDL_CONTROLLER_BINDTYPE_HAT && binding->input.hat.hat == i) {
+                gamecontroller->hat_bindings[num_hat_bindings++] = binding;
+            }
+        }
+    }
+    gamecontroller->hat_first[joystick->nhats] = num_hat_bindings;
+
+    gamecontroller->binding_index = block;
+}
+
 /*
  * Make a new button mapping struct
  */
@@ -602,6 +699,7 @@ static void SDL_PrivateLoadButtonMapping(SDL_GameController *gamecontroller, SDL
     SDL_memset(gamecontroller->last_match_axis, 0, gamecontroller->joystick->naxes * sizeof(*gamecontroller->last_match_axis));
 
     SDL_PrivateGameControllerParseControllerConfigString(gamecontroller, pchMapping);
+    SDL_PrivateIndexBindings(gamecontroller);
 
     /* Set the zero point for triggers */
     for (i = 0; i < gamecontroller->num_bindings; ++i) {
@@ -620,19 +718,16 @@ static void SDL_PrivateLoadButtonMapping(SDL_GameController *gamecontroller, SDL
 
 
 /*
- * grab the guid string from a mapping string
+ * grab the guid string from a mapping string. Only the first 32 characters
+ * of a GUID are significant, so a longer one is cut short.
  */
-static char *SDL_PrivateGetControllerGUIDFromMappingString(const char *pMapping)
+static char *SDL_PrivateGetControllerGUIDFromMappingString(const char *pMapping, char *pchGUID, size_t maxlen)
 {
     const char *pFirstComma = SDL_strchr(pMapping, ',');
     if (pFirstComma) {
-        char *pchGUID = SDL_malloc(pFirstComma - pMapping + 1);
-        if (!pchGUID) {
-            SDL_OutOfMemory();
-            return NULL;
-        }
-        SDL_memcpy(pchGUID, pMapping, pFirstComma - pMapping);
-        pchGUID[pFirstComma - pMapping] = '\0';
+        const size_t len = SDL_min((size_t) (pFirstComma - pMapping), maxlen - 1);
+        SDL_memcpy(pchGUID, pMapping, len);
+        pchGUID[len] = '\0';
 
         /* Convert old style GUIDs to the new style in 2.0.5 */
 #if __WIN32__
@@ -686,9 +781,9 @@ static char *SDL_PrivateGetControllerNameFromMappingString(const char *pMapping)
 
 
 /*
- * grab the button mapping string from a mapping string
+ * find the button mapping string in a mapping string
  */
-static char *SDL_PrivateGetControllerMappingFromMappingString(const char *pMapping)
+static const char *SDL_PrivateGetControllerMappingFromMappingString(const char *pMapping)
 {
     const char *pFirstComma, *pSecondComma;
 
@@ -700,7 +795,18 @@ static char *SDL_PrivateGetControllerMappingFromMappingString(const char *pMappi
     if (!pSecondComma)
         return NULL;
 
-    return SDL_strdup(pSecondComma + 1); /* mapping is everything after the 3rd comma */
+    return pSecondComma + 1; /* mapping is everything after the 3rd comma */
+}
+
+/*
+ * Helper function to get the name of a mapping, parsing it on first use
+ */
+static const char *SDL_PrivateGetControllerMappingName(ControllerMapping_t *pControllerMapping)
+{
+    if (!pControllerMapping->name) {
+        pControllerMapping->name = SDL_PrivateGetControllerNameFromMappingString(pControllerMapping->source);
+    }
+    return pControllerMapping->name;
 }
 
 /*
@@ -717,80 +823,89 @@ static void SDL_PrivateGameControllerRefreshMapping(ControllerMapping_t *pContro
             SDL_PushEvent(&event);
 
             /* Not really threadsafe.  Should this lock access within SDL_GameControllerEventWatcher? */
-            SDL_PrivateLoadButtonMapping(gamecontrollerlist, pControllerMapping->guid, pControllerMapping->name, pControllerMapping->mapping);
+            SDL_PrivateLoadButtonMapping(gamecontrollerlist, pControllerMapping->guid, SDL_PrivateGetControllerMappingName(pControllerMapping), pControllerMapping->mapping);
         }
 
         gamecontrollerlist = gamecontrollerlist->next;
     }
 }
 
+/*
+ * Helper function to set the strings of a mapping. Default mappings are
+ * string literals and are used in place; anything else is copied. The name
+ * isn't parsed until somebody asks for it.
+ */
+static int
+SDL_PrivateSetMappingSource(ControllerMapping_t *pControllerMapping, const char *mappingString, SDL_ControllerMappingPriority priority)
+{
+    const SDL_bool builtin = (priority == SDL_CONTROLLER_MAPPING_PRIORITY_DEFAULT);
+    const char *source = builtin ? mappingString : SDL_strdup(mappingString);
+
+    if (!source) {
+        return SDL_OutOfMemory();
+    }
+
+    if (pControllerMapping->free_source) {
+        SDL_free((char *) pControllerMapping->source);
+    }
+    SDL_free(pControllerMapping->name);
+    pControllerMapping->name = NULL;
+    pControllerMapping->source = source;
+    pControllerMapping->free_source = !builtin;
+    pControllerMapping->mapping = SDL_PrivateGetControllerMappingFromMappingString(source);
+    pControllerMapping->priority = priority;
+    return 0;
+}
+
 /*
  * Helper function to add a mapping for a guid
  */
 static ControllerMapping_t *
 SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_ControllerMappingPriority priority)
 {
-    char *pchName;
-    char *pchMapping;
     ControllerMapping_t *pControllerMapping;
+    ControllerMapping_t **bucket;
 
-    pchName = SDL_PrivateGetControllerNameFromMappingString(mappingString);
-    if (!pchName) {
-        SDL_SetError("Couldn't parse name from %s", mappingString);
-        return NULL;
-    }
-
-    pchMapping = SDL_PrivateGetControllerMappingFromMappingString(mappingString);
-    if (!pchMapping) {
-        SDL_free(pchName);
+    /* A mapping needs a name and bindings after the GUID */
+    if (!SDL_PrivateGetControllerMappingFromMappingString(mappingString)) {
         SDL_SetError("Couldn't parse %s", mappingString);
         return NULL;
     }
 
+    bucket = SDL_PrivateGetControllerMappingBucket(&jGUID);
     pControllerMapping = SDL_PrivateGetControllerMappingForGUID(&jGUID);
     if (pControllerMapping) {
         /* Only overwrite the mapping if the priority is the same or higher. */
         if (pControllerMapping->priority <= priority) {
             /* Update existing mapping */
-            SDL_free(pControllerMapping->name);
-            pControllerMapping->name = pchName;
-            SDL_free(pControllerMapping->mapping);
-            pControllerMapping->mapping = pchMapping;
-            pControllerMapping->priority = priority;
+            if (SDL_PrivateSetMappingSource(pControllerMapping, mappingString, priority) < 0) {
+                return NULL;
+            }
             /* refresh open controllers */
             SDL_PrivateGameControllerRefreshMapping(pControllerMapping);
-        } else {
-            SDL_free(pchName);
-            SDL_free(pchMapping);
         }
         *existing = SDL_TRUE;
     } else {
-        pControllerMapping = SDL_malloc(sizeof(*pControllerMapping));
+        pControllerMapping = SDL_calloc(1, sizeof(*pControllerMapping));
         if (!pControllerMapping) {
-            SDL_free(pchName);
-            SDL_free(pchMapping);
             SDL_OutOfMemory();
             return NULL;
         }
+        if (SDL_PrivateSetMappingSource(pControllerMapping, mappingString, priority) < 0) {
+            SDL_free(pControllerMapping);
+            return NULL;
+        }
         pControllerMapping->guid = jGUID;
-        pControllerMapping->name = pchName;
-        pControllerMapping->mapping = pchMapping;
-        pControllerMapping->next = NULL;
-        pControllerMapping->priority = priority;
-
-        if (s_pSupportedControllers) {
-            /* Add the mapping to the end of the list */
-            ControllerMapping_t *pCurrMapping, *pPrevMapping;
-
-            for ( pPrevMapping = s_pSupportedControllers, pCurrMapping = pPrevMapping->next;
-                  pCurrMapping; 
-                  pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next ) {
-                continue;
-            }
-            pPrevMapping->next = pControllerMapping;
+
+        /* Add the mapping to the end of the list, and to its bucket */
+        if (s_pLastSupportedController) {
+            s_pLastSupportedController->next = pControllerMapping;
         } else {
             s_pSupportedControllers = pControllerMapping;
         }
+        s_pLastSupportedController = pControllerMapping;
+        pControllerMapping->hash_next = *bucket;
+        *bucket = pControllerMapping;
         *existing = SDL_FALSE;
     }
     return pControllerMapping;
@@ -920,7 +1035,7 @@ SDL_GameControllerAddMappingsFromRW(SDL_RWops * rw, int freerw)
 static int
 SDL_PrivateGameControllerAddMapping(const char *mappingString, SDL_ControllerMappingPriority priority)
 {
-    char *pchGUID;
+    char pchGUID[33];  /* 32 hex digits, see SDL_JoystickGetGUIDString() */
     SDL_JoystickGUID jGUID;
     SDL_bool is_xinput_mapping = SDL_FALSE;
     SDL_bool is_emscripten_mapping = SDL_FALSE;
@@ -931,8 +1046,7 @@ SDL_PrivateGameControllerAddMapping(const char *mappingString, SDL_ControllerMap
         return SDL_InvalidParamError("mappingString");
     }
 
-    pchGUID = SDL_PrivateGetControllerGUIDFromMappingString(mappingString);
-    if (!pchGUID) {
+    if (!SDL_PrivateGetControllerGUIDFromMappingString(mappingString, pchGUID, sizeof(pchGUID))) {
         return SDL_SetError("Couldn't parse GUID from %s", mappingString);
     }
     if (!SDL_strcasecmp(pchGUID, "xinput")) {
@@ -942,7 +1056,6 @@ SDL_PrivateGameControllerAddMapping(const char *mappingString, SDL_ControllerMap
         is_emscripten_mapping = SDL_TRUE;
     }
     jGUID = SDL_JoystickGetGUIDFromString(pchGUID);
-    SDL_free(pchGUID);
 
     pControllerMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, &existing, priority);
     if (!pControllerMapping) {
@@ -1004,17 +1117,21 @@ SDL_GameControllerMappingForIndex(int mapping_index)
         if (mapping_index == 0) {
             char *pMappingString;
             char pchGUID[33];
+            const char *name = SDL_PrivateGetControllerMappingName(mapping);
             size_t needed;
 
+            if (!name) {
+                return NULL;
+            }
             SDL_JoystickGetGUIDString(mapping->guid, pchGUID, sizeof(pchGUID));
             /* allocate enough memory for GUID + ',' + name + ',' + mapping + \0 */
-            needed = SDL_strlen(pchGUID) + 1 + SDL_strlen(mapping->name) + 1 + SDL_strlen(mapping->mapping) + 1;
+            needed = SDL_strlen(pchGUID) + 1 + SDL_strlen(name) + 1 + SDL_strlen(mapping->mapping) + 1;
             pMappingString = SDL_malloc(needed);
             if (!pMappingString) {
                 SDL_OutOfMemory();
                 return NULL;
             }
-            SDL_snprintf(pMappingString, needed, "%s,%s,%s", pchGUID, mapping->name, mapping->mapping);
+            SDL_snprintf(pMappingString, needed, "%s,%s,%s", pchGUID, name, mapping->mapping);
             return pMappingString;
         }
         --mapping_index;
@@ -1032,16 +1149,20 @@ SDL_GameControllerMappingForGUID(SDL_JoystickGUID guid)
     ControllerMapping_t *mapping = SDL_PrivateGetControllerMappingForGUID(&guid);
     if (mapping) {
         char pchGUID[33];
+        const char *name = SDL_PrivateGetControllerMappingName(mapping);
         size_t needed;
+        if (!name) {
+            return NULL;
+        }
         SDL_JoystickGetGUIDString(guid, pchGUID, sizeof(pchGUID));
         /* allocate enough memory for GUID + ',' + name + ',' + mapping + \0 */
-        needed = SDL_strlen(pchGUID) + 1 + SDL_strlen(mapping->name) + 1 + SDL_strlen(mapping->mapping) + 1;
+        needed = SDL_strlen(pchGUID) + 1 + SDL_strlen(name) + 1 + SDL_strlen(mapping->mapping) + 1;
         pMappingString = SDL_malloc(needed);
         if (!pMappingString) {
             SDL_OutOfMemory();
             return NULL;
         }
-        SDL_snprintf(pMappingString, needed, "%s,%s,%s", pchGUID, mapping->name, mapping->mapping);
+        SDL_snprintf(pMappingString, needed, "%s,%s,%s", pchGUID, name, mapping->mapping);
     }
     return pMappingString;
 }
@@ -1132,7 +1253,7 @@ SDL_GameControllerNameForIndex(int device_index)
 {
     ControllerMapping_t *pSupportedController = SDL_PrivateGetControllerMapping(device_index);
     if (pSupportedController) {
-        return pSupportedController->name;
+        return SDL_PrivateGetControllerMappingName(pSupportedController);
     }
     return NULL;
 }
@@ -1162,7 +1283,7 @@ SDL_GameController *
 SDL_GameControllerOpen(int device_index)
 {
     SDL_GameController *gamecontroller;
-    SDL_GameController *gamecontrollerlist;
+    SDL_GameController **bucket;
     ControllerMapping_t *pSupportedController = NULL;
 
     if ((device_index < 0) || (device_index >= SDL_NumJoysticks())) {
@@ -1172,16 +1293,12 @@ SDL_GameControllerOpen(int device_index)
 
     SDL_LockJoystickList();
 
-    gamecontrollerlist = SDL_gamecontrollers;
     /* If the controller is already open, return it */
-    while (gamecontrollerlist) {
-        if (SDL_SYS_GetInstanceIdOfDeviceIndex(device_index) == gamecontrollerlist->joystick->instance_id) {
-                gamecontroller = gamecontrollerlist;
-                ++gamecontroller->ref_count;
-                SDL_UnlockJoystickList();
-                return (gamecontroller);
-        }
-        gamecontrollerlist = gamecontrollerlist->next;
+    gamecontroller = SDL_PrivateGetGameControllerForInstance(SDL_SYS_GetInstanceIdOfDeviceIndex(device_index));
+    if (gamecontroller) {
+        ++gamecontroller->ref_count;
+        SDL_UnlockJoystickList();
+        return (gamecontroller);
     }
 
     /* Find a controller mapping */
@@ -1229,13 +1346,16 @@ SDL_GameControllerOpen(int device_index)
         }
     }
 
-    SDL_PrivateLoadButtonMapping(gamecontroller, pSupportedController->guid, pSupportedController->name, pSupportedController->mapping);
+    SDL_PrivateLoadButtonMapping(gamecontroller, pSupportedController->guid, SDL_PrivateGetControllerMappingName(pSupportedController), pSupportedController->mapping);
 
     /* Add the controller to list */
     ++gamecontroller->ref_count;
     /* Link the controller in the list */
     gamecontroller->next = SDL_gamecontrollers;
     SDL_gamecontrollers = gamecontroller;
+    bucket = &SDL_gamecontrollerbuckets[(Uint32)gamecontroller->joystick->instance_id % SDL_CONTROLLER_INSTANCE_BUCKETS];
+    gamecontroller->instance_next = *bucket;
+    *bucket = gamecontroller;
 
     SDL_UnlockJoystickList();
 
@@ -1411,16 +1531,9 @@ SDL_GameControllerFromInstanceID(SDL_JoystickID joyid)
     SDL_GameController *gamecontroller;
 
     SDL_LockJoystickList();
-    gamecontroller = SDL_gamecontrollers;
-    while (gamecontroller) {
-        if (gamecontroller->joystick->instance_id == joyid) {
-            SDL_UnlockJoystickList();
-            return gamecontroller;
-        }
-        gamecontroller = gamecontroller->next;
-    }
+    gamecontroller = SDL_PrivateGetGameControllerForInstance(joyid);
     SDL_UnlockJoystickList();
-    return NULL;
+    return gamecontroller;
 }
 
 
@@ -1491,6 +1604,7 @@ void
 SDL_GameControllerClose(SDL_GameController * gamecontroller)
 {
     SDL_GameController *gamecontrollerlist, *gamecontrollerlistprev;
+    SDL_GameController **bucket;
 
     if (!gamecontroller)
         return;
@@ -1503,6 +1617,15 @@ SDL_GameControllerClose(SDL_GameController * gamecontroller)
         return;
     }
 
+    bucket = &SDL_gamecontrollerbuckets[(Uint32)gamecontroller->joystick->instance_id % SDL_CONTROLLER_INSTANCE_BUCKETS];
+    while (*bucket) {
+        if (*bucket == gamecontroller) {
+            *bucket = gamecontroller->instance_next;
+            break;
+        }
+        bucket = &(*bucket)->instance_next;
+    }
+
     SDL_JoystickClose(gamecontroller->joystick);
 
     gamecontrollerlist = SDL_gamecontrollers;
@@ -1522,6 +1645,7 @@ SDL_GameControllerClose(SDL_GameController * gamecontroller)
     }
 
     SDL_free(gamecontroller->bindings);
+    SDL_free(gamecontroller->binding_index);
     SDL_free(gamecontroller->last_match_axis);
     SDL_free(gamecontroller->last_hat_mask);
     SDL_free(gamecontroller);
@@ -1549,9 +1673,13 @@ SDL_GameControllerQuit(void)
         pControllerMap = s_pSupportedControllers;
         s_pSupportedControllers = s_pSupportedControllers->next;
         SDL_free(pControllerMap->name);
-        SDL_free(pControllerMap->mapping);
+        if (pControllerMap->free_source) {
+            SDL_free((char *) pControllerMap->source);
+        }
         SDL_free(pControllerMap);
     }
+    s_pLastSupportedController = NULL;
+    SDL_zero(s_pMappingBuckets);
 
     SDL_DelEventWatch(SDL_GameControllerEventWatcher, NULL);
 
@@ -26,8 +26,10 @@
 #include "SDL_hints.h"
 #include "SDL_log.h"
 #include "SDL_render.h"
+#include "SDL_timer.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
+#include "../video/SDL_sysvideo.h"
 
 
 #define SDL_WINDOWRENDERDATA    "_SDL_WindowRenderData"
@@ -44,6 +46,12 @@
         return retval; \
     }
 
+#define CHECK_READBACK_MAGIC(readback, retval) \
+    if (!readback || readback->magic != &readback_magic) { \
+        SDL_SetError("Invalid readback"); \
+        return retval; \
+    }
+
 
 #if !SDL_RENDER_DISABLED
 static const SDL_RenderDriver *render_drivers[] = {
@@ -74,9 +82,131 @@ static const SDL_RenderDriver *render_drivers[] = {
 
 static char renderer_magic;
 static char texture_magic;
+static char readback_magic;
 
 static int UpdateLogicalSize(SDL_Renderer *renderer);
 
+/* The names of the calls in Chrome traces, in SDL_RenderCall order */
+static const char *SDL_render_call_names[SDL_RENDER_CALL_COUNT] = {
+    "Clear", "DrawPoints", "DrawLines", "FillRects", "Copy", "CopyEx",
+    "Geometry", "UpdateTexture", "SetRenderTarget", "ReadPixels", "Present"
+};
+
+static Uint64
+SDL_ProfileTicksToNS(Uint64 ticks)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+
+    return (ticks / freq) * 1000000000 + ((ticks % freq) * 1000000000) / freq;
+}
+
+static double
+SDL_ProfileTraceTime(SDL_Renderer * renderer, Uint64 ticks)
+{
+    return (double) SDL_ProfileTicksToNS(ticks - renderer->profiler.trace_start) / 1000.0;
+}
+
+static void
+SDL_ProfileTraceEvent(SDL_Renderer * renderer, const char *event)
+{
+    SDL_RenderProfiler *profiler = &renderer->profiler;
+
+    if (!profiler->trace_empty) {
+        SDL_RWwrite(profiler->trace, ",\n", 2, 1);
+    }
+    SDL_RWwrite(profiler->trace, event, SDL_strlen(event), 1);
+    profiler->trace_empty = SDL_FALSE;
+}
+
+/* Returns the start of a driver call to pass to SDL_ProfileEnd(), or 0 if
+   the renderer isn't being profiled */
+static Uint64
+SDL_ProfileBegin(SDL_Renderer * renderer)
+{
+    return renderer->profiler.enabled ? SDL_GetPerformanceCounter() : 0;
+}
+
+static void
+SDL_ProfileEnd(SDL_Renderer * renderer, SDL_RenderCall call, Uint64 start)
+{
+    SDL_RenderProfiler *profiler = &renderer->profiler;
+    Uint64 end;
+
+    if (!start || !profiler->enabled) {
+        return;
+    }
+    end = SDL_GetPerformanceCounter();
+    ++profiler->frame.calls[call].calls;
+    profiler->frame.calls[call].ns += SDL_ProfileTicksToNS(end - start);
+
+    if (profiler->trace) {
+        char event[192];
+
+        SDL_snprintf(event, sizeof(event),
+                     "{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                     SDL_render_call_names[call], SDL_ProfileTraceTime(renderer, start),
+                     (double) SDL_ProfileTicksToNS(end - start) / 1000.0);
+        SDL_ProfileTraceEvent(renderer, event);
+    }
+}
+
+static void
+SDL_ProfileUpload(SDL_Renderer * renderer, Uint64 start, Uint64 bytes)
+{
+    if (start && renderer->profiler.enabled) {
+        renderer->profiler.frame.bytes_uploaded += bytes;
+    }
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_UPDATE_TEXTURE, start);
+}
+
+/* Called after each present: the frame being drawn becomes the last one */
+static void
+SDL_ProfileEndFrame(SDL_Renderer * renderer)
+{
+    SDL_RenderProfiler *profiler = &renderer->profiler;
+    SDL_RenderFrameProfile *frame = &profiler->frame;
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    if (!profiler->enabled) {
+        return;
+    }
+    if (renderer->window) {
+        frame->gpu_wait_ns = SDL_ProfileTicksToNS(renderer->window->swap_gpu_wait);
+        frame->vsync_wait_ns = SDL_ProfileTicksToNS(renderer->window->swap_vsync_wait);
+    }
+    frame->frame = profiler->last.frame + 1;
+    frame->frame_ns = SDL_ProfileTicksToNS(now - profiler->frame_start);
+
+    if (profiler->trace) {
+        char event[384];
+
+        SDL_snprintf(event, sizeof(event),
+                     "{\"name\":\"Frame\",\"cat\":\"render\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+                     "\"args\":{\"blend_changes\":%u,\"program_changes\":%u,\"texture_binds\":%u,"
+                     "\"bytes_uploaded\":%.0f,\"gpu_wait_us\":%.3f,\"vsync_wait_us\":%.3f}}",
+                     SDL_ProfileTraceTime(renderer, now),
+                     (unsigned int) frame->blend_changes, (unsigned int) frame->program_changes,
+                     (unsigned int) frame->texture_binds, (double) frame->bytes_uploaded,
+                     (double) frame->gpu_wait_ns / 1000.0, (double) frame->vsync_wait_ns / 1000.0);
+        SDL_ProfileTraceEvent(renderer, event);
+    }
+
+    profiler->last = *frame;
+    SDL_zerop(frame);
+    profiler->frame_start = now;
+}
+
+static void
+SDL_ProfileFromHint(SDL_Renderer * renderer)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_PROFILE);
+
+    if (!hint || !*hint || SDL_strcmp(hint, "0") == 0) {
+        return;
+    }
+    SDL_RenderSetProfiling(renderer, SDL_TRUE, (SDL_strcmp(hint, "1") == 0) ? NULL : hint);
+}
+
 int
 SDL_GetNumRenderDrivers(void)
 {
@@ -302,6 +432,12 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
 
         SDL_AddEventWatch(SDL_RendererEventWatch, renderer);
 
+        SDL_ProfileFromHint(renderer);
+
+        if (SDL_GetHintBoolean(SDL_HINT_RENDER_WARMUP, SDL_FALSE)) {
+            SDL_RenderWarmUp(renderer);
+        }
+
         SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
                     "Created renderer: %s", renderer->info.name);
     }
@@ -326,6 +462,8 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         renderer->scale.y = 1.0f;
 
         SDL_RenderSetViewport(renderer, NULL);
+
+        SDL_ProfileFromHint(renderer);
     }
     return renderer;
 #else
@@ -406,6 +544,293 @@ GetClosestSupportedFormat(SDL_Renderer * renderer, Uint32 format)
     return renderer->info.texture_formats[0];
 }
 
+static SDL_Texture *
+SDL_AllocTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h)
+{
+    SDL_Texture *texture;
+
+    texture = (SDL_Texture *) SDL_calloc(1, sizeof(*texture));
+    if (!texture) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    texture->magic = &texture_magic;
+    texture->format = format;
+    texture->access = access;
+    texture->w = w;
+    texture->h = h;
+    texture->r = 255;
+    texture->g = 255;
+    texture->b = 255;
+    texture->a = 255;
+    texture->renderer = renderer;
+    texture->next = renderer->textures;
+    if (renderer->textures) {
+        renderer->textures->prev = texture;
+    }
+    renderer->textures = texture;
+    return texture;
+}
+
+/* The atlas packs small static textures into shared pages. Each page keeps a
+   list of free rectangles: a texture takes the one it fits best, and what's
+   left of it is cut in two along the shorter side (a guillotine packer).
+   Freed rectangles are merged back with neighbours they share an edge with.
+   A page is destroyed as soon as its last texture is.
+
+   Each texture is surrounded by a one pixel gutter holding copies of its
+   edges, so filtering at its edges doesn't blend in its neighbours.
+ */
+#define SDL_ATLAS_PAGE_SIZE     1024
+#define SDL_ATLAS_GUTTER        1
+
+static void
+SDL_GetAtlasPageSize(SDL_Renderer * renderer, int *w, int *h)
+{
+    *w = SDL_ATLAS_PAGE_SIZE;
+    *h = SDL_ATLAS_PAGE_SIZE;
+    if (renderer->info.max_texture_width && *w > renderer->info.max_texture_width) {
+        *w = renderer->info.max_texture_width;
+    }
+    if (renderer->info.max_texture_height && *h > renderer->info.max_texture_height) {
+        *h = renderer->info.max_texture_height;
+    }
+}
+
+static int
+SDL_AddAtlasFreeRect(SDL_AtlasPage * page, const SDL_Rect * rect)
+{
+    if (page->num_free_rects == page->max_free_rects) {
+        const int max_free_rects = page->max_free_rects ? page->max_free_rects * 2 : 16;
+        SDL_Rect *free_rects = (SDL_Rect *) SDL_realloc(page->free_rects, max_free_rects * sizeof(*free_rects));
+        if (!free_rects) {
+            return SDL_OutOfMemory();
+        }
+        page->free_rects = free_rects;
+        page->max_free_rects = max_free_rects;
+    }
+    page->free_rects[page->num_free_rects++] = *rect;
+    return 0;
+}
+
+static void
+SDL_RemoveAtlasFreeRect(SDL_AtlasPage * page, int index)
+{
+    page->free_rects[index] = page->free_rects[--page->num_free_rects];
+}
+
+static SDL_bool
+SDL_AllocAtlasRect(SDL_AtlasPage * page, int w, int h, SDL_Rect * rect)
+{
+    SDL_Rect free_rect, right, below;
+    int best = -1, best_fit = 0;
+    int i;
+
+    /* Take the free area that leaves the least over on its shorter side */
+    for (i = 0; i < page->num_free_rects; ++i) {
+        const SDL_Rect *r = &page->free_rects[i];
+        if (r->w >= w && r->h >= h) {
+            const int fit = SDL_min(r->w - w, r->h - h);
+            if (best < 0 || fit < best_fit) {
+                best = i;
+                best_fit = fit;
+                if (fit == 0) {
+                    break;
+                }
+            }
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+
+    /* Splitting may add a free area, so make room for it first */
+    if (SDL_AddAtlasFreeRect(page, &page->free_rects[best]) < 0) {
+        return SDL_FALSE;
+    }
+    --page->num_free_rects;
+
+    free_rect = page->free_rects[best];
+    SDL_RemoveAtlasFreeRect(page, best);
+
+    rect->x = free_rect.x;
+    rect->y = free_rect.y;
+    rect->w = w;
+    rect->h = h;
+
+    /* Cut across the shorter leftover, keeping the other piece large */
+    right.x = free_rect.x + w;
+    right.y = free_rect.y;
+    right.w = free_rect.w - w;
+    below.x = free_rect.x;
+    below.y = free_rect.y + h;
+    below.h = free_rect.h - h;
+    if (right.w < below.h) {
+        right.h = h;
+        below.w = free_rect.w;
+    } else {
+        right.h = free_rect.h;
+        below.w = w;
+    }
+    if (right.w > 0 && right.h > 0) {
+        SDL_AddAtlasFreeRect(page, &right);
+    }
+    if (below.w > 0 && below.h > 0) {
+        SDL_AddAtlasFreeRect(page, &below);
+    }
+    return SDL_TRUE;
+}
+
+static void
+SDL_FreeAtlasRect(SDL_AtlasPage * page, const SDL_Rect * rect)
+{
+    SDL_Rect merged = *rect;
+    int i = 0;
+
+    while (i < page->num_free_rects) {
+        const SDL_Rect *r = &page->free_rects[i];
+        if (r->x == merged.x && r->w == merged.w &&
+            (r->y + r->h == merged.y || merged.y + merged.h == r->y)) {
+            merged.y = SDL_min(merged.y, r->y);
+            merged.h += r->h;
+        } else if (r->y == merged.y && r->h == merged.h &&
+                   (r->x + r->w == merged.x || merged.x + merged.w == r->x)) {
+            merged.x = SDL_min(merged.x, r->x);
+            merged.w += r->w;
+        } else {
+            ++i;
+            continue;
+        }
+        /* The larger area may now line up with ones already passed */
+        SDL_RemoveAtlasFreeRect(page, i);
+        i = 0;
+    }
+
+    /* If there's no memory for it, the area stays unused until the page goes */
+    SDL_AddAtlasFreeRect(page, &merged);
+}
+
+static SDL_AtlasPage *
+SDL_CreateAtlasPage(SDL_Renderer * renderer, Uint32 format)
+{
+    SDL_AtlasPage *page;
+    SDL_Rect rect;
+    int access;
+
+    page = (SDL_AtlasPage *) SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* Pages are drawn into when they're compacted */
+    access = SDL_RenderTargetSupported(renderer) ? SDL_TEXTUREACCESS_TARGET : SDL_TEXTUREACCESS_STATIC;
+
+    rect.x = 0;
+    rect.y = 0;
+    SDL_GetAtlasPageSize(renderer, &rect.w, &rect.h);
+    page->texture = SDL_CreateTexture(renderer, format, access, rect.w, rect.h);
+    if (!page->texture || SDL_AddAtlasFreeRect(page, &rect) < 0) {
+        if (page->texture) {
+            SDL_DestroyTexture(page->texture);
+        }
+        SDL_free(page);
+        return NULL;
+    }
+
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    return page;
+}
+
+static void
+SDL_DestroyAtlasPage(SDL_Renderer * renderer, SDL_AtlasPage * page)
+{
+    SDL_AtlasPage *prev = NULL, *curr;
+
+    for (curr = renderer->atlas_pages; curr; prev = curr, curr = curr->next) {
+        if (curr == page) {
+            if (prev) {
+                prev->next = page->next;
+            } else {
+                renderer->atlas_pages = page->next;
+            }
+            break;
+        }
+    }
+    SDL_DestroyTexture(page->texture);
+    SDL_free(page->free_rects);
+    SDL_free(page);
+}
+
+/* Find room for a texture of the given size and format, adding a page if
+   needed. The rect returned includes the gutter. */
+static SDL_AtlasPage *
+SDL_AllocAtlasTexture(SDL_Renderer * renderer, Uint32 format, int w, int h, SDL_Rect * rect)
+{
+    SDL_AtlasPage *page;
+
+    w += 2 * SDL_ATLAS_GUTTER;
+    h += 2 * SDL_ATLAS_GUTTER;
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        if (page->texture->format == format && SDL_AllocAtlasRect(page, w, h, rect)) {
+            return page;
+        }
+    }
+
+    page = SDL_CreateAtlasPage(renderer, format);
+    if (!page) {
+        return NULL;
+    }
+    if (!SDL_AllocAtlasRect(page, w, h, rect)) {
+        SDL_DestroyAtlasPage(renderer, page);
+        return NULL;
+    }
+    return page;
+}
+
+static void
+SDL_AddAtlasTexture(SDL_Texture * texture, SDL_AtlasPage * page, const SDL_Rect * rect)
+{
+    texture->atlas = page;
+    texture->atlas_rect.x = rect->x + SDL_ATLAS_GUTTER;
+    texture->atlas_rect.y = rect->y + SDL_ATLAS_GUTTER;
+    texture->atlas_rect.w = texture->w;
+    texture->atlas_rect.h = texture->h;
+    ++page->num_textures;
+    page->used_area += texture->w * texture->h;
+}
+
+/* Give back a rect from SDL_AllocAtlasTexture(), freeing the page if it's
+   no longer used */
+static void
+SDL_ReleaseAtlasRect(SDL_Renderer * renderer, SDL_AtlasPage * page, const SDL_Rect * rect)
+{
+    if (page->num_textures == 0) {
+        SDL_DestroyAtlasPage(renderer, page);
+    } else {
+        SDL_FreeAtlasRect(page, rect);
+    }
+}
+
+static void
+SDL_RemoveAtlasTexture(SDL_Texture * texture)
+{
+    SDL_AtlasPage *page = texture->atlas;
+    SDL_Rect rect;
+
+    rect.x = texture->atlas_rect.x - SDL_ATLAS_GUTTER;
+    rect.y = texture->atlas_rect.y - SDL_ATLAS_GUTTER;
+    rect.w = texture->atlas_rect.w + 2 * SDL_ATLAS_GUTTER;
+    rect.h = texture->atlas_rect.h + 2 * SDL_ATLAS_GUTTER;
+
+    texture->atlas = NULL;
+    page->used_area -= texture->w * texture->h;
+    --page->num_textures;
+    SDL_ReleaseAtlasRect(texture->renderer, page, &rect);
+}
+
 SDL_Texture *
 SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h)
 {
@@ -433,26 +858,10 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
         SDL_SetError("Texture dimensions are limited to %dx%d", renderer->info.max_texture_width, renderer->info.max_texture_height);
         return NULL;
     }
-    texture = (SDL_Texture *) SDL_calloc(1, sizeof(*texture));
+    texture = SDL_AllocTexture(renderer, format, access, w, h);
     if (!texture) {
-        SDL_OutOfMemory();
         return NULL;
     }
-    texture->magic = &texture_magic;
-    texture->format = format;
-    texture->access = access;
-    texture->w = w;
-    texture->h = h;
-    texture->r = 255;
-    texture->g = 255;
-    texture->b = 255;
-    texture->a = 255;
-    texture->renderer = renderer;
-    texture->next = renderer->textures;
-    if (renderer->textures) {
-        renderer->textures->prev = texture;
-    }
-    renderer->textures = texture;
 
     if (IsSupportedFormat(renderer, format)) {
         if (renderer->CreateTexture(renderer, texture) < 0) {
@@ -501,7 +910,41 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
 }
 
 SDL_Texture *
-SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
+SDL_CreateAtlasTexture(SDL_Renderer * renderer, Uint32 format, int w, int h)
+{
+    SDL_AtlasPage *page;
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    int page_w, page_h;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = renderer->info.texture_formats[0];
+    }
+
+    /* Only small textures the renderer can draw directly go in the atlas */
+    SDL_GetAtlasPageSize(renderer, &page_w, &page_h);
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || !IsSupportedFormat(renderer, format) ||
+        w <= 0 || h <= 0 || w > page_w / 4 || h > page_h / 4) {
+        return SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, w, h);
+    }
+
+    page = SDL_AllocAtlasTexture(renderer, format, w, h, &rect);
+    if (!page) {
+        return NULL;
+    }
+    texture = SDL_AllocTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!texture) {
+        SDL_ReleaseAtlasRect(renderer, page, &rect);
+        return NULL;
+    }
+    SDL_AddAtlasTexture(texture, page, &rect);
+    return texture;
+}
+
+static SDL_Texture *
+SDL_CreateTextureFromSurfaceInternal(SDL_Renderer * renderer, SDL_Surface * surface, SDL_bool atlas)
 {
     const SDL_PixelFormat *fmt;
     SDL_bool needAlpha;
@@ -532,8 +975,12 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
         }
     }
 
-    texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC,
-                                surface->w, surface->h);
+    if (atlas) {
+        texture = SDL_CreateAtlasTexture(renderer, format, surface->w, surface->h);
+    } else {
+        texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC,
+                                    surface->w, surface->h);
+    }
     if (!texture) {
         return NULL;
     }
@@ -588,6 +1035,18 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
     return texture;
 }
 
+SDL_Texture *
+SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
+{
+    return SDL_CreateTextureFromSurfaceInternal(renderer, surface, SDL_FALSE);
+}
+
+SDL_Texture *
+SDL_CreateAtlasTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
+{
+    return SDL_CreateTextureFromSurfaceInternal(renderer, surface, SDL_TRUE);
+}
+
 int
 SDL_QueryTexture(SDL_Texture * texture, Uint32 * format, int *access,
                  int *w, int *h)
@@ -627,6 +1086,8 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     texture->b = b;
     if (texture->native) {
         return SDL_SetTextureColorMod(texture->native, r, g, b);
+    } else if (texture->atlas) {
+        return 0;   /* The page is set up when the texture is drawn */
     } else if (renderer->SetTextureColorMod) {
         return renderer->SetTextureColorMod(renderer, texture);
     } else {
@@ -668,6 +1129,8 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
     texture->a = alpha;
     if (texture->native) {
         return SDL_SetTextureAlphaMod(texture->native, alpha);
+    } else if (texture->atlas) {
+        return 0;   /* The page is set up when the texture is drawn */
     } else if (renderer->SetTextureAlphaMod) {
         return renderer->SetTextureAlphaMod(renderer, texture);
     } else {
@@ -697,6 +1160,8 @@ SDL_SetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode blendMode)
     texture->blendMode = blendMode;
     if (texture->native) {
         return SDL_SetTextureBlendMode(texture->native, blendMode);
+    } else if (texture->atlas) {
+        return 0;   /* The page is set up when the texture is drawn */
     } else if (renderer->SetTextureBlendMode) {
         return renderer->SetTextureBlendMode(renderer, texture);
     } else {
@@ -802,6 +1267,88 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
     return 0;
 }
 
+static int
+SDL_UpdateTextureAtlas(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch)
+{
+    SDL_Texture *page = texture->atlas->texture;
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    const Uint8 *first = (const Uint8 *) pixels;
+    const Uint8 *last_row, *last_col, *last;
+    SDL_Rect full_rect, real_rect, edge;
+    SDL_bool top, bottom, left, right;
+
+    /* Keep the update off the neighbouring textures */
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = texture->w;
+    full_rect.h = texture->h;
+    if (!SDL_IntersectRect(rect, &full_rect, &real_rect)) {
+        return 0;
+    }
+    first += (real_rect.y - rect->y) * pitch + (real_rect.x - rect->x) * bpp;
+    last_row = first + (real_rect.h - 1) * pitch;
+    last_col = first + (real_rect.w - 1) * bpp;
+    last = last_row + (real_rect.w - 1) * bpp;
+
+    top = (real_rect.y == 0);
+    bottom = (real_rect.y + real_rect.h == texture->h);
+    left = (real_rect.x == 0);
+    right = (real_rect.x + real_rect.w == texture->w);
+
+    real_rect.x += texture->atlas_rect.x;
+    real_rect.y += texture->atlas_rect.y;
+    if (SDL_UpdateTexture(page, &real_rect, first, pitch) < 0) {
+        return -1;
+    }
+
+    /* Repeat the edges the update touched into the gutter */
+    edge.w = real_rect.w;
+    edge.h = 1;
+    edge.x = real_rect.x;
+    if (top) {
+        edge.y = real_rect.y - 1;
+        SDL_UpdateTexture(page, &edge, first, pitch);
+    }
+    if (bottom) {
+        edge.y = real_rect.y + real_rect.h;
+        SDL_UpdateTexture(page, &edge, last_row, pitch);
+    }
+    edge.w = 1;
+    edge.h = real_rect.h;
+    edge.y = real_rect.y;
+    if (left) {
+        edge.x = real_rect.x - 1;
+        SDL_UpdateTexture(page, &edge, first, pitch);
+    }
+    if (right) {
+        edge.x = real_rect.x + real_rect.w;
+        SDL_UpdateTexture(page, &edge, last_col, pitch);
+    }
+    edge.h = 1;
+    if (top && left) {
+        edge.x = real_rect.x - 1;
+        edge.y = real_rect.y - 1;
+        SDL_UpdateTexture(page, &edge, first, pitch);
+    }
+    if (top && right) {
+        edge.x = real_rect.x + real_rect.w;
+        edge.y = real_rect.y - 1;
+        SDL_UpdateTexture(page, &edge, last_col, pitch);
+    }
+    if (bottom && left) {
+        edge.x = real_rect.x - 1;
+        edge.y = real_rect.y + real_rect.h;
+        SDL_UpdateTexture(page, &edge, last_row, pitch);
+    }
+    if (bottom && right) {
+        edge.x = real_rect.x + real_rect.w;
+        edge.y = real_rect.y + real_rect.h;
+        SDL_UpdateTexture(page, &edge, last, pitch);
+    }
+    return 0;
+}
+
 int
 SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
                   const void *pixels, int pitch)
@@ -832,9 +1379,17 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
+    } else if (texture->atlas) {
+        return SDL_UpdateTextureAtlas(texture, rect, pixels, pitch);
     } else {
+        Uint64 start;
+        int status;
+
         renderer = texture->renderer;
-        return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
+        start = SDL_ProfileBegin(renderer);
+        status = renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
+        SDL_ProfileUpload(renderer, start, (Uint64) rect->h * rect->w * SDL_BYTESPERPIXEL(texture->format));
+        return status;
     }
 }
 
@@ -943,7 +1498,10 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         renderer = texture->renderer;
         SDL_assert(renderer->UpdateTextureYUV);
         if (renderer->UpdateTextureYUV) {
-            return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+            const Uint64 start = SDL_ProfileBegin(renderer);
+            const int status = renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+            SDL_ProfileUpload(renderer, start, (Uint64) rect->h * rect->w + 2 * ((rect->h + 1) / 2) * ((rect->w + 1) / 2));
+            return status;
         } else {
             return SDL_Unsupported();
         }
@@ -995,6 +1553,8 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
     } else if (texture->native) {
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
+        /* Kept for the profiler, which counts what the unlock uploads */
+        texture->locked_rect = *rect;
         renderer = texture->renderer;
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
@@ -1057,8 +1617,13 @@ SDL_UnlockTexture(SDL_Texture * texture)
     } else if (texture->native) {
         SDL_UnlockTextureNative(texture);
     } else {
+        const SDL_Rect *rect = &texture->locked_rect;
+        Uint64 start;
+
         renderer = texture->renderer;
+        start = SDL_ProfileBegin(renderer);
         renderer->UnlockTexture(renderer, texture);
+        SDL_ProfileUpload(renderer, start, (Uint64) rect->h * rect->w * SDL_BYTESPERPIXEL(texture->format));
     }
 }
 
@@ -1074,6 +1639,9 @@ SDL_RenderTargetSupported(SDL_Renderer *renderer)
 int
 SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    Uint64 start;
+    int status;
+
     if (!SDL_RenderTargetSupported(renderer)) {
         return SDL_Unsupported();
     }
@@ -1108,7 +1676,10 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
     }
     renderer->target = texture;
 
-    if (renderer->SetRenderTarget(renderer, texture) < 0) {
+    start = SDL_ProfileBegin(renderer);
+    status = renderer->SetRenderTarget(renderer, texture);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_SET_TARGET, start);
+    if (status < 0) {
         return -1;
     }
 
@@ -1410,13 +1981,19 @@ SDL_GetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode *blendMode)
 int
 SDL_RenderClear(SDL_Renderer * renderer)
 {
+    Uint64 start;
+    int status;
+
     CHECK_RENDERER_MAGIC(renderer, -1);
 
     /* Don't draw while we're hidden */
     if (renderer->hidden) {
         return 0;
     }
-    return renderer->RenderClear(renderer);
+    start = SDL_ProfileBegin(renderer);
+    status = renderer->RenderClear(renderer);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_CLEAR, start);
+    return status;
 }
 
 int
@@ -1434,6 +2011,7 @@ RenderDrawPointsWithRects(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
 {
     SDL_FRect *frects;
+    Uint64 start;
     int i;
     int status;
 
@@ -1448,7 +2026,9 @@ RenderDrawPointsWithRects(SDL_Renderer * renderer,
         frects[i].h = renderer->scale.y;
     }
 
+    start = SDL_ProfileBegin(renderer);
     status = renderer->RenderFillRects(renderer, frects, count);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_DRAW_POINTS, start);
 
     SDL_stack_free(frects);
 
@@ -1460,6 +2040,7 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
 {
     SDL_FPoint *fpoints;
+    Uint64 start;
     int i;
     int status;
 
@@ -1490,7 +2071,9 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
+    start = SDL_ProfileBegin(renderer);
     status = renderer->RenderDrawPoints(renderer, fpoints, count);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_DRAW_POINTS, start);
 
     SDL_stack_free(fpoints);
 
@@ -1516,6 +2099,7 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
     SDL_FRect *frect;
     SDL_FRect *frects;
     SDL_FPoint fpoints[2];
+    Uint64 start;
     int i, nrects;
     int status;
 
@@ -1524,6 +2108,7 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
         return SDL_OutOfMemory();
     }
 
+    start = SDL_ProfileBegin(renderer);
     status = 0;
     nrects = 0;
     for (i = 0; i < count-1; ++i) {
@@ -1556,6 +2141,7 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
     }
 
     status += renderer->RenderFillRects(renderer, frects, nrects);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_DRAW_LINES, start);
 
     SDL_stack_free(frects);
 
@@ -1570,6 +2156,7 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
                     const SDL_Point * points, int count)
 {
     SDL_FPoint *fpoints;
+    Uint64 start;
     int i;
     int status;
 
@@ -1600,7 +2187,9 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
+    start = SDL_ProfileBegin(renderer);
     status = renderer->RenderDrawLines(renderer, fpoints, count);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_DRAW_LINES, start);
 
     SDL_stack_free(fpoints);
 
@@ -1686,6 +2275,7 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
                     const SDL_Rect * rects, int count)
 {
     SDL_FRect *frects;
+    Uint64 start;
     int i;
     int status;
 
@@ -1714,13 +2304,36 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         frects[i].h = rects[i].h * renderer->scale.y;
     }
 
+    start = SDL_ProfileBegin(renderer);
     status = renderer->RenderFillRects(renderer, frects, count);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_FILL_RECTS, start);
 
     SDL_stack_free(frects);
 
     return status;
 }
 
+/* Set up the page a texture in the atlas is on to draw it, and move the
+   source rect to where it is on the page */
+static SDL_Texture *
+SDL_PrepareAtlasCopy(SDL_Texture * texture, SDL_Rect * srcrect)
+{
+    SDL_Texture *page = texture->atlas->texture;
+
+    if (page->r != texture->r || page->g != texture->g || page->b != texture->b) {
+        SDL_SetTextureColorMod(page, texture->r, texture->g, texture->b);
+    }
+    if (page->a != texture->a) {
+        SDL_SetTextureAlphaMod(page, texture->a);
+    }
+    if (page->blendMode != texture->blendMode) {
+        SDL_SetTextureBlendMode(page, texture->blendMode);
+    }
+    srcrect->x += texture->atlas_rect.x;
+    srcrect->y += texture->atlas_rect.y;
+    return page;
+}
+
 int
 SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect)
@@ -1728,6 +2341,8 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     SDL_Rect real_srcrect = { 0, 0, 0, 0 };
     SDL_Rect real_dstrect = { 0, 0, 0, 0 };
     SDL_FRect frect;
+    Uint64 start;
+    int status;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
     CHECK_TEXTURE_MAGIC(texture, -1);
@@ -1763,6 +2378,8 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = SDL_PrepareAtlasCopy(texture, &real_srcrect);
     }
 
     frect.x = real_dstrect.x * renderer->scale.x;
@@ -1770,7 +2387,10 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     frect.w = real_dstrect.w * renderer->scale.x;
     frect.h = real_dstrect.h * renderer->scale.y;
 
-    return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
+    start = SDL_ProfileBegin(renderer);
+    status = renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_COPY, start);
+    return status;
 }
 
 
@@ -1784,6 +2404,8 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     SDL_Point real_center;
     SDL_FRect frect;
     SDL_FPoint fcenter;
+    Uint64 start;
+    int status;
 
     if (flip == SDL_FLIP_NONE && (int)(angle/360) == angle/360) { /* fast path when we don't need rotation or flipping */
         return SDL_RenderCopy(renderer, texture, srcrect, dstrect);
@@ -1825,6 +2447,8 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = SDL_PrepareAtlasCopy(texture, &real_srcrect);
     }
 
     if (center) {
@@ -1842,7 +2466,251 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     fcenter.x = real_center.x * renderer->scale.x;
     fcenter.y = real_center.y * renderer->scale.y;
 
-    return renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
+    start = SDL_ProfileBegin(renderer);
+    status = renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_COPY_EX, start);
+    return status;
+}
+
+int
+SDL_GetRenderAtlasStats(SDL_Renderer * renderer, SDL_RenderAtlasStats * stats)
+{
+    SDL_AtlasPage *page;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+    SDL_GetAtlasPageSize(renderer, &stats->page_w, &stats->page_h);
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        ++stats->pages;
+        stats->textures += page->num_textures;
+        stats->used_area += page->used_area;
+        stats->total_area += (Uint64) page->texture->w * page->texture->h;
+        stats->free_rects += page->num_free_rects;
+    }
+    return 0;
+}
+
+static int SDLCALL
+SDL_CompareAtlasTextures(const void *a, const void *b)
+{
+    const SDL_Texture *A = *(const SDL_Texture **) a;
+    const SDL_Texture *B = *(const SDL_Texture **) b;
+
+    /* Tallest first, then widest, packs the rows of a page tightest */
+    if (A->h != B->h) {
+        return B->h - A->h;
+    }
+    return B->w - A->w;
+}
+
+int
+SDL_CompactRenderAtlas(SDL_Renderer * renderer)
+{
+    SDL_AtlasPage *old_pages, *page, *next;
+    SDL_Texture *texture, *target;
+    SDL_Texture **textures;
+    int count = 0, i;
+    int status = 0;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->atlas_pages) {
+        return 0;
+    }
+    if (renderer->atlas_pages->texture->access != SDL_TEXTUREACCESS_TARGET) {
+        return SDL_Unsupported();
+    }
+    if (renderer->hidden) {
+        return SDL_SetError("Can't compact the atlas while the renderer is hidden");
+    }
+
+    for (texture = renderer->textures; texture; texture = texture->next) {
+        if (texture->atlas) {
+            ++count;
+        }
+    }
+    textures = (SDL_Texture **) SDL_malloc(count * sizeof(*textures));
+    if (!textures) {
+        return SDL_OutOfMemory();
+    }
+    count = 0;
+    for (texture = renderer->textures; texture; texture = texture->next) {
+        if (texture->atlas) {
+            textures[count++] = texture;
+        }
+    }
+    SDL_qsort(textures, count, sizeof(*textures), SDL_CompareAtlasTextures);
+
+    /* Pack the textures into new pages, copying them over with their gutters */
+    old_pages = renderer->atlas_pages;
+    renderer->atlas_pages = NULL;
+    target = renderer->target;
+    for (i = 0; i < count; ++i) {
+        SDL_AtlasPage *old_page;
+        SDL_Rect srcrect, dstrect;
+
+        texture = textures[i];
+        old_page = texture->atlas;
+        page = SDL_AllocAtlasTexture(renderer, texture->format, texture->w, texture->h, &dstrect);
+        if (!page) {
+            status = -1;
+            break;
+        }
+
+        srcrect.x = texture->atlas_rect.x - SDL_ATLAS_GUTTER;
+        srcrect.y = texture->atlas_rect.y - SDL_ATLAS_GUTTER;
+        srcrect.w = dstrect.w;
+        srcrect.h = dstrect.h;
+        SDL_SetTextureColorMod(old_page->texture, 255, 255, 255);
+        SDL_SetTextureAlphaMod(old_page->texture, 255);
+        SDL_SetTextureBlendMode(old_page->texture, SDL_BLENDMODE_NONE);
+        if (SDL_SetRenderTarget(renderer, page->texture) < 0 ||
+            SDL_RenderCopy(renderer, old_page->texture, &srcrect, &dstrect) < 0) {
+            SDL_ReleaseAtlasRect(renderer, page, &dstrect);
+            status = -1;
+            break;
+        }
+
+        /* The old page goes once it's empty, so its space isn't freed */
+        --old_page->num_textures;
+        old_page->used_area -= texture->w * texture->h;
+        SDL_AddAtlasTexture(texture, page, &dstrect);
+    }
+    SDL_SetRenderTarget(renderer, target);
+    SDL_free(textures);
+
+    /* Anything left behind after a failure stays on its old page */
+    for (page = old_pages; page; page = next) {
+        next = page->next;
+        if (page->num_textures == 0) {
+            SDL_DestroyTexture(page->texture);
+            SDL_free(page->free_rects);
+            SDL_free(page);
+        } else {
+            page->next = renderer->atlas_pages;
+            renderer->atlas_pages = page;
+        }
+    }
+    return status;
+}
+
+/* Clip the area to read to the viewport, and work out where what's left
+   starts within it */
+static SDL_bool
+SDL_GetReadPixelsRect(SDL_Renderer * renderer, const SDL_Rect * rect,
+                      SDL_Rect * real_rect, int *offset_x, int *offset_y)
+{
+    real_rect->x = renderer->viewport.x;
+    real_rect->y = renderer->viewport.y;
+    real_rect->w = renderer->viewport.w;
+    real_rect->h = renderer->viewport.h;
+    *offset_x = 0;
+    *offset_y = 0;
+    if (rect) {
+        if (!SDL_IntersectRect(rect, real_rect, real_rect)) {
+            return SDL_FALSE;
+        }
+        if (real_rect->y > rect->y) {
+            *offset_y = real_rect->y - rect->y;
+        }
+        if (real_rect->x > rect->x) {
+            *offset_x = real_rect->x - rect->x;
+        }
+    }
+    return SDL_TRUE;
+}
+
+int
+SDL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Vertex * vertices, int num_vertices,
+                   const int * indices, int num_indices)
+{
+    SDL_Vertex *scaled = NULL;
+    Uint64 start;
+    int i, retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (indices) {
+        if (num_indices < 0 || (num_indices % 3) != 0) {
+            return SDL_SetError("Geometry needs three indices for each triangle");
+        }
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Geometry index %d is out of range", indices[i]);
+            }
+        }
+    } else if ((num_vertices % 3) != 0) {
+        return SDL_SetError("Geometry needs three vertices for each triangle");
+    }
+    if (!renderer->RenderGeometry) {
+        return SDL_Unsupported();
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden || num_vertices == 0 || (indices && num_indices == 0)) {
+        return 0;
+    }
+
+    if (texture) {
+        if (texture->native) {
+            texture = texture->native;
+        } else if (texture->atlas) {
+            SDL_Rect rect = { 0, 0, 0, 0 };
+            SDL_Texture *page = SDL_PrepareAtlasCopy(texture, &rect);
+
+            /* The texture coordinates have to be moved onto the page */
+            scaled = (SDL_Vertex *)SDL_malloc(num_vertices * sizeof(*scaled));
+            if (!scaled) {
+                return SDL_OutOfMemory();
+            }
+            for (i = 0; i < num_vertices; ++i) {
+                scaled[i] = vertices[i];
+                scaled[i].u = (rect.x + vertices[i].u * texture->w) / page->w;
+                scaled[i].v = (rect.y + vertices[i].v * texture->h) / page->h;
+            }
+            texture = page;
+        }
+    }
+
+    if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
+        if (!scaled) {
+            scaled = (SDL_Vertex *)SDL_malloc(num_vertices * sizeof(*scaled));
+            if (!scaled) {
+                return SDL_OutOfMemory();
+            }
+            SDL_memcpy(scaled, vertices, num_vertices * sizeof(*scaled));
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            scaled[i].x *= renderer->scale.x;
+            scaled[i].y *= renderer->scale.y;
+        }
+    }
+
+    start = SDL_ProfileBegin(renderer);
+    retval = renderer->RenderGeometry(renderer, texture, scaled ? scaled : vertices,
+                                      num_vertices, indices, indices ? num_indices : 0);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_GEOMETRY, start);
+    SDL_free(scaled);
+    return retval;
 }
 
 int
@@ -1850,6 +2718,9 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
 {
     SDL_Rect real_rect;
+    int offset_x, offset_y;
+    Uint64 start;
+    int status;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -1861,37 +2732,270 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         format = SDL_GetWindowPixelFormat(renderer->window);
     }
 
-    real_rect.x = renderer->viewport.x;
-    real_rect.y = renderer->viewport.y;
-    real_rect.w = renderer->viewport.w;
-    real_rect.h = renderer->viewport.h;
-    if (rect) {
-        if (!SDL_IntersectRect(rect, &real_rect, &real_rect)) {
-            return 0;
+    if (!SDL_GetReadPixelsRect(renderer, rect, &real_rect, &offset_x, &offset_y)) {
+        return 0;
+    }
+    pixels = (Uint8 *)pixels + pitch * offset_y + SDL_BYTESPERPIXEL(format) * offset_x;
+
+    start = SDL_ProfileBegin(renderer);
+    status = renderer->RenderReadPixels(renderer, &real_rect,
+                                        format, pixels, pitch);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_READ_PIXELS, start);
+    return status;
+}
+
+int
+SDL_ConvertReadbackPixels(SDL_RenderReadback * readback,
+                          const void * src, int src_pitch,
+                          Uint32 format, void * pixels, int pitch)
+{
+    if (readback->flipped) {
+        /* Walk the rows from the bottom, so they land the right way up */
+        src = (const Uint8 *)src + (readback->rect.h - 1) * src_pitch;
+        src_pitch = -src_pitch;
+    }
+    return SDL_ConvertPixels(readback->rect.w, readback->rect.h,
+                             readback->format, src, src_pitch,
+                             format, pixels, pitch);
+}
+
+SDL_RenderReadback *
+SDL_RenderReadPixelsAsync(SDL_Renderer * renderer, const SDL_Rect * rect)
+{
+    SDL_RenderReadback *readback;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels && !renderer->StartReadPixels) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    readback = (SDL_RenderReadback *) SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    readback->magic = &readback_magic;
+    readback->renderer = renderer;
+
+    /* An empty area leaves nothing to read */
+    if (SDL_GetReadPixelsRect(renderer, rect, &readback->rect,
+                              &readback->offset_x, &readback->offset_y)) {
+        int status;
+
+        if (renderer->StartReadPixels) {
+            status = renderer->StartReadPixels(renderer, readback);
+        } else {
+            /* Read the pixels now, leaving the conversion for later */
+            readback->format = renderer->target ? renderer->target->format :
+                               SDL_GetWindowPixelFormat(renderer->window);
+            readback->pitch = readback->rect.w * SDL_BYTESPERPIXEL(readback->format);
+            readback->pixels = SDL_malloc(readback->rect.h * readback->pitch);
+            if (!readback->pixels) {
+                status = SDL_OutOfMemory();
+            } else {
+                status = renderer->RenderReadPixels(renderer, &readback->rect,
+                                                    readback->format,
+                                                    readback->pixels,
+                                                    readback->pitch);
+            }
+        }
+        if (status < 0) {
+            SDL_free(readback->pixels);
+            SDL_free(readback);
+            return NULL;
         }
-        if (real_rect.y > rect->y) {
-            pixels = (Uint8 *)pixels + pitch * (real_rect.y - rect->y);
+    } else {
+        SDL_zero(readback->rect);
+    }
+
+    readback->next = renderer->readbacks;
+    if (renderer->readbacks) {
+        renderer->readbacks->prev = readback;
+    }
+    renderer->readbacks = readback;
+    return readback;
+}
+
+SDL_bool
+SDL_RenderReadbackReady(SDL_RenderReadback * readback)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_READBACK_MAGIC(readback, SDL_FALSE);
+
+    renderer = readback->renderer;
+    if (readback->driverdata && renderer->ReadPixelsReady) {
+        return renderer->ReadPixelsReady(renderer, readback);
+    }
+    return SDL_TRUE;
+}
+
+int
+SDL_FinishRenderReadback(SDL_RenderReadback * readback, Uint32 format,
+                         void *pixels, int pitch)
+{
+    SDL_Renderer *renderer;
+    int status = 0;
+
+    CHECK_READBACK_MAGIC(readback, -1);
+
+    renderer = readback->renderer;
+    if (pixels) {
+        if (!format) {
+            format = SDL_GetWindowPixelFormat(renderer->window);
         }
-        if (real_rect.x > rect->x) {
-            int bpp = SDL_BYTESPERPIXEL(format);
-            pixels = (Uint8 *)pixels + bpp * (real_rect.x - rect->x);
+        pixels = (Uint8 *)pixels + pitch * readback->offset_y +
+                 SDL_BYTESPERPIXEL(format) * readback->offset_x;
+    }
+
+    if (readback->rect.w > 0 && readback->rect.h > 0) {
+        if (renderer->FinishReadPixels) {
+            status = renderer->FinishReadPixels(renderer, readback, format, pixels, pitch);
+        } else if (pixels) {
+            status = SDL_ConvertReadbackPixels(readback, readback->pixels,
+                                               readback->pitch,
+                                               format, pixels, pitch);
         }
     }
 
-    return renderer->RenderReadPixels(renderer, &real_rect,
-                                      format, pixels, pitch);
+    if (readback->next) {
+        readback->next->prev = readback->prev;
+    }
+    if (readback->prev) {
+        readback->prev->next = readback->next;
+    } else {
+        renderer->readbacks = readback->next;
+    }
+    readback->magic = NULL;
+    SDL_free(readback->pixels);
+    SDL_free(readback);
+
+    return status;
 }
 
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
+    SDL_RenderPresentStats *stats;
+    Uint64 start;
+    int w, h;
+
     CHECK_RENDERER_MAGIC(renderer, );
 
     /* Don't draw while we're hidden */
     if (renderer->hidden) {
         return;
     }
+
+    /* Unless the driver says otherwise, the whole output is updated */
+    stats = &renderer->present_stats;
+    if (SDL_GetRendererOutputSize(renderer, &w, &h) < 0) {
+        w = h = 0;
+    }
+    stats->rects = 1;
+    stats->total_pixels = stats->damaged_pixels = (Uint32)w * h;
+
+    start = SDL_ProfileBegin(renderer);
     renderer->RenderPresent(renderer);
+    SDL_ProfileEnd(renderer, SDL_RENDER_CALL_PRESENT, start);
+    SDL_ProfileEndFrame(renderer);
+
+    ++stats->frames;
+    stats->damaged_ratio = stats->total_pixels ? (float)stats->damaged_pixels / stats->total_pixels : 0.0f;
+    stats->damaged_pixels_sum += stats->damaged_pixels;
+    stats->total_pixels_sum += stats->total_pixels;
+}
+
+int
+SDL_GetRenderPresentStats(SDL_Renderer * renderer, SDL_RenderPresentStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    *stats = renderer->present_stats;
+    return 0;
+}
+
+void
+SDL_ResetRenderPresentStats(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, );
+
+    SDL_zero(renderer->present_stats);
+}
+
+int
+SDL_RenderWarmUp(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->WarmUp) {
+        return 0;
+    }
+    return renderer->WarmUp(renderer);
+}
+
+int
+SDL_RenderSetProfiling(SDL_Renderer * renderer, SDL_bool enabled, const char *trace_file)
+{
+    SDL_RenderProfiler *profiler;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    profiler = &renderer->profiler;
+
+    /* Finish the trace being written, if any */
+    if (profiler->trace) {
+        SDL_RWwrite(profiler->trace, "\n]\n", 3, 1);
+        SDL_RWclose(profiler->trace);
+        profiler->trace = NULL;
+    }
+
+    if (!enabled) {
+        profiler->enabled = SDL_FALSE;
+        return 0;
+    }
+
+    if (trace_file) {
+        char event[128];
+
+        profiler->trace = SDL_RWFromFile(trace_file, "wb");
+        if (!profiler->trace) {
+            return -1;
+        }
+        SDL_RWwrite(profiler->trace, "[\n", 2, 1);
+        profiler->trace_start = SDL_GetPerformanceCounter();
+        profiler->trace_empty = SDL_TRUE;
+
+        SDL_snprintf(event, sizeof(event),
+                     "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SDL %s renderer\"}}",
+                     renderer->info.name);
+        SDL_ProfileTraceEvent(renderer, event);
+    }
+
+    if (!profiler->enabled) {
+        SDL_zero(profiler->frame);
+        SDL_zero(profiler->last);
+        profiler->frame_start = SDL_GetPerformanceCounter();
+        profiler->enabled = SDL_TRUE;
+    }
+    return 0;
+}
+
+int
+SDL_RenderGetFrameProfile(SDL_Renderer * renderer, SDL_RenderFrameProfile * profile)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!profile) {
+        return SDL_InvalidParamError("profile");
+    }
+    *profile = renderer->profiler.last;
+    return 0;
 }
 
 void
@@ -1917,6 +3021,13 @@ SDL_DestroyTexture(SDL_Texture * texture)
         renderer->textures = texture->next;
     }
 
+    if (texture->atlas) {
+        /* The page has the driver's texture */
+        SDL_RemoveAtlasTexture(texture);
+        SDL_free(texture);
+        return;
+    }
+
     if (texture->native) {
         SDL_DestroyTexture(texture->native);
     }
@@ -1932,10 +3043,29 @@ SDL_DestroyTexture(SDL_Texture * texture)
 void
 SDL_DestroyRenderer(SDL_Renderer * renderer)
 {
+    SDL_Texture *texture;
+
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    /* Discard the readbacks nobody finished */
+    while (renderer->readbacks) {
+        SDL_FinishRenderReadback(renderer->readbacks, 0, NULL, 0);
+    }
+
+    /* Free the textures in the atlas first, which frees its pages */
+    texture = renderer->textures;
+    while (texture) {
+        if (texture->atlas) {
+            SDL_DestroyTexture(texture);
+            texture = renderer->textures;
+        } else {
+            texture = texture->next;
+        }
+    }
+    SDL_assert(!renderer->atlas_pages);
+
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_Texture *tex = renderer->textures; (void) tex;
@@ -1947,6 +3077,9 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
         SDL_SetWindowData(renderer->window, SDL_WINDOWRENDERDATA, NULL);
     }
 
+    /* Finish the trace, if one is being written */
+    SDL_RenderSetProfiling(renderer, SDL_FALSE, NULL);
+
     /* It's no longer magical... */
     renderer->magic = NULL;
 
@@ -1962,6 +3095,8 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
     renderer = texture->renderer;
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
+    } else if (texture->atlas) {
+        return SDL_SetError("Textures in an atlas can't be bound");
     } else if (renderer && renderer->GL_BindTexture) {
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
@@ -1977,6 +3112,8 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
     renderer = texture->renderer;
     if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
+    } else if (texture->atlas) {
+        return SDL_SetError("Textures in an atlas can't be bound");
     } else if (renderer && renderer->GL_UnbindTexture) {
         return renderer->GL_UnbindTexture(renderer, texture);
     }
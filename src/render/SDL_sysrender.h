@@ -25,11 +25,13 @@
 
 #include "SDL_render.h"
 #include "SDL_events.h"
+#include "SDL_rwops.h"
 #include "SDL_yuv_sw_c.h"
 
 /* The SDL 2D rendering system */
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
+typedef struct SDL_AtlasPage SDL_AtlasPage;
 
 typedef struct
 {
@@ -66,12 +68,71 @@ struct SDL_Texture
     int pitch;
     SDL_Rect locked_rect;
 
+    /* Support for small static textures packed into an atlas page */
+    SDL_AtlasPage *atlas;
+    SDL_Rect atlas_rect;        /**< Where the texture is on the page */
+
     void *driverdata;           /**< Driver specific texture representation */
 
     SDL_Texture *prev;
     SDL_Texture *next;
 };
 
+/* Define the SDL readback structure, see SDL_RenderReadPixelsAsync() */
+struct SDL_RenderReadback
+{
+    const void *magic;
+    SDL_Renderer *renderer;
+
+    SDL_Rect rect;              /**< The area read, in the driver's coordinates */
+    int offset_x, offset_y;     /**< Where rect starts in the area asked for */
+    Uint32 format;              /**< The format of the pixels read */
+    SDL_bool flipped;           /**< The rows were read bottom-up */
+
+    /* The pixels, for renderers without asynchronous reads */
+    void *pixels;
+    int pitch;
+
+    void *driverdata;           /**< Driver specific readback representation */
+
+    SDL_RenderReadback *prev;
+    SDL_RenderReadback *next;
+};
+
+/* A page of the texture atlas, a texture shared by small static textures */
+struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    SDL_Rect *free_rects;       /**< The unused areas, which don't overlap */
+    int num_free_rects;
+    int max_free_rects;
+    int num_textures;           /**< The textures packed into the page */
+    int used_area;              /**< The pixels they cover */
+
+    SDL_AtlasPage *next;
+};
+
+/* The state of the render profiler, see SDL_RenderSetProfiling() */
+typedef struct SDL_RenderProfiler
+{
+    SDL_bool enabled;
+    SDL_RenderFrameProfile frame;   /**< The frame being drawn */
+    SDL_RenderFrameProfile last;    /**< The last frame presented */
+    Uint64 frame_start;             /**< The performance counter when the frame started */
+
+    SDL_RWops *trace;               /**< The Chrome trace being written, or NULL */
+    Uint64 trace_start;             /**< The performance counter at time 0 in the trace */
+    SDL_bool trace_empty;           /**< No event has been written yet */
+} SDL_RenderProfiler;
+
+/* Count a state change made by a driver, for the profiler */
+#define SDL_RENDER_PROFILE_COUNT(renderer, counter) \
+    do { \
+        if ((renderer)->profiler.enabled) { \
+            ++(renderer)->profiler.frame.counter; \
+        } \
+    } while (0)
+
 /* Define the SDL renderer structure */
 struct SDL_Renderer
 {
@@ -112,9 +173,20 @@ struct SDL_Renderer
     int (*RenderCopyEx) (SDL_Renderer * renderer, SDL_Texture * texture,
                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    /* Optional. The vertices are already scaled, and the indices checked. */
+    int (*RenderGeometry) (SDL_Renderer * renderer, SDL_Texture * texture,
+                           const SDL_Vertex * vertices, int num_vertices,
+                           const int * indices, int num_indices);
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
+    /* Optional. Finish is called with NULL pixels to discard the readback,
+       and frees its driverdata either way. */
+    int (*StartReadPixels) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
+    SDL_bool (*ReadPixelsReady) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
+    int (*FinishReadPixels) (SDL_Renderer * renderer, SDL_RenderReadback * readback,
+                             Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
+    int (*WarmUp) (SDL_Renderer * renderer);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
 
     void (*DestroyRenderer) (SDL_Renderer * renderer);
@@ -158,6 +230,18 @@ struct SDL_Renderer
     SDL_Texture *textures;
     SDL_Texture *target;
 
+    /* The readbacks that haven't been finished */
+    SDL_RenderReadback *readbacks;
+
+    /* The pages of the texture atlas */
+    SDL_AtlasPage *atlas_pages;
+
+    /* Drivers that update less than the whole output at present fill in the
+       last frame's rects and pixels here */
+    SDL_RenderPresentStats present_stats;
+
+    SDL_RenderProfiler profiler;
+
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
@@ -173,6 +257,12 @@ struct SDL_RenderDriver
     SDL_RendererInfo info;
 };
 
+/* Write out the pixels of a readback, turning bottom-up rows the right way
+   up as part of the conversion */
+extern int SDL_ConvertReadbackPixels(SDL_RenderReadback * readback,
+                                     const void * src, int src_pitch,
+                                     Uint32 format, void * pixels, int pitch);
+
 /* Not all of these are available in a given build. Use #ifdefs, etc. */
 extern SDL_RenderDriver D3D_RenderDriver;
 extern SDL_RenderDriver D3D11_RenderDriver;
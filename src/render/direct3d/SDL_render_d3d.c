@@ -28,6 +28,7 @@
 #include "../../core/windows/SDL_windows.h"
 
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 #include "SDL_loadso.h"
 #include "SDL_syswm.h"
 #include "../SDL_sysrender.h"
@@ -805,7 +806,8 @@ D3D_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
 static D3DTEXTUREFILTERTYPE
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
 
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return D3DTEXF_POINT;
@@ -25,6 +25,7 @@
 #define COBJMACROS
 #include "../../core/windows/SDL_windows.h"
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 #include "SDL_loadso.h"
 #include "SDL_syswm.h"
 #include "../SDL_sysrender.h"
@@ -1697,7 +1698,8 @@ D3D11_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
 static D3D11_FILTER
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return D3D11_FILTER_MIN_MAG_MIP_POINT;
     } else /* if (*hint == '1' || SDL_strcasecmp(hint, "linear") == 0) */ {
@@ -23,6 +23,7 @@
 #if SDL_VIDEO_RENDER_OGL && !SDL_RENDER_DISABLED
 
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 #include "SDL_log.h"
 #include "SDL_assert.h"
 #include "SDL_opengl.h"
@@ -640,7 +641,8 @@ convert_format(GL_RenderData *renderdata, Uint32 pixel_format,
 static GLenum
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
 
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return GL_NEAREST;
@@ -35,6 +35,7 @@ SDL_PROC(void, glDeleteTextures, (GLsizei, const GLuint *))
 SDL_PROC(void, glDisable, (GLenum))
 SDL_PROC(void, glDisableVertexAttribArray, (GLuint))
 SDL_PROC(void, glDrawArrays, (GLenum, GLint, GLsizei))
+SDL_PROC(void, glDrawElements, (GLenum, GLsizei, GLenum, const void *))
 SDL_PROC(void, glEnable, (GLenum))
 SDL_PROC(void, glEnableVertexAttribArray, (GLuint))
 SDL_PROC(void, glFinish, (void))
@@ -65,6 +66,7 @@ SDL_PROC(void, glUniform1i, (GLint, GLint))
 SDL_PROC(void, glUniform4f, (GLint, GLfloat, GLfloat, GLfloat, GLfloat))
 SDL_PROC(void, glUniformMatrix4fv, (GLint, GLsizei, GLboolean, const GLfloat *))
 SDL_PROC(void, glUseProgram, (GLuint))
+SDL_PROC(void, glVertexAttrib4f, (GLuint, GLfloat, GLfloat, GLfloat, GLfloat))
 SDL_PROC(void, glVertexAttribPointer, (GLuint, GLint, GLenum, GLboolean, GLsizei, const void *))
 SDL_PROC(void, glViewport, (GLint, GLint, GLsizei, GLsizei))
 SDL_PROC(void, glBindFramebuffer, (GLenum, GLuint))
@@ -22,7 +22,9 @@
 
 #if SDL_VIDEO_RENDER_OGL_ES2 && !SDL_RENDER_DISABLED
 
+#include "SDL_filesystem.h"
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 #include "SDL_opengles2.h"
 #include "../SDL_sysrender.h"
 #include "../../video/SDL_blit.h"
@@ -47,6 +49,54 @@
 #define RENDERER_CONTEXT_MAJOR 2
 #define RENDERER_CONTEXT_MINOR 0
 
+/* From GL_EXT_unpack_subimage and OpenGL ES 3.0, which the GLES2 headers
+   may not have */
+#ifndef GL_UNPACK_ROW_LENGTH_EXT
+#define GL_UNPACK_ROW_LENGTH_EXT 0x0CF2
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 /* Used to re-create the window with OpenGL ES capability */
 extern int SDL_RecreateWindow(SDL_Window * window, Uint32 flags);
 
@@ -100,8 +150,22 @@ typedef struct GLES2_TextureData
     GLenum texture_v;
     GLenum texture_u;
     GLES2_FBOList *fbo;
+    SDL_Rect locked_rect;
+    /* Streaming textures lock straight into one of two pixel unpack buffers
+       when they're available, alternating so that a lock doesn't wait for
+       the previous upload. pixel_data isn't allocated then. */
+    GLuint pixel_buffers[2];
+    int pixel_buffer;
+    void *mapped;
 } GLES2_TextureData;
 
+/* An asynchronous read into a pixel pack buffer, done once sync signals */
+typedef struct GLES2_ReadbackData
+{
+    GLuint buffer;
+    void *sync;
+} GLES2_ReadbackData;
+
 typedef struct GLES2_ShaderCacheEntry
 {
     GLuint id;
@@ -146,6 +210,7 @@ typedef enum
     GLES2_ATTRIBUTE_TEXCOORD = 1,
     GLES2_ATTRIBUTE_ANGLE = 2,
     GLES2_ATTRIBUTE_CENTER = 3,
+    GLES2_ATTRIBUTE_COLOR = 4,
 } GLES2_Attribute;
 
 typedef enum
@@ -179,6 +244,7 @@ typedef struct GLES2_DriverContext
     struct {
         int blendMode;
         SDL_bool tex_coords;
+        GLuint texture;     /* bound to GL_TEXTURE0 for copies, 0 if unknown */
     } current;
 
 #define SDL_PROC(ret,func,params) ret (APIENTRY *func) params;
@@ -195,12 +261,42 @@ typedef struct GLES2_DriverContext
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
 #if SDL_GLES2_USE_VBOS
-    GLuint vertex_buffers[4];
-    GLsizeiptr vertex_buffer_size[4];
+    GLuint vertex_buffers[5];
+    GLsizeiptr vertex_buffer_size[5];
 #endif
+
+    /* Rows that aren't tightly packed are uploaded in place if
+       GL_UNPACK_ROW_LENGTH is available, otherwise through the staging
+       buffer, which only ever grows */
+    SDL_bool unpack_subimage;
+    Uint8 *staging;
+    size_t staging_size;
+
+    /* Pixel unpack buffers, from OpenGL ES 3.0 */
+    SDL_bool pixel_buffers;
+    void *(APIENTRY *glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+    GLboolean (APIENTRY *glUnmapBuffer)(GLenum);
+    void (APIENTRY *glDeleteBuffers)(GLsizei, const GLuint *);
+
+    /* Fences for asynchronous reads, also from OpenGL ES 3.0 */
+    SDL_bool async_readback;
+    void *(APIENTRY *glFenceSync)(GLenum, GLbitfield);
+    GLenum (APIENTRY *glClientWaitSync)(void *, GLbitfield, Uint64);
+    void (APIENTRY *glDeleteSync)(void *);
+
+    /* Indices past 65535 can be drawn without unpacking the vertices */
+    SDL_bool element_index_uint;
+
+    /* Linked programs are kept between runs in this directory, if there's
+       one, and only loaded again by the same driver */
+    char *program_cache_path;
+    char *program_cache_identity;
+    void (APIENTRY *glGetProgramBinary)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+    void (APIENTRY *glProgramBinary)(GLuint, GLenum, const void *, GLint);
+    void (APIENTRY *glProgramParameteri)(GLuint, GLenum, GLint);
 } GLES2_DriverContext;
 
-#define GLES2_MAX_CACHED_PROGRAMS 8
+#define GLES2_MAX_CACHED_PROGRAMS 32
 
 
 SDL_FORCE_INLINE const char*
@@ -440,7 +536,9 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             GLES2_ShaderCacheEntry *next;
             entry = data->shader_cache.head;
             while (entry) {
-                data->glDeleteShader(entry->id);
+                if (entry->id) {
+                    data->glDeleteShader(entry->id);
+                }
                 next = entry->next;
                 SDL_free(entry);
                 entry = next;
@@ -468,6 +566,9 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             SDL_GL_DeleteContext(data->context);
         }
         SDL_free(data->shader_formats);
+        SDL_free(data->staging);
+        SDL_free(data->program_cache_path);
+        SDL_free(data->program_cache_identity);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -494,7 +595,8 @@ static void GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
 static GLenum
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
 
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return GL_NEAREST;
@@ -563,10 +665,29 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
             /* Need to add size for the U/V plane */
             size += ((texture->h * data->pitch) / 2);
         }
-        data->pixel_data = SDL_calloc(1, size);
-        if (!data->pixel_data) {
-            SDL_free(data);
-            return SDL_OutOfMemory();
+        if (renderdata->pixel_buffers && !data->yuv && !data->nv12) {
+            int i;
+
+            GL_CheckError("", renderer);
+            renderdata->glGenBuffers(2, data->pixel_buffers);
+            for (i = 0; i < 2; ++i) {
+                renderdata->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, data->pixel_buffers[i]);
+                renderdata->glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+            }
+            renderdata->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            if (GL_CheckError("glBufferData()", renderer) < 0) {
+                /* Fall back to uploading from pixel_data */
+                renderdata->glDeleteBuffers(2, data->pixel_buffers);
+                data->pixel_buffers[0] = data->pixel_buffers[1] = 0;
+                SDL_ClearError();
+            }
+        }
+        if (!data->pixel_buffers[0]) {
+            data->pixel_data = SDL_calloc(1, size);
+            if (!data->pixel_data) {
+                SDL_free(data);
+                return SDL_OutOfMemory();
+            }
         }
     }
 
@@ -624,6 +745,7 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         return -1;
     }
     texture->driverdata = data;
+    renderdata->current.texture = 0;
     renderdata->glActiveTexture(GL_TEXTURE0);
     renderdata->glBindTexture(data->texture_type, data->texture);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
@@ -647,33 +769,41 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 static int
 GLES2_TexSubImage2D(GLES2_DriverContext *data, GLenum target, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels, GLint pitch, GLint bpp)
 {
-    Uint8 *blob = NULL;
+    const int src_pitch = width * bpp;
     Uint8 *src;
-    int src_pitch;
+    size_t size;
     int y;
 
+    if (pitch == src_pitch) {
+        data->glTexSubImage2D(target, 0, xoffset, yoffset, width, height, format, type, pixels);
+        return 0;
+    }
+
+    if (data->unpack_subimage && (pitch % bpp) == 0) {
+        data->glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, pitch / bpp);
+        data->glTexSubImage2D(target, 0, xoffset, yoffset, width, height, format, type, pixels);
+        data->glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0);
+        return 0;
+    }
+
     /* Reformat the texture data into a tightly packed array */
-    src_pitch = width * bpp;
-    src = (Uint8 *)pixels;
-    if (pitch != src_pitch) {
-        blob = (Uint8 *)SDL_malloc(src_pitch * height);
-        if (!blob) {
+    size = (size_t)src_pitch * height;
+    if (size > data->staging_size) {
+        Uint8 *staging = (Uint8 *)SDL_realloc(data->staging, size);
+        if (!staging) {
             return SDL_OutOfMemory();
         }
-        src = blob;
-        for (y = 0; y < height; ++y)
-        {
-            SDL_memcpy(src, pixels, src_pitch);
-            src += src_pitch;
-            pixels = (Uint8 *)pixels + pitch;
-        }
-        src = blob;
+        data->staging = staging;
+        data->staging_size = size;
     }
-
-    data->glTexSubImage2D(target, 0, xoffset, yoffset, width, height, format, type, src);
-    if (blob) {
-        SDL_free(blob);
+    src = data->staging;
+    for (y = 0; y < height; ++y) {
+        SDL_memcpy(src, pixels, src_pitch);
+        src += src_pitch;
+        pixels = (const Uint8 *)pixels + pitch;
     }
+
+    data->glTexSubImage2D(target, 0, xoffset, yoffset, width, height, format, type, data->staging);
     return 0;
 }
 
@@ -692,6 +822,7 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     }
 
     /* Create a texture subimage with the supplied data */
+    data->current.texture = 0;
     data->glBindTexture(tdata->texture_type, tdata->texture);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x,
@@ -770,6 +901,7 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
+    data->current.texture = 0;
     data->glBindTexture(tdata->texture_type, tdata->texture_v);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x / 2,
@@ -807,10 +939,28 @@ static int
 GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
                   void **pixels, int *pitch)
 {
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+    Uint8 *base = (Uint8 *)tdata->pixel_data;
+
+    if (tdata->pixel_buffers[0]) {
+        /* The locked pixels are write-only, so the old contents can go */
+        GLES2_ActivateRenderer(renderer);
+        if (!tdata->mapped) {
+            data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tdata->pixel_buffers[tdata->pixel_buffer]);
+            tdata->mapped = data->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, tdata->pitch * texture->h,
+                                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            if (!tdata->mapped) {
+                return SDL_SetError("glMapBufferRange() failed");
+            }
+        }
+        base = (Uint8 *)tdata->mapped;
+    }
+    tdata->locked_rect = *rect;
 
     /* Retrieve the buffer/pitch for the specified region */
-    *pixels = (Uint8 *)tdata->pixel_data +
+    *pixels = base +
               (tdata->pitch * rect->y) +
               (rect->x * SDL_BYTESPERPIXEL(texture->format));
     *pitch = tdata->pitch;
@@ -821,15 +971,36 @@ GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *
 static void
 GLES2_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
-    SDL_Rect rect;
-
-    /* We do whole texture updates, at least for now */
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = texture->w;
-    rect.h = texture->h;
-    GLES2_UpdateTexture(renderer, texture, &rect, tdata->pixel_data, tdata->pitch);
+    const SDL_Rect *rect = &tdata->locked_rect;
+    const size_t offset = (tdata->pitch * rect->y) + (rect->x * SDL_BYTESPERPIXEL(texture->format));
+    SDL_Rect full_rect;
+
+    if (tdata->pixel_buffers[0]) {
+        if (!tdata->mapped) {
+            return;
+        }
+        GLES2_ActivateRenderer(renderer);
+        data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tdata->pixel_buffers[tdata->pixel_buffer]);
+        data->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        tdata->mapped = NULL;
+
+        /* With the buffer bound, the pixel pointer is an offset into it */
+        GLES2_UpdateTexture(renderer, texture, rect, (const void *)(uintptr_t)offset, tdata->pitch);
+        data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        tdata->pixel_buffer = !tdata->pixel_buffer;
+    } else if (tdata->yuv || tdata->nv12) {
+        /* The chroma planes follow the whole luma plane, so update it all */
+        full_rect.x = 0;
+        full_rect.y = 0;
+        full_rect.w = texture->w;
+        full_rect.h = texture->h;
+        GLES2_UpdateTexture(renderer, texture, &full_rect, tdata->pixel_data, tdata->pitch);
+    } else {
+        /* Only the locked area can have changed */
+        GLES2_UpdateTexture(renderer, texture, rect, (const Uint8 *)tdata->pixel_data + offset, tdata->pitch);
+    }
 }
 
 static int
@@ -865,6 +1036,7 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 
     /* Destroy the texture */
     if (tdata) {
+        data->current.texture = 0;  /* the name may be reused */
         data->glDeleteTextures(1, &tdata->texture);
         if (tdata->texture_v) {
             data->glDeleteTextures(1, &tdata->texture_v);
@@ -872,6 +1044,14 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         if (tdata->texture_u) {
             data->glDeleteTextures(1, &tdata->texture_u);
         }
+        if (tdata->pixel_buffers[0]) {
+            if (tdata->mapped) {
+                data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tdata->pixel_buffers[tdata->pixel_buffer]);
+                data->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            data->glDeleteBuffers(2, tdata->pixel_buffers);
+        }
         SDL_free(tdata->pixel_data);
         SDL_free(tdata);
         texture->driverdata = NULL;
@@ -884,6 +1064,7 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 
 static GLES2_ShaderCacheEntry *GLES2_CacheShader(SDL_Renderer *renderer, GLES2_ShaderType type,
                                                  SDL_BlendMode blendMode);
+static int GLES2_CompileShader(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *entry);
 static void GLES2_EvictShader(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *entry);
 static GLES2_ProgramCacheEntry *GLES2_CacheProgram(SDL_Renderer *renderer,
                                                    GLES2_ShaderCacheEntry *vertex,
@@ -892,6 +1073,149 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(SDL_Renderer *renderer,
 static int GLES2_SelectProgram(SDL_Renderer *renderer, GLES2_ImageSource source,
                                SDL_BlendMode blendMode);
 
+#define GLES2_PROGRAM_FILE_MAGIC    0x50474C53  /* "SLGP" */
+#define GLES2_PROGRAM_FILE_VERSION  1
+
+static Uint64
+GLES2_HashShaderInstance(Uint64 hash, const GLES2_ShaderInstance *instance)
+{
+    const Uint8 *data = (const Uint8 *)instance->data;
+    size_t length = (instance->format == (GLenum)-1) ? SDL_strlen((const char *)data) : (size_t)instance->length;
+    size_t i;
+
+    /* 64-bit FNV-1a */
+    hash ^= instance->type;
+    hash *= 0x100000001B3ULL;
+    hash ^= instance->format;
+    hash *= 0x100000001B3ULL;
+    for (i = 0; i < length; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/* The file for a pair of shaders is named after a hash of their sources, and
+   records the driver that linked it, since binaries only load on that one */
+static SDL_RWops *
+GLES2_OpenProgramFile(GLES2_DriverContext *data, GLES2_ShaderCacheEntry *vertex,
+                      GLES2_ShaderCacheEntry *fragment, Uint64 *hash, const char *mode)
+{
+    SDL_RWops *file;
+    size_t pathlen;
+    char *path;
+
+    *hash = GLES2_HashShaderInstance(0xCBF29CE484222325ULL, vertex->instance);
+    *hash = GLES2_HashShaderInstance(*hash, fragment->instance);
+
+    pathlen = SDL_strlen(data->program_cache_path) + 22;
+    path = SDL_stack_alloc(char, pathlen);
+    if (!path) {
+        return NULL;
+    }
+    SDL_snprintf(path, pathlen, "%s%08x%08x.bin", data->program_cache_path,
+                 (unsigned int)(*hash >> 32), (unsigned int)(*hash & 0xFFFFFFFF));
+    file = SDL_RWFromFile(path, mode);
+    SDL_stack_free(path);
+    return file;
+}
+
+static SDL_bool
+GLES2_LoadProgramBinary(GLES2_DriverContext *data, GLuint program,
+                        GLES2_ShaderCacheEntry *vertex, GLES2_ShaderCacheEntry *fragment)
+{
+    const size_t identity_length = SDL_strlen(data->program_cache_identity);
+    SDL_RWops *file;
+    Uint64 hash;
+    Uint32 length;
+    GLenum format;
+    char *identity = NULL;
+    void *binary = NULL;
+    GLint linked = GL_FALSE;
+
+    file = GLES2_OpenProgramFile(data, vertex, fragment, &hash, "rb");
+    if (!file) {
+        return SDL_FALSE;
+    }
+
+    /* Anything that doesn't match is left to be overwritten by a fresh link */
+    if (SDL_ReadLE32(file) != GLES2_PROGRAM_FILE_MAGIC ||
+        SDL_ReadLE32(file) != GLES2_PROGRAM_FILE_VERSION ||
+        SDL_ReadLE64(file) != hash ||
+        SDL_ReadLE32(file) != identity_length) {
+        goto done;
+    }
+    identity = (char *)SDL_malloc(identity_length);
+    if (!identity || SDL_RWread(file, identity, identity_length, 1) != 1 ||
+        SDL_memcmp(identity, data->program_cache_identity, identity_length) != 0) {
+        goto done;
+    }
+    format = (GLenum)SDL_ReadLE32(file);
+    length = SDL_ReadLE32(file);
+    if (length == 0 || length > 0x1000000) {
+        goto done;
+    }
+    binary = SDL_malloc(length);
+    if (!binary || SDL_RWread(file, binary, length, 1) != 1) {
+        goto done;
+    }
+
+    /* The driver validates the binary, and fails the link if it's stale */
+    data->glProgramBinary(program, format, binary, (GLint)length);
+    data->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    while (data->glGetError() != GL_NO_ERROR) {
+        continue;
+    }
+
+done:
+    SDL_free(binary);
+    SDL_free(identity);
+    SDL_RWclose(file);
+    return linked ? SDL_TRUE : SDL_FALSE;
+}
+
+static void
+GLES2_SaveProgramBinary(GLES2_DriverContext *data, GLuint program,
+                        GLES2_ShaderCacheEntry *vertex, GLES2_ShaderCacheEntry *fragment)
+{
+    const size_t identity_length = SDL_strlen(data->program_cache_identity);
+    SDL_RWops *file;
+    Uint64 hash;
+    GLint length = 0;
+    GLsizei written = 0;
+    GLenum format = 0;
+    void *binary;
+
+    data->glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    binary = SDL_malloc(length);
+    if (!binary) {
+        return;
+    }
+    data->glGetProgramBinary(program, length, &written, &format, binary);
+    if (data->glGetError() != GL_NO_ERROR || written <= 0) {
+        SDL_free(binary);
+        return;
+    }
+
+    /* A cache that can't be written is only a missed chance to save time */
+    file = GLES2_OpenProgramFile(data, vertex, fragment, &hash, "wb");
+    if (file) {
+        SDL_WriteLE32(file, GLES2_PROGRAM_FILE_MAGIC);
+        SDL_WriteLE32(file, GLES2_PROGRAM_FILE_VERSION);
+        SDL_WriteLE64(file, hash);
+        SDL_WriteLE32(file, (Uint32)identity_length);
+        SDL_RWwrite(file, data->program_cache_identity, identity_length, 1);
+        SDL_WriteLE32(file, format);
+        SDL_WriteLE32(file, (Uint32)written);
+        SDL_RWwrite(file, binary, written, 1);
+        SDL_RWclose(file);
+    }
+    SDL_free(binary);
+}
+
 static GLES2_ProgramCacheEntry *
 GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
                    GLES2_ShaderCacheEntry *fragment, SDL_BlendMode blendMode)
@@ -935,21 +1259,37 @@ GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
     entry->fragment_shader = fragment;
     entry->blend_mode = blendMode;
 
-    /* Create the program and link it */
+    /* Load the program linked on an earlier run, or compile and link it */
     entry->id = data->glCreateProgram();
-    data->glAttachShader(entry->id, vertex->id);
-    data->glAttachShader(entry->id, fragment->id);
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_POSITION, "a_position");
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_ANGLE, "a_angle");
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CENTER, "a_center");
-    data->glLinkProgram(entry->id);
-    data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
-    if (!linkSuccessful) {
-        data->glDeleteProgram(entry->id);
-        SDL_free(entry);
-        SDL_SetError("Failed to link shader program");
-        return NULL;
+    if (!data->program_cache_path ||
+        !GLES2_LoadProgramBinary(data, entry->id, vertex, fragment)) {
+        if (GLES2_CompileShader(renderer, vertex) < 0 ||
+            GLES2_CompileShader(renderer, fragment) < 0) {
+            data->glDeleteProgram(entry->id);
+            SDL_free(entry);
+            return NULL;
+        }
+        data->glAttachShader(entry->id, vertex->id);
+        data->glAttachShader(entry->id, fragment->id);
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_POSITION, "a_position");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_ANGLE, "a_angle");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CENTER, "a_center");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
+        if (data->program_cache_path && data->glProgramParameteri) {
+            data->glProgramParameteri(entry->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        data->glLinkProgram(entry->id);
+        data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
+        if (!linkSuccessful) {
+            data->glDeleteProgram(entry->id);
+            SDL_free(entry);
+            SDL_SetError("Failed to link shader program");
+            return NULL;
+        }
+        if (data->program_cache_path) {
+            GLES2_SaveProgramBinary(data, entry->id, vertex, fragment);
+        }
     }
 
     /* Predetermine locations of uniform variables */
@@ -1017,7 +1357,6 @@ GLES2_CacheShader(SDL_Renderer *renderer, GLES2_ShaderType type, SDL_BlendMode b
     const GLES2_Shader *shader;
     const GLES2_ShaderInstance *instance = NULL;
     GLES2_ShaderCacheEntry *entry = NULL;
-    GLint compileSuccessful = GL_FALSE;
     int i, j;
 
     /* Find the corresponding shader */
@@ -1056,7 +1395,7 @@ GLES2_CacheShader(SDL_Renderer *renderer, GLES2_ShaderType type, SDL_BlendMode b
         return entry;
     }
 
-    /* Create a shader cache entry */
+    /* Create a shader cache entry, compiled once a program needs it */
     entry = (GLES2_ShaderCacheEntry *)SDL_calloc(1, sizeof(GLES2_ShaderCacheEntry));
     if (!entry) {
         SDL_OutOfMemory();
@@ -1065,6 +1404,27 @@ GLES2_CacheShader(SDL_Renderer *renderer, GLES2_ShaderType type, SDL_BlendMode b
     entry->type = type;
     entry->instance = instance;
 
+    /* Link the shader entry in at the front of the cache */
+    if (data->shader_cache.head) {
+        entry->next = data->shader_cache.head;
+        data->shader_cache.head->prev = entry;
+    }
+    data->shader_cache.head = entry;
+    ++data->shader_cache.count;
+    return entry;
+}
+
+static int
+GLES2_CompileShader(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *entry)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const GLES2_ShaderInstance *instance = entry->instance;
+    GLint compileSuccessful = GL_FALSE;
+
+    if (entry->id) {
+        return 0;
+    }
+
     /* Compile or load the selected shader instance */
     entry->id = data->glCreateShader(instance->type);
     if (instance->format == (GLenum)-1) {
@@ -1093,18 +1453,10 @@ GLES2_CacheShader(SDL_Renderer *renderer, GLES2_ShaderType type, SDL_BlendMode b
             SDL_SetError("Failed to load the shader");
         }
         data->glDeleteShader(entry->id);
-        SDL_free(entry);
-        return NULL;
-    }
-
-    /* Link the shader entry in at the front of the cache */
-    if (data->shader_cache.head) {
-        entry->next = data->shader_cache.head;
-        data->shader_cache.head->prev = entry;
+        entry->id = 0;
+        return -1;
     }
-    data->shader_cache.head = entry;
-    ++data->shader_cache.count;
-    return entry;
+    return 0;
 }
 
 static void
@@ -1125,7 +1477,9 @@ GLES2_EvictShader(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *entry)
     --data->shader_cache.count;
 
     /* Deallocate the shader */
-    data->glDeleteShader(entry->id);
+    if (entry->id) {
+        data->glDeleteShader(entry->id);
+    }
     SDL_free(entry);
 }
 
@@ -1194,6 +1548,7 @@ GLES2_SelectProgram(SDL_Renderer *renderer, GLES2_ImageSource source, SDL_BlendM
 
     /* Select that program in OpenGL */
     data->glUseProgram(program->id);
+    SDL_RENDER_PROFILE_COUNT(renderer, program_changes);
 
     /* Set the current program */
     data->current_program = program;
@@ -1277,6 +1632,9 @@ static int GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const
 static int GLES2_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+static int GLES2_RenderGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                                const SDL_Vertex *vertices, int num_vertices,
+                                const int *indices, int num_indices);
 static int GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch);
 static void GLES2_RenderPresent(SDL_Renderer *renderer);
@@ -1341,9 +1699,12 @@ GLES2_RenderClear(SDL_Renderer * renderer)
 }
 
 static void
-GLES2_SetBlendMode(GLES2_DriverContext *data, int blendMode)
+GLES2_SetBlendMode(SDL_Renderer *renderer, int blendMode)
 {
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+
     if (blendMode != data->current.blendMode) {
+        SDL_RENDER_PROFILE_COUNT(renderer, blend_changes);
         switch (blendMode) {
         default:
         case SDL_BLENDMODE_NONE:
@@ -1380,16 +1741,15 @@ GLES2_SetTexCoords(GLES2_DriverContext * data, SDL_bool enabled)
 }
 
 static int
-GLES2_SetDrawingState(SDL_Renderer * renderer)
+GLES2_SetSolidState(SDL_Renderer * renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     const int blendMode = renderer->blendMode;
     GLES2_ProgramCacheEntry *program;
-    Uint8 r, g, b, a;
 
     GLES2_ActivateRenderer(renderer);
 
-    GLES2_SetBlendMode(data, blendMode);
+    GLES2_SetBlendMode(renderer, blendMode);
 
     GLES2_SetTexCoords(data, SDL_FALSE);
 
@@ -1399,18 +1759,13 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
     }
 
     /* Select the color to draw with */
-    g = renderer->g;
-    a = renderer->a;
-
     if (renderer->target &&
          (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
          renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-        r = renderer->b;
-        b = renderer->r;
-     } else {
-        r = renderer->r;
-        b = renderer->b;
-     }
+        const Uint8 tmp = r;
+        r = b;
+        b = tmp;
+    }
 
     program = data->current_program;
     if (!CompareColors(program->color_r, program->color_g, program->color_b, program->color_a, r, g, b, a)) {
@@ -1425,14 +1780,23 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
     return 0;
 }
 
+static int
+GLES2_SetDrawingState(SDL_Renderer * renderer)
+{
+    return GLES2_SetSolidState(renderer, renderer->r, renderer->g, renderer->b, renderer->a);
+}
+
 static int
 GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr,
                          const void *vertexData, size_t dataSizeInBytes)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const GLint size = (attr == GLES2_ATTRIBUTE_ANGLE) ? 1 : (attr == GLES2_ATTRIBUTE_COLOR) ? 4 : 2;
+    const GLenum type = (attr == GLES2_ATTRIBUTE_COLOR) ? GL_UNSIGNED_BYTE : GL_FLOAT;
+    const GLboolean normalized = (attr == GLES2_ATTRIBUTE_COLOR) ? GL_TRUE : GL_FALSE;
 
 #if !SDL_GLES2_USE_VBOS
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, vertexData);
+    data->glVertexAttribPointer(attr, size, type, normalized, 0, vertexData);
 #else
     if (!data->vertex_buffers[attr]) {
         data->glGenBuffers(1, &data->vertex_buffers[attr]);
@@ -1447,7 +1811,7 @@ GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr,
         data->glBufferSubData(GL_ARRAY_BUFFER, 0, dataSizeInBytes, vertexData);
     }
 
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, 0);
+    data->glVertexAttribPointer(attr, size, type, normalized, 0, 0);
 #endif
 
     return 0;
@@ -1666,19 +2030,27 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
     if (tdata->yuv) {
         data->glActiveTexture(GL_TEXTURE2);
         data->glBindTexture(tdata->texture_type, tdata->texture_v);
+        SDL_RENDER_PROFILE_COUNT(renderer, texture_binds);
 
         data->glActiveTexture(GL_TEXTURE1);
         data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        SDL_RENDER_PROFILE_COUNT(renderer, texture_binds);
 
         data->glActiveTexture(GL_TEXTURE0);
     }
     if (tdata->nv12) {
         data->glActiveTexture(GL_TEXTURE1);
         data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        SDL_RENDER_PROFILE_COUNT(renderer, texture_binds);
 
         data->glActiveTexture(GL_TEXTURE0);
     }
-    data->glBindTexture(tdata->texture_type, tdata->texture);
+    /* Copies from textures sharing an atlas page keep the same binding */
+    if (tdata->texture != data->current.texture) {
+        data->glBindTexture(tdata->texture_type, tdata->texture);
+        data->current.texture = tdata->texture;
+        SDL_RENDER_PROFILE_COUNT(renderer, texture_binds);
+    }
 
     /* Configure color modulation */
     g = texture->g;
@@ -1705,7 +2077,7 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
     }
 
     /* Configure texture blending */
-    GLES2_SetBlendMode(data, blendMode);
+    GLES2_SetBlendMode(renderer, blendMode);
 
     GLES2_SetTexCoords(data, SDL_TRUE);
     return 0;
@@ -1820,6 +2192,91 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     return GL_CheckError("", renderer);
 }
 
+static int
+GLES2_RenderGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                     const SDL_Vertex *vertices, int num_vertices,
+                     const int *indices, int num_indices)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    /* Without 32-bit indices, large meshes are drawn as plain triangles */
+    const SDL_bool unpack = (indices && num_vertices > 65536 && !data->element_index_uint);
+    const int count = unpack ? num_indices : num_vertices;
+    const SDL_bool swap_rb = (renderer->target &&
+                              (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
+                               renderer->target->format == SDL_PIXELFORMAT_RGB888));
+    GLfloat *positions, *texCoords;
+    GLubyte *colors;
+    GLushort *shortIndices = NULL;
+    void *buffer;
+    size_t size;
+    int i;
+
+    GLES2_ActivateRenderer(renderer);
+
+    if (texture) {
+        if (GLES2_SetupCopy(renderer, texture) < 0) {
+            return -1;
+        }
+    } else if (GLES2_SetSolidState(renderer, 255, 255, 255, 255) < 0) {
+        return -1;
+    }
+
+    size = count * (4 * sizeof(GLfloat) + 4);
+    if (indices && !unpack && num_vertices <= 65536) {
+        size += num_indices * sizeof(GLushort);
+    }
+    buffer = SDL_malloc(size);
+    if (!buffer) {
+        return SDL_OutOfMemory();
+    }
+    positions = (GLfloat *)buffer;
+    texCoords = positions + count * 2;
+    colors = (GLubyte *)(texCoords + count * 2);
+    if (indices && !unpack && num_vertices <= 65536) {
+        shortIndices = (GLushort *)(colors + count * 4);
+        for (i = 0; i < num_indices; ++i) {
+            shortIndices[i] = (GLushort)indices[i];
+        }
+    }
+
+    for (i = 0; i < count; ++i) {
+        const SDL_Vertex *vertex = unpack ? &vertices[indices[i]] : &vertices[i];
+
+        positions[i * 2] = vertex->x;
+        positions[i * 2 + 1] = vertex->y;
+        texCoords[i * 2] = vertex->u;
+        texCoords[i * 2 + 1] = vertex->v;
+        colors[i * 4] = swap_rb ? vertex->color.b : vertex->color.r;
+        colors[i * 4 + 1] = vertex->color.g;
+        colors[i * 4 + 2] = swap_rb ? vertex->color.r : vertex->color.b;
+        colors[i * 4 + 3] = vertex->color.a;
+    }
+
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, positions, count * 2 * sizeof(GLfloat));
+    if (texture) {
+        GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, texCoords, count * 2 * sizeof(GLfloat));
+    }
+    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_COLOR, colors, count * 4);
+
+    /* The whole mesh goes out in a single draw call */
+    if (shortIndices) {
+        data->glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_SHORT, shortIndices);
+    } else if (indices && !unpack) {
+        data->glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+    } else {
+        data->glDrawArrays(GL_TRIANGLES, 0, count);
+    }
+
+    /* The color stays white for everything else */
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+
+    SDL_free(buffer);
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch)
@@ -1828,8 +2285,9 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     Uint32 temp_format = renderer->target ? renderer->target->format : SDL_PIXELFORMAT_ABGR8888;
     void *temp_pixels;
     int temp_pitch;
-    Uint8 *src, *dst, *tmp;
-    int w, h, length, rows;
+    Uint8 *src;
+    int src_pitch;
+    int w, h;
     int status;
 
     GLES2_ActivateRenderer(renderer);
@@ -1845,34 +2303,141 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     data->glReadPixels(rect->x, renderer->target ? rect->y : (h-rect->y)-rect->h,
                        rect->w, rect->h, GL_RGBA, GL_UNSIGNED_BYTE, temp_pixels);
     if (GL_CheckError("glReadPixels()", renderer) < 0) {
+        SDL_free(temp_pixels);
         return -1;
     }
 
-    /* Flip the rows to be top-down if necessary */
+    /* The window's rows come bottom-up, so convert them from the last one
+       up, flipping them in the same pass */
+    src = (Uint8 *)temp_pixels;
+    src_pitch = temp_pitch;
     if (!renderer->target) {
-        length = rect->w * SDL_BYTESPERPIXEL(temp_format);
-        src = (Uint8*)temp_pixels + (rect->h-1)*temp_pitch;
-        dst = (Uint8*)temp_pixels;
-        tmp = SDL_stack_alloc(Uint8, length);
-        rows = rect->h / 2;
-        while (rows--) {
-            SDL_memcpy(tmp, dst, length);
-            SDL_memcpy(dst, src, length);
-            SDL_memcpy(src, tmp, length);
-            dst += temp_pitch;
-            src -= temp_pitch;
-        }
-        SDL_stack_free(tmp);
+        src += (rect->h - 1) * temp_pitch;
+        src_pitch = -temp_pitch;
     }
 
     status = SDL_ConvertPixels(rect->w, rect->h,
-                               temp_format, temp_pixels, temp_pitch,
+                               temp_format, src, src_pitch,
                                pixel_format, pixels, pitch);
     SDL_free(temp_pixels);
 
     return status;
 }
 
+static int
+GLES2_StartReadPixels(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const SDL_Rect *rect = &readback->rect;
+    GLES2_ReadbackData *rdata;
+    int w, h, y;
+    size_t size;
+
+    GLES2_ActivateRenderer(renderer);
+
+    readback->format = renderer->target ? renderer->target->format : SDL_PIXELFORMAT_ABGR8888;
+    readback->flipped = renderer->target ? SDL_FALSE : SDL_TRUE;
+    readback->pitch = rect->w * SDL_BYTESPERPIXEL(readback->format);
+    size = (size_t)readback->pitch * rect->h;
+
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    y = renderer->target ? rect->y : (h-rect->y)-rect->h;
+
+    if (!data->async_readback) {
+        /* Read now, and leave the flip and conversion for the finish */
+        readback->pixels = SDL_malloc(size);
+        if (!readback->pixels) {
+            return SDL_OutOfMemory();
+        }
+        data->glReadPixels(rect->x, y, rect->w, rect->h, GL_RGBA, GL_UNSIGNED_BYTE, readback->pixels);
+        return GL_CheckError("glReadPixels()", renderer);
+    }
+
+    rdata = (GLES2_ReadbackData *)SDL_calloc(1, sizeof(*rdata));
+    if (!rdata) {
+        return SDL_OutOfMemory();
+    }
+
+    /* The read goes into the buffer once the GPU gets to it */
+    GL_CheckError("", renderer);
+    data->glGenBuffers(1, &rdata->buffer);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, rdata->buffer);
+    data->glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    data->glReadPixels(rect->x, y, rect->w, rect->h, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    data->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    rdata->sync = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (GL_CheckError("glReadPixels()", renderer) < 0 || !rdata->sync) {
+        if (rdata->sync) {
+            data->glDeleteSync(rdata->sync);
+        }
+        data->glDeleteBuffers(1, &rdata->buffer);
+        SDL_free(rdata);
+        return -1;
+    }
+
+    readback->driverdata = rdata;
+    return 0;
+}
+
+static SDL_bool
+GLES2_ReadPixelsReady(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLES2_ReadbackData *rdata = (GLES2_ReadbackData *)readback->driverdata;
+    GLenum status;
+
+    GLES2_ActivateRenderer(renderer);
+
+    status = data->glClientWaitSync(rdata->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+}
+
+static int
+GLES2_FinishReadPixels(SDL_Renderer * renderer, SDL_RenderReadback * readback,
+                       Uint32 format, void * pixels, int pitch)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLES2_ReadbackData *rdata = (GLES2_ReadbackData *)readback->driverdata;
+    int status = 0;
+
+    if (!rdata) {
+        if (!pixels) {
+            return 0;
+        }
+        return SDL_ConvertReadbackPixels(readback, readback->pixels, readback->pitch,
+                                         format, pixels, pitch);
+    }
+
+    GLES2_ActivateRenderer(renderer);
+
+    if (pixels) {
+        const Uint64 timeout = 1000000000;  /* 1 second, in nanoseconds */
+        void *src;
+
+        while (data->glClientWaitSync(rdata->sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout) == GL_TIMEOUT_EXPIRED) {
+            continue;
+        }
+
+        data->glBindBuffer(GL_PIXEL_PACK_BUFFER, rdata->buffer);
+        src = data->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)readback->pitch * readback->rect.h, GL_MAP_READ_BIT);
+        if (src) {
+            status = SDL_ConvertReadbackPixels(readback, src, readback->pitch,
+                                               format, pixels, pitch);
+            data->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else {
+            status = SDL_SetError("glMapBufferRange() failed");
+        }
+        data->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    data->glDeleteSync(rdata->sync);
+    data->glDeleteBuffers(1, &rdata->buffer);
+    SDL_free(rdata);
+    readback->driverdata = NULL;
+
+    return status;
+}
+
 static void
 GLES2_RenderPresent(SDL_Renderer *renderer)
 {
@@ -1882,6 +2447,38 @@ GLES2_RenderPresent(SDL_Renderer *renderer)
     SDL_GL_SwapWindow(renderer->window);
 }
 
+static int
+GLES2_WarmUp(SDL_Renderer *renderer)
+{
+    static const GLES2_ImageSource sources[] = {
+        GLES2_IMAGESOURCE_SOLID,
+        GLES2_IMAGESOURCE_TEXTURE_ABGR,
+        GLES2_IMAGESOURCE_TEXTURE_ARGB,
+        GLES2_IMAGESOURCE_TEXTURE_RGB,
+        GLES2_IMAGESOURCE_TEXTURE_BGR
+    };
+    static const SDL_BlendMode blendModes[] = {
+        SDL_BLENDMODE_NONE,
+        SDL_BLENDMODE_BLEND,
+        SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_MOD
+    };
+    int i, j;
+
+    GLES2_ActivateRenderer(renderer);
+
+    /* Link every program for the RGB texture formats, so the first frames
+       that draw with them don't stall. YUV programs are left until needed. */
+    for (i = 0; i < SDL_arraysize(sources); ++i) {
+        for (j = 0; j < SDL_arraysize(blendModes); ++j) {
+            if (GLES2_SelectProgram(renderer, sources[i], blendModes[j]) < 0) {
+                return -1;
+            }
+        }
+    }
+    return GL_CheckError("", renderer);
+}
+
 
 /*************************************************************************************************
  * Bind/unbinding of textures
@@ -1895,6 +2492,7 @@ static int GLES2_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, flo
     GLES2_TextureData *texturedata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ActivateRenderer(renderer);
 
+    data->current.texture = 0;
     data->glBindTexture(texturedata->texture_type, texturedata->texture);
 
     if (texw) {
@@ -1913,6 +2511,7 @@ static int GLES2_UnbindTexture (SDL_Renderer * renderer, SDL_Texture *texture)
     GLES2_TextureData *texturedata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ActivateRenderer(renderer);
 
+    data->current.texture = 0;
     data->glBindTexture(texturedata->texture_type, 0);
 
     return 0;
@@ -1940,6 +2539,7 @@ GLES2_ResetState(SDL_Renderer *renderer)
 
     data->current.blendMode = -1;
     data->current.tex_coords = SDL_FALSE;
+    data->current.texture = 0;
 
     data->glActiveTexture(GL_TEXTURE0);
     data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
@@ -1953,6 +2553,10 @@ GLES2_ResetState(SDL_Renderer *renderer)
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_POSITION);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
 
+    /* Only geometry has vertex colors, everything else is drawn in white */
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+
     GL_CheckError("", renderer);
 }
 
@@ -1969,6 +2573,7 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     GLint window_framebuffer;
     GLint value;
     int profile_mask = 0, major = 0, minor = 0;
+    const char *version;
     SDL_bool changed_window = SDL_FALSE;
 
     if (SDL_GL_GetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, &profile_mask) < 0) {
@@ -2086,6 +2691,79 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     }
 #endif /* ZUNE_HD */
 
+    /* OpenGL ES 3.0 has GL_UNPACK_ROW_LENGTH and pixel unpack buffers */
+    version = (const char *)data->glGetString(GL_VERSION);
+    if (version && SDL_strncmp(version, "OpenGL ES ", 10) == 0 && SDL_atoi(version + 10) >= 3) {
+        data->unpack_subimage = SDL_TRUE;
+        data->element_index_uint = SDL_TRUE;
+#ifndef __SDL_NOGETPROCADDR__
+        data->glMapBufferRange = SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glUnmapBuffer = SDL_GL_GetProcAddress("glUnmapBuffer");
+        data->glDeleteBuffers = SDL_GL_GetProcAddress("glDeleteBuffers");
+        if (data->glMapBufferRange && data->glUnmapBuffer && data->glDeleteBuffers) {
+            data->pixel_buffers = SDL_TRUE;
+        }
+        data->glFenceSync = SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->pixel_buffers && data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->async_readback = SDL_TRUE;
+        }
+        data->glGetProgramBinary = SDL_GL_GetProcAddress("glGetProgramBinary");
+        data->glProgramBinary = SDL_GL_GetProcAddress("glProgramBinary");
+        data->glProgramParameteri = SDL_GL_GetProcAddress("glProgramParameteri");
+#endif
+    } else if (SDL_GL_ExtensionSupported("GL_EXT_unpack_subimage")) {
+        data->unpack_subimage = SDL_TRUE;
+    }
+    if (SDL_GL_ExtensionSupported("GL_OES_element_index_uint")) {
+        data->element_index_uint = SDL_TRUE;
+    }
+
+    /* Linked programs can be saved with OpenGL ES 3.0 or the OES extension */
+#ifndef __SDL_NOGETPROCADDR__
+    if (!data->glProgramBinary && SDL_GL_ExtensionSupported("GL_OES_get_program_binary")) {
+        data->glGetProgramBinary = SDL_GL_GetProcAddress("glGetProgramBinaryOES");
+        data->glProgramBinary = SDL_GL_GetProcAddress("glProgramBinaryOES");
+    }
+#endif
+    value = 0;
+    if (data->glGetProgramBinary && data->glProgramBinary) {
+        data->glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &value);
+    }
+    if (value > 0) {
+        const char *hint = SDL_GetHint(SDL_HINT_RENDER_PROGRAM_CACHE);
+
+        /* The cache writes to disk, so it's only used when the hint asks */
+        if (hint && SDL_strcmp(hint, "1") == 0) {
+            data->program_cache_path = SDL_GetPrefPath("libsdl", "programs");
+        } else if (hint && *hint && SDL_strcmp(hint, "0") != 0) {
+            const size_t len = SDL_strlen(hint);
+            data->program_cache_path = (char *)SDL_malloc(len + 2);
+            if (data->program_cache_path) {
+                SDL_strlcpy(data->program_cache_path, hint, len + 2);
+                if (hint[len - 1] != '/' && hint[len - 1] != '\\') {
+                    SDL_strlcat(data->program_cache_path, "/", len + 2);
+                }
+            }
+        }
+        if (data->program_cache_path) {
+            const char *vendor = (const char *)data->glGetString(GL_VENDOR);
+            const char *renderer_name = (const char *)data->glGetString(GL_RENDERER);
+            char identity[512];
+
+            /* Binaries are only good for the driver that produced them */
+            SDL_snprintf(identity, sizeof(identity), "%s\n%s\n%s",
+                         vendor ? vendor : "", renderer_name ? renderer_name : "",
+                         version ? version : "");
+            data->program_cache_identity = SDL_strdup(identity);
+            if (!data->program_cache_identity) {
+                SDL_free(data->program_cache_path);
+                data->program_cache_path = NULL;
+            }
+        }
+    }
+
     data->framebuffers = NULL;
     data->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &window_framebuffer);
     data->window_framebuffer = (GLuint)window_framebuffer;
@@ -2107,8 +2785,13 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->RenderFillRects     = &GLES2_RenderFillRects;
     renderer->RenderCopy          = &GLES2_RenderCopy;
     renderer->RenderCopyEx        = &GLES2_RenderCopyEx;
+    renderer->RenderGeometry      = &GLES2_RenderGeometry;
     renderer->RenderReadPixels    = &GLES2_RenderReadPixels;
+    renderer->StartReadPixels     = &GLES2_StartReadPixels;
+    renderer->ReadPixelsReady     = &GLES2_ReadPixelsReady;
+    renderer->FinishReadPixels    = &GLES2_FinishReadPixels;
     renderer->RenderPresent       = &GLES2_RenderPresent;
+    renderer->WarmUp              = &GLES2_WarmUp;
     renderer->DestroyTexture      = &GLES2_DestroyTexture;
     renderer->DestroyRenderer     = &GLES2_DestroyRenderer;
     renderer->GL_BindTexture      = &GLES2_BindTexture;
@@ -37,7 +37,9 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
     attribute vec2 a_texCoord; \
     attribute float a_angle; \
     attribute vec2 a_center; \
+    attribute vec4 a_color; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -47,6 +49,7 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
         mat2 rotationMatrix = mat2(c, -s, s, c); \
         vec2 position = rotationMatrix * (a_position - a_center) + a_center; \
         v_texCoord = a_texCoord; \
+        v_color = a_color; \
         gl_Position = u_projection * vec4(position, 0.0, 1.0);\
         gl_PointSize = 1.0; \
     } \
@@ -55,10 +58,11 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
 static const Uint8 GLES2_FragmentSrc_SolidSrc_[] = " \
     precision mediump float; \
     uniform vec4 u_color; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
-        gl_FragColor = u_color; \
+        gl_FragColor = u_color * v_color; \
     } \
 ";
 
@@ -67,11 +71,12 @@ static const Uint8 GLES2_FragmentSrc_TextureABGRSrc_[] = " \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
         gl_FragColor = texture2D(u_texture, v_texCoord); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -81,6 +86,7 @@ static const Uint8 GLES2_FragmentSrc_TextureARGBSrc_[] = " \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -88,7 +94,7 @@ static const Uint8 GLES2_FragmentSrc_TextureARGBSrc_[] = " \
         gl_FragColor = abgr; \
         gl_FragColor.r = abgr.b; \
         gl_FragColor.b = abgr.r; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -98,6 +104,7 @@ static const Uint8 GLES2_FragmentSrc_TextureRGBSrc_[] = " \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -106,7 +113,7 @@ static const Uint8 GLES2_FragmentSrc_TextureRGBSrc_[] = " \
         gl_FragColor.r = abgr.b; \
         gl_FragColor.b = abgr.r; \
         gl_FragColor.a = 1.0; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -116,13 +123,14 @@ static const Uint8 GLES2_FragmentSrc_TextureBGRSrc_[] = " \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
         vec4 abgr = texture2D(u_texture, v_texCoord); \
         gl_FragColor = abgr; \
         gl_FragColor.a = 1.0; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -134,6 +142,7 @@ static const Uint8 GLES2_FragmentSrc_TextureYUVSrc_[] = " \
     uniform sampler2D u_texture_v; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -146,7 +155,7 @@ static const Uint8 GLES2_FragmentSrc_TextureYUVSrc_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -157,6 +166,7 @@ static const Uint8 GLES2_FragmentSrc_TextureNV12Src_[] = " \
     uniform sampler2D u_texture_u; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -168,7 +178,7 @@ static const Uint8 GLES2_FragmentSrc_TextureNV12Src_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -179,6 +189,7 @@ static const Uint8 GLES2_FragmentSrc_TextureNV21Src_[] = " \
     uniform sampler2D u_texture_u; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -190,7 +201,7 @@ static const Uint8 GLES2_FragmentSrc_TextureNV21Src_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
@@ -23,6 +23,7 @@
 #if SDL_VIDEO_RENDER_PSP
 
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 #include "../SDL_sysrender.h"
 
 #include <pspkernel.h>
@@ -189,7 +190,8 @@ TextureNextPow2(unsigned int w)
 static int
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
 
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return GU_NEAREST; /* GU_NEAREST good for tile-map */
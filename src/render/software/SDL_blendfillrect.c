@@ -22,9 +22,20 @@
 
 #if !SDL_RENDER_DISABLED
 
+#include "SDL_cpuinfo.h"
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+/* The AVX2 kernels are built for AVX2 with SDL_TARGETING_AVX2, and only
+   used when SDL_HasAVX2() finds it at runtime. */
+#if HAVE_AVX2_INTRINSICS
+#include <immintrin.h>
+#endif
+
 
 static int
 SDL_BlendFillRect_RGB555(SDL_Surface * dst, const SDL_Rect * rect,
@@ -192,11 +203,339 @@ SDL_BlendFillRect_RGBA(SDL_Surface * dst, const SDL_Rect * rect,
     }
 }
 
+/* Blended spans for 32-bit formats with 8-bit channels and for RGB565/BGR565.
+
+   The color is set up once per fill in the destination's layout and a span
+   function blends it into one row. For 32-bit pixels every byte is handled
+   the same way:
+
+       BLEND, MOD:  out = DRAW_MUL(d, mul) + add
+       ADD:         out = MIN(d + add, 255)
+
+   BLEND multiplies every byte by inva and adds the premultiplied color, MOD
+   multiplies by the color and by 255 where there's no color channel, and
+   ADD adds nothing to the alpha byte. Bits outside the channels are cleared
+   afterwards with 'keep', like the scalar code does. RGB565 pixels keep the
+   three fields in the low three bytes of 'mul' and 'add', from the top field
+   down, and expand them to 8 bits with the same rounding as SDL_expand_byte.
+
+   Every kernel gives the same results as the scalar code above.
+ */
+typedef struct SDL_BlendSpan SDL_BlendSpan;
+
+typedef void (*SDL_BlendSpanFunc)(void *pixels, int width, const SDL_BlendSpan *span);
+
+struct SDL_BlendSpan
+{
+    SDL_BlendSpanFunc func;
+    SDL_BlendMode blendMode;
+    Uint32 mul;
+    Uint32 add;
+    Uint32 keep;
+};
+
+/* The pixels left over after the last whole vector */
+static void
+SDL_BlendSpanTail_8888(Uint32 *pixel, int width, const SDL_BlendSpan *span)
+{
+    while (width--) {
+        const Uint32 d = *pixel;
+        Uint32 out = 0;
+        int shift;
+
+        for (shift = 0; shift < 32; shift += 8) {
+            unsigned c = (d >> shift) & 0xFF;
+            const unsigned s = (span->add >> shift) & 0xFF;
+
+            if (span->blendMode == SDL_BLENDMODE_ADD) {
+                c += s;
+                if (c > 0xFF) c = 0xFF;
+            } else {
+                c = DRAW_MUL(c, (span->mul >> shift) & 0xFF) + s;
+            }
+            out |= (Uint32) c << shift;
+        }
+        *pixel++ = out & span->keep;
+    }
+}
+
+static void
+SDL_BlendSpanTail_565(Uint16 *pixel, int width, const SDL_BlendSpan *span)
+{
+    while (width--) {
+        const unsigned d = *pixel;
+        unsigned c[3];
+        int i;
+
+        c[0] = SDL_expand_byte[3][d >> 11];
+        c[1] = SDL_expand_byte[2][(d >> 5) & 0x3F];
+        c[2] = SDL_expand_byte[3][d & 0x1F];
+        for (i = 0; i < 3; ++i) {
+            const int shift = (2 - i) * 8;
+            const unsigned s = (span->add >> shift) & 0xFF;
+
+            if (span->blendMode == SDL_BLENDMODE_ADD) {
+                c[i] += s;
+                if (c[i] > 0xFF) c[i] = 0xFF;
+            } else {
+                c[i] = DRAW_MUL(c[i], (span->mul >> shift) & 0xFF) + s;
+            }
+        }
+        *pixel++ = (Uint16) (((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3));
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* DRAW_MUL(x, mul) + add for eight values; (t + 1 + (t >> 8)) >> 8 is t / 255
+   for every product of two bytes. */
+static SDL_INLINE __m128i
+BlendMulAdd_SSE2(const __m128i x, const __m128i mul, const __m128i add)
+{
+    const __m128i t = _mm_mullo_epi16(x, mul);
+    const __m128i q = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(t, _mm_set1_epi16(1)), _mm_srli_epi16(t, 8)), 8);
+    return _mm_add_epi16(q, add);
+}
+
+static void
+SDL_BlendSpan_8888_SSE2(void *pixels, int width, const SDL_BlendSpan *span)
+{
+    Uint32 *pixel = (Uint32 *) pixels;
+    const __m128i add = _mm_set1_epi32((int) span->add);
+    const __m128i keep = _mm_set1_epi32((int) span->keep);
+    int n = width / 4;
+
+    if (span->blendMode == SDL_BLENDMODE_ADD) {
+        for (; n; --n, pixel += 4) {
+            const __m128i d = _mm_loadu_si128((const __m128i *) pixel);
+            _mm_storeu_si128((__m128i *) pixel, _mm_and_si128(_mm_adds_epu8(d, add), keep));
+        }
+    } else {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i mul16 = _mm_unpacklo_epi8(_mm_set1_epi32((int) span->mul), zero);
+        const __m128i add16 = _mm_unpacklo_epi8(add, zero);
+
+        for (; n; --n, pixel += 4) {
+            const __m128i d = _mm_loadu_si128((const __m128i *) pixel);
+            const __m128i lo = BlendMulAdd_SSE2(_mm_unpacklo_epi8(d, zero), mul16, add16);
+            const __m128i hi = BlendMulAdd_SSE2(_mm_unpackhi_epi8(d, zero), mul16, add16);
+            _mm_storeu_si128((__m128i *) pixel, _mm_and_si128(_mm_packus_epi16(lo, hi), keep));
+        }
+    }
+    SDL_BlendSpanTail_8888(pixel, width & 3, span);
+}
+
+/* One 565 field, expanded to 8 bits, blended with the color */
+static SDL_INLINE __m128i
+BlendField565_SSE2(const __m128i x, const SDL_BlendSpan *span, int shift)
+{
+    const __m128i add = _mm_set1_epi16((short) ((span->add >> shift) & 0xFF));
+
+    if (span->blendMode == SDL_BLENDMODE_ADD) {
+        return _mm_min_epi16(_mm_add_epi16(x, add), _mm_set1_epi16(0xFF));
+    }
+    return BlendMulAdd_SSE2(x, _mm_set1_epi16((short) ((span->mul >> shift) & 0xFF)), add);
+}
+
+static void
+SDL_BlendSpan_565_SSE2(void *pixels, int width, const SDL_BlendSpan *span)
+{
+    Uint16 *pixel = (Uint16 *) pixels;
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    int n = width / 8;
+
+    for (; n; --n, pixel += 8) {
+        const __m128i d = _mm_loadu_si128((const __m128i *) pixel);
+        /* x * 255 / 31 and x * 255 / 63 rounded, like SDL_expand_byte[3] and [2] */
+        __m128i top = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(d, 11), _mm_set1_epi16(1053)), 7);
+        __m128i mid = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 5), mask6), _mm_set1_epi16(259)), _mm_set1_epi16(3)), 6);
+        __m128i bot = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(d, mask5), _mm_set1_epi16(1053)), 7);
+
+        top = BlendField565_SSE2(top, span, 16);
+        mid = BlendField565_SSE2(mid, span, 8);
+        bot = BlendField565_SSE2(bot, span, 0);
+        top = _mm_slli_epi16(_mm_srli_epi16(top, 3), 11);
+        mid = _mm_slli_epi16(_mm_srli_epi16(mid, 2), 5);
+        bot = _mm_srli_epi16(bot, 3);
+        _mm_storeu_si128((__m128i *) pixel, _mm_or_si128(_mm_or_si128(top, mid), bot));
+    }
+    SDL_BlendSpanTail_565(pixel, width & 7, span);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+BlendMulAdd_AVX2(const __m256i x, const __m256i mul, const __m256i add)
+{
+    const __m256i t = _mm256_mullo_epi16(x, mul);
+    const __m256i q = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(t, _mm256_set1_epi16(1)), _mm256_srli_epi16(t, 8)), 8);
+    return _mm256_add_epi16(q, add);
+}
+
+static SDL_TARGETING_AVX2 void
+SDL_BlendSpan_8888_AVX2(void *pixels, int width, const SDL_BlendSpan *span)
+{
+    Uint32 *pixel = (Uint32 *) pixels;
+    const __m256i add = _mm256_set1_epi32((int) span->add);
+    const __m256i keep = _mm256_set1_epi32((int) span->keep);
+    int n = width / 8;
+
+    if (span->blendMode == SDL_BLENDMODE_ADD) {
+        for (; n; --n, pixel += 8) {
+            const __m256i d = _mm256_loadu_si256((const __m256i *) pixel);
+            _mm256_storeu_si256((__m256i *) pixel, _mm256_and_si256(_mm256_adds_epu8(d, add), keep));
+        }
+    } else {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i mul16 = _mm256_unpacklo_epi8(_mm256_set1_epi32((int) span->mul), zero);
+        const __m256i add16 = _mm256_unpacklo_epi8(add, zero);
+
+        /* the unpacks and the pack work within 128-bit lanes, so they cancel out */
+        for (; n; --n, pixel += 8) {
+            const __m256i d = _mm256_loadu_si256((const __m256i *) pixel);
+            const __m256i lo = BlendMulAdd_AVX2(_mm256_unpacklo_epi8(d, zero), mul16, add16);
+            const __m256i hi = BlendMulAdd_AVX2(_mm256_unpackhi_epi8(d, zero), mul16, add16);
+            _mm256_storeu_si256((__m256i *) pixel, _mm256_and_si256(_mm256_packus_epi16(lo, hi), keep));
+        }
+    }
+    SDL_BlendSpanTail_8888(pixel, width & 7, span);
+}
+
+static SDL_INLINE SDL_TARGETING_AVX2 __m256i
+BlendField565_AVX2(const __m256i x, const SDL_BlendSpan *span, int shift)
+{
+    const __m256i add = _mm256_set1_epi16((short) ((span->add >> shift) & 0xFF));
+
+    if (span->blendMode == SDL_BLENDMODE_ADD) {
+        return _mm256_min_epi16(_mm256_add_epi16(x, add), _mm256_set1_epi16(0xFF));
+    }
+    return BlendMulAdd_AVX2(x, _mm256_set1_epi16((short) ((span->mul >> shift) & 0xFF)), add);
+}
+
+static SDL_TARGETING_AVX2 void
+SDL_BlendSpan_565_AVX2(void *pixels, int width, const SDL_BlendSpan *span)
+{
+    Uint16 *pixel = (Uint16 *) pixels;
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+    int n = width / 16;
+
+    for (; n; --n, pixel += 16) {
+        const __m256i d = _mm256_loadu_si256((const __m256i *) pixel);
+        __m256i top = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(d, 11), _mm256_set1_epi16(1053)), 7);
+        __m256i mid = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(d, 5), mask6), _mm256_set1_epi16(259)), _mm256_set1_epi16(3)), 6);
+        __m256i bot = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(d, mask5), _mm256_set1_epi16(1053)), 7);
+
+        top = BlendField565_AVX2(top, span, 16);
+        mid = BlendField565_AVX2(mid, span, 8);
+        bot = BlendField565_AVX2(bot, span, 0);
+        top = _mm256_slli_epi16(_mm256_srli_epi16(top, 3), 11);
+        mid = _mm256_slli_epi16(_mm256_srli_epi16(mid, 2), 5);
+        bot = _mm256_srli_epi16(bot, 3);
+        _mm256_storeu_si256((__m256i *) pixel, _mm256_or_si256(_mm256_or_si256(top, mid), bot));
+    }
+    SDL_BlendSpanTail_565(pixel, width & 15, span);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+/* Set up a span for the color, which is already premultiplied for BLEND and
+   ADD. Returns SDL_FALSE if there's no kernel for this format or CPU. */
+static SDL_bool
+SDL_SetupBlendSpan(SDL_Surface * dst, SDL_BlendMode blendMode,
+                   Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendSpan *span)
+{
+    const SDL_PixelFormat *fmt = dst->format;
+    const Uint32 inva = 0xff - a;
+    Uint32 color, other;
+    SDL_bool is_8888;
+
+    if (blendMode != SDL_BLENDMODE_BLEND &&
+        blendMode != SDL_BLENDMODE_ADD &&
+        blendMode != SDL_BLENDMODE_MOD) {
+        return SDL_FALSE;
+    }
+
+    if (fmt->BytesPerPixel == 4 &&
+        fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+        (fmt->Rshift % 8) == 0 && (fmt->Gshift % 8) == 0 && (fmt->Bshift % 8) == 0 &&
+        (!fmt->Amask || (fmt->Aloss == 0 && (fmt->Ashift % 8) == 0))) {
+        color = ((Uint32) r << fmt->Rshift) | ((Uint32) g << fmt->Gshift) | ((Uint32) b << fmt->Bshift);
+        other = ~(fmt->Rmask | fmt->Gmask | fmt->Bmask);
+        span->keep = fmt->Rmask | fmt->Gmask | fmt->Bmask | fmt->Amask;
+        is_8888 = SDL_TRUE;
+    } else if (fmt->BytesPerPixel == 2 && !fmt->Amask && fmt->Gmask == 0x07E0 &&
+               ((fmt->Rmask == 0xF800 && fmt->Bmask == 0x001F) ||
+                (fmt->Rmask == 0x001F && fmt->Bmask == 0xF800))) {
+        if (fmt->Rmask == 0xF800) {
+            color = ((Uint32) r << 16) | ((Uint32) g << 8) | b;
+        } else {
+            color = ((Uint32) b << 16) | ((Uint32) g << 8) | r;
+        }
+        other = 0;
+        span->keep = 0xFFFF;
+        is_8888 = SDL_FALSE;
+    } else {
+        return SDL_FALSE;
+    }
+
+    span->func = NULL;
+#if HAVE_AVX2_INTRINSICS
+    if (!span->func && SDL_HasAVX2()) {
+        span->func = is_8888 ? SDL_BlendSpan_8888_AVX2 : SDL_BlendSpan_565_AVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (!span->func && SDL_HasSSE2()) {
+        span->func = is_8888 ? SDL_BlendSpan_8888_SSE2 : SDL_BlendSpan_565_SSE2;
+    }
+#endif
+    if (!span->func) {
+        return SDL_FALSE;
+    }
+
+    span->blendMode = blendMode;
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        span->mul = inva * 0x01010101;
+        span->add = color | (other & ((Uint32) a * 0x01010101));
+        break;
+    case SDL_BLENDMODE_ADD:
+        span->mul = 0;
+        span->add = color;
+        break;
+    default:
+        span->mul = color | other;
+        span->add = 0;
+        break;
+    }
+    return SDL_TRUE;
+}
+
+/* Blend the color into an already clipped rectangle, a row at a time, or
+   all at once if the rows are contiguous. */
+static void
+SDL_BlendSpanRect(SDL_Surface * dst, const SDL_Rect * rect, const SDL_BlendSpan *span)
+{
+    const int bpp = dst->format->BytesPerPixel;
+    Uint8 *row = (Uint8 *) dst->pixels + rect->y * dst->pitch + rect->x * bpp;
+    int height = rect->h;
+
+    if (rect->w * bpp == dst->pitch) {
+        span->func(row, rect->w * height, span);
+        return;
+    }
+    while (height--) {
+        span->func(row, rect->w, span);
+        row += dst->pitch;
+    }
+}
+
 int
 SDL_BlendFillRect(SDL_Surface * dst, const SDL_Rect * rect,
                   SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     SDL_Rect clipped;
+    SDL_BlendSpan span;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -224,6 +563,11 @@ SDL_BlendFillRect(SDL_Surface * dst, const SDL_Rect * rect,
         b = DRAW_MUL(b, a);
     }
 
+    if (SDL_SetupBlendSpan(dst, blendMode, r, g, b, a, &span)) {
+        SDL_BlendSpanRect(dst, rect, &span);
+        return 0;
+    }
+
     switch (dst->format->BitsPerPixel) {
     case 15:
         switch (dst->format->Rmask) {
@@ -263,6 +607,7 @@ int
 SDL_BlendFillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
                    SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
+    SDL_BlendSpan span;
     SDL_Rect rect;
     int i;
     int (*func)(SDL_Surface * dst, const SDL_Rect * rect,
@@ -284,6 +629,16 @@ SDL_BlendFillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         b = DRAW_MUL(b, a);
     }
 
+    /* The span is set up once and used for every rectangle */
+    if (SDL_SetupBlendSpan(dst, blendMode, r, g, b, a, &span)) {
+        for (i = 0; i < count; ++i) {
+            if (SDL_IntersectRect(&rects[i], &dst->clip_rect, &rect)) {
+                SDL_BlendSpanRect(dst, &rect, &span);
+            }
+        }
+        return 0;
+    }
+
     /* FIXME: Does this function pointer slow things down significantly? */
     switch (dst->format->BitsPerPixel) {
     case 15:
@@ -23,6 +23,7 @@
 #if !SDL_RENDER_DISABLED
 
 #include "SDL_draw.h"
+#include "SDL_blendfillrect.h"
 #include "SDL_blendline.h"
 #include "SDL_blendpoint.h"
 
@@ -704,6 +705,33 @@ SDL_CalculateBlendLineFunc(const SDL_PixelFormat * fmt)
     return NULL;
 }
 
+/* A horizontal line covers the same pixels as a rectangle one pixel high,
+   so it goes through the blended fill spans. */
+static void
+SDL_BlendHLine(SDL_Surface * dst, int x1, int y1, int x2,
+               SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a,
+               SDL_bool draw_end)
+{
+    SDL_Rect rect;
+
+    if (x1 <= x2) {
+        rect.x = x1;
+        rect.w = x2 - x1;
+    } else {
+        rect.x = x2 + 1;
+        rect.w = x1 - x2;
+    }
+    if (draw_end) {
+        if (x1 > x2) {
+            --rect.x;
+        }
+        ++rect.w;
+    }
+    rect.y = y1;
+    rect.h = 1;
+    SDL_BlendFillRect(dst, &rect, blendMode, r, g, b, a);
+}
+
 int
 SDL_BlendLine(SDL_Surface * dst, int x1, int y1, int x2, int y2,
               SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
@@ -725,7 +753,11 @@ SDL_BlendLine(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         return 0;
     }
 
-    func(dst, x1, y1, x2, y2, blendMode, r, g, b, a, SDL_TRUE);
+    if (y1 == y2 && blendMode != SDL_BLENDMODE_NONE) {
+        SDL_BlendHLine(dst, x1, y1, x2, blendMode, r, g, b, a, SDL_TRUE);
+    } else {
+        func(dst, x1, y1, x2, y2, blendMode, r, g, b, a, SDL_TRUE);
+    }
     return 0;
 }
 
@@ -763,7 +795,11 @@ SDL_BlendLines(SDL_Surface * dst, const SDL_Point * points, int count,
         /* Draw the end if it was clipped */
         draw_end = (x2 != points[i].x || y2 != points[i].y);
 
-        func(dst, x1, y1, x2, y2, blendMode, r, g, b, a, draw_end);
+        if (y1 == y2 && blendMode != SDL_BLENDMODE_NONE) {
+            SDL_BlendHLine(dst, x1, y1, x2, blendMode, r, g, b, a, draw_end);
+        } else {
+            func(dst, x1, y1, x2, y2, blendMode, r, g, b, a, draw_end);
+        }
     }
     if (points[0].x != points[count-1].x || points[0].y != points[count-1].y) {
         SDL_BlendPoint(dst, points[count-1].x, points[count-1].y,
@@ -25,6 +25,7 @@
 #include "../SDL_sysrender.h"
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
+#include "../../SDL_hints_c.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -68,6 +69,9 @@ static int SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                           const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip);
+static int SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Vertex * vertices, int num_vertices,
+                             const int * indices, int num_indices);
 static int SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                Uint32 format, void * pixels, int pitch);
 static void SW_RenderPresent(SDL_Renderer * renderer);
@@ -95,12 +99,100 @@ SDL_RenderDriver SW_RenderDriver = {
      0}
 };
 
+/* The most separate areas of the window tracked between presents */
+#define SW_MAX_DAMAGE_RECTS 16
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The parts of the window surface drawn to since the last present. They
+       never overlap, so their areas add up to the pixels to update. */
+    SDL_Rect damage[SW_MAX_DAMAGE_RECTS];
+    int num_damage;
+    SDL_bool full_damage;
 } SW_RenderData;
 
+static int
+SW_RectArea(const SDL_Rect * rect)
+{
+    return rect->w * rect->h;
+}
+
+static void
+SW_MergeDamage(SW_RenderData * data, SDL_Rect area)
+{
+    SDL_Rect merged;
+    int i, best, growth, best_growth;
+
+    /* Merge it with the rects it overlaps, or that it nearly fills out to a
+       rectangle along with it, until it stands apart from all of them */
+    for (i = 0; i < data->num_damage; ) {
+        SDL_UnionRect(&area, &data->damage[i], &merged);
+        if (SDL_HasIntersection(&area, &data->damage[i]) ||
+            SW_RectArea(&merged) * 3 <= (SW_RectArea(&area) + SW_RectArea(&data->damage[i])) * 4) {
+            area = merged;
+            data->damage[i] = data->damage[--data->num_damage];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    /* Without room for another rect, grow the one that grows the least */
+    if (data->num_damage == SW_MAX_DAMAGE_RECTS) {
+        best = 0;
+        best_growth = -1;
+        for (i = 0; i < data->num_damage; ++i) {
+            SDL_UnionRect(&area, &data->damage[i], &merged);
+            growth = SW_RectArea(&merged) - SW_RectArea(&data->damage[i]);
+            if (best_growth < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        SDL_UnionRect(&area, &data->damage[best], &merged);
+        data->damage[best] = data->damage[--data->num_damage];
+        SW_MergeDamage(data, merged);
+        return;
+    }
+
+    if (area.w == data->window->w && area.h == data->window->h) {
+        data->full_damage = SDL_TRUE;
+        data->num_damage = 0;
+    } else {
+        data->damage[data->num_damage++] = area;
+    }
+}
+
+static void
+SW_AddDamage(SDL_Renderer * renderer, const SDL_Rect * rect)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Rect area;
+
+    /* Drawing into a texture doesn't change the window until it's copied */
+    if (data->full_damage || !data->surface || data->surface != data->window) {
+        return;
+    }
+
+    /* Everything drawn is clipped to the viewport and clip rect */
+    if (SDL_IntersectRect(rect, &data->surface->clip_rect, &area)) {
+        SW_MergeDamage(data, area);
+    }
+}
+
+static void
+SW_AddFullDamage(SDL_Renderer * renderer)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+
+    if (data->surface == data->window) {
+        data->full_damage = SDL_TRUE;
+        data->num_damage = 0;
+    }
+}
 
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
@@ -114,6 +206,8 @@ SW_ActivateRenderer(SDL_Renderer * renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->full_damage = SDL_TRUE;
+            data->num_damage = 0;
 
             SW_UpdateViewport(renderer);
             SW_UpdateClipRect(renderer);
@@ -147,6 +241,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->full_damage = SDL_TRUE;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -166,6 +261,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->RenderFillRects = SW_RenderFillRects;
     renderer->RenderCopy = SW_RenderCopy;
     renderer->RenderCopyEx = SW_RenderCopyEx;
+    renderer->RenderGeometry = SW_RenderGeometry;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
     renderer->DestroyTexture = SW_DestroyTexture;
@@ -198,6 +294,10 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        /* The window system may have lost what it was last shown */
+        data->full_damage = SDL_TRUE;
+        data->num_damage = 0;
     }
 }
 
@@ -398,6 +498,7 @@ SW_RenderClear(SDL_Renderer * renderer)
     SDL_SetClipRect(surface, NULL);
     SDL_FillRect(surface, NULL, color);
     SDL_SetClipRect(surface, &clip_rect);
+    SW_AddFullDamage(renderer);
     return 0;
 }
 
@@ -407,6 +508,7 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
+    SDL_Rect bounds;
     int i, status;
 
     if (!surface) {
@@ -432,6 +534,10 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    if (SDL_EnclosePoints(final_points, count, NULL, &bounds)) {
+        SW_AddDamage(renderer, &bounds);
+    }
+
     /* Draw the points! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -456,6 +562,7 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
+    SDL_Rect bounds;
     int i, status;
 
     if (!surface) {
@@ -481,6 +588,10 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    if (SDL_EnclosePoints(final_points, count, NULL, &bounds)) {
+        SW_AddDamage(renderer, &bounds);
+    }
+
     /* Draw the lines! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -533,6 +644,10 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
         }
     }
 
+    for (i = 0; i < count; ++i) {
+        SW_AddDamage(renderer, &final_rects[i]);
+    }
+
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
                                    renderer->r, renderer->g, renderer->b,
@@ -571,6 +686,8 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     final_rect.w = (int)dstrect->w;
     final_rect.h = (int)dstrect->h;
 
+    SW_AddDamage(renderer, &final_rect);
+
     if ( srcrect->w == final_rect.w && srcrect->h == final_rect.h ) {
         return SDL_BlitSurface(src, srcrect, surface, &final_rect);
     } else {
@@ -585,7 +702,8 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int
 GetScaleQuality(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    static SDL_HintCache scale_quality = { SDL_HINT_RENDER_SCALE_QUALITY };
+    const char *hint = SDL_GetCachedHint(&scale_quality);
 
     if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
         return 0;
@@ -759,6 +877,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
             tmp_rect.w = dstwidth;
             tmp_rect.h = dstheight;
 
+            SW_AddDamage(renderer, &tmp_rect);
+
             /* The NONE blend mode needs some special care with non-opaque surfaces.
              * Other blend modes or opaque surfaces can be blitted directly.
              */
@@ -826,6 +946,354 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval;
 }
 
+/* Triangle edges are walked in fixed point with this many fractional bits */
+#define SW_SUBPIXEL_BITS    8
+#define SW_SUBPIXEL_ONE     (1 << SW_SUBPIXEL_BITS)
+
+/* Coordinates past this, in pixels, would overflow the edge functions */
+#define SW_MAX_COORDINATE   (1 << 20)
+
+static Sint64
+SW_FloorDiv(Sint64 a, Sint64 b)
+{
+    /* b is always positive */
+    return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+static void
+SW_ReadPixel(const SDL_Surface * surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a)
+{
+    const SDL_PixelFormat *format = surface->format;
+    const Uint8 *p = (const Uint8 *)surface->pixels + y * surface->pitch + x * format->BytesPerPixel;
+    Uint32 pixel;
+
+    switch (format->BytesPerPixel) {
+    case 1:
+        pixel = *p;
+        break;
+    case 2:
+        pixel = *(const Uint16 *)p;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+        pixel = (p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+        break;
+    default:
+        pixel = *(const Uint32 *)p;
+        if (format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0) {
+            *r = (Uint8)(pixel >> format->Rshift);
+            *g = (Uint8)(pixel >> format->Gshift);
+            *b = (Uint8)(pixel >> format->Bshift);
+            *a = format->Amask ? (Uint8)(pixel >> format->Ashift) : 255;
+            return;
+        }
+        break;
+    }
+    SDL_GetRGBA(pixel, format, r, g, b, a);
+}
+
+static void
+SW_WritePixel(SDL_Surface * surface, int x, int y, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const SDL_PixelFormat *format = surface->format;
+    Uint8 *p = (Uint8 *)surface->pixels + y * surface->pitch + x * format->BytesPerPixel;
+    Uint32 pixel;
+
+    if (format->BytesPerPixel == 4 && format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0) {
+        pixel = ((Uint32)r << format->Rshift) | ((Uint32)g << format->Gshift) | ((Uint32)b << format->Bshift);
+        if (format->Amask) {
+            pixel |= (Uint32)a << format->Ashift;
+        }
+        *(Uint32 *)p = pixel;
+        return;
+    }
+
+    pixel = SDL_MapRGBA(format, r, g, b, a);
+    switch (format->BytesPerPixel) {
+    case 1:
+        *p = (Uint8)pixel;
+        break;
+    case 2:
+        *(Uint16 *)p = (Uint16)pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        p[0] = (Uint8)pixel;
+        p[1] = (Uint8)(pixel >> 8);
+        p[2] = (Uint8)(pixel >> 16);
+#else
+        p[0] = (Uint8)(pixel >> 16);
+        p[1] = (Uint8)(pixel >> 8);
+        p[2] = (Uint8)pixel;
+#endif
+        break;
+    default:
+        *(Uint32 *)p = pixel;
+        break;
+    }
+}
+
+/* Shades a span of a triangle one pixel at a time, with the color and texture
+   coordinates starting at attr[] and stepping by step[] */
+static void
+SW_ShadeSpan(SDL_Surface * surface, SDL_Surface * src, SDL_BlendMode blendMode,
+             const Uint8 *mod, int x, int y, int w, float *attr, const float *step)
+{
+    Uint8 sr, sg, sb, sa, dr, dg, db, da;
+    int tx, ty, r, g, b, a;
+    int i, k;
+
+    for (i = 0; i < w; ++i) {
+        r = (int)attr[0];
+        g = (int)attr[1];
+        b = (int)attr[2];
+        a = (int)attr[3];
+        if (src) {
+            tx = (int)(attr[4] * src->w);
+            ty = (int)(attr[5] * src->h);
+            tx = SDL_max(0, SDL_min(tx, src->w - 1));
+            ty = SDL_max(0, SDL_min(ty, src->h - 1));
+            SW_ReadPixel(src, tx, ty, &sr, &sg, &sb, &sa);
+            r = (sr * r * mod[0]) / (255 * 255);
+            g = (sg * g * mod[1]) / (255 * 255);
+            b = (sb * b * mod[2]) / (255 * 255);
+            a = (sa * a * mod[3]) / (255 * 255);
+        }
+        r = SDL_max(0, SDL_min(r, 255));
+        g = SDL_max(0, SDL_min(g, 255));
+        b = SDL_max(0, SDL_min(b, 255));
+        a = SDL_max(0, SDL_min(a, 255));
+
+        switch (blendMode) {
+        case SDL_BLENDMODE_BLEND:
+            SW_ReadPixel(surface, x + i, y, &dr, &dg, &db, &da);
+            r = (r * a + dr * (255 - a)) / 255;
+            g = (g * a + dg * (255 - a)) / 255;
+            b = (b * a + db * (255 - a)) / 255;
+            a = a + (da * (255 - a)) / 255;
+            break;
+        case SDL_BLENDMODE_ADD:
+            SW_ReadPixel(surface, x + i, y, &dr, &dg, &db, &da);
+            r = SDL_min(dr + (r * a) / 255, 255);
+            g = SDL_min(dg + (g * a) / 255, 255);
+            b = SDL_min(db + (b * a) / 255, 255);
+            a = da;
+            break;
+        case SDL_BLENDMODE_MOD:
+            SW_ReadPixel(surface, x + i, y, &dr, &dg, &db, &da);
+            r = (r * dr) / 255;
+            g = (g * dg) / 255;
+            b = (b * db) / 255;
+            a = da;
+            break;
+        default:
+            break;
+        }
+        SW_WritePixel(surface, x + i, y, (Uint8)r, (Uint8)g, (Uint8)b, (Uint8)a);
+
+        for (k = 0; k < 6; ++k) {
+            attr[k] += step[k];
+        }
+    }
+}
+
+/* Rasterizes a triangle with edge functions evaluated at pixel centers. The
+   pixels exactly on an edge belong to the triangle only if it's a top or a
+   left edge, so triangles sharing an edge never draw a pixel twice. */
+static void
+SW_RenderTriangle(SDL_Renderer * renderer, SDL_Surface * surface, SDL_Surface * src,
+                  SDL_BlendMode blendMode, const Uint8 *mod, const SDL_Vertex *v[3])
+{
+    const SDL_Rect *clip = &surface->clip_rect;
+    Sint64 X[3], Y[3], E[3], stepx[3], stepy[3], bias[3];
+    Sint64 area, lo, hi, e;
+    float attr[3][6], dattr[6], row[6];
+    SDL_bool flat;
+    SDL_Rect bounds, span;
+    Uint32 color = 0;
+    int i, k, y, minx, miny, maxx, maxy;
+
+    for (i = 0; i < 3; ++i) {
+        const float vx = v[i]->x + renderer->viewport.x;
+        const float vy = v[i]->y + renderer->viewport.y;
+
+        if (vx < -SW_MAX_COORDINATE || vx > SW_MAX_COORDINATE ||
+            vy < -SW_MAX_COORDINATE || vy > SW_MAX_COORDINATE) {
+            return;
+        }
+        X[i] = (Sint64)SDL_floor(vx * SW_SUBPIXEL_ONE + 0.5f);
+        Y[i] = (Sint64)SDL_floor(vy * SW_SUBPIXEL_ONE + 0.5f);
+    }
+
+    area = (X[1] - X[0]) * (Y[2] - Y[0]) - (Y[1] - Y[0]) * (X[2] - X[0]);
+    if (area == 0) {
+        return;
+    }
+    if (area < 0) {
+        const SDL_Vertex *tmp = v[1];
+        Sint64 t;
+
+        v[1] = v[2];
+        v[2] = tmp;
+        t = X[1]; X[1] = X[2]; X[2] = t;
+        t = Y[1]; Y[1] = Y[2]; Y[2] = t;
+        area = -area;
+    }
+
+    /* The pixels whose centers are inside, clipped */
+    minx = (int)SW_FloorDiv(SDL_min(X[0], SDL_min(X[1], X[2])), SW_SUBPIXEL_ONE);
+    miny = (int)SW_FloorDiv(SDL_min(Y[0], SDL_min(Y[1], Y[2])), SW_SUBPIXEL_ONE);
+    maxx = (int)SW_FloorDiv(SDL_max(X[0], SDL_max(X[1], X[2])), SW_SUBPIXEL_ONE);
+    maxy = (int)SW_FloorDiv(SDL_max(Y[0], SDL_max(Y[1], Y[2])), SW_SUBPIXEL_ONE);
+    minx = SDL_max(minx, clip->x);
+    miny = SDL_max(miny, clip->y);
+    maxx = SDL_min(maxx, clip->x + clip->w - 1);
+    maxy = SDL_min(maxy, clip->y + clip->h - 1);
+    if (minx > maxx || miny > maxy) {
+        return;
+    }
+    bounds.x = minx;
+    bounds.y = miny;
+    bounds.w = maxx - minx + 1;
+    bounds.h = maxy - miny + 1;
+    SW_AddDamage(renderer, &bounds);
+
+    /* Edge i is opposite vertex i, and is its weight at a point */
+    for (i = 0; i < 3; ++i) {
+        const int a = (i + 1) % 3, b = (i + 2) % 3;
+        const Sint64 dx = X[b] - X[a], dy = Y[b] - Y[a];
+        const Sint64 px = (Sint64)minx * SW_SUBPIXEL_ONE + SW_SUBPIXEL_ONE / 2;
+        const Sint64 py = (Sint64)miny * SW_SUBPIXEL_ONE + SW_SUBPIXEL_ONE / 2;
+
+        E[i] = dx * (py - Y[a]) - dy * (px - X[a]);
+        stepx[i] = -dy * SW_SUBPIXEL_ONE;
+        stepy[i] = dx * SW_SUBPIXEL_ONE;
+        bias[i] = ((dy == 0 && dx > 0) || dy < 0) ? 0 : -1;
+    }
+
+    for (i = 0; i < 3; ++i) {
+        attr[i][0] = v[i]->color.r;
+        attr[i][1] = v[i]->color.g;
+        attr[i][2] = v[i]->color.b;
+        attr[i][3] = v[i]->color.a;
+        attr[i][4] = v[i]->u;
+        attr[i][5] = v[i]->v;
+    }
+    for (k = 0; k < 6; ++k) {
+        dattr[k] = (float)((stepx[0] * attr[0][k] + stepx[1] * attr[1][k] + stepx[2] * attr[2][k]) / (double)area);
+    }
+
+    /* Untextured triangles in one color are filled a span at a time */
+    flat = (!src &&
+            v[0]->color.r == v[1]->color.r && v[0]->color.r == v[2]->color.r &&
+            v[0]->color.g == v[1]->color.g && v[0]->color.g == v[2]->color.g &&
+            v[0]->color.b == v[1]->color.b && v[0]->color.b == v[2]->color.b &&
+            v[0]->color.a == v[1]->color.a && v[0]->color.a == v[2]->color.a);
+    if (flat && blendMode == SDL_BLENDMODE_NONE) {
+        color = SDL_MapRGBA(surface->format, v[0]->color.r, v[0]->color.g, v[0]->color.b, v[0]->color.a);
+    }
+
+    for (y = miny; y <= maxy; ++y) {
+        /* Where all three edges are inside along this row */
+        lo = 0;
+        hi = maxx - minx;
+        for (i = 0; i < 3 && lo <= hi; ++i) {
+            e = E[i] + bias[i];
+            if (stepx[i] > 0) {
+                lo = SDL_max(lo, -SW_FloorDiv(e, stepx[i]));
+            } else if (stepx[i] < 0) {
+                hi = SDL_min(hi, SW_FloorDiv(e, -stepx[i]));
+            } else if (e < 0) {
+                hi = -1;
+            }
+        }
+
+        if (lo <= hi) {
+            span.x = minx + (int)lo;
+            span.y = y;
+            span.w = (int)(hi - lo) + 1;
+            span.h = 1;
+            if (flat && blendMode == SDL_BLENDMODE_NONE) {
+                SDL_FillRect(surface, &span, color);
+            } else if (flat) {
+                SDL_BlendFillRect(surface, &span, blendMode,
+                                  v[0]->color.r, v[0]->color.g, v[0]->color.b, v[0]->color.a);
+            } else {
+                for (k = 0; k < 6; ++k) {
+                    row[k] = (float)(((E[0] + lo * stepx[0]) * attr[0][k] +
+                                      (E[1] + lo * stepx[1]) * attr[1][k] +
+                                      (E[2] + lo * stepx[2]) * attr[2][k]) / (double)area);
+                }
+                SW_ShadeSpan(surface, src, blendMode, mod, span.x, y, span.w, row, dattr);
+            }
+        }
+
+        for (i = 0; i < 3; ++i) {
+            E[i] += stepy[i];
+        }
+    }
+}
+
+static int
+SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Vertex * vertices, int num_vertices,
+                  const int * indices, int num_indices)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SDL_Surface *src = NULL;
+    SDL_BlendMode blendMode = renderer->blendMode;
+    Uint8 mod[4] = { 255, 255, 255, 255 };
+    const SDL_Vertex *v[3];
+    const int count = indices ? num_indices : num_vertices;
+    int i;
+
+    if (!surface) {
+        return -1;
+    }
+
+    if (texture) {
+        src = (SDL_Surface *) texture->driverdata;
+        blendMode = texture->blendMode;
+        mod[0] = texture->r;
+        mod[1] = texture->g;
+        mod[2] = texture->b;
+        mod[3] = texture->a;
+        if (SDL_MUSTLOCK(src) && SDL_LockSurface(src) < 0) {
+            return -1;
+        }
+    }
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) < 0) {
+        if (src && SDL_MUSTLOCK(src)) {
+            SDL_UnlockSurface(src);
+        }
+        return -1;
+    }
+
+    for (i = 0; i + 2 < count; i += 3) {
+        if (indices) {
+            v[0] = &vertices[indices[i]];
+            v[1] = &vertices[indices[i + 1]];
+            v[2] = &vertices[indices[i + 2]];
+        } else {
+            v[0] = &vertices[i];
+            v[1] = &vertices[i + 1];
+            v[2] = &vertices[i + 2];
+        }
+        SW_RenderTriangle(renderer, surface, src, blendMode, mod, v);
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+    if (src && SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return 0;
+}
+
 static int
 SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 format, void * pixels, int pitch)
@@ -865,11 +1333,30 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_RenderPresentStats *stats = &renderer->present_stats;
     SDL_Window *window = renderer->window;
+    int i;
+
+    if (!window) {
+        return;
+    }
 
-    if (window) {
+    /* Only copy out what was drawn, if the surface is still the window's */
+    if (data->full_damage || !data->window) {
         SDL_UpdateWindowSurface(window);
+    } else {
+        stats->rects = data->num_damage;
+        stats->damaged_pixels = 0;
+        for (i = 0; i < data->num_damage; ++i) {
+            stats->damaged_pixels += SW_RectArea(&data->damage[i]);
+        }
+        if (data->num_damage > 0) {
+            SDL_UpdateWindowSurfaceRects(window, data->damage, data->num_damage);
+        }
     }
+    data->full_damage = SDL_FALSE;
+    data->num_damage = 0;
 }
 
 static void
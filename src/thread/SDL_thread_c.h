@@ -42,6 +42,10 @@
 #endif
 #include "../SDL_error_c.h"
 
+/* Convert a millisecond timeout to nanoseconds, keeping SDL_MUTEX_MAXWAIT infinite */
+#define SDL_TIMEOUT_MS_TO_NS(ms) \
+    (((ms) == SDL_MUTEX_MAXWAIT) ? SDL_MUTEX_MAXWAIT_NS : ((Uint64)(ms) * 1000000))
+
 typedef enum SDL_ThreadState
 {
     SDL_THREAD_STATE_ALIVE,
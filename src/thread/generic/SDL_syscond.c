@@ -27,6 +27,7 @@
  */
 
 #include "SDL_thread.h"
+#include "../SDL_thread_c.h"
 
 struct SDL_cond
 {
@@ -135,7 +136,7 @@ SDL_CondBroadcast(SDL_cond * cond)
     return 0;
 }
 
-/* Wait on the condition variable for at most 'ms' milliseconds.
+/* Wait on the condition variable for at most 'ns' nanoseconds.
    The mutex must be locked before entering this function!
    The mutex is unlocked during the wait, and locked again after the wait.
 
@@ -157,7 +158,7 @@ Thread B:
     SDL_UnlockMutex(lock);
  */
 int
-SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+SDL_CondWaitTimeoutNS(SDL_cond * cond, SDL_mutex * mutex, Uint64 ns)
 {
     int retval;
 
@@ -177,10 +178,10 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
     SDL_UnlockMutex(mutex);
 
     /* Wait for a signal */
-    if (ms == SDL_MUTEX_MAXWAIT) {
+    if (ns == SDL_MUTEX_MAXWAIT_NS) {
         retval = SDL_SemWait(cond->wait_sem);
     } else {
-        retval = SDL_SemWaitTimeout(cond->wait_sem, ms);
+        retval = SDL_SemWaitTimeoutNS(cond->wait_sem, ns);
     }
 
     /* Let the signaler know we have completed the wait, otherwise
@@ -210,11 +211,18 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
     return retval;
 }
 
+/* Wait on the condition variable for at most 'ms' milliseconds */
+int
+SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+{
+    return SDL_CondWaitTimeoutNS(cond, mutex, SDL_TIMEOUT_MS_TO_NS(ms));
+}
+
 /* Wait on the condition variable forever */
 int
 SDL_CondWait(SDL_cond * cond, SDL_mutex * mutex)
 {
-    return SDL_CondWaitTimeout(cond, mutex, SDL_MUTEX_MAXWAIT);
+    return SDL_CondWaitTimeoutNS(cond, mutex, SDL_MUTEX_MAXWAIT_NS);
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -25,6 +25,7 @@
 #include "SDL_timer.h"
 #include "SDL_thread.h"
 #include "SDL_systhread_c.h"
+#include "../SDL_thread_c.h"
 
 
 #if SDL_THREADS_DISABLED
@@ -53,6 +54,12 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     return SDL_SetError("SDL not built with thread support");
 }
 
+int
+SDL_SemWaitTimeoutNS(SDL_sem * sem, Uint64 timeout)
+{
+    return SDL_SetError("SDL not built with thread support");
+}
+
 int
 SDL_SemWait(SDL_sem * sem)
 {
@@ -147,7 +154,7 @@ SDL_SemTryWait(SDL_sem * sem)
 }
 
 int
-SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+SDL_SemWaitTimeoutNS(SDL_sem * sem, Uint64 timeout)
 {
     int retval;
 
@@ -164,8 +171,8 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     ++sem->waiters_count;
     retval = 0;
     while ((sem->count == 0) && (retval != SDL_MUTEX_TIMEDOUT)) {
-        retval = SDL_CondWaitTimeout(sem->count_nonzero,
-                                     sem->count_lock, timeout);
+        retval = SDL_CondWaitTimeoutNS(sem->count_nonzero,
+                                       sem->count_lock, timeout);
     }
     --sem->waiters_count;
     if (retval == 0) {
@@ -176,10 +183,16 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     return retval;
 }
 
+int
+SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+{
+    return SDL_SemWaitTimeoutNS(sem, SDL_TIMEOUT_MS_TO_NS(timeout));
+}
+
 int
 SDL_SemWait(SDL_sem * sem)
 {
-    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+    return SDL_SemWaitTimeoutNS(sem, SDL_MUTEX_MAXWAIT_NS);
 }
 
 Uint32
@@ -29,6 +29,7 @@
 
 #include "SDL_error.h"
 #include "SDL_thread.h"
+#include "../SDL_thread_c.h"
 
 #include <pspthreadman.h>
 #include <pspkerror.h>
@@ -73,12 +74,13 @@ void SDL_DestroySemaphore(SDL_sem *sem)
 }
 
 /* TODO: This routine is a bit overloaded.
- * If the timeout is 0 then just poll the semaphore; if it's SDL_MUTEX_MAXWAIT, pass
+ * If the timeout is 0 then just poll the semaphore; if it's SDL_MUTEX_MAXWAIT_NS, pass
  * NULL to sceKernelWaitSema() so that it waits indefinitely; and if the timeout
  * is specified, convert it to microseconds. */
-int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout)
+int SDL_SemWaitTimeoutNS(SDL_sem *sem, Uint64 timeout)
 {
-    Uint32 *pTimeout;
+    SceUInt micro;
+    SceUInt *pTimeout;
     int res;
 
     if (sem == NULL) {
@@ -94,11 +96,13 @@ int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout)
         return 0;
     }
 
-    if (timeout == SDL_MUTEX_MAXWAIT) {
+    if (timeout == SDL_MUTEX_MAXWAIT_NS) {
         pTimeout = NULL;
     } else {
-        timeout *= 1000;  /* Convert to microseconds. */
-        pTimeout = &timeout;
+        /* Convert to microseconds, rounding up. */
+        timeout = (timeout / 1000) + ((timeout % 1000) ? 1 : 0);
+        micro = (SceUInt) SDL_min(timeout, 0xFFFFFFFE);
+        pTimeout = &micro;
     }
 
     res = sceKernelWaitSema(sem->semid, 1, pTimeout);
@@ -112,14 +116,19 @@ int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout)
     }
 }
 
+int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout)
+{
+    return SDL_SemWaitTimeoutNS(sem, SDL_TIMEOUT_MS_TO_NS(timeout));
+}
+
 int SDL_SemTryWait(SDL_sem *sem)
 {
-    return SDL_SemWaitTimeout(sem, 0);
+    return SDL_SemWaitTimeoutNS(sem, 0);
 }
 
 int SDL_SemWait(SDL_sem *sem)
 {
-    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+    return SDL_SemWaitTimeoutNS(sem, SDL_MUTEX_MAXWAIT_NS);
 }
 
 /* Returns the current count of the semaphore */
@@ -28,6 +28,8 @@
 
 #include "SDL_thread.h"
 #include "SDL_sysmutex_c.h"
+#include "../SDL_thread_c.h"
+#include "../../timer/SDL_timer_c.h"
 
 struct SDL_cond
 {
@@ -39,14 +41,30 @@ SDL_cond *
 SDL_CreateCond(void)
 {
     SDL_cond *cond;
+#if defined(HAVE_CLOCK_GETTIME) && defined(HAVE_PTHREAD_CONDATTR_SETCLOCK)
+    pthread_condattr_t attr;
+#endif
 
     cond = (SDL_cond *) SDL_malloc(sizeof(SDL_cond));
     if (cond) {
+#if defined(HAVE_CLOCK_GETTIME) && defined(HAVE_PTHREAD_CONDATTR_SETCLOCK)
+        /* Time out against the monotonic clock so wall clock changes can't
+           stretch or cut short a wait */
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        if (pthread_cond_init(&cond->cond, &attr) != 0) {
+            SDL_SetError("pthread_cond_init() failed");
+            SDL_free(cond);
+            cond = NULL;
+        }
+        pthread_condattr_destroy(&attr);
+#else
         if (pthread_cond_init(&cond->cond, NULL) < 0) {
             SDL_SetError("pthread_cond_init() failed");
             SDL_free(cond);
             cond = NULL;
         }
+#endif
     }
     return (cond);
 }
@@ -96,7 +114,7 @@ SDL_CondBroadcast(SDL_cond * cond)
 }
 
 int
-SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+SDL_CondWaitTimeoutNS(SDL_cond * cond, SDL_mutex * mutex, Uint64 ns)
 {
     int retval;
 #ifndef HAVE_CLOCK_GETTIME
@@ -108,18 +126,29 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
         return SDL_SetError("Passed a NULL condition variable");
     }
 
+    if (ns == SDL_MUTEX_MAXWAIT_NS) {
+        return SDL_CondWait(cond, mutex);
+    }
+    if (ns > SDL_MAX_DELAY_NS) {
+        ns = SDL_MAX_DELAY_NS;  /* keep the deadline within time_t */
+    }
+
 #ifdef HAVE_CLOCK_GETTIME
+#ifdef HAVE_PTHREAD_CONDATTR_SETCLOCK
+    clock_gettime(CLOCK_MONOTONIC, &abstime);
+#else
     clock_gettime(CLOCK_REALTIME, &abstime);
+#endif
 
-    abstime.tv_nsec += (ms % 1000) * 1000000;
-    abstime.tv_sec += ms / 1000;
+    abstime.tv_sec += (time_t) (ns / 1000000000);
+    abstime.tv_nsec += (long) (ns % 1000000000);
 #else
     gettimeofday(&delta, NULL);
 
-    abstime.tv_sec = delta.tv_sec + (ms / 1000);
-    abstime.tv_nsec = (delta.tv_usec + (ms % 1000) * 1000) * 1000;
+    abstime.tv_sec = delta.tv_sec + (time_t) (ns / 1000000000);
+    abstime.tv_nsec = (delta.tv_usec * 1000) + (long) (ns % 1000000000);
 #endif
-    if (abstime.tv_nsec > 1000000000) {
+    if (abstime.tv_nsec >= 1000000000) {
         abstime.tv_sec += 1;
         abstime.tv_nsec -= 1000000000;
     }
@@ -141,6 +170,12 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
     return retval;
 }
 
+int
+SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+{
+    return SDL_CondWaitTimeoutNS(cond, mutex, SDL_TIMEOUT_MS_TO_NS(ms));
+}
+
 /* Wait on the condition variable, unlocking the provided mutex.
    The mutex must be locked before entering this function!
  */
@@ -28,6 +28,8 @@
 
 #include "SDL_thread.h"
 #include "SDL_timer.h"
+#include "../SDL_thread_c.h"
+#include "../../timer/SDL_timer_c.h"
 
 /* Wrapper around POSIX 1003.1b semaphores */
 
@@ -99,7 +101,7 @@ SDL_SemWait(SDL_sem * sem)
 }
 
 int
-SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+SDL_SemWaitTimeoutNS(SDL_sem * sem, Uint64 timeout)
 {
     int retval;
 #ifdef HAVE_SEM_TIMEDWAIT
@@ -108,7 +110,7 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
 #endif
     struct timespec ts_timeout;
 #else
-    Uint32 end;
+    Uint64 now, end, step;
 #endif
 
     if (!sem) {
@@ -119,9 +121,12 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     if (timeout == 0) {
         return SDL_SemTryWait(sem);
     }
-    if (timeout == SDL_MUTEX_MAXWAIT) {
+    if (timeout == SDL_MUTEX_MAXWAIT_NS) {
         return SDL_SemWait(sem);
     }
+    if (timeout > SDL_MAX_DELAY_NS) {
+        timeout = SDL_MAX_DELAY_NS;  /* keep the deadline within time_t */
+    }
 
 #ifdef HAVE_SEM_TIMEDWAIT
     /* Setup the timeout. sem_timedwait doesn't wait for
@@ -129,28 +134,36 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     * This time is now plus the timeout.
     */
 #ifdef HAVE_CLOCK_GETTIME
+#ifdef HAVE_SEM_CLOCKWAIT
+    clock_gettime(CLOCK_MONOTONIC, &ts_timeout);
+#else
     clock_gettime(CLOCK_REALTIME, &ts_timeout);
+#endif
 
     /* Add our timeout to current time */
-    ts_timeout.tv_nsec += (timeout % 1000) * 1000000;
-    ts_timeout.tv_sec += timeout / 1000;
+    ts_timeout.tv_sec += (time_t) (timeout / 1000000000);
+    ts_timeout.tv_nsec += (long) (timeout % 1000000000);
 #else
     gettimeofday(&now, NULL);
 
     /* Add our timeout to current time */
-    ts_timeout.tv_sec = now.tv_sec + (timeout / 1000);
-    ts_timeout.tv_nsec = (now.tv_usec + (timeout % 1000) * 1000) * 1000;
+    ts_timeout.tv_sec = now.tv_sec + (time_t) (timeout / 1000000000);
+    ts_timeout.tv_nsec = (now.tv_usec * 1000) + (long) (timeout % 1000000000);
 #endif
 
     /* Wrap the second if needed */
-    if (ts_timeout.tv_nsec > 1000000000) {
+    if (ts_timeout.tv_nsec >= 1000000000) {
         ts_timeout.tv_sec += 1;
         ts_timeout.tv_nsec -= 1000000000;
     }
 
     /* Wait. */
     do {
+#if defined(HAVE_CLOCK_GETTIME) && defined(HAVE_SEM_CLOCKWAIT)
+        retval = sem_clockwait(&sem->sem, CLOCK_MONOTONIC, &ts_timeout);
+#else
         retval = sem_timedwait(&sem->sem, &ts_timeout);
+#endif
     } while (retval < 0 && errno == EINTR);
 
     if (retval < 0) {
@@ -161,18 +174,28 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
         }
     }
 #else
-    end = SDL_GetTicks() + timeout;
+    /* Poll in slices of a tenth of the timeout, between 10 us and 1 ms */
+    step = SDL_max(SDL_min(timeout / 10, 1000000), 10000);
+    end = SDL_GetPerformanceCounter() + (timeout / 1000000000) * SDL_GetPerformanceFrequency() +
+          ((timeout % 1000000000) * SDL_GetPerformanceFrequency()) / 1000000000;
     while ((retval = SDL_SemTryWait(sem)) == SDL_MUTEX_TIMEDOUT) {
-        if (SDL_TICKS_PASSED(SDL_GetTicks(), end)) {
+        now = SDL_GetPerformanceCounter();
+        if (now >= end) {
             break;
         }
-        SDL_Delay(1);
+        SDL_DelayNS(step);
     }
 #endif /* HAVE_SEM_TIMEDWAIT */
 
     return retval;
 }
 
+int
+SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+{
+    return SDL_SemWaitTimeoutNS(sem, SDL_TIMEOUT_MS_TO_NS(timeout));
+}
+
 Uint32
 SDL_SemValue(SDL_sem * sem)
 {
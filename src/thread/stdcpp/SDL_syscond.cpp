@@ -22,6 +22,7 @@
 
 extern "C" {
 #include "SDL_thread.h"
+#include "../SDL_thread_c.h"
 }
 
 #include <chrono>
@@ -92,7 +93,7 @@ SDL_CondBroadcast(SDL_cond * cond)
     return 0;
 }
 
-/* Wait on the condition variable for at most 'ms' milliseconds.
+/* Wait on the condition variable for at most 'ns' nanoseconds.
    The mutex must be locked before entering this function!
    The mutex is unlocked during the wait, and locked again after the wait.
 
@@ -115,7 +116,7 @@ Thread B:
  */
 extern "C"
 int
-SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+SDL_CondWaitTimeoutNS(SDL_cond * cond, SDL_mutex * mutex, Uint64 ns)
 {
     if (!cond) {
         SDL_SetError("Passed a NULL condition variable");
@@ -129,7 +130,7 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
 
     try {
         std::unique_lock<std::recursive_mutex> cpp_lock(mutex->cpp_mutex, std::adopt_lock_t());
-        if (ms == SDL_MUTEX_MAXWAIT) {
+        if (ns == SDL_MUTEX_MAXWAIT_NS) {
             cond->cpp_cond.wait(
                 cpp_lock
                 );
@@ -138,7 +139,7 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
         } else {
             auto wait_result = cond->cpp_cond.wait_for(
                 cpp_lock,
-                std::chrono::duration<Uint32, std::milli>(ms)
+                std::chrono::duration<Uint64, std::nano>(ns)
                 );
             cpp_lock.release();
             if (wait_result == std::cv_status::timeout) {
@@ -153,12 +154,20 @@ SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
     }
 }
 
+/* Wait on the condition variable for at most 'ms' milliseconds */
+extern "C"
+int
+SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+{
+    return SDL_CondWaitTimeoutNS(cond, mutex, SDL_TIMEOUT_MS_TO_NS(ms));
+}
+
 /* Wait on the condition variable forever */
 extern "C"
 int
 SDL_CondWait(SDL_cond * cond, SDL_mutex * mutex)
 {
-    return SDL_CondWaitTimeout(cond, mutex, SDL_MUTEX_MAXWAIT);
+    return SDL_CondWaitTimeoutNS(cond, mutex, SDL_MUTEX_MAXWAIT_NS);
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
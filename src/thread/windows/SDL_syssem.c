@@ -27,6 +27,7 @@
 #include "../../core/windows/SDL_windows.h"
 
 #include "SDL_thread.h"
+#include "../SDL_thread_c.h"
 
 struct SDL_semaphore
 {
@@ -76,7 +77,7 @@ SDL_DestroySemaphore(SDL_sem * sem)
 }
 
 int
-SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+SDL_SemWaitTimeoutNS(SDL_sem * sem, Uint64 timeout)
 {
     int retval;
     DWORD dwMilliseconds;
@@ -85,10 +86,12 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
         return SDL_SetError("Passed a NULL sem");
     }
 
-    if (timeout == SDL_MUTEX_MAXWAIT) {
+    if (timeout == SDL_MUTEX_MAXWAIT_NS) {
         dwMilliseconds = INFINITE;
     } else {
-        dwMilliseconds = (DWORD) timeout;
+        /* Round up so we never wake before the requested time */
+        timeout = (timeout / 1000000) + ((timeout % 1000000) ? 1 : 0);
+        dwMilliseconds = (DWORD) SDL_min(timeout, (Uint64) (INFINITE - 1));
     }
 #if __WINRT__
     switch (WaitForSingleObjectEx(sem->id, dwMilliseconds, FALSE)) {
@@ -109,16 +112,22 @@ SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
     return retval;
 }
 
+int
+SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+{
+    return SDL_SemWaitTimeoutNS(sem, SDL_TIMEOUT_MS_TO_NS(timeout));
+}
+
 int
 SDL_SemTryWait(SDL_sem * sem)
 {
-    return SDL_SemWaitTimeout(sem, 0);
+    return SDL_SemWaitTimeoutNS(sem, 0);
 }
 
 int
 SDL_SemWait(SDL_sem * sem)
 {
-    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+    return SDL_SemWaitTimeoutNS(sem, SDL_MUTEX_MAXWAIT_NS);
 }
 
 /* Returns the current count of the semaphore */
@@ -369,4 +369,14 @@ SDL_RemoveTimer(SDL_TimerID id)
     return canceled;
 }
 
+Uint64
+SDL_TicksToMicroseconds(Uint64 ticks)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+
+    /* Split at whole seconds, so the multiply can't overflow and the
+       frequency doesn't need to be a whole number of MHz */
+    return (ticks / freq) * 1000000 + ((ticks % freq) * 1000000) / freq;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -31,4 +31,11 @@ extern void SDL_TicksQuit(void);
 extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 
+/* Longest finite wait handed to the OS, a little over four years. Its
+   seconds still fit a 32-bit time_t once added to CLOCK_REALTIME. */
+#define SDL_MAX_DELAY_NS    ((Uint64) 0x7FFFFFF * 1000000000)
+
+/* Convert a performance counter interval to microseconds */
+extern Uint64 SDL_TicksToMicroseconds(Uint64 ticks);
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -70,6 +70,12 @@ SDL_Delay(Uint32 ms)
     SDL_Unsupported();
 }
 
+void
+SDL_DelayNS(Uint64 ns)
+{
+    SDL_Unsupported();
+}
+
 #endif /* SDL_TIMER_DUMMY || SDL_TIMERS_DISABLED */
 
 /* vi: set ts=4 sw=4 expandtab: */
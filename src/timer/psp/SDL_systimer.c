@@ -85,6 +85,16 @@ void SDL_Delay(Uint32 ms)
     sceKernelDelayThreadCB(ms * 1000);
 }
 
+void SDL_DelayNS(Uint64 ns)
+{
+    const Uint64 max_delay = 0xffffffffUL;
+    Uint64 us = (ns + 999) / 1000;
+    if (us > max_delay) {
+        us = max_delay;
+    }
+    sceKernelDelayThreadCB((SceUInt) us);
+}
+
 #endif /* SDL_TIMERS_PSP */
 
 /* vim: ts=4 sw=4
@@ -185,48 +185,75 @@ SDL_GetPerformanceFrequency(void)
 }
 
 void
-SDL_Delay(Uint32 ms)
+SDL_DelayNS(Uint64 ns)
 {
     int was_error;
 
-#if HAVE_NANOSLEEP
+#if HAVE_CLOCK_GETTIME && HAVE_CLOCK_NANOSLEEP
+    struct timespec deadline;
+#elif HAVE_NANOSLEEP
     struct timespec elapsed, tv;
 #else
     struct timeval tv;
-    Uint32 then, now, elapsed;
+    Uint64 then, now, elapsed, us;
 #endif
 
+    /* Keep the seconds within even a 32-bit time_t */
+    if (ns > SDL_MAX_DELAY_NS) {
+        ns = SDL_MAX_DELAY_NS;
+    }
+
     /* Set the timeout interval */
-#if HAVE_NANOSLEEP
-    elapsed.tv_sec = ms / 1000;
-    elapsed.tv_nsec = (ms % 1000) * 1000000;
+#if HAVE_CLOCK_GETTIME && HAVE_CLOCK_NANOSLEEP
+    /* Sleep until an absolute monotonic deadline, so being interrupted
+       doesn't accumulate error and wall clock changes don't matter */
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t) (ns / 1000000000);
+    deadline.tv_nsec += (long) (ns % 1000000000);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+#elif HAVE_NANOSLEEP
+    elapsed.tv_sec = (time_t) (ns / 1000000000);
+    elapsed.tv_nsec = (long) (ns % 1000000000);
 #else
-    then = SDL_GetTicks();
+    then = SDL_GetPerformanceCounter();
+    us = (ns + 999) / 1000;  /* select() has microsecond granularity */
 #endif
     do {
         errno = 0;
 
-#if HAVE_NANOSLEEP
+#if HAVE_CLOCK_GETTIME && HAVE_CLOCK_NANOSLEEP
+        was_error = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        errno = was_error;
+#elif HAVE_NANOSLEEP
         tv.tv_sec = elapsed.tv_sec;
         tv.tv_nsec = elapsed.tv_nsec;
         was_error = nanosleep(&tv, &elapsed);
 #else
         /* Calculate the time interval left (in case of interrupt) */
-        now = SDL_GetTicks();
-        elapsed = (now - then);
+        now = SDL_GetPerformanceCounter();
+        elapsed = ((now - then) * 1000000) / SDL_GetPerformanceFrequency();
         then = now;
-        if (elapsed >= ms) {
+        if (elapsed >= us) {
             break;
         }
-        ms -= elapsed;
-        tv.tv_sec = ms / 1000;
-        tv.tv_usec = (ms % 1000) * 1000;
+        us -= elapsed;
+        tv.tv_sec = (time_t) (us / 1000000);
+        tv.tv_usec = (suseconds_t) (us % 1000000);
 
         was_error = select(0, NULL, NULL, NULL, &tv);
 #endif /* HAVE_NANOSLEEP */
     } while (was_error && (errno == EINTR));
 }
 
+void
+SDL_Delay(Uint32 ms)
+{
+    SDL_DelayNS((Uint64) ms * 1000000);
+}
+
 #endif /* SDL_TIMER_UNIX */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -195,6 +195,14 @@ SDL_Delay(Uint32 ms)
 #endif
 }
 
+void
+SDL_DelayNS(Uint64 ns)
+{
+    /* Sleep() only has millisecond granularity, so round up */
+    const Uint64 ms = (ns / 1000000) + ((ns % 1000000) ? 1 : 0);
+    SDL_Delay((Uint32) SDL_min(ms, 0xFFFFFFFE));
+}
+
 #endif /* SDL_TIMER_WINDOWS */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -118,38 +118,34 @@ int SDL_EGL_SetErrorEx(const char * message, const char * eglFunctionName, EGLin
 }
 
 /* EGL implementation of SDL OpenGL ES support */
-#ifdef EGL_KHR_create_context        
-static int SDL_EGL_HasExtension(_THIS, const char *ext)
+static int SDL_EGL_FindExtension(const char *exts, const char *ext)
 {
-    int i;
-    int len = 0;
-    size_t ext_len;
-    const char *exts;
-    const char *ext_word;
-
-    ext_len = SDL_strlen(ext);
-    exts = _this->egl_data->eglQueryString(_this->egl_data->egl_display, EGL_EXTENSIONS);
-
-    if (exts) {
-        ext_word = exts;
-
-        for (i = 0; exts[i] != 0; i++) {
-            if (exts[i] == ' ') {
-                if (ext_len == len && !SDL_strncmp(ext_word, ext, len)) {
-                    return 1;
-                }
+    const size_t ext_len = SDL_strlen(ext);
+    const char *ext_word = exts;
 
-                len = 0;
-                ext_word = &exts[i + 1];
-            } else {
-                len++;
-            }
+    while (ext_word && *ext_word) {
+        size_t len = 0;
+        while (ext_word[len] && ext_word[len] != ' ') {
+            ++len;
+        }
+        if (ext_len == len && !SDL_strncmp(ext_word, ext, len)) {
+            return 1;
+        }
+        ext_word += len;
+        while (*ext_word == ' ') {
+            ++ext_word;
         }
     }
 
     return 0;
 }
-#endif /* EGL_KHR_create_context */
+
+#if defined(EGL_KHR_create_context) || defined(EGL_KHR_fence_sync)
+static int SDL_EGL_HasExtension(_THIS, const char *ext)
+{
+    return SDL_EGL_FindExtension(_this->egl_data->eglQueryString(_this->egl_data->egl_display, EGL_EXTENSIONS), ext);
+}
+#endif /* EGL_KHR_create_context || EGL_KHR_fence_sync */
 
 void *
 SDL_EGL_GetProcAddress(_THIS, const char *proc)
@@ -201,6 +197,12 @@ SDL_EGL_UnloadLibrary(_THIS)
 
 int
 SDL_EGL_LoadLibrary(_THIS, const char *egl_path, NativeDisplayType native_display)
+{
+    return SDL_EGL_LoadLibraryEx(_this, egl_path, native_display, 0);
+}
+
+int
+SDL_EGL_LoadLibraryEx(_THIS, const char *egl_path, NativeDisplayType native_display, EGLenum platform)
 {
     void *dll_handle = NULL, *egl_dll_handle = NULL; /* The naming is counter intuitive, but hey, I just work here -- Gabriel */
     const char *path = NULL;
@@ -314,6 +316,7 @@ SDL_EGL_LoadLibrary(_THIS, const char *egl_path, NativeDisplayType native_displa
     LOAD_FUNC(eglCreateContext);
     LOAD_FUNC(eglDestroyContext);
     LOAD_FUNC(eglCreateWindowSurface);
+    LOAD_FUNC(eglCreatePbufferSurface);
     LOAD_FUNC(eglDestroySurface);
     LOAD_FUNC(eglMakeCurrent);
     LOAD_FUNC(eglSwapBuffers);
@@ -325,7 +328,20 @@ SDL_EGL_LoadLibrary(_THIS, const char *egl_path, NativeDisplayType native_displa
     LOAD_FUNC(eglGetError);
 
 #if !defined(__WINRT__)
-    _this->egl_data->egl_display = _this->egl_data->eglGetDisplay(native_display);
+#ifdef EGL_EXT_platform_base
+    /* Client extensions are only there with EGL 1.5 or EGL_EXT_client_extensions */
+    if (platform &&
+        SDL_EGL_FindExtension(_this->egl_data->eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_EXT_platform_base")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC) _this->egl_data->eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (eglGetPlatformDisplayEXT) {
+            _this->egl_data->egl_display = eglGetPlatformDisplayEXT(platform, (void *) native_display, NULL);
+        }
+    }
+#endif
+    if (!_this->egl_data->egl_display) {
+        _this->egl_data->egl_display = _this->egl_data->eglGetDisplay(native_display);
+    }
     if (!_this->egl_data->egl_display) {
         return SDL_SetError("Could not get EGL display");
     }
@@ -335,6 +351,14 @@ SDL_EGL_LoadLibrary(_THIS, const char *egl_path, NativeDisplayType native_displa
     }
 #endif
 
+#ifdef EGL_KHR_fence_sync
+    if (SDL_EGL_HasExtension(_this, "EGL_KHR_fence_sync")) {
+        _this->egl_data->eglCreateSyncKHR = _this->egl_data->eglGetProcAddress("eglCreateSyncKHR");
+        _this->egl_data->eglDestroySyncKHR = _this->egl_data->eglGetProcAddress("eglDestroySyncKHR");
+        _this->egl_data->eglClientWaitSyncKHR = _this->egl_data->eglGetProcAddress("eglClientWaitSyncKHR");
+    }
+#endif
+
     if (path) {
         SDL_strlcpy(_this->gl_config.driver_path, path, sizeof(_this->gl_config.driver_path) - 1);
     } else {
@@ -367,6 +391,14 @@ SDL_EGL_ChooseConfig(_THIS)
     attribs[i++] = _this->gl_config.green_size;
     attribs[i++] = EGL_BLUE_SIZE;
     attribs[i++] = _this->gl_config.blue_size;
+
+    /* Pbuffers stand in for windows on a 32-bit display, so don't let the
+       small default sizes match a 16-bit config */
+    if (_this->egl_data->is_offscreen) {
+        for (j = 1; j < i; j += 2) {
+            attribs[j] = SDL_max(attribs[j], 8);
+        }
+    }
     
     if (_this->gl_config.alpha_size) {
         attribs[i++] = EGL_ALPHA_SIZE;
@@ -408,6 +440,11 @@ SDL_EGL_ChooseConfig(_THIS)
         }
     }
 
+    if (_this->egl_data->is_offscreen) {
+        attribs[i++] = EGL_SURFACE_TYPE;
+        attribs[i++] = EGL_PBUFFER_BIT;
+    }
+
     attribs[i++] = EGL_RENDERABLE_TYPE;
     if (_this->gl_config.profile_mask == SDL_GL_CONTEXT_PROFILE_ES) {
 #ifdef EGL_KHR_create_context
@@ -638,6 +675,59 @@ SDL_EGL_SwapBuffers(_THIS, EGLSurface egl_surface)
     return 0;
 }
 
+void *
+SDL_EGL_CreateFence(_THIS)
+{
+    EGLSyncKHR sync = NULL;
+
+    if (!_this->egl_data) {
+        SDL_SetError("EGL not initialized");
+        return NULL;
+    }
+#ifdef EGL_KHR_fence_sync
+    if (_this->egl_data->eglCreateSyncKHR && _this->egl_data->eglDestroySyncKHR &&
+        _this->egl_data->eglClientWaitSyncKHR) {
+        sync = _this->egl_data->eglCreateSyncKHR(_this->egl_data->egl_display, EGL_SYNC_FENCE_KHR, NULL);
+        if (sync == EGL_NO_SYNC_KHR) {
+            SDL_EGL_SetError("unable to create a fence", "eglCreateSyncKHR");
+        }
+        return sync;
+    }
+#endif
+    SDL_SetError("EGL implementation does not support fences");
+    return sync;
+}
+
+int
+SDL_EGL_WaitFence(_THIS, void *fence, Uint64 timeout)
+{
+#ifdef EGL_KHR_fence_sync
+    /* Flush, or a fence that's still queued up in the driver never signals */
+    const EGLint status = _this->egl_data->eglClientWaitSyncKHR(_this->egl_data->egl_display,
+                                                                (EGLSyncKHR) fence,
+                                                                EGL_SYNC_FLUSH_COMMANDS_BIT_KHR,
+                                                                (EGLTimeKHR) timeout);
+    if (status == EGL_CONDITION_SATISFIED_KHR) {
+        return 1;
+    } else if (status == EGL_TIMEOUT_EXPIRED_KHR) {
+        return 0;
+    }
+    return SDL_EGL_SetError("unable to wait for a fence", "eglClientWaitSyncKHR");
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+void
+SDL_EGL_DeleteFence(_THIS, void *fence)
+{
+#ifdef EGL_KHR_fence_sync
+    if (fence) {
+        _this->egl_data->eglDestroySyncKHR(_this->egl_data->egl_display, (EGLSyncKHR) fence);
+    }
+#endif
+}
+
 void
 SDL_EGL_DeleteContext(_THIS, SDL_GLContext context)
 {
@@ -688,6 +778,32 @@ SDL_EGL_CreateSurface(_THIS, NativeWindowType nw)
     return surface;
 }
 
+EGLSurface
+SDL_EGL_CreateOffscreenSurface(_THIS, int width, int height)
+{
+    EGLSurface surface;
+    EGLint attributes[] = {
+        EGL_WIDTH, 0,
+        EGL_HEIGHT, 0,
+        EGL_NONE
+    };
+    attributes[1] = width;
+    attributes[3] = height;
+
+    if (SDL_EGL_ChooseConfig(_this) != 0) {
+        return EGL_NO_SURFACE;
+    }
+
+    surface = _this->egl_data->eglCreatePbufferSurface(
+            _this->egl_data->egl_display,
+            _this->egl_data->egl_config,
+            attributes);
+    if (surface == EGL_NO_SURFACE) {
+        SDL_EGL_SetError("unable to create an EGL pbuffer surface", "eglCreatePbufferSurface");
+    }
+    return surface;
+}
+
 void
 SDL_EGL_DestroySurface(_THIS, EGLSurface egl_surface) 
 {
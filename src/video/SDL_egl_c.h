@@ -35,6 +35,7 @@ typedef struct SDL_EGL_VideoData
     EGLDisplay egl_display;
     EGLConfig egl_config;
     int egl_swapinterval;
+    SDL_bool is_offscreen;      /* configs need pbuffers instead of windows */
     
     EGLDisplay(EGLAPIENTRY *eglGetDisplay) (NativeDisplayType display);
     EGLBoolean(EGLAPIENTRY *eglInitialize) (EGLDisplay dpy, EGLint * major,
@@ -59,6 +60,9 @@ typedef struct SDL_EGL_VideoData
                                          EGLConfig config,
                                          NativeWindowType window,
                                          const EGLint * attrib_list);
+    EGLSurface(EGLAPIENTRY *eglCreatePbufferSurface) (EGLDisplay dpy,
+                                         EGLConfig config,
+                                         const EGLint * attrib_list);
     EGLBoolean(EGLAPIENTRY *eglDestroySurface) (EGLDisplay dpy, EGLSurface surface);
     
     EGLBoolean(EGLAPIENTRY *eglMakeCurrent) (EGLDisplay dpy, EGLSurface draw,
@@ -81,11 +85,20 @@ typedef struct SDL_EGL_VideoData
 
     EGLint(EGLAPIENTRY *eglGetError)(void);
 
+    /* EGL_KHR_fence_sync, NULL if the display doesn't have it */
+    EGLSyncKHR(EGLAPIENTRY *eglCreateSyncKHR) (EGLDisplay dpy, EGLenum type,
+                                   const EGLint * attrib_list);
+    EGLBoolean(EGLAPIENTRY *eglDestroySyncKHR) (EGLDisplay dpy, EGLSyncKHR sync);
+    EGLint(EGLAPIENTRY *eglClientWaitSyncKHR) (EGLDisplay dpy, EGLSyncKHR sync,
+                                   EGLint flags, EGLTimeKHR timeout);
+
 } SDL_EGL_VideoData;
 
 /* OpenGLES functions */
 extern int SDL_EGL_GetAttribute(_THIS, SDL_GLattr attrib, int *value);
 extern int SDL_EGL_LoadLibrary(_THIS, const char *path, NativeDisplayType native_display);
+/* Gets the display with eglGetPlatformDisplayEXT() if the platform is nonzero and supported */
+extern int SDL_EGL_LoadLibraryEx(_THIS, const char *path, NativeDisplayType native_display, EGLenum platform);
 extern void *SDL_EGL_GetProcAddress(_THIS, const char *proc);
 extern void SDL_EGL_UnloadLibrary(_THIS);
 extern int SDL_EGL_ChooseConfig(_THIS);
@@ -93,7 +106,11 @@ extern int SDL_EGL_SetSwapInterval(_THIS, int interval);
 extern int SDL_EGL_GetSwapInterval(_THIS);
 extern void SDL_EGL_DeleteContext(_THIS, SDL_GLContext context);
 extern EGLSurface *SDL_EGL_CreateSurface(_THIS, NativeWindowType nw);
+extern EGLSurface SDL_EGL_CreateOffscreenSurface(_THIS, int width, int height);
 extern void SDL_EGL_DestroySurface(_THIS, EGLSurface egl_surface);
+extern void *SDL_EGL_CreateFence(_THIS);
+extern int SDL_EGL_WaitFence(_THIS, void *fence, Uint64 timeout);
+extern void SDL_EGL_DeleteFence(_THIS, void *fence);
 
 /* These need to be wrapped to get the surface for the window by the platform GLES implementation */
 extern SDL_GLContext SDL_EGL_CreateContext(_THIS, EGLSurface egl_surface);
@@ -67,6 +67,23 @@ typedef struct SDL_WindowUserData
     struct SDL_WindowUserData *next;
 } SDL_WindowUserData;
 
+/* The most frames SDL_GL_SetFramePacing() lets the GPU fall behind */
+#define SDL_GL_MAX_FRAMES_IN_FLIGHT 8
+
+#define SDL_GL_FENCE_FOREVER (~(Uint64) 0)
+
+/* Frame pacing state for SDL_GL_SwapWindow() */
+typedef struct SDL_GLFramePacer
+{
+    int frames_in_flight;       /* 0 leaves GPU synchronization to the driver */
+    Uint64 target_interval;     /* performance counter ticks, 0 for none */
+    Uint64 next_deadline;       /* when the next frame is due, 0 if unknown */
+    void *fences[SDL_GL_MAX_FRAMES_IN_FLIGHT];  /* ring of frames in flight */
+    int first_fence;
+    int num_fences;
+    SDL_GLFrameTiming timing;
+} SDL_GLFramePacer;
+
 /* Define the SDL window structure, corresponding to toplevel windows */
 struct SDL_Window
 {
@@ -106,6 +123,13 @@ struct SDL_Window
 
     SDL_WindowUserData *data;
 
+    /* Performance counter ticks the last SDL_GL_SwapWindow() waited for the
+       GPU to finish and for vsync, for video drivers that measure them */
+    Uint64 swap_gpu_wait;
+    Uint64 swap_vsync_wait;
+
+    SDL_GLFramePacer pacer;
+
     void *driverdata;
 
     SDL_Window *prev;
@@ -260,12 +284,27 @@ struct SDL_VideoDevice
     int (*GL_SwapWindow) (_THIS, SDL_Window * window);
     void (*GL_DeleteContext) (_THIS, SDL_GLContext context);
 
+    /* Optional: GPU fences for frame pacing. GL_CreateFence inserts a fence
+       after the commands sent so far in the current context. GL_WaitFence
+       waits up to 'timeout' ns, returning 1 if the fence signaled, 0 on
+       timeout and -1 on error. A timeout of SDL_GL_FENCE_FOREVER never
+       expires. */
+    void *(*GL_CreateFence) (_THIS);
+    int (*GL_WaitFence) (_THIS, void *fence, Uint64 timeout);
+    void (*GL_DeleteFence) (_THIS, void *fence);
+
     /* * * */
     /*
      * Event manager functions
      */
     void (*PumpEvents) (_THIS);
 
+    /* Optional: block until the driver has input or 'timeout' ms pass (-1 is
+       forever), returning 1 if input is ready, 0 on timeout and -1 on error.
+       SendWakeupEvent must interrupt it and may be called from any thread. */
+    int (*WaitEventTimeout) (_THIS, int timeout);
+    void (*SendWakeupEvent) (_THIS);
+
     /* Suspend the screensaver */
     void (*SuspendScreenSaver) (_THIS);
 
@@ -387,6 +426,7 @@ extern VideoBootStrap Android_bootstrap;
 extern VideoBootStrap PSP_bootstrap;
 extern VideoBootStrap RPI_bootstrap;
 extern VideoBootStrap DUMMY_bootstrap;
+extern VideoBootStrap OFFSCREEN_bootstrap;
 extern VideoBootStrap Wayland_bootstrap;
 extern VideoBootStrap NACL_bootstrap;
 extern VideoBootStrap VIVANTE_bootstrap;
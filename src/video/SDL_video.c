@@ -30,6 +30,7 @@
 #include "SDL_rect_c.h"
 #include "../events/SDL_events_c.h"
 #include "../timer/SDL_timer_c.h"
+#include "../SDL_hints_c.h"
 
 #include "SDL_syswm.h"
 
@@ -114,6 +115,9 @@ static VideoBootStrap *bootstrap[] = {
 #if SDL_VIDEO_DRIVER_EMSCRIPTEN
     &Emscripten_bootstrap,
 #endif
+#if SDL_VIDEO_DRIVER_OFFSCREEN
+    &OFFSCREEN_bootstrap,
+#endif
 #if SDL_VIDEO_DRIVER_DUMMY
     &DUMMY_bootstrap,
 #endif
@@ -122,6 +126,8 @@ static VideoBootStrap *bootstrap[] = {
 
 static SDL_VideoDevice *_this = NULL;
 
+static void SDL_GL_DiscardFrames(SDL_Window * window);
+
 #define CHECK_WINDOW_MAGIC(window, retval) \
     if (!_this) { \
         SDL_UninitializedVideo(); \
@@ -1551,6 +1557,7 @@ SDL_RecreateWindow(SDL_Window * window, Uint32 flags)
         window->surface->flags &= ~SDL_DONTFREE;
         SDL_FreeSurface(window->surface);
         window->surface = NULL;
+        window->surface_valid = SDL_FALSE;
     }
     if (_this->DestroyWindowFramebuffer) {
         _this->DestroyWindowFramebuffer(_this, window);
@@ -2536,6 +2543,8 @@ SDL_OnWindowFocusGained(SDL_Window * window)
 static SDL_bool
 ShouldMinimizeOnFocusLoss(SDL_Window * window)
 {
+    static SDL_HintCache minimize_on_focus_loss = { SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS };
+
     if (!(window->flags & SDL_WINDOW_FULLSCREEN) || window->is_destroying) {
         return SDL_FALSE;
     }
@@ -2548,7 +2557,7 @@ ShouldMinimizeOnFocusLoss(SDL_Window * window)
     }
 #endif
 
-    return SDL_GetHintBoolean(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS, SDL_TRUE);
+    return SDL_GetCachedHintBoolean(&minimize_on_focus_loss, SDL_TRUE);
 }
 
 void
@@ -2609,6 +2618,7 @@ SDL_DestroyWindow(SDL_Window * window)
             SDL_GL_MakeCurrent(window, NULL);
         }
     }
+    SDL_GL_DiscardFrames(window);
 
     if (window->surface) {
         window->surface->flags &= ~SDL_DONTFREE;
@@ -3443,9 +3453,124 @@ SDL_GL_GetSwapInterval(void)
     }
 }
 
+static Uint64
+SDL_GL_TicksToNS(Uint64 ticks)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    return ((ticks / freq) * 1000000000) + (((ticks % freq) * 1000000000) / freq);
+}
+
+static Uint64
+SDL_GL_NSToTicks(Uint64 ns)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    return ((ns / 1000000000) * freq) + (((ns % 1000000000) * freq) / 1000000000);
+}
+
+/* Wait for the oldest frame in flight, or just check on it if timeout is 0 */
+static SDL_bool
+SDL_GL_RetireFrame(SDL_Window * window, Uint64 timeout)
+{
+    SDL_GLFramePacer *pacer = &window->pacer;
+    void *fence = pacer->fences[pacer->first_fence];
+
+    if (_this->GL_WaitFence(_this, fence, timeout) == 0) {
+        return SDL_FALSE;
+    }
+    /* On error the fence is dropped anyway, so a broken fence can't stall us */
+    _this->GL_DeleteFence(_this, fence);
+    pacer->fences[pacer->first_fence] = NULL;
+    pacer->first_fence = (pacer->first_fence + 1) % SDL_GL_MAX_FRAMES_IN_FLIGHT;
+    --pacer->num_fences;
+    return SDL_TRUE;
+}
+
+static void
+SDL_GL_DiscardFrames(SDL_Window * window)
+{
+    SDL_GLFramePacer *pacer = &window->pacer;
+
+    while (pacer->num_fences > 0) {
+        _this->GL_DeleteFence(_this, pacer->fences[pacer->first_fence]);
+        pacer->fences[pacer->first_fence] = NULL;
+        pacer->first_fence = (pacer->first_fence + 1) % SDL_GL_MAX_FRAMES_IN_FLIGHT;
+        --pacer->num_fences;
+    }
+    pacer->first_fence = 0;
+}
+
+static void
+SDL_GL_WaitForDeadline(Uint64 deadline)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    /* SDL_Delay() can oversleep, so spin for the last couple of milliseconds */
+    while (now < deadline) {
+        const Uint64 ms = ((deadline - now) * 1000) / freq;
+        if (ms > 2) {
+            SDL_Delay((Uint32) (ms - 2));
+        }
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
+/* The time each frame is meant to be on screen, or 0 if it isn't known */
+static Uint64
+SDL_GL_GetFrameInterval(SDL_Window * window)
+{
+    SDL_VideoDisplay *display;
+    int interval;
+
+    if (window->pacer.target_interval) {
+        return window->pacer.target_interval;
+    }
+    interval = SDL_GL_GetSwapInterval();
+    if (interval < 0) {
+        interval = -interval;
+    }
+    display = SDL_GetDisplayForWindow(window);
+    if (interval == 0 || !display || display->current_mode.refresh_rate <= 0) {
+        return 0;
+    }
+    return (SDL_GetPerformanceFrequency() * interval) / display->current_mode.refresh_rate;
+}
+
+static void
+SDL_GL_FramePresented(SDL_Window * window, Uint64 now)
+{
+    SDL_GLFramePacer *pacer = &window->pacer;
+    SDL_GLFrameTiming *timing = &pacer->timing;
+    const Uint64 interval = SDL_GL_GetFrameInterval(window);
+
+    if (timing->frame > 0) {
+        const Uint64 elapsed = now - timing->present_time;
+
+        timing->interval_ns = SDL_GL_TicksToNS(elapsed);
+        if (interval && elapsed > interval + interval / 2) {
+            timing->missed_frames += (Uint32) ((elapsed + interval / 2) / interval - 1);
+        }
+    }
+    ++timing->frame;
+    timing->present_time = now;
+
+    /* Keep to the target cadence, unless the frame was too late to catch up */
+    if (pacer->target_interval) {
+        if (pacer->next_deadline && now < pacer->next_deadline + interval / 2) {
+            pacer->next_deadline += interval;
+        } else {
+            pacer->next_deadline = now + interval;
+        }
+    }
+}
+
 void
 SDL_GL_SwapWindow(SDL_Window * window)
 {
+    SDL_GLFramePacer *pacer;
+    void *fence = NULL;
+    Uint64 start;
+
     CHECK_WINDOW_MAGIC(window,);
 
     if (!(window->flags & SDL_WINDOW_OPENGL)) {
@@ -3458,7 +3583,100 @@ SDL_GL_SwapWindow(SDL_Window * window)
         return;
     }
 
+    pacer = &window->pacer;
+    window->swap_gpu_wait = 0;
+    window->swap_vsync_wait = 0;
+
+    /* Mark where this frame's commands end, before the swap flushes them */
+    if (pacer->frames_in_flight > 0) {
+        fence = _this->GL_CreateFence(_this);
+    }
+
+    if (pacer->target_interval && pacer->next_deadline) {
+        SDL_GL_WaitForDeadline(pacer->next_deadline);
+    }
+
     _this->GL_SwapWindow(_this, window);
+    SDL_GL_FramePresented(window, SDL_GetPerformanceCounter());
+
+    /* Let the GPU fall behind by at most frames_in_flight frames */
+    if (fence) {
+        pacer->fences[(pacer->first_fence + pacer->num_fences) % SDL_GL_MAX_FRAMES_IN_FLIGHT] = fence;
+        ++pacer->num_fences;
+    }
+    start = SDL_GetPerformanceCounter();
+    while (pacer->num_fences > 0 && pacer->num_fences >= pacer->frames_in_flight) {
+        SDL_GL_RetireFrame(window, SDL_GL_FENCE_FOREVER);
+    }
+    if (pacer->frames_in_flight > 0) {
+        const Uint64 waited = SDL_GetPerformanceCounter() - start;
+        window->swap_gpu_wait += waited;
+        pacer->timing.gpu_wait_ns = SDL_GL_TicksToNS(waited);
+    }
+    pacer->timing.frames_in_flight = pacer->num_fences;
+}
+
+int
+SDL_GL_SetFramePacing(SDL_Window * window, int frames_in_flight, Uint64 target_interval_ns)
+{
+    SDL_GLFramePacer *pacer;
+
+    CHECK_WINDOW_MAGIC(window, -1);
+
+    if (!(window->flags & SDL_WINDOW_OPENGL)) {
+        return SDL_SetError("The specified window isn't an OpenGL window");
+    }
+    if (frames_in_flight < 0 || frames_in_flight > SDL_GL_MAX_FRAMES_IN_FLIGHT) {
+        return SDL_InvalidParamError("frames_in_flight");
+    }
+    if (SDL_GL_GetCurrentWindow() != window) {
+        return SDL_SetError("The specified window has not been made current");
+    }
+
+    if (frames_in_flight > 0) {
+        void *fence;
+
+        if (!_this->GL_CreateFence) {
+            return SDL_SetError("GPU fences aren't supported by this video driver");
+        }
+        fence = _this->GL_CreateFence(_this);
+        if (!fence) {
+            return -1;
+        }
+        _this->GL_DeleteFence(_this, fence);
+    }
+
+    pacer = &window->pacer;
+    while (pacer->num_fences > 0) {
+        SDL_GL_RetireFrame(window, SDL_GL_FENCE_FOREVER);
+    }
+    pacer->frames_in_flight = frames_in_flight;
+    pacer->target_interval = SDL_GL_NSToTicks(target_interval_ns);
+    pacer->next_deadline = 0;
+    pacer->timing.frames_in_flight = 0;
+    return 0;
+}
+
+int
+SDL_GL_GetFrameTiming(SDL_Window * window, SDL_GLFrameTiming * timing)
+{
+    SDL_GLFramePacer *pacer;
+
+    CHECK_WINDOW_MAGIC(window, -1);
+
+    if (!timing) {
+        return SDL_InvalidParamError("timing");
+    }
+
+    /* Let go of the frames the GPU has finished since the last swap */
+    pacer = &window->pacer;
+    while (pacer->num_fences > 0 && SDL_GL_RetireFrame(window, 0)) {
+        continue;
+    }
+    pacer->timing.frames_in_flight = pacer->num_fences;
+
+    *timing = pacer->timing;
+    return 0;
 }
 
 void
@@ -3830,7 +4048,9 @@ SDL_ShowSimpleMessageBox(Uint32 flags, const char *title, const char *message, S
 SDL_bool
 SDL_ShouldAllowTopmost(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_ALLOW_TOPMOST, SDL_TRUE);
+    static SDL_HintCache allow_topmost = { SDL_HINT_ALLOW_TOPMOST };
+
+    return SDL_GetCachedHintBoolean(&allow_topmost, SDL_TRUE);
 }
 
 int
@@ -175,7 +175,14 @@ DREAM_Create()
 	device->GL_GetSwapInterval = DREAM_EGL_GetSwapInterval;
 	device->GL_SwapWindow = DREAM_EGL_SwapWindow;
 	device->GL_DeleteContext = DREAM_EGL_DeleteContext;
+	device->GL_CreateFence = SDL_EGL_CreateFence;
+	device->GL_WaitFence = SDL_EGL_WaitFence;
+	device->GL_DeleteFence = SDL_EGL_DeleteFence;
 	device->PumpEvents = DREAM_PumpEvents;
+#ifdef SDL_INPUT_LINUXEV
+	device->WaitEventTimeout = DREAM_WaitEventTimeout;
+	device->SendWakeupEvent = DREAM_SendWakeupEvent;
+#endif
 
 	/* !!! FIXME: implement SetWindowBordered */
 
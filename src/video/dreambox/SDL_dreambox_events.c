@@ -44,6 +44,21 @@ DREAM_PumpEvents(_THIS)
 #endif
 }
 
+#ifdef SDL_INPUT_LINUXEV
+/* Sleep on the remote control and other input devices instead of polling */
+int
+DREAM_WaitEventTimeout(_THIS, int timeout)
+{
+    return SDL_EVDEV_WaitEvents(timeout);
+}
+
+void
+DREAM_SendWakeupEvent(_THIS)
+{
+    SDL_EVDEV_SendWakeup();
+}
+#endif
+
 #endif /* SDL_VIDEO_DRIVER_DREAMBOX */
 
 /* vi: set ts=4 sw=4 expandtab: */
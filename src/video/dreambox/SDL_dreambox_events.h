@@ -28,6 +28,8 @@
 #include "../../SDL_internal.h"
 
 extern void DREAM_PumpEvents(_THIS);
+extern int DREAM_WaitEventTimeout(_THIS, int timeout);
+extern void DREAM_SendWakeupEvent(_THIS);
 extern void DREAM_EventInit(_THIS);
 extern void DREAM_EventQuit(_THIS);
 
@@ -26,6 +26,7 @@
 
 #if SDL_VIDEO_DRIVER_DREAMBOX && SDL_VIDEO_OPENGL_EGL
 
+#include "SDL_timer.h"
 #include "SDL_dreambox.h"
 #include "SDL_dreambox_gles.h"
 
@@ -459,19 +460,31 @@ DREAM_EGL_SwapWindow(_THIS, SDL_Window * window)
 	SDL_VideoData *phdata = (SDL_VideoData *) _this->driverdata;
 	SDL_WindowData *wdata = (SDL_WindowData *) window->driverdata;
 	EGLBoolean status;
+	Uint64 start, finished;
 	
 	if (phdata->egl_initialized != SDL_TRUE) {
 		return SDL_SetError("DREAM: GLES initialization failed, no OpenGL ES support");
 	}
 
-	/* Many applications do not uses glFinish(), so we call it for them */
-	glFinish();
+	start = SDL_GetPerformanceCounter();
 
-	/* Wait until OpenGL ES rendering is completed */
-	eglWaitGL();
+	/* Many applications do not uses glFinish(), so we call it for them,
+	   unless SDL_GL_SwapWindow() keeps the GPU in check with fences */
+	if (window->pacer.frames_in_flight == 0) {
+		glFinish();
+
+		/* Wait until OpenGL ES rendering is completed */
+		eglWaitGL();
+	}
+
+	finished = SDL_GetPerformanceCounter();
 	
 	/* FIXME: we need nativ Wait for Vsync */
 	dreambox_wait_for_sync();
+
+	/* Let the render profiler see where the swap waited */
+	window->swap_gpu_wait = finished - start;
+	window->swap_vsync_wait = SDL_GetPerformanceCounter() - finished;
 	
 	eglSwapBuffers(phdata->egl_display, wdata->gles_surface);
 	
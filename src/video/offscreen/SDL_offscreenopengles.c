@@ -0,0 +1,103 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_DRIVER_OFFSCREEN && SDL_VIDEO_OPENGL_EGL
+
+#include "SDL_opengles2.h"
+#include "SDL_offscreenopengles.h"
+#include "SDL_offscreenvideo.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+/* EGL implementation of SDL OpenGL support */
+
+int
+OFFSCREEN_GLES_LoadLibrary(_THIS, const char *path)
+{
+    /* Without EGL_MESA_platform_surfaceless this falls back to the default
+       display, which still has pbuffers wherever there is a display server */
+    if (SDL_EGL_LoadLibraryEx(_this, path, EGL_DEFAULT_DISPLAY, EGL_PLATFORM_SURFACELESS_MESA) < 0) {
+        return -1;
+    }
+    _this->egl_data->is_offscreen = SDL_TRUE;
+    return 0;
+}
+
+SDL_EGL_CreateContext_impl(OFFSCREEN)
+SDL_EGL_MakeCurrent_impl(OFFSCREEN)
+
+static int
+OFFSCREEN_GLES_CaptureFrame(_THIS, SDL_Window * window)
+{
+    typedef void (GL_APIENTRYP ReadPixels_fn) (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels);
+    typedef void (GL_APIENTRYP GetIntegerv_fn) (GLenum pname, GLint *params);
+    typedef void (GL_APIENTRYP BindFramebuffer_fn) (GLenum target, GLuint framebuffer);
+    SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
+    const size_t size = (size_t) window->w * window->h * 4;
+    ReadPixels_fn glReadPixels = (ReadPixels_fn) SDL_GL_GetProcAddress("glReadPixels");
+    GetIntegerv_fn glGetIntegerv = (GetIntegerv_fn) SDL_GL_GetProcAddress("glGetIntegerv");
+    BindFramebuffer_fn glBindFramebuffer = (BindFramebuffer_fn) SDL_GL_GetProcAddress("glBindFramebuffer");
+    GLint framebuffer = 0;
+
+    if (!glReadPixels || !glGetIntegerv || !glBindFramebuffer) {
+        return SDL_SetError("Couldn't load the GL functions to capture frames");
+    }
+
+    if (size > data->readback_size) {
+        Uint8 *readback = (Uint8 *) SDL_realloc(data->readback, size);
+        if (!readback) {
+            return SDL_OutOfMemory();
+        }
+        data->readback = readback;
+        data->readback_size = size;
+    }
+
+    /* Read the window, even if the application left a framebuffer object bound */
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+    if (framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    glReadPixels(0, 0, window->w, window->h, GL_RGBA, GL_UNSIGNED_BYTE, data->readback);
+    if (framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint) framebuffer);
+    }
+
+    return OFFSCREEN_CaptureFrame(window, data->readback, window->w * 4, SDL_TRUE);
+}
+
+int
+OFFSCREEN_GLES_SwapWindow(_THIS, SDL_Window * window)
+{
+    SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
+
+    /* A pbuffer has no back buffer, so what was drawn is what's presented */
+    if (data->capture && OFFSCREEN_GLES_CaptureFrame(_this, window) < 0) {
+        return -1;
+    }
+    return SDL_EGL_SwapBuffers(_this, data->egl_surface);
+}
+
+#endif /* SDL_VIDEO_DRIVER_OFFSCREEN && SDL_VIDEO_OPENGL_EGL */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,273 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_DRIVER_OFFSCREEN
+
+/* Offscreen SDL video driver implementation; windows are drawn to memory or,
+ *  for OpenGL ES, to EGL pbuffers, so that the software and GLES2 renderers
+ *  can run without a display server. With Mesa's llvmpipe and
+ *  EGL_MESA_platform_surfaceless it doesn't need a GPU either, which makes
+ *  it a reproducible place to benchmark rendering.
+ *
+ * Presented frames can be captured with SDL_HINT_VIDEO_OFFSCREEN_CAPTURE.
+ */
+
+#include "SDL_video.h"
+#include "SDL_hints.h"
+#include "../SDL_sysvideo.h"
+#include "../SDL_pixels_c.h"
+
+#include "SDL_offscreenvideo.h"
+#include "SDL_offscreenframebuffer_c.h"
+#include "SDL_offscreenopengles.h"
+
+#define OFFSCREENVID_DRIVER_NAME "offscreen"
+
+/* Initialization/Query functions */
+static int OFFSCREEN_VideoInit(_THIS);
+static int OFFSCREEN_SetDisplayMode(_THIS, SDL_VideoDisplay * display, SDL_DisplayMode * mode);
+static void OFFSCREEN_VideoQuit(_THIS);
+static void OFFSCREEN_PumpEvents(_THIS);
+
+/* Window functions */
+static int OFFSCREEN_CreateWindow(_THIS, SDL_Window * window);
+static void OFFSCREEN_SetWindowSize(_THIS, SDL_Window * window);
+static void OFFSCREEN_DestroyWindow(_THIS, SDL_Window * window);
+
+/* OFFSCREEN driver bootstrap functions */
+
+static int
+OFFSCREEN_Available(void)
+{
+    const char *envr = SDL_getenv("SDL_VIDEODRIVER");
+    if ((envr) && (SDL_strcmp(envr, OFFSCREENVID_DRIVER_NAME) == 0)) {
+        return (1);
+    }
+
+    return (0);
+}
+
+static void
+OFFSCREEN_DeleteDevice(SDL_VideoDevice * device)
+{
+    SDL_free(device);
+}
+
+static SDL_VideoDevice *
+OFFSCREEN_CreateDevice(int devindex)
+{
+    SDL_VideoDevice *device;
+
+    /* Initialize all variables that we clean on shutdown */
+    device = (SDL_VideoDevice *) SDL_calloc(1, sizeof(SDL_VideoDevice));
+    if (!device) {
+        SDL_OutOfMemory();
+        return (0);
+    }
+
+    /* Set the function pointers */
+    device->VideoInit = OFFSCREEN_VideoInit;
+    device->VideoQuit = OFFSCREEN_VideoQuit;
+    device->SetDisplayMode = OFFSCREEN_SetDisplayMode;
+    device->PumpEvents = OFFSCREEN_PumpEvents;
+    device->CreateWindow = OFFSCREEN_CreateWindow;
+    device->SetWindowSize = OFFSCREEN_SetWindowSize;
+    device->DestroyWindow = OFFSCREEN_DestroyWindow;
+    device->CreateWindowFramebuffer = SDL_OFFSCREEN_CreateWindowFramebuffer;
+    device->UpdateWindowFramebuffer = SDL_OFFSCREEN_UpdateWindowFramebuffer;
+    device->DestroyWindowFramebuffer = SDL_OFFSCREEN_DestroyWindowFramebuffer;
+
+#if SDL_VIDEO_OPENGL_EGL
+    device->GL_LoadLibrary = OFFSCREEN_GLES_LoadLibrary;
+    device->GL_GetProcAddress = OFFSCREEN_GLES_GetProcAddress;
+    device->GL_UnloadLibrary = OFFSCREEN_GLES_UnloadLibrary;
+    device->GL_CreateContext = OFFSCREEN_GLES_CreateContext;
+    device->GL_MakeCurrent = OFFSCREEN_GLES_MakeCurrent;
+    device->GL_SetSwapInterval = OFFSCREEN_GLES_SetSwapInterval;
+    device->GL_GetSwapInterval = OFFSCREEN_GLES_GetSwapInterval;
+    device->GL_SwapWindow = OFFSCREEN_GLES_SwapWindow;
+    device->GL_DeleteContext = OFFSCREEN_GLES_DeleteContext;
+    device->GL_CreateFence = OFFSCREEN_GLES_CreateFence;
+    device->GL_WaitFence = OFFSCREEN_GLES_WaitFence;
+    device->GL_DeleteFence = OFFSCREEN_GLES_DeleteFence;
+#endif
+
+    device->free = OFFSCREEN_DeleteDevice;
+
+    return device;
+}
+
+VideoBootStrap OFFSCREEN_bootstrap = {
+    OFFSCREENVID_DRIVER_NAME, "SDL offscreen video driver",
+    OFFSCREEN_Available, OFFSCREEN_CreateDevice
+};
+
+
+int
+OFFSCREEN_VideoInit(_THIS)
+{
+    SDL_DisplayMode mode;
+
+    /* Use a fake 32-bpp desktop mode */
+    mode.format = SDL_PIXELFORMAT_RGB888;
+    mode.w = 1024;
+    mode.h = 768;
+    mode.refresh_rate = 0;
+    mode.driverdata = NULL;
+    if (SDL_AddBasicVideoDisplay(&mode) < 0) {
+        return -1;
+    }
+
+    SDL_zero(mode);
+    SDL_AddDisplayMode(&_this->displays[0], &mode);
+
+    /* We're done! */
+    return 0;
+}
+
+static int
+OFFSCREEN_SetDisplayMode(_THIS, SDL_VideoDisplay * display, SDL_DisplayMode * mode)
+{
+    return 0;
+}
+
+void
+OFFSCREEN_VideoQuit(_THIS)
+{
+}
+
+static void
+OFFSCREEN_PumpEvents(_THIS)
+{
+    /* do nothing. */
+}
+
+static int
+OFFSCREEN_CreateWindow(_THIS, SDL_Window * window)
+{
+    SDL_WindowData *data;
+    const char *capture;
+
+    data = (SDL_WindowData *) SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return SDL_OutOfMemory();
+    }
+
+    capture = SDL_GetHint(SDL_HINT_VIDEO_OFFSCREEN_CAPTURE);
+    if (capture && *capture) {
+        char file[1024];
+        SDL_snprintf(file, sizeof(file), "%s-window%u.rgba", capture, (unsigned int) window->id);
+        data->capture = SDL_RWFromFile(file, "wb");
+        if (!data->capture) {
+            SDL_free(data);
+            return -1;
+        }
+    }
+
+#if SDL_VIDEO_OPENGL_EGL
+    if (window->flags & SDL_WINDOW_OPENGL) {
+        data->egl_surface = SDL_EGL_CreateOffscreenSurface(_this, window->w, window->h);
+        if (data->egl_surface == EGL_NO_SURFACE) {
+            if (data->capture) {
+                SDL_RWclose(data->capture);
+            }
+            SDL_free(data);
+            return -1;
+        }
+    } else {
+        data->egl_surface = EGL_NO_SURFACE;
+    }
+#endif
+
+    window->driverdata = data;
+    return 0;
+}
+
+static void
+OFFSCREEN_SetWindowSize(_THIS, SDL_Window * window)
+{
+#if SDL_VIDEO_OPENGL_EGL
+    SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
+    EGLSurface egl_surface;
+
+    /* Pbuffers can't be resized, so replace the window's */
+    if (data->egl_surface == EGL_NO_SURFACE) {
+        return;
+    }
+    egl_surface = SDL_EGL_CreateOffscreenSurface(_this, window->w, window->h);
+    if (egl_surface == EGL_NO_SURFACE) {
+        return;
+    }
+    if (SDL_GL_GetCurrentWindow() == window) {
+        SDL_EGL_MakeCurrent(_this, egl_surface, SDL_GL_GetCurrentContext());
+    }
+    SDL_EGL_DestroySurface(_this, data->egl_surface);
+    data->egl_surface = egl_surface;
+#endif
+}
+
+static void
+OFFSCREEN_DestroyWindow(_THIS, SDL_Window * window)
+{
+    SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
+
+    if (data) {
+#if SDL_VIDEO_OPENGL_EGL
+        SDL_EGL_DestroySurface(_this, data->egl_surface);
+#endif
+        if (data->capture) {
+            SDL_RWclose(data->capture);
+        }
+        SDL_free(data->readback);
+        SDL_free(data);
+    }
+    window->driverdata = NULL;
+}
+
+int
+OFFSCREEN_CaptureFrame(SDL_Window * window, const void *pixels, int pitch, SDL_bool bottom_up)
+{
+    SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
+    const size_t row_size = (size_t) window->w * 4;
+    const Uint8 *row;
+    int y;
+
+    if ((size_t) pitch == row_size && !bottom_up) {
+        if (SDL_RWwrite(data->capture, pixels, row_size * window->h, 1) != 1) {
+            return -1;
+        }
+        return 0;
+    }
+
+    /* Flip GL frames on the way out, rather than in another copy */
+    for (y = 0; y < window->h; ++y) {
+        row = (const Uint8 *) pixels + (bottom_up ? window->h - 1 - y : y) * pitch;
+        if (SDL_RWwrite(data->capture, row, row_size, 1) != 1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif /* SDL_VIDEO_DRIVER_OFFSCREEN */
+
+/* vi: set ts=4 sw=4 expandtab: */
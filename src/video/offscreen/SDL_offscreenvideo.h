@@ -0,0 +1,44 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#ifndef SDL_offscreenvideo_h_
+#define SDL_offscreenvideo_h_
+
+#include "../SDL_sysvideo.h"
+#include "../SDL_egl_c.h"
+
+typedef struct SDL_WindowData
+{
+#if SDL_VIDEO_OPENGL_EGL
+    EGLSurface egl_surface;     /* pbuffer that stands in for the window */
+#endif
+    SDL_Surface *framebuffer;
+    SDL_RWops *capture;         /* where presented frames go, or NULL */
+    Uint8 *readback;            /* GL frame being captured */
+    size_t readback_size;
+} SDL_WindowData;
+
+extern int OFFSCREEN_CaptureFrame(SDL_Window * window, const void *pixels, int pitch, SDL_bool bottom_up);
+
+#endif /* SDL_offscreenvideo_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -38,6 +38,7 @@
 #include "SDL_events.h"
 #include "../../events/SDL_mouse_c.h"
 #include "../../events/SDL_keyboard_c.h"
+#include "../../events/SDL_events_c.h"
 #include "SDL_hints.h"
 
 #ifdef SDL_INPUT_LINUXEV
@@ -183,6 +184,7 @@ RPI_VideoInit(_THIS)
     if (SDL_EVDEV_Init() < 0) {
         return -1;
     }
+    SDL_AddEventWaitFd(SDL_EVDEV_GetWaitFd());
 #endif    
     
     RPI_InitMouse(_this);
@@ -194,6 +196,7 @@ void
 RPI_VideoQuit(_THIS)
 {
 #ifdef SDL_INPUT_LINUXEV    
+    SDL_DelEventWaitFd(SDL_EVDEV_GetWaitFd());
     SDL_EVDEV_Quit();
 #endif    
 }
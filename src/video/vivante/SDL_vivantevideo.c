@@ -212,6 +212,7 @@ VIVANTE_VideoInit(_THIS)
     if (SDL_EVDEV_Init() < 0) {
         return -1;
     }
+    SDL_AddEventWaitFd(SDL_EVDEV_GetWaitFd());
 #endif
 
     return 0;
@@ -223,6 +224,7 @@ VIVANTE_VideoQuit(_THIS)
     SDL_VideoData *videodata = (SDL_VideoData *)_this->driverdata;
 
 #ifdef SDL_INPUT_LINUXEV
+    SDL_DelEventWaitFd(SDL_EVDEV_GetWaitFd());
     SDL_EVDEV_Quit();
 #endif
 
@@ -49,6 +49,93 @@ poked(int sig)
     done = 1;
 }
 
+/* With --bench, several threads feed the device small chunks as fast as it
+   takes them, while the audio thread drains the queue. This reports how
+   long SDL_QueueAudio() held up the producers and how long the audio
+   thread's callbacks took while they were hammering on the queue. */
+#define BENCH_PRODUCERS 2
+#define BENCH_CHUNK     512
+
+static struct
+{
+    SDL_SpinLock lock;
+    Uint32 pos;
+    Uint32 calls;
+    Uint64 total_ticks;
+    Uint64 max_ticks;
+} bench;
+
+static int SDLCALL
+BenchProducer(void *data)
+{
+    /* keep about four device buffers queued. */
+    const Uint32 target = (Uint32) wave.spec.samples * wave.spec.channels * (SDL_AUDIO_BITSIZE(wave.spec.format) / 8) * 4;
+
+    while (!done) {
+        Uint64 start, elapsed;
+        Uint32 pos;
+
+        if (SDL_GetQueuedAudioSize(1) >= target) {
+            SDL_Delay(1);
+            continue;
+        }
+
+        SDL_AtomicLock(&bench.lock);
+        pos = bench.pos;
+        bench.pos = (pos + BENCH_CHUNK < wave.soundlen) ? pos + BENCH_CHUNK : 0;
+        SDL_AtomicUnlock(&bench.lock);
+
+        start = SDL_GetPerformanceCounter();
+        SDL_QueueAudio(1, wave.sound + pos, SDL_min(BENCH_CHUNK, wave.soundlen - pos));
+        elapsed = SDL_GetPerformanceCounter() - start;
+
+        SDL_AtomicLock(&bench.lock);
+        bench.calls++;
+        bench.total_ticks += elapsed;
+        if (elapsed > bench.max_ticks) {
+            bench.max_ticks = elapsed;
+        }
+        SDL_AtomicUnlock(&bench.lock);
+    }
+    return 0;
+}
+
+static void
+bench_run(int seconds)
+{
+    const double ticks_per_us = SDL_GetPerformanceFrequency() / 1000000.0;
+    SDL_Thread *threads[BENCH_PRODUCERS];
+    SDL_AudioDeviceStats stats;
+    Uint32 end = SDL_GetTicks() + seconds * 1000;
+    int i;
+
+    SDL_ResetAudioDeviceStats(1);
+    for (i = 0; i < BENCH_PRODUCERS; ++i) {
+        threads[i] = SDL_CreateThread(BenchProducer, "BenchProducer", NULL);
+    }
+
+    while (!done && !SDL_TICKS_PASSED(SDL_GetTicks(), end)) {
+        SDL_Delay(100);
+    }
+    done = 1;
+
+    for (i = 0; i < BENCH_PRODUCERS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    SDL_Log("%d producers, %u SDL_QueueAudio() calls of %d bytes: mean %.2f us, max %.2f us\n",
+            BENCH_PRODUCERS, (unsigned int) bench.calls, BENCH_CHUNK,
+            bench.calls ? (bench.total_ticks / ticks_per_us) / bench.calls : 0.0,
+            bench.max_ticks / ticks_per_us);
+    if (SDL_GetAudioDeviceStats(1, &stats) == 0) {
+        SDL_Log("audio thread: %u callbacks, mean %u us, max %u us, period %u us, %u late wakeups\n",
+                (unsigned int) stats.callbacks,
+                stats.callbacks ? (unsigned int) (stats.callback_total_us / stats.callbacks) : 0,
+                (unsigned int) stats.callback_max_us, (unsigned int) stats.period_us,
+                (unsigned int) stats.late_wakeups);
+    }
+}
+
 void
 loop()
 {
@@ -76,6 +163,8 @@ int
 main(int argc, char *argv[])
 {
     char filename[4096];
+    int bench_seconds = 0;
+    int i;
 
     /* Enable standard application logging */
     SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
@@ -86,10 +175,16 @@ main(int argc, char *argv[])
         return (1);
     }
 
-    if (argc > 1) {
-        SDL_strlcpy(filename, argv[1], sizeof(filename));
-    } else {
-        SDL_strlcpy(filename, "sample.wav", sizeof(filename));
+    SDL_strlcpy(filename, "sample.wav", sizeof(filename));
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--bench") == 0) {
+            bench_seconds = 5;
+            if ((i + 1 < argc) && (SDL_atoi(argv[i + 1]) > 0)) {
+                bench_seconds = SDL_atoi(argv[++i]);
+            }
+        } else {
+            SDL_strlcpy(filename, argv[i], sizeof(filename));
+        }
     }
     /* Load the wave file into memory */
     if (SDL_LoadWAV(filename, &wave.spec, &wave.sound, &wave.soundlen) == NULL) {
@@ -125,6 +220,14 @@ main(int argc, char *argv[])
 
     done = 0;
 
+    if (bench_seconds > 0) {
+        bench_run(bench_seconds);
+        SDL_CloseAudio();
+        SDL_FreeWAV(wave.sound);
+        SDL_Quit();
+        return 0;
+    }
+
     /* Note that we stuff the entire audio buffer into the queue in one
        shot. Most apps would want to feed it a little at a time, as it
        plays, but we're going for simplicity here. */
@@ -26,6 +26,13 @@ _audioSetUp(void *arg)
     if (ret != 0) {
            SDLTest_LogError("%s", SDL_GetError());
         }
+
+    /* Tests that pair SDL_AudioInit() with SDL_AudioQuit() can leave the subsystem
+       refcounted with no driver loaded; bring the driver back in that case */
+    if (ret == 0 && SDL_GetCurrentAudioDriver() == NULL) {
+        ret = SDL_AudioInit(NULL);
+        SDLTest_AssertCheck(ret==0, "Check result from SDL_AudioInit(NULL)");
+    }
 }
 
 void
@@ -967,6 +974,674 @@ int audio_openCloseAudioDeviceConnected()
    return TEST_COMPLETED;
 }
 
+/**
+ * \brief Checks the statistics of an open audio device.
+ *
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceStats
+ * \sa https://wiki.libsdl.org/SDL_ResetAudioDeviceStats
+ */
+int audio_getAudioDeviceStats()
+{
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioDeviceStats stats;
+   Uint32 expected_period;
+   int result, i, total;
+
+   /* Invalid parameters */
+   result = SDL_GetAudioDeviceStats(0, &stats);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats(0,...)");
+   SDLTest_AssertCheck(result == -1, "Verify result with invalid device; expected: -1, got: %i", result);
+
+   /* The dummy driver always opens and paces its callback like real hardware */
+   SDL_AudioQuit();
+   result = SDL_AudioInit("dummy");
+   SDLTest_AssertPass("Call to SDL_AudioInit('dummy')");
+   SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+   if (result != 0) {
+      SDL_AudioInit(NULL);
+      return TEST_ABORTED;
+   }
+
+   desired.freq = 22050;
+   desired.format = AUDIO_S16SYS;
+   desired.channels = 2;
+   desired.samples = 1024;
+   desired.callback = _audio_testCallback;
+   desired.userdata = NULL;
+
+   id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+   SDLTest_AssertPass("Call to SDL_OpenAudioDevice()");
+   SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+   if (id == 0) {
+      SDL_AudioQuit();
+      SDL_AudioInit(NULL);
+      return TEST_ABORTED;
+   }
+
+   result = SDL_GetAudioDeviceStats(id, NULL);
+   SDLTest_AssertCheck(result == -1, "Verify result with NULL stats; expected: -1, got: %i", result);
+
+   /* Let the callback run a few times */
+   _audio_testCallbackCounter = 0;
+   SDL_PauseAudioDevice(id, 0);
+   for (i = 0; i < 100 && _audio_testCallbackCounter < 3; ++i) {
+      SDL_Delay(10);
+   }
+   SDL_PauseAudioDevice(id, 1);
+   SDLTest_AssertCheck(_audio_testCallbackCounter >= 3, "Verify callback counter; expected: >=3, got: %i", _audio_testCallbackCounter);
+
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats()");
+   SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %i", result);
+   SDLTest_AssertCheck((int)stats.callbacks >= 3, "Verify callbacks; expected: >=3, got: %u", (unsigned int)stats.callbacks);
+   expected_period = (Uint32)(((Uint64)desired.samples * 1000000) / desired.freq);
+   SDLTest_AssertCheck(stats.period_us == expected_period, "Verify period; expected: %u, got: %u", (unsigned int)expected_period, (unsigned int)stats.period_us);
+   total = 0;
+   for (i = 0; i < SDL_AUDIO_STATS_BUCKETS; ++i) {
+      total += stats.callback_histogram[i];
+   }
+   SDLTest_AssertCheck(total == (int)stats.callbacks, "Verify callback histogram total; expected: %u, got: %i", (unsigned int)stats.callbacks, total);
+
+   SDL_ResetAudioDeviceStats(id);
+   SDLTest_AssertPass("Call to SDL_ResetAudioDeviceStats()");
+   SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertCheck(stats.callback_max_us == 0, "Verify callback_max_us was reset; got: %u", (unsigned int)stats.callback_max_us);
+   SDLTest_AssertCheck(stats.period_us == expected_period, "Verify period was kept; expected: %u, got: %u", (unsigned int)expected_period, (unsigned int)stats.period_us);
+
+   SDL_CloseAudioDevice(id);
+   SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+   SDL_AudioQuit();
+   SDL_AudioInit(NULL);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks SDL_MixAudioFormat and SDL_MixAudioFormatMulti against the expected saturated sums.
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormat
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormatMulti
+ */
+int audio_mixAudioFormat()
+{
+   /* Odd sizes so both the vector and the scalar tail code run */
+   Sint16 src[67], src2[67], dst[67], dst2[67];
+   float fsrc[67], fsrc2[67], fdst[67], fdst2[67];
+   const Uint8 *srcs[2];
+   int volumes[2];
+   int i, result, errors;
+
+   for (i = 0; i < 67; i++) {
+      src[i] = (Sint16) ((i * 977) - 32768);
+      src2[i] = (Sint16) (i - 33);
+      dst[i] = (Sint16) (32767 - (i * 1021));
+   }
+   SDL_memcpy(dst2, dst, sizeof (dst));
+
+   SDL_MixAudioFormat((Uint8 *) dst, (const Uint8 *) src, AUDIO_S16SYS, sizeof (dst), 100);
+   SDLTest_AssertPass("Call to SDL_MixAudioFormat(...,AUDIO_S16SYS,...)");
+   errors = 0;
+   for (i = 0; i < 67; i++) {
+      const int expected = SDL_max(SDL_min(dst2[i] + (src[i] * 100) / SDL_MIX_MAXVOLUME, 32767), -32768);
+      if (dst[i] != expected) {
+         SDLTest_AssertCheck(dst[i] == expected, "Verify sample %d; expected: %d, got: %d", i, expected, dst[i]);
+         errors++;
+      }
+   }
+   SDLTest_AssertCheck(errors == 0, "Verify mixed samples; expected: 0 errors, got: %d", errors);
+
+   /* A single source gives the same result as SDL_MixAudioFormat */
+   SDL_memcpy(dst, dst2, sizeof (dst));
+   srcs[0] = (const Uint8 *) src;
+   volumes[0] = 100;
+   result = SDL_MixAudioFormatMulti((Uint8 *) dst2, srcs, volumes, 1, AUDIO_S16SYS, sizeof (dst2));
+   SDLTest_AssertPass("Call to SDL_MixAudioFormatMulti(...,1,...)");
+   SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %d", result);
+   SDL_MixAudioFormat((Uint8 *) dst, (const Uint8 *) src, AUDIO_S16SYS, sizeof (dst), 100);
+   SDLTest_AssertCheck(SDL_memcmp(dst, dst2, sizeof (dst)) == 0, "Verify single source matches SDL_MixAudioFormat");
+
+   /* Several sources are clipped once, on the final sum */
+   for (i = 0; i < 67; i++) {
+      dst[i] = 30000;
+   }
+   srcs[0] = (const Uint8 *) src2;
+   srcs[1] = (const Uint8 *) src;
+   volumes[0] = SDL_MIX_MAXVOLUME;
+   volumes[1] = 0;
+   result = SDL_MixAudioFormatMulti((Uint8 *) dst, srcs, volumes, 2, AUDIO_S16SYS, sizeof (dst));
+   SDLTest_AssertPass("Call to SDL_MixAudioFormatMulti(...,2,...)");
+   SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %d", result);
+   errors = 0;
+   for (i = 0; i < 67; i++) {
+      errors += (dst[i] != 30000 + src2[i]);
+   }
+   SDLTest_AssertCheck(errors == 0, "Verify mixed samples; expected: 0 errors, got: %d", errors);
+
+   /* Scaled sources that overflow partway through the sum */
+   for (i = 0; i < 67; i++) {
+      dst[i] = (Sint16) (32767 - (i * 1021));
+   }
+   SDL_memcpy(dst2, dst, sizeof (dst));
+   srcs[0] = (const Uint8 *) src;
+   srcs[1] = (const Uint8 *) src2;
+   volumes[0] = 100;
+   volumes[1] = 77;
+   result = SDL_MixAudioFormatMulti((Uint8 *) dst, srcs, volumes, 2, AUDIO_S16SYS, sizeof (dst));
+   SDLTest_AssertPass("Call to SDL_MixAudioFormatMulti(...,AUDIO_S16SYS,...)");
+   SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %d", result);
+   errors = 0;
+   for (i = 0; i < 67; i++) {
+      const int sum = dst2[i] + (src[i] * 100) / SDL_MIX_MAXVOLUME + (src2[i] * 77) / SDL_MIX_MAXVOLUME;
+      const int expected = SDL_max(SDL_min(sum, 32767), -32768);
+      if (dst[i] != expected) {
+         SDLTest_AssertCheck(dst[i] == expected, "Verify sample %d; expected: %d, got: %d", i, expected, dst[i]);
+         errors++;
+      }
+   }
+   SDLTest_AssertCheck(errors == 0, "Verify mixed samples; expected: 0 errors, got: %d", errors);
+
+   for (i = 0; i < 67; i++) {
+      fsrc[i] = (float) ((i - 33) / 16.0);
+      fsrc2[i] = (float) (i * 0.0625);
+      fdst[i] = (float) ((i & 1) ? 3.0e+38 : -0.5);
+   }
+   SDL_memcpy(fdst2, fdst, sizeof (fdst));
+   srcs[0] = (const Uint8 *) fsrc;
+   srcs[1] = (const Uint8 *) fsrc2;
+   volumes[0] = 100;
+   volumes[1] = 77;
+   result = SDL_MixAudioFormatMulti((Uint8 *) fdst, srcs, volumes, 2, AUDIO_F32SYS, sizeof (fdst));
+   SDLTest_AssertPass("Call to SDL_MixAudioFormatMulti(...,AUDIO_F32SYS,...)");
+   SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %d", result);
+   errors = 0;
+   for (i = 0; i < 67; i++) {
+      /* dst is scaled at SDL_MIX_MAXVOLUME too, so its odd samples overflow to infinity */
+      const double sum = (double) ((fdst2[i] * (float) SDL_MIX_MAXVOLUME) * (1.0f / SDL_MIX_MAXVOLUME))
+                       + (double) ((fsrc[i] * 100.0f) * (1.0f / SDL_MIX_MAXVOLUME))
+                       + (double) ((fsrc2[i] * 77.0f) * (1.0f / SDL_MIX_MAXVOLUME));
+      const float expected = (float) SDL_max(SDL_min(sum, 3.402823466e+38F), -3.402823466e+38F);
+      if (fdst[i] != expected) {
+         SDLTest_AssertCheck(fdst[i] == expected, "Verify sample %d; expected: %g, got: %g", i, expected, fdst[i]);
+         errors++;
+      }
+   }
+   SDLTest_AssertCheck(errors == 0, "Verify mixed samples; expected: 0 errors, got: %d", errors);
+
+   /* Invalid parameters */
+   result = SDL_MixAudioFormatMulti(NULL, srcs, NULL, 2, AUDIO_S16SYS, sizeof (dst));
+   SDLTest_AssertCheck(result == -1, "Verify result with NULL dst; expected: -1, got: %d", result);
+   result = SDL_MixAudioFormatMulti((Uint8 *) dst, NULL, NULL, 2, AUDIO_S16SYS, sizeof (dst));
+   SDLTest_AssertCheck(result == -1, "Verify result with NULL srcs; expected: -1, got: %d", result);
+   result = SDL_MixAudioFormatMulti((Uint8 *) dst, srcs, NULL, 2, 0x1234, sizeof (dst));
+   SDLTest_AssertCheck(result == -1, "Verify result with invalid format; expected: -1, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks timestamps of queued capture and playback audio, using the disk driver.
+ *
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceTimestamp
+ * \sa https://wiki.libsdl.org/SDL_QueueAudioTimestamped
+ * \sa https://wiki.libsdl.org/SDL_DequeueAudioTimestamped
+ */
+int audio_audioTimestamps()
+{
+   const char *infile = "sdlaudio-timestamps.raw";
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioTimestamp ts, ts2;
+   SDL_RWops *rw;
+   Uint8 buffer[2048];
+   Uint32 got, got2;
+   Uint64 now;
+   int result, i;
+
+   result = SDL_GetAudioDeviceTimestamp(0, &ts);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceTimestamp(0,...)");
+   SDLTest_AssertCheck(result == -1, "Verify result with invalid device; expected: -1, got: %i", result);
+
+   /* Half a second of capture data for the disk driver */
+   SDL_memset(buffer, 0x40, sizeof (buffer));
+   rw = SDL_RWFromFile(infile, "wb");
+   SDLTest_AssertCheck(rw != NULL, "Verify capture file was created");
+   if (rw == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 11; ++i) {
+      SDL_RWwrite(rw, buffer, sizeof (buffer), 1);
+   }
+   SDL_RWclose(rw);
+
+   /* Swap drivers underneath the initialized subsystem */
+   SDL_AudioQuit();
+   result = SDL_AudioInit("disk");
+   SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+   SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+   if (result != 0) {
+      SDL_AudioInit(NULL);
+      remove(infile);
+      return TEST_ABORTED;
+   }
+
+   desired.freq = 22050;
+   desired.format = AUDIO_S16SYS;
+   desired.channels = 1;
+   desired.samples = 512;
+   desired.callback = NULL;
+   desired.userdata = NULL;
+
+   /* Capture: consecutive dequeues continue each other's frame count */
+   id = SDL_OpenAudioDevice(infile, 1, &desired, &obtained, 0);
+   SDLTest_AssertCheck(id > 0, "Validate capture device ID; expected: >0, got: %i", id);
+   if (id > 0) {
+      SDL_PauseAudioDevice(id, 0);
+      for (i = 0; i < 100 && SDL_GetQueuedAudioSize(id) < 2 * obtained.size; ++i) {
+         SDL_Delay(10);
+      }
+      got = SDL_DequeueAudioTimestamped(id, buffer, 300, &ts);
+      got2 = SDL_DequeueAudioTimestamped(id, buffer, 300, &ts2);
+      now = SDL_GetPerformanceCounter();
+      SDLTest_AssertPass("Call to SDL_DequeueAudioTimestamped()");
+      SDLTest_AssertCheck(got == 300 && got2 == 300, "Verify dequeued sizes; expected: 300, got: %u and %u", (unsigned int)got, (unsigned int)got2);
+      SDLTest_AssertCheck(ts.frame == 0, "Verify first frame; expected: 0, got: %u", (unsigned int)ts.frame);
+      SDLTest_AssertCheck(ts2.frame == ts.frame + 150, "Verify second frame; expected: %u, got: %u", (unsigned int)(ts.frame + 150), (unsigned int)ts2.frame);
+      SDLTest_AssertCheck(ts.time != 0 && ts.time < ts2.time && ts2.time < now, "Verify capture times are in order and in the past");
+      SDL_CloseAudioDevice(id);
+   }
+
+   /* Playback: queued audio is heard after what's already queued */
+   id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+   SDLTest_AssertCheck(id > 0, "Validate playback device ID; expected: >0, got: %i", id);
+   if (id > 0) {
+      now = SDL_GetPerformanceCounter();
+      result = SDL_QueueAudioTimestamped(id, buffer, 1000, &ts);
+      SDLTest_AssertPass("Call to SDL_QueueAudioTimestamped()");
+      SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %i", result);
+      SDL_QueueAudioTimestamped(id, buffer, 1000, &ts2);
+      SDLTest_AssertCheck(ts.frame == 0, "Verify first frame; expected: 0, got: %u", (unsigned int)ts.frame);
+      SDLTest_AssertCheck(ts2.frame == 500, "Verify second frame; expected: 500, got: %u", (unsigned int)ts2.frame);
+      SDLTest_AssertCheck(ts.time >= now && ts2.time > ts.time, "Verify playback times are in order and in the future");
+
+      SDL_PauseAudioDevice(id, 0);
+      for (i = 0; i < 100 && SDL_GetQueuedAudioSize(id) > 0; ++i) {
+         SDL_Delay(10);
+      }
+      SDL_PauseAudioDevice(id, 1);
+      result = SDL_GetAudioDeviceTimestamp(id, &ts);
+      SDLTest_AssertPass("Call to SDL_GetAudioDeviceTimestamp()");
+      SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %i", result);
+      SDLTest_AssertCheck(ts.time != 0 && (ts.frame % obtained.samples) == 0, "Verify frame is a whole number of callbacks; got: %u", (unsigned int)ts.frame);
+      SDL_CloseAudioDevice(id);
+   }
+
+   SDL_AudioQuit();
+   SDL_AudioInit(NULL);
+   remove(infile);
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * \brief Checks that the disk driver runs faster than realtime with no delay, and writes a WAV file.
+ */
+int audio_diskAudioFreeRunning()
+{
+   const char *outfile = "sdlaudio-freerun.wav";
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained, spec;
+   Uint8 *sound = NULL;
+   Uint32 soundlen = 0;
+   int result, callbacks, i;
+
+   SDL_AudioQuit();
+   result = SDL_AudioInit("disk");
+   SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+   SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+   if (result != 0) {
+      SDL_AudioInit(NULL);
+      return TEST_ABORTED;
+   }
+
+   /* Big endian float data has to be converted for the WAV file */
+   desired.freq = 22050;
+   desired.format = AUDIO_F32MSB;
+   desired.channels = 2;
+   desired.samples = 1024;
+   desired.callback = _audio_testCallback;
+   desired.userdata = NULL;
+
+   SDL_setenv("SDL_DISKAUDIODELAY", "0", 1);
+   id = SDL_OpenAudioDevice(outfile, 0, &desired, &obtained, 0);
+   SDL_setenv("SDL_DISKAUDIODELAY", "", 1);
+   SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+   if (id > 0) {
+      /* Once it's going, realtime would be less than one callback */
+      _audio_testCallbackCounter = 0;
+      SDL_PauseAudioDevice(id, 0);
+      for (i = 0; i < 100 && _audio_testCallbackCounter == 0; ++i) {
+         SDL_Delay(10);
+      }
+      SDL_Delay(20);
+      SDL_PauseAudioDevice(id, 1);
+      callbacks = _audio_testCallbackCounter;
+      SDLTest_AssertCheck(callbacks > 10, "Verify callback counter; expected: >10, got: %i", callbacks);
+      SDL_CloseAudioDevice(id);
+
+      result = (SDL_LoadWAV(outfile, &spec, &sound, &soundlen) != NULL);
+      SDLTest_AssertPass("Call to SDL_LoadWAV()");
+      SDLTest_AssertCheck(result, "Verify the output is a WAV file");
+      if (result) {
+         SDLTest_AssertCheck(spec.format == AUDIO_F32LSB && spec.channels == 2 && spec.freq == 22050,
+                             "Verify WAV spec; got format 0x%X, %d channels, %d Hz", spec.format, spec.channels, spec.freq);
+         /* the pause may catch the last buffer before it's written */
+         SDLTest_AssertCheck(soundlen >= (Uint32) (callbacks - 1) * 8192 && (soundlen % 8192) == 0,
+                             "Verify WAV length; expected: >=%u, got: %u", (unsigned int) (callbacks - 1) * 8192, (unsigned int) soundlen);
+         SDL_FreeWAV(sound);
+      }
+
+      /* Capture reads the whole file at once, then paces the silence after it */
+      desired.format = AUDIO_F32SYS;
+      desired.callback = NULL;
+      SDL_setenv("SDL_DISKAUDIODELAY", "0", 1);
+      id = SDL_OpenAudioDevice(outfile, 1, &desired, &obtained, 0);
+      SDL_setenv("SDL_DISKAUDIODELAY", "", 1);
+      SDLTest_AssertCheck(id > 0, "Validate capture device ID; expected: >0, got: %i", id);
+      if (id > 0) {
+         Uint32 queued;
+         SDL_PauseAudioDevice(id, 0);
+         SDL_Delay(200);
+         SDL_PauseAudioDevice(id, 1);
+         queued = SDL_GetQueuedAudioSize(id);
+         /* the file, plus a second of silence is lots of slack for 200ms */
+         SDLTest_AssertCheck(queued >= soundlen && queued <= soundlen + 44 + 22050 * 8,
+                             "Verify queued capture; expected: %u to %u, got: %u", (unsigned int) soundlen,
+                             (unsigned int) (soundlen + 44 + 22050 * 8), (unsigned int) queued);
+         SDL_CloseAudioDevice(id);
+      }
+   }
+
+   SDL_AudioQuit();
+   SDL_AudioInit(NULL);
+   remove(outfile);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks that queued capture audio comes out of SDL_DequeueAudio in order, using the disk driver.
+ *
+ * The audio thread fills the queue's ring buffer and the test drains it in
+ * odd sized pieces, so reads are cut short and the ring wraps several times.
+ *
+ * \sa https://wiki.libsdl.org/SDL_DequeueAudio
+ * \sa https://wiki.libsdl.org/SDL_ClearQueuedAudio
+ */
+int audio_dequeueCaptureRing()
+{
+   const char *infile = "sdlaudio-ring.raw";
+   const Uint32 total = 3 * 64 * 1024;  /* several times the ring */
+   const Uint32 chunk = 3001;  /* splits samples and device buffers */
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   SDL_RWops *rw;
+   Uint32 *pattern;
+   Uint8 buf[3001];
+   Uint32 got, pos, i;
+   int result, partial, errors, tries;
+
+   pattern = (Uint32 *) SDL_malloc(2 * total);
+   SDLTest_AssertCheck(pattern != NULL, "Verify memory allocation");
+   if (pattern == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < (2 * total) / 4; i++) {
+      pattern[i] = i;
+   }
+   rw = SDL_RWFromFile(infile, "wb");
+   SDLTest_AssertCheck(rw != NULL, "Verify %s was created", infile);
+   if (rw == NULL) {
+      SDL_free(pattern);
+      return TEST_ABORTED;
+   }
+   SDL_RWwrite(rw, pattern, 1, 2 * total);
+   SDL_RWclose(rw);
+
+   SDL_AudioQuit();
+   result = SDL_AudioInit("disk");
+   SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+   SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+   if (result != 0) {
+      SDL_AudioInit(NULL);
+      SDL_free(pattern);
+      remove(infile);
+      return TEST_ABORTED;
+   }
+
+   desired.freq = 22050;
+   desired.format = AUDIO_S32SYS;
+   desired.channels = 2;
+   desired.samples = 1024;
+   desired.callback = NULL;
+   desired.userdata = NULL;
+
+   /* 8KB every 10ms; the ring holds eight of those, plenty of slack */
+   SDL_setenv("SDL_DISKAUDIODELAY", "10", 1);
+   id = SDL_OpenAudioDevice(infile, 1, &desired, &obtained, 0);
+   SDL_setenv("SDL_DISKAUDIODELAY", "", 1);
+   SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+   if (id > 0) {
+      SDL_PauseAudioDevice(id, 0);
+
+      pos = 0;
+      partial = 0;
+      errors = 0;
+      for (tries = 0; pos < total && tries < 5000; ) {
+         got = SDL_DequeueAudio(id, buf, chunk);
+         if (got == 0) {
+            SDL_Delay(1);
+            tries++;
+            continue;
+         }
+         if (got < chunk) {
+            partial++;
+         }
+         if (SDL_memcmp(buf, ((const Uint8 *) pattern) + pos, got) != 0) {
+            errors++;
+         }
+         pos += got;
+      }
+      SDLTest_AssertCheck(pos >= total, "Verify dequeued bytes; expected: >=%u, got: %u", (unsigned int) total, (unsigned int) pos);
+      SDLTest_AssertCheck(errors == 0, "Verify dequeued data is in order; expected: 0 errors, got: %d", errors);
+      SDLTest_AssertCheck(partial > 0, "Verify some reads were cut short; got: %d", partial);
+
+      /* Clearing drops everything queued, and capture goes on after it */
+      SDL_PauseAudioDevice(id, 1);
+      SDL_Delay(50);
+      SDL_ClearQueuedAudio(id);
+      SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+      got = SDL_GetQueuedAudioSize(id);
+      SDLTest_AssertCheck(got == 0, "Verify queue is empty after clear; got: %u", (unsigned int) got);
+      got = SDL_DequeueAudio(id, buf, chunk);
+      SDLTest_AssertCheck(got == 0, "Verify nothing to dequeue after clear; got: %u", (unsigned int) got);
+
+      SDL_PauseAudioDevice(id, 0);
+      for (tries = 0; SDL_GetQueuedAudioSize(id) < 8 && tries < 1000; tries++) {
+         SDL_Delay(1);
+      }
+      got = SDL_DequeueAudio(id, buf, 8);
+      SDL_PauseAudioDevice(id, 1);
+      SDLTest_AssertCheck(got == 8, "Verify dequeue after clear; expected: 8, got: %u", (unsigned int) got);
+      if (got == 8) {
+         Uint32 first;
+         SDL_memcpy(&first, buf, sizeof (first));
+         /* it starts on a later device buffer, wherever the file is by now */
+         SDLTest_AssertCheck(first * 4 >= pos && ((first * 4) % obtained.size) == 0,
+                             "Verify capture resumed on a device buffer after byte %u; got sample %u", (unsigned int) pos, (unsigned int) first);
+      }
+
+      SDL_CloseAudioDevice(id);
+   }
+
+   SDL_AudioQuit();
+   SDL_AudioInit(NULL);
+   SDL_free(pattern);
+   remove(infile);
+
+   return TEST_COMPLETED;
+}
+
+
+/* Writes a WAVE header for a data chunk of the given size. */
+static void
+_audio_writeWAVHeader(SDL_RWops *rw, Uint16 encoding, Uint16 channels, Uint32 freq,
+                      Uint16 blockalign, Uint16 bits, Uint16 samplesperblock, Uint32 datalen)
+{
+   const Uint32 fmtlen = samplesperblock ? 20 : 16;
+   SDL_WriteLE32(rw, 0x46464952);  /* RIFF */
+   SDL_WriteLE32(rw, 4 + (8 + fmtlen) + (8 + datalen));
+   SDL_WriteLE32(rw, 0x45564157);  /* WAVE */
+   SDL_WriteLE32(rw, 0x20746D66);  /* fmt  */
+   SDL_WriteLE32(rw, fmtlen);
+   SDL_WriteLE16(rw, encoding);
+   SDL_WriteLE16(rw, channels);
+   SDL_WriteLE32(rw, freq);
+   SDL_WriteLE32(rw, samplesperblock ? (freq * blockalign) / samplesperblock : freq * blockalign);
+   SDL_WriteLE16(rw, blockalign);
+   SDL_WriteLE16(rw, bits);
+   if (samplesperblock) {
+      SDL_WriteLE16(rw, 2);
+      SDL_WriteLE16(rw, samplesperblock);
+   }
+   SDL_WriteLE32(rw, 0x61746164);  /* data */
+   SDL_WriteLE32(rw, datalen);
+}
+
+/**
+ * \brief Checks that SDL_OpenWAV and SDL_ReadWAV decode PCM and IMA ADPCM files, piece by piece.
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenWAV_RW
+ * \sa https://wiki.libsdl.org/SDL_ReadWAV
+ * \sa https://wiki.libsdl.org/SDL_RewindWAV
+ * \sa https://wiki.libsdl.org/SDL_GetWAVLength
+ */
+int audio_openReadWAV()
+{
+   const char *file = "sdlaudio-reader.wav";
+   /* Two 9 sample IMA ADPCM blocks: initial sample, step index, 0, then 8 nybbles */
+   const Uint8 ima[16] = {
+      0xE8, 0x03, 0, 0, 0x07, 0x7F, 0x80, 0x3C,
+      0x38, 0xFF, 40, 0, 0x19, 0x2A, 0xF0, 0x88
+   };
+   const Sint16 ima_decoded[18] = {
+      1000, 1011, 1013, 988, 1044, 1052, 1045, 984, 1041,
+      -200, -326, -212, -385, -228, -200, -591, -647, -698
+   };
+   Sint16 pcm[2000], out[2000];
+   Uint8 imawav[80];
+   SDL_AudioSpec spec;
+   SDL_WAVReader *reader;
+   SDL_RWops *rw;
+   Uint8 *sound = NULL;
+   Uint32 soundlen = 0;
+   int i, got, pos, result;
+
+   /* 16-bit stereo PCM, read back in pieces that aren't whole frames */
+   for (i = 0; i < 2000; i++) {
+      pcm[i] = (Sint16) ((i * 2311) ^ (i << 5));
+   }
+   rw = SDL_RWFromFile(file, "wb");
+   SDLTest_AssertCheck(rw != NULL, "Verify %s was created", file);
+   if (rw == NULL) {
+      return TEST_ABORTED;
+   }
+   _audio_writeWAVHeader(rw, 1, 2, 22050, 4, 16, 0, sizeof (pcm));
+   for (i = 0; i < 2000; i++) {
+      SDL_WriteLE16(rw, (Uint16) pcm[i]);
+   }
+   SDL_RWclose(rw);
+
+   reader = SDL_OpenWAV(file, &spec);
+   SDLTest_AssertPass("Call to SDL_OpenWAV()");
+   SDLTest_AssertCheck(reader != NULL, "Verify reader is not NULL");
+   if (reader != NULL) {
+      SDLTest_AssertCheck(spec.format == AUDIO_S16LSB && spec.channels == 2 && spec.freq == 22050,
+                          "Verify spec; got format 0x%X, %d channels, %d Hz", spec.format, spec.channels, spec.freq);
+      SDLTest_AssertCheck(SDL_GetWAVLength(reader) == sizeof (pcm),
+                          "Verify length; expected: %u, got: %u", (unsigned int) sizeof (pcm), (unsigned int) SDL_GetWAVLength(reader));
+
+      SDL_memset(out, 0, sizeof (out));
+      pos = 0;
+      do {
+         got = SDL_ReadWAV(reader, ((Uint8 *) out) + pos, SDL_min(999, (int) sizeof (out) - pos));
+         SDLTest_AssertCheck(got >= 0 && (got % 4) == 0, "Verify SDL_ReadWAV() returns whole frames; got: %d", got);
+         pos += SDL_max(got, 0);
+      } while (got > 0 && pos < (int) sizeof (out));
+      SDLTest_AssertCheck(pos == sizeof (pcm), "Verify bytes read; expected: %u, got: %d", (unsigned int) sizeof (pcm), pos);
+      SDLTest_AssertCheck(SDL_memcmp(out, pcm, sizeof (pcm)) == 0, "Verify samples match what was written");
+      got = SDL_ReadWAV(reader, out, sizeof (out));
+      SDLTest_AssertCheck(got == 0, "Verify SDL_ReadWAV() at the end; expected: 0, got: %d", got);
+
+      result = SDL_RewindWAV(reader);
+      SDLTest_AssertPass("Call to SDL_RewindWAV()");
+      SDLTest_AssertCheck(result == 0, "Verify result; expected: 0, got: %d", result);
+      SDL_memset(out, 0, sizeof (out));
+      got = SDL_ReadWAV(reader, out, sizeof (out));
+      SDLTest_AssertCheck(got == sizeof (pcm), "Verify bytes read after rewind; expected: %u, got: %d", (unsigned int) sizeof (pcm), got);
+      SDLTest_AssertCheck(SDL_memcmp(out, pcm, sizeof (pcm)) == 0, "Verify samples match after rewind");
+
+      SDL_CloseWAV(reader);
+      SDLTest_AssertPass("Call to SDL_CloseWAV()");
+   }
+
+   /* A short IMA ADPCM file decodes the same incrementally and all at once */
+   rw = SDL_RWFromMem(imawav, sizeof (imawav));
+   _audio_writeWAVHeader(rw, 0x11, 1, 8000, 8, 4, 9, sizeof (ima));
+   SDL_RWwrite(rw, ima, 1, sizeof (ima));
+   pos = (int) SDL_RWtell(rw);
+   SDL_RWclose(rw);
+
+   reader = SDL_OpenWAV_RW(SDL_RWFromConstMem(imawav, pos), 1, &spec);
+   SDLTest_AssertPass("Call to SDL_OpenWAV_RW()");
+   SDLTest_AssertCheck(reader != NULL, "Verify reader is not NULL");
+   if (reader != NULL) {
+      SDLTest_AssertCheck(spec.format == AUDIO_S16LSB && spec.channels == 1 && spec.freq == 8000,
+                          "Verify spec; got format 0x%X, %d channels, %d Hz", spec.format, spec.channels, spec.freq);
+      SDLTest_AssertCheck(SDL_GetWAVLength(reader) == sizeof (ima_decoded),
+                          "Verify length; expected: %u, got: %u", (unsigned int) sizeof (ima_decoded), (unsigned int) SDL_GetWAVLength(reader));
+      SDL_memset(out, 0, sizeof (out));
+      got = SDL_ReadWAV(reader, out, 10);
+      SDLTest_AssertCheck(got == 10, "Verify bytes read; expected: 10, got: %d", got);
+      got = SDL_ReadWAV(reader, ((Uint8 *) out) + 10, sizeof (out) - 10);
+      SDLTest_AssertCheck(got == sizeof (ima_decoded) - 10, "Verify bytes read; expected: %u, got: %d", (unsigned int) sizeof (ima_decoded) - 10, got);
+      for (i = 0; i < 18; i++) {
+         const Sint16 sample = (Sint16) SDL_SwapLE16((Uint16) out[i]);
+         SDLTest_AssertCheck(sample == ima_decoded[i], "Verify sample %d; expected: %d, got: %d", i, ima_decoded[i], sample);
+      }
+      SDL_CloseWAV(reader);
+   }
+
+   sound = NULL;
+   result = (SDL_LoadWAV_RW(SDL_RWFromConstMem(imawav, pos), 1, &spec, &sound, &soundlen) != NULL);
+   SDLTest_AssertPass("Call to SDL_LoadWAV_RW()");
+   SDLTest_AssertCheck(result, "Verify the IMA ADPCM file loads");
+   if (result) {
+      SDLTest_AssertCheck(soundlen == sizeof (ima_decoded) && SDL_memcmp(sound, out, soundlen) == 0,
+                          "Verify SDL_LoadWAV_RW() matches SDL_ReadWAV(); got %u bytes", (unsigned int) soundlen);
+      SDL_FreeWAV(sound);
+   }
+
+   /* Invalid parameters */
+   got = SDL_ReadWAV(NULL, out, sizeof (out));
+   SDLTest_AssertCheck(got == -1, "Verify SDL_ReadWAV(NULL,...); expected: -1, got: %d", got);
+
+   remove(file);
+
+   return TEST_COMPLETED;
+}
 
 
 /* ================= Test Case References ================== */
@@ -1022,11 +1697,30 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_getAudioDeviceStats, "audio_getAudioDeviceStats", "Checks the statistics of an open audio device.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Checks SDL_MixAudioFormat and SDL_MixAudioFormatMulti against the expected saturated sums.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_audioTimestamps, "audio_audioTimestamps", "Checks timestamps of queued capture and playback audio, using the disk driver.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_diskAudioFreeRunning, "audio_diskAudioFreeRunning", "Checks that the disk driver runs faster than realtime with no delay, and writes a WAV file.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_dequeueCaptureRing, "audio_dequeueCaptureRing", "Checks that queued capture audio is dequeued in order across reads, ring wraps and a clear.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest21 =
+        { (SDLTest_TestCaseFp)audio_openReadWAV, "audio_openReadWAV", "Checks that SDL_OpenWAV and SDL_ReadWAV decode PCM and IMA ADPCM files, piece by piece.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17,
+    &audioTest18, &audioTest19, &audioTest20, &audioTest21, NULL
 };
 
 /* Audio test suite (global) */
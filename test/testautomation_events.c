@@ -7,6 +7,13 @@
 #include "SDL.h"
 #include "SDL_test.h"
 
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 /* Test case functions */
@@ -174,6 +181,229 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Checks the event queue statistics
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventTypeStats
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventQueueStats
+ */
+int
+events_queueStats(void *arg)
+{
+   SDL_Event event;
+   SDL_EventTypeStats typeStats;
+   SDL_EventQueueStats queueStats;
+   int i, result;
+
+   /* Start from an empty queue */
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_ResetEventQueueStats();
+   SDLTest_AssertPass("Call to SDL_ResetEventQueueStats()");
+
+   event.type = SDL_USEREVENT;
+   event.user.code = SDLTest_RandomSint32();
+   event.user.data1 = (void *)&_userdataValue1;
+   event.user.data2 = (void *)&_userdataValue2;
+
+   /* Push one which the filter rejects, setting the filter flushes the queue */
+   _userdataCheck = 0;
+   SDL_SetEventFilter(_events_sampleNullEventFilter, NULL);
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_PushEvent, expected: 0, got: %d", result);
+   SDL_SetEventFilter(NULL, NULL);
+
+   for (i = 0; i < 3; ++i) {
+      SDL_PushEvent(&event);
+   }
+
+   /* Consume two of them */
+   SDL_PollEvent(&event);
+   SDL_PollEvent(&event);
+
+   result = SDL_GetEventTypeStats(SDL_USEREVENT, &typeStats);
+   SDLTest_AssertPass("Call to SDL_GetEventTypeStats()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_GetEventTypeStats, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(typeStats.pushed == 3, "Check pushed, expected: 3, got: %u", (unsigned int)typeStats.pushed);
+   SDLTest_AssertCheck(typeStats.filtered == 1, "Check filtered, expected: 1, got: %u", (unsigned int)typeStats.filtered);
+   SDLTest_AssertCheck(typeStats.dropped == 0, "Check dropped, expected: 0, got: %u", (unsigned int)typeStats.dropped);
+   SDLTest_AssertCheck(typeStats.consumed == 2, "Check consumed, expected: 2, got: %u", (unsigned int)typeStats.consumed);
+
+   result = SDL_GetEventQueueStats(&queueStats);
+   SDLTest_AssertPass("Call to SDL_GetEventQueueStats()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_GetEventQueueStats, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(queueStats.depth == 1, "Check depth, expected: 1, got: %d", queueStats.depth);
+   SDLTest_AssertCheck(queueStats.max_depth == 3, "Check max_depth, expected: 3, got: %d", queueStats.max_depth);
+   SDLTest_AssertCheck(queueStats.watcher_calls >= 1, "Check watcher_calls, expected: >=1, got: %u", (unsigned int)queueStats.watcher_calls);
+   SDLTest_AssertCheck(queueStats.latency_count == 2, "Check latency_count, expected: 2, got: %u", (unsigned int)queueStats.latency_count);
+   SDLTest_AssertCheck(queueStats.latency_p50_us <= queueStats.latency_max_us, "Check latency_p50_us <= latency_max_us");
+
+   /* Invalid parameters */
+   result = SDL_GetEventTypeStats(SDL_USEREVENT, NULL);
+   SDLTest_AssertCheck(result == -1, "Check result with NULL stats, expected: -1, got: %d", result);
+   result = SDL_GetEventQueueStats(NULL);
+   SDLTest_AssertCheck(result == -1, "Check result with NULL stats, expected: -1, got: %d", result);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks that motion events are merged in the queue when coalescing is enabled
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_EventCoalescing
+ */
+int
+events_coalesceMotion(void *arg)
+{
+   SDL_Event event;
+   SDL_EventTypeStats typeStats;
+   Uint8 state;
+   int i, count;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_ResetEventQueueStats();
+
+   state = SDL_EventCoalescing(SDL_USEREVENT, SDL_ENABLE);
+   SDLTest_AssertCheck(state == SDL_DISABLE, "Check user events can't be coalesced, got: %d", state);
+   state = SDL_EventCoalescing(SDL_MOUSEMOTION, SDL_QUERY);
+   SDLTest_AssertCheck(state == SDL_DISABLE, "Check mouse motion isn't coalesced by default, got: %d", state);
+   state = SDL_EventCoalescing(SDL_MOUSEMOTION, SDL_ENABLE);
+   SDLTest_AssertPass("Call to SDL_EventCoalescing(SDL_MOUSEMOTION, SDL_ENABLE)");
+
+   /* Four motions of the same mouse, then one of another mouse */
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   for (i = 1; i <= 4; ++i) {
+      event.motion.x = i * 10;
+      event.motion.y = i * 20;
+      event.motion.xrel = 10;
+      event.motion.yrel = -5;
+      SDL_PushEvent(&event);
+   }
+   event.motion.which = 1;
+   SDL_PushEvent(&event);
+
+   count = 0;
+   while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION) == 1) {
+      if (count == 0) {
+         SDLTest_AssertCheck(event.motion.x == 40 && event.motion.y == 80, "Check merged position, expected: 40,80, got: %d,%d", event.motion.x, event.motion.y);
+         SDLTest_AssertCheck(event.motion.xrel == 40 && event.motion.yrel == -20, "Check merged motion, expected: 40,-20, got: %d,%d", event.motion.xrel, event.motion.yrel);
+      }
+      ++count;
+   }
+   SDLTest_AssertCheck(count == 2, "Check queued motion events, expected: 2, got: %d", count);
+
+   SDL_GetEventTypeStats(SDL_MOUSEMOTION, &typeStats);
+   SDLTest_AssertCheck(typeStats.coalesced == 3, "Check coalesced, expected: 3, got: %u", (unsigned int)typeStats.coalesced);
+
+   state = SDL_EventCoalescing(SDL_MOUSEMOTION, SDL_DISABLE);
+   SDLTest_AssertCheck(state == SDL_ENABLE, "Check previous state, expected: SDL_ENABLE, got: %d", state);
+
+   /* Without coalescing every event is queued */
+   for (i = 0; i < 4; ++i) {
+      SDL_PushEvent(&event);
+   }
+   count = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(count == 4, "Check queued motion events, expected: 4, got: %d", count);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   return TEST_COMPLETED;
+}
+
+#ifdef __LINUX__
+/* Writes one input event to a uinput device */
+static int
+_events_writeInput(int fd, int type, int code, int value)
+{
+   struct input_event ev;
+
+   SDL_zero(ev);
+   ev.type = type;
+   ev.code = code;
+   ev.value = value;
+   return (write(fd, &ev, sizeof(ev)) == sizeof(ev)) ? 0 : -1;
+}
+#endif
+
+/**
+ * @brief Checks that every key event from an evdev device gets through when
+ * more arrive at once than SDL reads in one go
+ *
+ * Needs /dev/uinput and a video driver that reads evdev devices, and is
+ * skipped otherwise.
+ */
+int
+events_evdevBatchedRead(void *arg)
+{
+#ifdef __LINUX__
+   const char *driver = SDL_GetCurrentVideoDriver();
+   const int presses = 100;
+   struct uinput_user_dev dev;
+   SDL_Event event;
+   Uint32 start;
+   int fd, i, count, failed = 0;
+
+   if (!driver || (SDL_strcmp(driver, "dreambox") != 0 && SDL_strcmp(driver, "vivante") != 0 && SDL_strcmp(driver, "RPI") != 0)) {
+      SDLTest_Log("Video driver %s doesn't read evdev devices, skipping test", driver ? driver : "(none)");
+      return TEST_SKIPPED;
+   }
+   fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+   if (fd < 0) {
+      SDLTest_Log("Couldn't open /dev/uinput, skipping test");
+      return TEST_SKIPPED;
+   }
+
+   SDL_zero(dev);
+   SDL_strlcpy(dev.name, "SDL test keyboard", sizeof(dev.name));
+   dev.id.bustype = BUS_VIRTUAL;
+   if (ioctl(fd, UI_SET_EVBIT, EV_KEY) < 0 || ioctl(fd, UI_SET_KEYBIT, KEY_A) < 0 ||
+       write(fd, &dev, sizeof(dev)) != sizeof(dev) || ioctl(fd, UI_DEV_CREATE) < 0) {
+      SDLTest_Log("Couldn't create a uinput device, skipping test");
+      close(fd);
+      return TEST_SKIPPED;
+   }
+   SDLTest_AssertPass("Created a uinput keyboard");
+
+   /* Give hotplug time to open the new device */
+   for (i = 0; i < 50; ++i) {
+      SDL_PumpEvents();
+      SDL_Delay(10);
+   }
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Several reads' worth of events, all written before SDL looks */
+   for (i = 0; i < presses && !failed; ++i) {
+      failed |= _events_writeInput(fd, EV_KEY, KEY_A, 1);
+      failed |= _events_writeInput(fd, EV_SYN, SYN_REPORT, 0);
+      failed |= _events_writeInput(fd, EV_KEY, KEY_A, 0);
+      failed |= _events_writeInput(fd, EV_SYN, SYN_REPORT, 0);
+   }
+   SDLTest_AssertCheck(failed == 0, "Check writing %d key presses to the device", presses);
+
+   count = 0;
+   start = SDL_GetTicks();
+   while (count < presses && !SDL_TICKS_PASSED(SDL_GetTicks(), start + 1000)) {
+      SDL_PumpEvents();
+      while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_KEYDOWN, SDL_KEYDOWN) == 1) {
+         if (event.key.keysym.scancode == SDL_SCANCODE_A) {
+            ++count;
+         }
+      }
+   }
+   SDLTest_AssertCheck(count == presses, "Check key presses received, expected: %d, got: %d", presses, count);
+
+   ioctl(fd, UI_DEV_DESTROY);
+   close(fd);
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   return TEST_COMPLETED;
+#else
+   SDLTest_Log("evdev is only on Linux, skipping test");
+   return TEST_SKIPPED;
+#endif
+}
 
 /* ================= Test References ================== */
 
@@ -187,9 +417,18 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_queueStats, "events_queueStats", "Checks the event queue statistics", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Checks that motion events are merged in the queue", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_evdevBatchedRead, "events_evdevBatchedRead", "Checks that bursts of evdev key events all get through", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, NULL
 };
 
 /* Events test suite (global) */
@@ -145,6 +145,142 @@ hints_setHint(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Check hint priorities against the environment, and that returned
+ *        values stay readable after the hint changes
+ */
+int
+hints_priorityAndEnvironment(void *arg)
+{
+  const char *name = "SDL_TEST_HINT_PRIORITY";
+  const char *first;
+  const char *value;
+  SDL_bool result;
+
+  result = SDL_SetHint(name, "first");
+  SDLTest_AssertCheck(result == SDL_TRUE, "Verify SDL_SetHint(%s, first) succeeded", name);
+  first = SDL_GetHint(name);
+  SDLTest_AssertCheck(first && SDL_strcmp(first, "first") == 0, "Verify hint is 'first', got '%s'", first ? first : "null");
+
+  result = SDL_SetHint(name, "second");
+  SDLTest_AssertCheck(result == SDL_TRUE, "Verify SDL_SetHint(%s, second) succeeded", name);
+  value = SDL_GetHint(name);
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "second") == 0, "Verify hint is 'second', got '%s'", value ? value : "null");
+  SDLTest_AssertCheck(SDL_strcmp(first, "first") == 0, "Verify the earlier value is still readable, got '%s'", first);
+
+  result = SDL_SetHintWithPriority(name, "default", SDL_HINT_DEFAULT);
+  SDLTest_AssertCheck(result == SDL_FALSE, "Verify a lower priority can't replace the hint");
+  value = SDL_GetHint(name);
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "second") == 0, "Verify hint is still 'second', got '%s'", value ? value : "null");
+
+  SDL_setenv(name, "environment", 1);
+  SDLTest_AssertPass("Call to SDL_setenv(%s, environment)", name);
+  value = SDL_GetHint(name);
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "environment") == 0, "Verify the environment wins, got '%s'", value ? value : "null");
+  result = SDL_SetHint(name, "third");
+  SDLTest_AssertCheck(result == SDL_FALSE, "Verify SDL_SetHint() can't replace the environment");
+
+  result = SDL_SetHintWithPriority(name, "override", SDL_HINT_OVERRIDE);
+  SDLTest_AssertCheck(result == SDL_TRUE, "Verify SDL_HINT_OVERRIDE replaces the environment");
+  value = SDL_GetHint(name);
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "override") == 0, "Verify hint is 'override', got '%s'", value ? value : "null");
+
+  SDL_setenv(name, "", 1);
+  return TEST_COMPLETED;
+}
+
+static int _hintCallbackCount;
+static char _hintCallbackOld[32], _hintCallbackNew[32];
+
+static int SDLCALL
+_hintSetterThread(void *data)
+{
+  SDL_SetHint("SDL_TEST_HINT_OTHER", (const char *) data);
+  return 0;
+}
+
+/* Waits on a thread that sets a hint, which would deadlock if hints were locked */
+static void SDLCALL
+_hintWaitingCallback(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+  SDL_Thread *thread;
+
+  _hintCallbackCount++;
+  SDL_strlcpy(_hintCallbackOld, oldValue ? oldValue : "null", sizeof(_hintCallbackOld));
+  SDL_strlcpy(_hintCallbackNew, newValue ? newValue : "null", sizeof(_hintCallbackNew));
+  if (oldValue != newValue) {
+    thread = SDL_CreateThread(_hintSetterThread, "HintSetter", (void *) newValue);
+    SDL_WaitThread(thread, NULL);
+  }
+}
+
+static void SDLCALL
+_hintCountingCallback(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+  (*(int *) userdata)++;
+}
+
+/* Removes the counting callback, which comes after it */
+static void SDLCALL
+_hintRemovingCallback(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+  SDL_DelHintCallback(name, _hintCountingCallback, userdata);
+}
+
+/**
+ * @brief Check that hint callbacks run without the hints locked, and that a
+ *        hint can change many times
+ */
+int
+hints_callbacks(void *arg)
+{
+  const char *name = "SDL_TEST_HINT_CALLBACK";
+  const char *value;
+  char buf[32];
+  int counted = 0;
+  int i;
+
+  SDL_SetHint(name, "start");
+  _hintCallbackCount = 0;
+  SDL_AddHintCallback(name, _hintWaitingCallback, NULL);
+  SDLTest_AssertPass("Call to SDL_AddHintCallback()");
+  SDLTest_AssertCheck(_hintCallbackCount == 1, "Verify the callback was called when added, got %d calls", _hintCallbackCount);
+
+  SDL_SetHint(name, "changed");
+  SDLTest_AssertPass("Call to SDL_SetHint() with a callback waiting on another thread");
+  SDLTest_AssertCheck(_hintCallbackCount == 2, "Verify the callback was called, got %d calls", _hintCallbackCount);
+  SDLTest_AssertCheck(SDL_strcmp(_hintCallbackOld, "start") == 0 && SDL_strcmp(_hintCallbackNew, "changed") == 0,
+                      "Verify the callback values, got '%s' -> '%s'", _hintCallbackOld, _hintCallbackNew);
+  value = SDL_GetHint("SDL_TEST_HINT_OTHER");
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "changed") == 0, "Verify the other thread set its hint, got '%s'", value ? value : "null");
+  SDL_DelHintCallback(name, _hintWaitingCallback, NULL);
+
+  /* A callback removed by an earlier one isn't called */
+  SDL_AddHintCallback(name, _hintCountingCallback, &counted);
+  SDL_AddHintCallback(name, _hintRemovingCallback, &counted);
+  counted = 0;
+  SDL_SetHint(name, "removed");
+  SDLTest_AssertCheck(counted == 0, "Verify the removed callback wasn't called, got %d calls", counted);
+  SDL_DelHintCallback(name, _hintRemovingCallback, &counted);
+
+  /* Old values are dropped as new ones come in */
+  for (i = 0; i < 100; i++) {
+    SDL_snprintf(buf, sizeof(buf), "value %d", i);
+    SDL_SetHint(name, buf);
+    value = SDL_GetHint(name);
+    if (!value || SDL_strcmp(value, buf) != 0) {
+      SDLTest_AssertCheck(SDL_FALSE, "Verify hint is '%s', got '%s'", buf, value ? value : "null");
+      break;
+    }
+  }
+  SDLTest_AssertCheck(i == 100, "Verify the hint followed 100 changes, got %d", i);
+  SDL_SetHint(name, "value 3");
+  value = SDL_GetHint(name);
+  SDLTest_AssertCheck(value && SDL_strcmp(value, "value 3") == 0, "Verify an old value can be set again, got '%s'", value ? value : "null");
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -154,9 +290,15 @@ static const SDLTest_TestCaseReference hintsTest1 =
 static const SDLTest_TestCaseReference hintsTest2 =
         { (SDLTest_TestCaseFp)hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference hintsTest3 =
+        { (SDLTest_TestCaseFp)hints_priorityAndEnvironment, "hints_priorityAndEnvironment", "Check hint priorities against the environment", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference hintsTest4 =
+        { (SDLTest_TestCaseFp)hints_callbacks, "hints_callbacks", "Check that hint callbacks run without the hints locked", TEST_ENABLED };
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] =  {
-    &hintsTest1, &hintsTest2, NULL
+    &hintsTest1, &hintsTest2, &hintsTest3, &hintsTest4, NULL
 };
 
 /* Hints test suite (global) */
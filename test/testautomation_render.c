@@ -8,6 +8,13 @@
 #include "SDL.h"
 #include "SDL_test.h"
 
+#if defined(__LINUX__) || defined(__MACOSX__)
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#define HAVE_PROGRAM_CACHE_TEST 1
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 #define TESTRENDER_SCREEN_W     80
@@ -36,6 +43,7 @@ static SDL_Texture *_loadTestFace(void);
 static int _hasBlendModes(void);
 static int _hasDrawColor(void);
 static int _isSupported(int code);
+static void _drawRows(void);
 
 /**
  * Create software renderer for tests
@@ -766,6 +774,1021 @@ render_testBlitBlend (void *arg)
 }
 
 
+/**
+ * @brief Tests reading pixels asynchronously.
+ *
+ * Reads the primitives back with SDL_RenderReadPixelsAsync() in a few
+ * formats and clipped rects, and compares them to SDL_RenderReadPixels().
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderReadPixels
+ */
+int
+render_testReadPixelsAsync (void *arg)
+{
+   const Uint32 formats[] = { RENDER_COMPARE_FORMAT, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565 };
+   SDL_RenderReadback *readback;
+   SDL_Rect rects[2];
+   Uint8 *expected, *pixels;
+   const int pitch = 4*TESTRENDER_SCREEN_W;
+   const size_t size = pitch*TESTRENDER_SCREEN_H;
+   int i, j, ret;
+
+   expected = (Uint8 *)SDL_malloc(size);
+   pixels = (Uint8 *)SDL_malloc(size);
+   SDLTest_AssertCheck(expected != NULL && pixels != NULL, "Validate allocated pixel buffers");
+   if (expected == NULL || pixels == NULL) {
+      SDL_free(expected);
+      SDL_free(pixels);
+      return TEST_ABORTED;
+   }
+
+   /* The whole test area, and one hanging off the top left of the viewport */
+   rects[0].x = 0;
+   rects[0].y = 0;
+   rects[0].w = TESTRENDER_SCREEN_W;
+   rects[0].h = TESTRENDER_SCREEN_H;
+   rects[1].x = -5;
+   rects[1].y = -7;
+   rects[1].w = 30;
+   rects[1].h = 20;
+
+   for (i = 0; i < SDL_arraysize(rects); i++) {
+      for (j = 0; j < SDL_arraysize(formats); j++) {
+         _drawRows();
+         SDL_memset(expected, 0xAA, size);
+         SDL_memset(pixels, 0xAA, size);
+
+         ret = SDL_RenderReadPixels(renderer, &rects[i], formats[j], expected, pitch);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+         readback = SDL_RenderReadPixelsAsync(renderer, &rects[i]);
+         SDLTest_AssertCheck(readback != NULL, "Validate result from SDL_RenderReadPixelsAsync is not NULL");
+         if (readback == NULL) {
+            continue;
+         }
+
+         /* Drawing after the read has started mustn't change what it reads */
+         SDL_SetRenderDrawColor(renderer, 1, 2, 3, SDL_ALPHA_OPAQUE);
+         SDL_RenderDrawLine(renderer, 0, 0, TESTRENDER_SCREEN_W - 1, TESTRENDER_SCREEN_H - 1);
+
+         ret = SDL_FinishRenderReadback(readback, formats[j], pixels, pitch);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_FinishRenderReadback, expected: 0, got: %i", ret);
+         SDLTest_AssertCheck(SDL_memcmp(expected, pixels, size) == 0,
+            "Validate pixels read asynchronously match, rect %i format %s", i, SDL_GetPixelFormatName(formats[j]));
+      }
+   }
+
+   /* A readback can be dropped without reading it, or left for SDL_DestroyRenderer() */
+   readback = SDL_RenderReadPixelsAsync(renderer, NULL);
+   SDLTest_AssertCheck(readback != NULL, "Validate result from SDL_RenderReadPixelsAsync is not NULL");
+   if (readback) {
+      while (!SDL_RenderReadbackReady(readback)) {
+         SDL_Delay(1);
+      }
+      SDLTest_AssertPass("SDL_RenderReadbackReady()");
+      ret = SDL_FinishRenderReadback(readback, 0, NULL, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from discarding with SDL_FinishRenderReadback, expected: 0, got: %i", ret);
+   }
+   readback = SDL_RenderReadPixelsAsync(renderer, &rects[1]);
+   SDLTest_AssertCheck(readback != NULL, "Validate result from SDL_RenderReadPixelsAsync is not NULL");
+
+   SDL_free(expected);
+   SDL_free(pixels);
+
+   return TEST_COMPLETED;
+}
+
+#define ATLAS_TEXTURES  15
+#define ATLAS_MAX_SIZE  8
+/* Each texture gets a cell that holds it at twice its largest size */
+#define ATLAS_CELL      (2*ATLAS_MAX_SIZE)
+#define ATLAS_COLUMNS   (TESTRENDER_SCREEN_W/ATLAS_CELL)
+
+/**
+ * @brief Draws the test textures in a grid, scaled and flipped by turns. Helper function.
+ */
+static void
+_drawAtlasGrid(SDL_Texture **textures, Uint8 *pixels)
+{
+   SDL_Rect rect;
+   int i, ret;
+
+   _clearScreen();
+   for (i = 0; i < ATLAS_TEXTURES; i++) {
+      if (textures[i] == NULL) {
+         continue;
+      }
+      SDL_QueryTexture(textures[i], NULL, NULL, &rect.w, &rect.h);
+      rect.x = (i % ATLAS_COLUMNS) * ATLAS_CELL;
+      rect.y = (i / ATLAS_COLUMNS) * ATLAS_CELL;
+      if (i % 3 == 1) {
+         /* Twice the size, so no sample lands on the edge of a texel,
+            where GPUs may round either way */
+         rect.w *= 2;
+         rect.h *= 2;
+      }
+      ret = SDL_RenderCopyEx(renderer, textures[i], NULL, &rect, 0.0, NULL, (i % 4 == 2) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+   }
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = TESTRENDER_SCREEN_W;
+   rect.h = TESTRENDER_SCREEN_H;
+   ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, pixels, 4*TESTRENDER_SCREEN_W);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+}
+
+/**
+ * @brief Tests textures packed into an atlas.
+ *
+ * Draws the same surfaces from their own textures and from an atlas, and
+ * checks they come out the same before and after the atlas is compacted.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTextureFromSurface
+ */
+int
+render_testAtlas (void *arg)
+{
+   SDL_Texture *textures[ATLAS_TEXTURES];
+   SDL_Texture *atlas_textures[ATLAS_TEXTURES];
+   SDL_RenderAtlasStats stats;
+   SDL_Surface *surface;
+   Uint8 *expected, *pixels;
+   const size_t size = 4*TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H;
+   int i, x, y, ret;
+
+   expected = (Uint8 *)SDL_calloc(1, size);
+   pixels = (Uint8 *)SDL_calloc(1, size);
+   SDLTest_AssertCheck(expected != NULL && pixels != NULL, "Validate allocated pixel buffers");
+   if (expected == NULL || pixels == NULL) {
+      SDL_free(expected);
+      SDL_free(pixels);
+      return TEST_ABORTED;
+   }
+
+   /* Random small opaque surfaces */
+   for (i = 0; i < ATLAS_TEXTURES; i++) {
+      surface = SDL_CreateRGBSurface(0, SDLTest_RandomIntegerInRange(1, ATLAS_MAX_SIZE), SDLTest_RandomIntegerInRange(1, ATLAS_MAX_SIZE), 32,
+                                     RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+      SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+      if (surface == NULL) {
+         textures[i] = atlas_textures[i] = NULL;
+         continue;
+      }
+      for (y = 0; y < surface->h; y++) {
+         for (x = 0; x < surface->w; x++) {
+            ((Uint32 *)((Uint8 *)surface->pixels + y*surface->pitch))[x] = SDLTest_RandomUint32() | RENDER_COMPARE_AMASK;
+         }
+      }
+      textures[i] = SDL_CreateTextureFromSurface(renderer, surface);
+      atlas_textures[i] = SDL_CreateAtlasTextureFromSurface(renderer, surface);
+      SDLTest_AssertCheck(textures[i] != NULL && atlas_textures[i] != NULL, "Verify results from SDL_CreateTextureFromSurface and SDL_CreateAtlasTextureFromSurface are not NULL");
+      SDL_FreeSurface(surface);
+
+      /* Modulation is kept per texture, not per page */
+      if (i % 2) {
+         SDL_SetTextureColorMod(textures[i], 200, 100, 50);
+         SDL_SetTextureColorMod(atlas_textures[i], 200, 100, 50);
+      }
+   }
+
+   ret = SDL_GetRenderAtlasStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderAtlasStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.textures == ATLAS_TEXTURES, "Validate textures in the atlas, expected: %i, got: %i", ATLAS_TEXTURES, stats.textures);
+   SDLTest_AssertCheck(stats.pages == 1, "Validate pages in the atlas, expected: 1, got: %i", stats.pages);
+   SDLTest_AssertCheck(stats.used_area > 0 && stats.used_area < stats.total_area, "Validate area used in the atlas");
+
+   _drawAtlasGrid(textures, expected);
+   _drawAtlasGrid(atlas_textures, pixels);
+   SDLTest_AssertCheck(SDL_memcmp(expected, pixels, size) == 0, "Validate textures in the atlas draw like their own");
+
+   /* Free every other texture, then repack the rest */
+   for (i = 0; i < ATLAS_TEXTURES; i += 2) {
+      SDL_DestroyTexture(textures[i]);
+      SDL_DestroyTexture(atlas_textures[i]);
+      textures[i] = atlas_textures[i] = NULL;
+   }
+   SDL_GetRenderAtlasStats(renderer, &stats);
+   SDLTest_AssertCheck(stats.textures == ATLAS_TEXTURES/2, "Validate textures in the atlas, expected: %i, got: %i", ATLAS_TEXTURES/2, stats.textures);
+
+   if (SDL_RenderTargetSupported(renderer)) {
+      ret = SDL_CompactRenderAtlas(renderer);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_CompactRenderAtlas, expected: 0, got: %i", ret);
+      SDL_GetRenderAtlasStats(renderer, &stats);
+      SDLTest_AssertCheck(stats.textures == ATLAS_TEXTURES/2, "Validate textures in the atlas, expected: %i, got: %i", ATLAS_TEXTURES/2, stats.textures);
+   }
+
+   _drawAtlasGrid(textures, expected);
+   _drawAtlasGrid(atlas_textures, pixels);
+   SDLTest_AssertCheck(SDL_memcmp(expected, pixels, size) == 0, "Validate textures in the atlas draw like their own after compacting");
+
+   /* The page goes with the last texture on it */
+   for (i = 0; i < ATLAS_TEXTURES; i++) {
+      if (textures[i]) {
+         SDL_DestroyTexture(textures[i]);
+      }
+      if (atlas_textures[i]) {
+         SDL_DestroyTexture(atlas_textures[i]);
+      }
+   }
+   SDL_GetRenderAtlasStats(renderer, &stats);
+   SDLTest_AssertCheck(stats.pages == 0, "Validate pages in the atlas, expected: 0, got: %i", stats.pages);
+
+   SDL_free(expected);
+   SDL_free(pixels);
+
+   return TEST_COMPLETED;
+}
+
+#if HAVE_PROGRAM_CACHE_TEST
+#define PROGRAM_FILES_COUNT     0
+#define PROGRAM_FILES_MARK      1
+#define PROGRAM_FILES_MARKED    2
+#define PROGRAM_FILES_REMOVE    3
+
+/* Appended to the saved programs. Loading a program leaves its file alone,
+   linking it again rewrites the file without this. */
+static const char _programMarker[] = "testautomation";
+
+/* Does action to each saved program in dir, returns how many it worked on */
+static int
+_programFiles(const char *dir, int action)
+{
+   DIR *d = opendir(dir);
+   struct dirent *ent;
+   SDL_RWops *rw;
+   char path[4096];
+   char marker[sizeof (_programMarker)];
+   size_t len;
+   int count = 0;
+
+   if (d == NULL) {
+      return 0;
+   }
+   while ((ent = readdir(d)) != NULL) {
+      len = SDL_strlen(ent->d_name);
+      if (len < 4 || SDL_strcmp(ent->d_name + len - 4, ".bin") != 0) {
+         continue;
+      }
+      SDL_snprintf(path, sizeof (path), "%s/%s", dir, ent->d_name);
+      switch (action) {
+      case PROGRAM_FILES_MARK:
+         rw = SDL_RWFromFile(path, "ab");
+         if (rw != NULL) {
+            count += (int) SDL_RWwrite(rw, _programMarker, sizeof (_programMarker), 1);
+            SDL_RWclose(rw);
+         }
+         break;
+      case PROGRAM_FILES_MARKED:
+         rw = SDL_RWFromFile(path, "rb");
+         if (rw != NULL) {
+            if (SDL_RWseek(rw, -(Sint64) sizeof (marker), RW_SEEK_END) >= 0 &&
+                SDL_RWread(rw, marker, sizeof (marker), 1) == 1 &&
+                SDL_memcmp(marker, _programMarker, sizeof (marker)) == 0) {
+               count++;
+            }
+            SDL_RWclose(rw);
+         }
+         break;
+      case PROGRAM_FILES_REMOVE:
+         count += (remove(path) == 0);
+         break;
+      default:
+         count++;
+         break;
+      }
+   }
+   closedir(d);
+   if (action == PROGRAM_FILES_REMOVE) {
+      rmdir(dir);
+   }
+   return count;
+}
+#endif
+
+/**
+ * @brief Tests preparing shaders ahead of time.
+ *
+ * Calls SDL_RenderWarmUp() and checks that drawing with every blend mode
+ * still gives the expected results afterwards. On OpenGL ES 2, it also
+ * checks that a recreated renderer loads its programs from the disk cache.
+ */
+int
+render_testWarmUp (void *arg)
+{
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+#if HAVE_PROGRAM_CACHE_TEST
+   SDL_RendererInfo info;
+#endif
+   SDL_Rect rect;
+   Uint32 pixel;
+   int i, ret;
+
+   ret = SDL_RenderWarmUp(NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderWarmUp(NULL), expected: -1, got: %i", ret);
+
+   ret = SDL_RenderWarmUp(renderer);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderWarmUp, expected: 0, got: %i", ret);
+
+   /* Opaque white drawn over black comes out white in every mode but MOD */
+   for (i = 0; i < SDL_arraysize(modes); i++) {
+      _clearScreen();
+      rect.x = i * 8;
+      rect.y = i * 8;
+      rect.w = 8;
+      rect.h = 8;
+      SDL_SetRenderDrawBlendMode(renderer, modes[i]);
+      SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+      SDL_RenderFillRect(renderer, &rect);
+
+      rect.w = 1;
+      rect.h = 1;
+      pixel = 0;
+      ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+      SDLTest_AssertCheck((pixel & 0x00FFFFFF) == (modes[i] == SDL_BLENDMODE_MOD ? 0 : 0x00FFFFFF),
+                          "Validate pixel drawn with blend mode %i, got: 0x%08x", modes[i], pixel);
+   }
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+#if HAVE_PROGRAM_CACHE_TEST
+   if (SDL_GetRendererInfo(renderer, &info) == 0 && SDL_strcmp(info.name, "opengles2") == 0) {
+      char dir[] = "/tmp/sdlprogramsXXXXXX";
+      int saved, marked, loaded;
+
+      SDLTest_AssertCheck(mkdtemp(dir) != NULL, "Create a directory for the program cache");
+      SDL_SetHint(SDL_HINT_RENDER_PROGRAM_CACHE, dir);
+
+      /* The first renderer links the programs and saves them */
+      SDL_DestroyRenderer(renderer);
+      renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+      SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result with the program cache");
+      if (renderer != NULL) {
+         ret = SDL_RenderWarmUp(renderer);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderWarmUp, expected: 0, got: %i", ret);
+         SDL_DestroyRenderer(renderer);
+      }
+      saved = _programFiles(dir, PROGRAM_FILES_COUNT);
+      marked = _programFiles(dir, PROGRAM_FILES_MARK);
+      SDLTest_AssertCheck(marked == saved, "Mark the saved programs, expected: %i, got: %i", saved, marked);
+
+      /* The second one loads them, and leaves the files alone */
+      renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+      SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result with the program cache");
+      if (renderer != NULL) {
+         ret = SDL_RenderWarmUp(renderer);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderWarmUp, expected: 0, got: %i", ret);
+      }
+      if (saved == 0) {
+         SDLTest_Log("The driver can't save program binaries, so the cache wasn't checked");
+      } else {
+         loaded = _programFiles(dir, PROGRAM_FILES_MARKED);
+         SDLTest_AssertCheck(loaded == saved, "Validate programs loaded from the cache, expected: %i, got: %i", saved, loaded);
+      }
+
+      SDL_SetHint(SDL_HINT_RENDER_PROGRAM_CACHE, "0");
+      _programFiles(dir, PROGRAM_FILES_REMOVE);
+   }
+#endif
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the statistics of presents.
+ *
+ * Checks that a clear updates the whole output, and that a small fill
+ * updates no less than the area filled.
+ */
+int
+render_testPresentStats (void *arg)
+{
+   SDL_RenderPresentStats stats;
+   SDL_RendererInfo info;
+   SDL_Rect rect;
+   Uint32 total;
+   SDL_bool tracked;
+   int w = 0, h = 0, ret;
+
+   ret = SDL_GetRenderPresentStats(NULL, &stats);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_GetRenderPresentStats(NULL), expected: -1, got: %i", ret);
+   ret = SDL_GetRenderPresentStats(renderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_GetRenderPresentStats with NULL stats, expected: -1, got: %i", ret);
+
+   /* Only the software renderer tracks damage, the others update everything */
+   tracked = (SDL_GetRendererInfo(renderer, &info) == 0 && SDL_strcmp(info.name, "software") == 0);
+
+   SDL_GetRendererOutputSize(renderer, &w, &h);
+   total = (Uint32)(w * h);
+   _clearScreen();
+   SDL_ResetRenderPresentStats(renderer);
+
+   /* A clear damages everything */
+   SDL_RenderClear(renderer);
+   SDL_RenderPresent(renderer);
+   ret = SDL_GetRenderPresentStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderPresentStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.frames == 1, "Validate frames, expected: 1, got: %u", (unsigned int)stats.frames);
+   SDLTest_AssertCheck(stats.total_pixels == total, "Validate total pixels, expected: %u, got: %u", (unsigned int)total, (unsigned int)stats.total_pixels);
+   SDLTest_AssertCheck(stats.damaged_pixels == total, "Validate damaged pixels, expected: %u, got: %u", (unsigned int)total, (unsigned int)stats.damaged_pixels);
+   SDLTest_AssertCheck(stats.damaged_ratio == 1.0f, "Validate damaged ratio, expected: 1.0, got: %f", stats.damaged_ratio);
+
+   /* A small fill damages at least what was filled */
+   rect.x = 10;
+   rect.y = 20;
+   rect.w = 8;
+   rect.h = 8;
+   SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderPresent(renderer);
+   SDL_GetRenderPresentStats(renderer, &stats);
+   if (tracked) {
+      SDLTest_AssertCheck(stats.rects == 1, "Validate rects, expected: 1, got: %i", stats.rects);
+      SDLTest_AssertCheck(stats.damaged_pixels == 64, "Validate damaged pixels, expected: 64, got: %u", (unsigned int)stats.damaged_pixels);
+   } else {
+      SDLTest_AssertCheck(stats.rects >= 1, "Validate rects, expected: >= 1, got: %i", stats.rects);
+      SDLTest_AssertCheck(stats.damaged_pixels >= 64 && stats.damaged_pixels <= total,
+                          "Validate damaged pixels, expected: 64 to %u, got: %u", (unsigned int)total, (unsigned int)stats.damaged_pixels);
+   }
+
+   /* Nothing drawn damages nothing, or no more than the output */
+   SDL_RenderPresent(renderer);
+   SDL_GetRenderPresentStats(renderer, &stats);
+   if (tracked) {
+      SDLTest_AssertCheck(stats.rects == 0, "Validate rects, expected: 0, got: %i", stats.rects);
+      SDLTest_AssertCheck(stats.damaged_pixels == 0, "Validate damaged pixels, expected: 0, got: %u", (unsigned int)stats.damaged_pixels);
+   } else {
+      SDLTest_AssertCheck(stats.damaged_pixels <= total, "Validate damaged pixels, expected: <= %u, got: %u", (unsigned int)total, (unsigned int)stats.damaged_pixels);
+   }
+   SDLTest_AssertCheck(stats.frames == 3, "Validate frames, expected: 3, got: %u", (unsigned int)stats.frames);
+   SDLTest_AssertCheck(stats.total_pixels_sum == (Uint64)total * 3, "Validate total pixels over all frames");
+   SDLTest_AssertCheck(stats.damaged_pixels_sum >= (Uint64)total + 64 && stats.damaged_pixels_sum <= stats.total_pixels_sum,
+                       "Validate damaged pixels over all frames");
+
+   SDL_ResetRenderPresentStats(renderer);
+   SDL_GetRenderPresentStats(renderer, &stats);
+   SDLTest_AssertCheck(stats.frames == 0, "Validate frames after reset, expected: 0, got: %u", (unsigned int)stats.frames);
+
+   return TEST_COMPLETED;
+}
+
+/* Fills in the four corners of a rect, for two triangles through _quadIndices */
+static void
+_setQuad(SDL_Vertex *vertices, float x, float y, float w, float h, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+   int i;
+
+   for (i = 0; i < 4; i++) {
+      vertices[i].x = x + ((i & 1) ? w : 0.0f);
+      vertices[i].y = y + ((i & 2) ? h : 0.0f);
+      vertices[i].u = (i & 1) ? 1.0f : 0.0f;
+      vertices[i].v = (i & 2) ? 1.0f : 0.0f;
+      vertices[i].color.r = r;
+      vertices[i].color.g = g;
+      vertices[i].color.b = b;
+      vertices[i].color.a = a;
+   }
+}
+
+static const int _quadIndices[] = { 0, 1, 2, 2, 1, 3 };
+
+/**
+ * @brief Tests drawing triangles with SDL_RenderGeometry().
+ *
+ * Checks that quads made of two triangles cover the same pixels as the
+ * equivalent fills and copies, and that vertex colors are interpolated.
+ */
+int
+render_testGeometry (void *arg)
+{
+   SDL_Vertex vertices[4];
+   SDL_Texture *tface;
+   SDL_Rect rect, area;
+   Uint8 *expected, *pixels;
+   const int pitch = 4*TESTRENDER_SCREEN_W;
+   const size_t size = pitch*TESTRENDER_SCREEN_H;
+   const int bad_indices[] = { 0, 1, 4 };
+   Uint32 pixel;
+   int ret;
+
+   area.x = 0;
+   area.y = 0;
+   area.w = TESTRENDER_SCREEN_W;
+   area.h = TESTRENDER_SCREEN_H;
+
+   expected = (Uint8 *)SDL_malloc(size);
+   pixels = (Uint8 *)SDL_malloc(size);
+   SDLTest_AssertCheck(expected != NULL && pixels != NULL, "Validate allocated pixel buffers");
+   if (expected == NULL || pixels == NULL) {
+      SDL_free(expected);
+      SDL_free(pixels);
+      return TEST_ABORTED;
+   }
+
+   /* Invalid parameters */
+   _setQuad(vertices, 0.0f, 0.0f, 8.0f, 8.0f, 255, 255, 255, 255);
+   ret = SDL_RenderGeometry(renderer, NULL, NULL, 3, NULL, 0);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with NULL vertices, expected: -1, got: %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, NULL, 0);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with 4 vertices, expected: -1, got: %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, bad_indices, 3);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with an index out of range, expected: -1, got: %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, _quadIndices, 4);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with 4 indices, expected: -1, got: %i", ret);
+
+   /* Only renderers that implement geometry are checked */
+   SDL_ClearError();
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, _quadIndices, 6);
+   if (ret == -1 && SDL_strcmp(SDL_GetError(), "That operation is not supported") == 0) {
+      SDLTest_Log("SDL_RenderGeometry is not supported by this renderer");
+      SDL_free(expected);
+      SDL_free(pixels);
+      return TEST_SKIPPED;
+   }
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+
+   /* A solid quad covers what a fill does, with no gap or seam on the diagonal */
+   _clearScreen();
+   rect.x = 10;
+   rect.y = 7;
+   rect.w = 23;
+   rect.h = 31;
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+   SDL_SetRenderDrawColor(renderer, 200, 100, 50, 128);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderFillRect(renderer, &rect);
+   ret = SDL_RenderReadPixels(renderer, &area, RENDER_COMPARE_FORMAT, expected, pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+   _clearScreen();
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+   _setQuad(vertices, 10.0f, 7.0f, 23.0f, 31.0f, 200, 100, 50, 128);
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, _quadIndices, 6);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, _quadIndices, 6);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   ret = SDL_RenderReadPixels(renderer, &area, RENDER_COMPARE_FORMAT, pixels, pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(SDL_memcmp(expected, pixels, size) == 0, "Validate solid quad matches the filled rect");
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+   /* A textured quad covers what a copy does */
+   tface = _loadTestFace();
+   SDLTest_AssertCheck(tface != NULL, "Verify _loadTestFace() result");
+   if (tface != NULL) {
+      _clearScreen();
+      rect.x = 20;
+      rect.y = 12;
+      SDL_QueryTexture(tface, NULL, NULL, &rect.w, &rect.h);
+      SDL_SetTextureColorMod(tface, 255, 128, 255);
+      SDL_RenderCopy(renderer, tface, NULL, &rect);
+      SDL_RenderReadPixels(renderer, &area, RENDER_COMPARE_FORMAT, expected, pitch);
+
+      _clearScreen();
+      _setQuad(vertices, 20.0f, 12.0f, (float)rect.w, (float)rect.h, 255, 255, 255, 255);
+      ret = SDL_RenderGeometry(renderer, tface, vertices, 4, _quadIndices, 6);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+      SDL_RenderReadPixels(renderer, &area, RENDER_COMPARE_FORMAT, pixels, pitch);
+      SDLTest_AssertCheck(SDL_memcmp(expected, pixels, size) == 0, "Validate textured quad matches the copy");
+      SDL_DestroyTexture(tface);
+   }
+
+   /* Colors blend from corner to corner */
+   _clearScreen();
+   _setQuad(vertices, 0.0f, 0.0f, 64.0f, 48.0f, 0, 0, 0, 255);
+   vertices[0].color.r = 255;
+   vertices[3].color.b = 255;
+   ret = SDL_RenderGeometry(renderer, NULL, vertices, 4, _quadIndices, 6);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   rect.w = 1;
+   rect.h = 1;
+
+   rect.x = 0;
+   rect.y = 0;
+   SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+   SDLTest_AssertCheck(((pixel >> 16) & 0xFF) > 240 && (pixel & 0xFF) < 16, "Validate pixel near the red corner, got: 0x%08x", pixel);
+   rect.x = 63;
+   rect.y = 47;
+   SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+   SDLTest_AssertCheck(((pixel >> 16) & 0xFF) < 16 && (pixel & 0xFF) > 240, "Validate pixel near the blue corner, got: 0x%08x", pixel);
+   rect.x = 63;
+   rect.y = 0;
+   SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+   SDLTest_AssertCheck((pixel & 0x00FFFFFF) < 0x00101010, "Validate pixel near a black corner, got: 0x%08x", pixel);
+
+   SDL_free(expected);
+   SDL_free(pixels);
+
+   return TEST_COMPLETED;
+}
+
+/* What a blended fill does to one channel, 'a' being the draw alpha */
+static Uint8
+_blendChannel(SDL_BlendMode blendMode, Uint8 d, Uint8 s, Uint8 a)
+{
+   unsigned v;
+
+   switch (blendMode) {
+   case SDL_BLENDMODE_BLEND:
+      return (Uint8)(((255 - a) * d) / 255 + (s * a) / 255);
+   case SDL_BLENDMODE_ADD:
+      v = d + (s * a) / 255;
+      return (Uint8)((v > 255) ? 255 : v);
+   default:
+      return (Uint8)((d * s) / 255);
+   }
+}
+
+/**
+ * @brief Tests blended fills and horizontal lines in the software renderer
+ * against a per pixel reference, for the formats with fast blended spans.
+ */
+int
+render_testBlendFillFormats (void *arg)
+{
+   const Uint32 formats[] = {
+      SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ABGR8888,
+      SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR565, SDL_PIXELFORMAT_RGB555
+   };
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+   const Uint8 cr = 200, cg = 100, cb = 50, ca = 120;
+   SDL_Rect rects[3];
+   size_t f, m, i;
+   int x, y, ret;
+
+   /* Odd widths, so every span has a tail after its vectors */
+   rects[0].x = 1; rects[0].y = 1; rects[0].w = 35; rects[0].h = 1;
+   rects[1].x = 0; rects[1].y = 3; rects[1].w = 37; rects[1].h = 2;
+   rects[2].x = 30; rects[2].y = 5; rects[2].w = 40; rects[2].h = 1;
+
+   for (f = 0; f < SDL_arraysize(formats); ++f) {
+      for (m = 0; m < SDL_arraysize(modes); ++m) {
+         SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, 37, 7, 0, formats[f]);
+         SDL_Surface *background = SDL_CreateRGBSurfaceWithFormat(0, 37, 7, 0, formats[f]);
+         SDL_Renderer *sw;
+         int failures = 0;
+
+         SDLTest_AssertCheck(surface != NULL && background != NULL, "Validate result from SDL_CreateRGBSurfaceWithFormat(%s)", SDL_GetPixelFormatName(formats[f]));
+         if (surface == NULL || background == NULL) {
+            SDL_FreeSurface(surface);
+            SDL_FreeSurface(background);
+            return TEST_ABORTED;
+         }
+         for (y = 0; y < surface->h; ++y) {
+            for (x = 0; x < surface->w; ++x) {
+               SDL_Rect pixel;
+               pixel.x = x;
+               pixel.y = y;
+               pixel.w = 1;
+               pixel.h = 1;
+               SDL_FillRect(background, &pixel, SDL_MapRGBA(background->format, (Uint8)(x * 7), (Uint8)(y * 40), (Uint8)(255 - x * 5), (Uint8)(100 + y * 20)));
+            }
+         }
+         SDL_SetSurfaceBlendMode(background, SDL_BLENDMODE_NONE);
+         SDL_BlitSurface(background, NULL, surface, NULL);
+
+         sw = SDL_CreateSoftwareRenderer(surface);
+         SDLTest_AssertCheck(sw != NULL, "Validate result from SDL_CreateSoftwareRenderer");
+         if (sw == NULL) {
+            SDL_FreeSurface(surface);
+            SDL_FreeSurface(background);
+            return TEST_ABORTED;
+         }
+         SDL_SetRenderDrawBlendMode(sw, modes[m]);
+         SDL_SetRenderDrawColor(sw, cr, cg, cb, ca);
+         ret = SDL_RenderFillRects(sw, rects, (int)SDL_arraysize(rects));
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderFillRects, expected: 0, got: %i", ret);
+         ret = SDL_RenderDrawLine(sw, 31, 0, 2, 0);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderDrawLine, expected: 0, got: %i", ret);
+
+         for (y = 0; y < surface->h; ++y) {
+            for (x = 0; x < surface->w; ++x) {
+               SDL_Point point;
+               Uint8 *row = (Uint8 *)background->pixels + y * background->pitch;
+               Uint32 bg, pixel, expected;
+               Uint8 r, g, b, a;
+               SDL_bool covered = (y == 0 && x >= 2 && x <= 31);
+
+               point.x = x;
+               point.y = y;
+               for (i = 0; i < SDL_arraysize(rects); ++i) {
+                  if (SDL_PointInRect(&point, &rects[i])) {
+                     covered = SDL_TRUE;
+                  }
+               }
+               if (background->format->BytesPerPixel == 4) {
+                  bg = ((Uint32 *)row)[x];
+                  pixel = ((Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch))[x];
+               } else {
+                  bg = ((Uint16 *)row)[x];
+                  pixel = ((Uint16 *)((Uint8 *)surface->pixels + y * surface->pitch))[x];
+               }
+               expected = bg;
+               if (covered) {
+                  SDL_GetRGBA(bg, background->format, &r, &g, &b, &a);
+                  r = _blendChannel(modes[m], r, cr, ca);
+                  g = _blendChannel(modes[m], g, cg, ca);
+                  b = _blendChannel(modes[m], b, cb, ca);
+                  if (modes[m] == SDL_BLENDMODE_BLEND) {
+                     a = (Uint8)(((255 - ca) * a) / 255 + ca);
+                  }
+                  expected = SDL_MapRGBA(background->format, r, g, b, a);
+               }
+               if (pixel != expected) {
+                  ++failures;
+               }
+            }
+         }
+         SDLTest_AssertCheck(failures == 0, "Validate blend mode %d on %s, expected: 0 wrong pixels, got: %i", (int)modes[m], SDL_GetPixelFormatName(formats[f]), failures);
+
+         SDL_DestroyRenderer(sw);
+         SDL_FreeSurface(surface);
+         SDL_FreeSurface(background);
+      }
+   }
+
+   return TEST_COMPLETED;
+}
+
+#define RENDER_PROFILE_TRACE_FILE "render_profile_trace.json"
+
+/**
+ * @brief Tests the counts of the render profiler and its Chrome trace.
+ */
+int
+render_testProfile (void *arg)
+{
+   SDL_RenderFrameProfile profile;
+   SDL_Texture *texture;
+   SDL_RWops *rw;
+   SDL_Rect rect;
+   Uint32 pixels[16*16];
+   Uint64 calls_ns = 0;
+   char *trace = NULL;
+   Sint64 size = 0;
+   int i, ret;
+
+   ret = SDL_RenderGetFrameProfile(renderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGetFrameProfile with NULL profile, expected: -1, got: %i", ret);
+
+   _clearScreen();
+   ret = SDL_RenderGetFrameProfile(renderer, &profile);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetFrameProfile, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(profile.frame == 0, "Validate no frame is profiled before profiling is on, got: %u", (unsigned int)profile.frame);
+
+   ret = SDL_RenderSetProfiling(renderer, SDL_TRUE, RENDER_PROFILE_TRACE_FILE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetProfiling, expected: 0, got: %i", ret);
+
+   SDL_memset(pixels, 0x80, sizeof(pixels));
+   texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+   SDLTest_AssertCheck(texture != NULL, "Validate result from SDL_CreateTexture");
+
+   /* One frame of everything */
+   rect.x = 5;
+   rect.y = 5;
+   rect.w = 16;
+   rect.h = 16;
+   SDL_SetRenderDrawColor(renderer, 10, 20, 30, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(renderer);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderFillRect(renderer, NULL);
+   SDL_RenderDrawLine(renderer, 0, 0, 20, 10);
+   if (texture != NULL) {
+      SDL_UpdateTexture(texture, NULL, pixels, 16 * sizeof(Uint32));
+      SDL_RenderCopy(renderer, texture, NULL, &rect);
+   }
+   SDL_RenderPresent(renderer);
+
+   ret = SDL_RenderGetFrameProfile(renderer, &profile);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetFrameProfile, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(profile.frame == 1, "Validate frame, expected: 1, got: %u", (unsigned int)profile.frame);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_CLEAR].calls == 1, "Validate clears, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_CLEAR].calls);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_FILL_RECTS].calls == 2, "Validate fills, expected: 2, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_FILL_RECTS].calls);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_DRAW_LINES].calls == 1, "Validate lines, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_DRAW_LINES].calls);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_PRESENT].calls == 1, "Validate presents, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_PRESENT].calls);
+   if (texture != NULL) {
+      SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_UPDATE_TEXTURE].calls == 1, "Validate texture updates, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_UPDATE_TEXTURE].calls);
+      SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_COPY].calls == 1, "Validate copies, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_COPY].calls);
+      SDLTest_AssertCheck(profile.bytes_uploaded == sizeof(pixels), "Validate bytes uploaded, expected: %u, got: %u", (unsigned int)sizeof(pixels), (unsigned int)profile.bytes_uploaded);
+   }
+   for (i = 0; i < SDL_RENDER_CALL_COUNT; ++i) {
+      calls_ns += profile.calls[i].ns;
+   }
+   SDLTest_AssertCheck(profile.frame_ns >= calls_ns, "Validate the frame took at least as long as its calls");
+
+   /* The next frame starts from zero */
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderPresent(renderer);
+   SDL_RenderGetFrameProfile(renderer, &profile);
+   SDLTest_AssertCheck(profile.frame == 2, "Validate frame, expected: 2, got: %u", (unsigned int)profile.frame);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_CLEAR].calls == 0, "Validate clears, expected: 0, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_CLEAR].calls);
+   SDLTest_AssertCheck(profile.calls[SDL_RENDER_CALL_FILL_RECTS].calls == 1, "Validate fills, expected: 1, got: %u", (unsigned int)profile.calls[SDL_RENDER_CALL_FILL_RECTS].calls);
+   SDLTest_AssertCheck(profile.bytes_uploaded == 0, "Validate bytes uploaded, expected: 0, got: %u", (unsigned int)profile.bytes_uploaded);
+
+   /* Turning it off completes the trace */
+   ret = SDL_RenderSetProfiling(renderer, SDL_FALSE, NULL);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetProfiling, expected: 0, got: %i", ret);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderPresent(renderer);
+   SDL_RenderGetFrameProfile(renderer, &profile);
+   SDLTest_AssertCheck(profile.frame == 2, "Validate frames aren't profiled after profiling is off, got: %u", (unsigned int)profile.frame);
+
+   rw = SDL_RWFromFile(RENDER_PROFILE_TRACE_FILE, "rb");
+   SDLTest_AssertCheck(rw != NULL, "Validate the trace file was written");
+   if (rw != NULL) {
+      size = SDL_RWsize(rw);
+      trace = (char *)SDL_calloc(1, (size_t)size + 1);
+      if (trace != NULL) {
+         SDL_RWread(rw, trace, 1, (size_t)size);
+      }
+      SDL_RWclose(rw);
+   }
+   if (trace != NULL) {
+      SDLTest_AssertCheck(size > 4 && trace[0] == '[' && trace[size - 2] == ']', "Validate the trace is a JSON array");
+      SDLTest_AssertCheck(SDL_strstr(trace, "\"name\":\"FillRects\"") != NULL, "Validate the trace has the fills");
+      SDLTest_AssertCheck(SDL_strstr(trace, "\"name\":\"Frame\"") != NULL, "Validate the trace has the frame counters");
+      SDL_free(trace);
+   }
+   remove(RENDER_PROFILE_TRACE_FILE);
+
+   if (texture != NULL) {
+      SDL_DestroyTexture(texture);
+   }
+
+   return TEST_COMPLETED;
+}
+
+#define UPDATE_TEXTURE_SIZE    16
+#define UPDATE_TEXTURE_PAD     5
+
+/**
+ * @brief A distinct opaque color for each texel and pass. Helper function.
+ */
+static Uint32
+_updatePixel(int x, int y, int pass)
+{
+   return RENDER_COMPARE_AMASK | ((Uint32)(x * 15 + pass * 40) & 0xff) << 16 | ((Uint32)(y * 15) & 0xff) << 8 | (Uint32)(pass * 60 + 10);
+}
+
+/**
+ * @brief Fills a rectangle of the expected texture contents. Helper function.
+ */
+static void
+_updateExpected(Uint32 *expected, const SDL_Rect *rect, int pass)
+{
+   int x, y;
+
+   for (y = rect->y; y < rect->y + rect->h; y++) {
+      for (x = rect->x; x < rect->x + rect->w; x++) {
+         expected[y*UPDATE_TEXTURE_SIZE + x] = _updatePixel(x, y, pass);
+      }
+   }
+}
+
+/**
+ * @brief Fills a rectangle through SDL_LockTexture. Helper function.
+ */
+static void
+_updateLocked(SDL_Texture *texture, const SDL_Rect *rect, int pass)
+{
+   void *pixels;
+   int pitch, x, y, ret;
+
+   ret = SDL_LockTexture(texture, rect, &pixels, &pitch);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_LockTexture, expected: 0, got: %i", ret);
+   if (ret != 0) {
+      return;
+   }
+   for (y = 0; y < rect->h; y++) {
+      for (x = 0; x < rect->w; x++) {
+         ((Uint32 *)((Uint8 *)pixels + y*pitch))[x] = _updatePixel(rect->x + x, rect->y + y, pass);
+      }
+   }
+   SDL_UnlockTexture(texture);
+}
+
+/**
+ * @brief Draws a texture 1:1 and compares it with the expected texels. Helper function.
+ */
+static void
+_checkUpdated(SDL_Texture *texture, const Uint32 *expected, const char *name, const char *what)
+{
+   Uint32 pixels[UPDATE_TEXTURE_SIZE*UPDATE_TEXTURE_SIZE];
+   SDL_Rect rect;
+   int i, ret, wrong = 0, first = -1;
+
+   _clearScreen();
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = UPDATE_TEXTURE_SIZE;
+   rect.h = UPDATE_TEXTURE_SIZE;
+   ret = SDL_RenderCopy(renderer, texture, NULL, &rect);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+   ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, pixels, sizeof(Uint32)*UPDATE_TEXTURE_SIZE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      if ((pixels[i] & 0x00ffffff) != (expected[i] & 0x00ffffff)) {
+         if (first < 0) {
+            first = i;
+         }
+         wrong++;
+      }
+   }
+   SDLTest_AssertCheck(wrong == 0, "Validate %s on renderer '%s', expected: 0 wrong pixels, got: %i (first at %i,%i)",
+                       what, name, wrong, (first < 0) ? 0 : first % UPDATE_TEXTURE_SIZE, (first < 0) ? 0 : first / UPDATE_TEXTURE_SIZE);
+}
+
+/**
+ * @brief Tests texture uploads of rectangles on every renderer.
+ *
+ * Updates a rectangle from rows with padding, locks a rectangle of a
+ * streaming texture, and locks it several times back to back, checking
+ * that only the rectangles change.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_LockTexture
+ */
+int
+render_testTextureUpdate (void *arg)
+{
+   const SDL_Rect full = { 0, 0, UPDATE_TEXTURE_SIZE, UPDATE_TEXTURE_SIZE };
+   const SDL_Rect sub = { 3, 2, 7, 5 };
+   const SDL_Rect cycles[] = { { 1, 1, 4, 4 }, { 8, 3, 6, 9 }, { 2, 10, 12, 3 }, { 0, 0, 16, 1 }, { 15, 4, 1, 12 } };
+   const int padded_pitch = (sub.w + UPDATE_TEXTURE_PAD) * sizeof(Uint32);
+   Uint32 expected[UPDATE_TEXTURE_SIZE*UPDATE_TEXTURE_SIZE];
+   Uint32 padded[(7 + UPDATE_TEXTURE_PAD) * 5];
+   SDL_RendererInfo info;
+   SDL_Texture *texture;
+   int n, i, x, y, ret;
+
+   n = SDL_GetNumRenderDrivers();
+   for (i = 0; i < n; i++) {
+      /* Each driver gets the test window in turn */
+      SDL_DestroyRenderer(renderer);
+      renderer = SDL_CreateRenderer(window, i, 0);
+      if (renderer == NULL) {
+         SDLTest_Log("Render driver %i isn't available: %s", i, SDL_GetError());
+         continue;
+      }
+      SDL_GetRendererInfo(renderer, &info);
+
+      /* A rectangle from rows longer than the rectangle */
+      texture = SDL_CreateTexture(renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, UPDATE_TEXTURE_SIZE, UPDATE_TEXTURE_SIZE);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+         _updateExpected(expected, &full, 0);
+         ret = SDL_UpdateTexture(texture, NULL, expected, sizeof(Uint32)*UPDATE_TEXTURE_SIZE);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+
+         for (y = 0; y < sub.h; y++) {
+            for (x = 0; x < sub.w + UPDATE_TEXTURE_PAD; x++) {
+               /* The padding must never reach the texture */
+               padded[y*(sub.w + UPDATE_TEXTURE_PAD) + x] = (x < sub.w) ? _updatePixel(sub.x + x, sub.y + y, 1) : 0xffffffff;
+            }
+         }
+         ret = SDL_UpdateTexture(texture, &sub, padded, padded_pitch);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture with a padded pitch, expected: 0, got: %i", ret);
+         _updateExpected(expected, &sub, 1);
+         _checkUpdated(texture, expected, info.name, "rectangle updated from padded rows");
+         SDL_DestroyTexture(texture);
+      }
+
+      /* Rectangles locked in a streaming texture */
+      texture = SDL_CreateTexture(renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STREAMING, UPDATE_TEXTURE_SIZE, UPDATE_TEXTURE_SIZE);
+      SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (texture != NULL) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+         _updateLocked(texture, &full, 0);
+         _updateExpected(expected, &full, 0);
+         _checkUpdated(texture, expected, info.name, "fully locked texture");
+
+         _updateLocked(texture, &sub, 1);
+         _updateExpected(expected, &sub, 1);
+         _checkUpdated(texture, expected, info.name, "locked rectangle");
+
+         /* Back to back, so double buffered uploads take turns */
+         for (x = 0; x < SDL_arraysize(cycles); x++) {
+            _updateLocked(texture, &cycles[x], 2 + x);
+            _updateExpected(expected, &cycles[x], 2 + x);
+         }
+         _checkUpdated(texture, expected, info.name, "rectangles locked back to back");
+         SDL_DestroyTexture(texture);
+      }
+   }
+
+   /* Back to the renderer the other tests expect */
+   SDL_DestroyRenderer(renderer);
+   renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+   SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result");
+
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Checks to see if functionality is supported. Helper function.
  */
@@ -1058,6 +2081,21 @@ _clearScreen(void)
    return 0;
 }
 
+/**
+ * @brief Clears the screen and draws rows that can be told apart. Helper function.
+ */
+static void
+_drawRows(void)
+{
+   int y;
+
+   _clearScreen();
+   for (y = 0; y < TESTRENDER_SCREEN_H; y++) {
+      SDL_SetRenderDrawColor(renderer, y*4, 255 - y*4, y*2, SDL_ALPHA_OPAQUE);
+      SDL_RenderDrawLine(renderer, y, y, TESTRENDER_SCREEN_W - 1, y);
+   }
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1085,9 +2123,33 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels asynchronously", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testAtlas, "render_testAtlas", "Tests textures packed into an atlas", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testWarmUp, "render_testWarmUp", "Tests preparing shaders ahead of time", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testPresentStats, "render_testPresentStats", "Tests the statistics of presents", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests drawing triangles with SDL_RenderGeometry", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest13 =
+        { (SDLTest_TestCaseFp)render_testBlendFillFormats, "render_testBlendFillFormats", "Tests blended fills in the software renderer's pixel formats", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest14 =
+        { (SDLTest_TestCaseFp)render_testProfile, "render_testProfile", "Tests the render profiler", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest15 =
+        { (SDLTest_TestCaseFp)render_testTextureUpdate, "render_testTextureUpdate", "Tests texture updates and locks of rectangles on every renderer", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, NULL
 };
 
 /* Render test suite (global) */
@@ -172,6 +172,84 @@ timer_addRemoveTimer(void *arg)
   return TEST_COMPLETED;
 }
 
+/* Wakes the waiters of timer_hugeWaitTimeout */
+static SDL_sem *_wakeSem = NULL;
+static SDL_mutex *_wakeMutex = NULL;
+static SDL_cond *_wakeCond = NULL;
+static int _wakeFlag = 0;
+
+Uint32 _timerWakeCallback(Uint32 interval, void *param)
+{
+   if (param == _wakeSem) {
+       SDL_SemPost(_wakeSem);
+   } else {
+       SDL_LockMutex(_wakeMutex);
+       _wakeFlag = 1;
+       SDL_CondSignal(_wakeCond);
+       SDL_UnlockMutex(_wakeMutex);
+   }
+   return 0;
+}
+
+/**
+ * @brief Finite but huge nanosecond timeouts must wait rather than time out at once
+ */
+int
+timer_hugeWaitTimeout(void *arg)
+{
+  const Uint64 timeout = SDL_MUTEX_MAXWAIT_NS - 1;
+  SDL_TimerID id;
+  Uint32 start, difference;
+  int result;
+
+  _wakeSem = SDL_CreateSemaphore(0);
+  _wakeMutex = SDL_CreateMutex();
+  _wakeCond = SDL_CreateCond();
+  _wakeFlag = 0;
+  SDLTest_AssertCheck(_wakeSem != NULL && _wakeMutex != NULL && _wakeCond != NULL, "Check creation of semaphore, mutex and condition variable");
+  if (_wakeSem == NULL || _wakeMutex == NULL || _wakeCond == NULL) {
+    SDL_DestroySemaphore(_wakeSem);
+    SDL_DestroyMutex(_wakeMutex);
+    SDL_DestroyCond(_wakeCond);
+    return TEST_ABORTED;
+  }
+
+  /* Semaphore posted after 50 ms */
+  start = SDL_GetTicks();
+  id = SDL_AddTimer(50, _timerWakeCallback, _wakeSem);
+  SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+  result = SDL_SemWaitTimeoutNS(_wakeSem, timeout);
+  difference = SDL_GetTicks() - start;
+  SDLTest_AssertPass("Call to SDL_SemWaitTimeoutNS(sem, SDL_MUTEX_MAXWAIT_NS - 1)");
+  SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %i", result);
+  SDLTest_AssertCheck(difference >= 40, "Check wait time, expected: >=40, got: %u", (unsigned int)difference);
+
+  /* Condition variable signaled after 50 ms */
+  start = SDL_GetTicks();
+  SDL_LockMutex(_wakeMutex);
+  id = SDL_AddTimer(50, _timerWakeCallback, NULL);
+  SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+  result = 0;
+  while (!_wakeFlag && result == 0) {
+    result = SDL_CondWaitTimeoutNS(_wakeCond, _wakeMutex, timeout);
+  }
+  SDL_UnlockMutex(_wakeMutex);
+  difference = SDL_GetTicks() - start;
+  SDLTest_AssertPass("Call to SDL_CondWaitTimeoutNS(cond, mutex, SDL_MUTEX_MAXWAIT_NS - 1)");
+  SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %i", result);
+  SDLTest_AssertCheck(_wakeFlag == 1, "Check condition was signaled, expected: 1, got: %i", _wakeFlag);
+  SDLTest_AssertCheck(difference >= 40, "Check wait time, expected: >=40, got: %u", (unsigned int)difference);
+
+  SDL_DestroySemaphore(_wakeSem);
+  SDL_DestroyMutex(_wakeMutex);
+  SDL_DestroyCond(_wakeCond);
+  _wakeSem = NULL;
+  _wakeMutex = NULL;
+  _wakeCond = NULL;
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +265,12 @@ static const SDLTest_TestCaseReference timerTest3 =
 static const SDLTest_TestCaseReference timerTest4 =
         { (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference timerTest5 =
+        { (SDLTest_TestCaseFp)timer_hugeWaitTimeout, "timer_hugeWaitTimeout", "Call to SDL_SemWaitTimeoutNS and SDL_CondWaitTimeoutNS with a huge finite timeout", TEST_ENABLED };
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] =  {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, NULL
 };
 
 /* Timer test suite (global) */
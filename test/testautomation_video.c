@@ -1721,6 +1721,107 @@ video_getSetWindowData(void *arg)
 }
 
 
+/**
+ * @brief Checks SDL_GL_SetFramePacing and SDL_GL_GetFrameTiming positive and negative cases
+ */
+int
+video_getSetFramePacing(void *arg)
+{
+  const char* title = "video_getSetFramePacing Test Window";
+  const Uint64 interval = 20000000;  /* 20ms */
+  const char* driver;
+  SDL_Window* window;
+  SDL_GLContext context;
+  SDL_GLFrameTiming timing;
+  int i, result;
+
+  /* Call against new test window */
+  window = _createVideoSuiteTestWindow(title);
+  if (window == NULL) return TEST_ABORTED;
+
+  /* A window that hasn't swapped has no timing yet */
+  SDL_memset(&timing, 0xFF, sizeof(timing));
+  result = SDL_GL_GetFrameTiming(window, &timing);
+  SDLTest_AssertPass("Call to SDL_GL_GetFrameTiming()");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  SDLTest_AssertCheck(timing.frame == 0, "Validate frame; expected: 0, got: %u", (unsigned int)timing.frame);
+  SDLTest_AssertCheck(timing.missed_frames == 0, "Validate missed_frames; expected: 0, got: %u", (unsigned int)timing.missed_frames);
+  SDLTest_AssertCheck(timing.frames_in_flight == 0, "Validate frames_in_flight; expected: 0, got: %d", timing.frames_in_flight);
+
+  /* Pacing needs an OpenGL window */
+  result = SDL_GL_SetFramePacing(window, 2, 0);
+  SDLTest_AssertPass("Call to SDL_GL_SetFramePacing(window,2,0)");
+  SDLTest_AssertCheck(result == -1, "Validate result value; expected: -1, got: %d", result);
+
+  /* Negative tests */
+  SDL_ClearError();
+  SDLTest_AssertPass("Call to SDL_ClearError()");
+
+  result = SDL_GL_GetFrameTiming(window, NULL);
+  SDLTest_AssertPass("Call to SDL_GL_GetFrameTiming(timing=NULL)");
+  SDLTest_AssertCheck(result == -1, "Validate result value; expected: -1, got: %d", result);
+  _checkInvalidParameterError();
+
+  result = SDL_GL_GetFrameTiming(NULL, &timing);
+  SDLTest_AssertPass("Call to SDL_GL_GetFrameTiming(window=NULL)");
+  SDLTest_AssertCheck(result == -1, "Validate result value; expected: -1, got: %d", result);
+  _checkInvalidWindowError();
+
+  result = SDL_GL_SetFramePacing(NULL, 2, 0);
+  SDLTest_AssertPass("Call to SDL_GL_SetFramePacing(window=NULL)");
+  SDLTest_AssertCheck(result == -1, "Validate result value; expected: -1, got: %d", result);
+  _checkInvalidWindowError();
+
+  /* Clean up */
+  _destroyVideoSuiteTestWindow(window);
+
+  /* The offscreen driver has real OpenGL ES windows, if EGL is there */
+  driver = SDL_GetCurrentVideoDriver();
+  if (driver == NULL || SDL_strcmp(driver, "offscreen") != 0) {
+    return TEST_COMPLETED;
+  }
+  SDL_GL_ResetAttributes();
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
+  window = SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 64, 64, SDL_WINDOW_OPENGL);
+  context = window ? SDL_GL_CreateContext(window) : NULL;
+  if (context == NULL) {
+    SDLTest_Log("No OpenGL ES context under the offscreen driver: %s", SDL_GetError());
+    if (window) {
+      SDL_DestroyWindow(window);
+    }
+    SDL_GL_ResetAttributes();
+    return TEST_SKIPPED;
+  }
+  SDLTest_AssertPass("Call to SDL_GL_CreateContext() for an OpenGL ES window");
+
+  result = SDL_GL_SetFramePacing(window, 2, interval);
+  SDLTest_AssertPass("Call to SDL_GL_SetFramePacing(window,2,%u)", (unsigned int)interval);
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+
+  for (i = 0; i < 10; i++) {
+    SDL_GL_SwapWindow(window);
+  }
+  SDLTest_AssertPass("Call to SDL_GL_SwapWindow() 10 times");
+
+  result = SDL_GL_GetFrameTiming(window, &timing);
+  SDLTest_AssertPass("Call to SDL_GL_GetFrameTiming()");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  SDLTest_AssertCheck(timing.frame == 10, "Validate frame; expected: 10, got: %u", (unsigned int)timing.frame);
+  /* Held for the target at least, with room for a loaded machine */
+  SDLTest_AssertCheck(timing.interval_ns >= (interval * 9) / 10 && timing.interval_ns <= interval * 3,
+                      "Validate interval_ns; expected: about %u, got: %u", (unsigned int)interval, (unsigned int)timing.interval_ns);
+  SDLTest_AssertCheck(timing.frames_in_flight >= 0 && timing.frames_in_flight <= 2,
+                      "Validate frames_in_flight; expected: 0 to 2, got: %d", timing.frames_in_flight);
+
+  SDL_GL_DeleteContext(context);
+  SDL_DestroyWindow(window);
+  SDL_GL_ResetAttributes();
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -1793,13 +1894,16 @@ static const SDLTest_TestCaseReference videoTest22 =
 static const SDLTest_TestCaseReference videoTest23 =
         { (SDLTest_TestCaseFp)video_getSetWindowData, "video_getSetWindowData",  "Checks SDL_SetWindowData and SDL_GetWindowData positive and negative cases", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference videoTest24 =
+        { (SDLTest_TestCaseFp)video_getSetFramePacing, "video_getSetFramePacing",  "Checks SDL_GL_SetFramePacing and SDL_GL_GetFrameTiming positive and negative cases", TEST_ENABLED };
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] =  {
     &videoTest1, &videoTest2, &videoTest3, &videoTest4, &videoTest5, &videoTest6,
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
     &videoTest18, &videoTest19, &videoTest20, &videoTest21, &videoTest22,
-    &videoTest23, NULL
+    &videoTest23, &videoTest24, NULL
 };
 
 /* Video test suite (global) */
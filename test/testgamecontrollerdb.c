@@ -0,0 +1,118 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Time the game controller mapping database: starting the subsystem with
+   the built-in mappings, loading a large community-style database with
+   SDL_GameControllerAddMappingsFromRW(), and looking mappings up by GUID */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define MAPPINGS    5000
+#define LOOKUPS     100000
+
+static double
+Elapsed(Uint64 start)
+{
+    return ((double) (SDL_GetPerformanceCounter() - start) * 1000.0) /
+           (double) SDL_GetPerformanceFrequency();
+}
+
+static void
+MakeGUID(int i, char *guid, size_t len)
+{
+    /* Like real USB GUIDs: bus type, vendor, product and version */
+    SDL_snprintf(guid, len, "03000000%02x%02x0000%02x%02x0000%02x%02x0000",
+                 (i * 7) & 0xFF, (i >> 8) & 0xFF, (i * 13) & 0xFF, (i >> 4) & 0xFF,
+                 i & 0xFF, (i >> 12) & 0xFF);
+}
+
+static char *
+MakeDatabase(int count, size_t *len)
+{
+    const size_t line_len = 256;
+    char *db = (char *) SDL_malloc(count * line_len);
+    char guid[33];
+    size_t used = 0;
+    int i;
+
+    if (!db) {
+        return NULL;
+    }
+    for (i = 0; i < count; ++i) {
+        MakeGUID(i, guid, sizeof(guid));
+        used += SDL_snprintf(db + used, line_len, "%s,Test Pad %d,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftx:a0,lefty:a1,start:b7,x:b2,y:b3,platform:%s,\n",
+                             guid, i, SDL_GetPlatform());
+    }
+    *len = used;
+    return db;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int count = (argc > 1 && SDL_atoi(argv[1]) > 0) ? SDL_atoi(argv[1]) : MAPPINGS;
+    SDL_JoystickGUID *guids;
+    char guid[33];
+    Uint64 start;
+    size_t len = 0;
+    char *db;
+    int added, found = 0, i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    db = MakeDatabase(count, &len);
+    guids = (SDL_JoystickGUID *) SDL_malloc(count * sizeof(*guids));
+    if (!db || !guids) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return (1);
+    }
+    for (i = 0; i < count; ++i) {
+        MakeGUID(i, guid, sizeof(guid));
+        guids[i] = SDL_JoystickGetGUIDFromString(guid);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    if (SDL_Init(SDL_INIT_GAMECONTROLLER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+    SDL_Log("init      %8.3f ms, %d built-in mappings\n", Elapsed(start), SDL_GameControllerNumMappings());
+
+    start = SDL_GetPerformanceCounter();
+    added = SDL_GameControllerAddMappingsFromRW(SDL_RWFromConstMem(db, (int) len), 1);
+    SDL_Log("load      %8.3f ms, %d mappings added\n", Elapsed(start), added);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < LOOKUPS; ++i) {
+        char *mapping = SDL_GameControllerMappingForGUID(guids[(i * 7919) % count]);
+        if (mapping) {
+            ++found;
+            SDL_free(mapping);
+        }
+    }
+    SDL_Log("lookup    %8.3f us each, %d of %d found\n", (Elapsed(start) * 1000.0) / LOOKUPS, found, LOOKUPS);
+
+    start = SDL_GetPerformanceCounter();
+    SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
+    SDL_Log("quit      %8.3f ms\n", Elapsed(start));
+
+    SDL_free(guids);
+    SDL_free(db);
+    SDL_Quit();
+    return (found == LOOKUPS) ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,125 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Time the translation of joystick events into game controller events:
+   open every attached controller, push a stream of synthetic axis, button
+   and hat events for them through SDL_PushEvent(), and report the time the
+   event watchers took per event. With no controllers attached this still
+   times the watchers turning away joystick events nobody opened. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define EVENTS      1000000
+#define MAX_PADS    16
+
+int
+main(int argc, char *argv[])
+{
+    const int count = (argc > 1 && SDL_atoi(argv[1]) > 0) ? SDL_atoi(argv[1]) : EVENTS;
+    SDL_GameController *pads[MAX_PADS];
+    SDL_JoystickID ids[MAX_PADS];
+    SDL_EventQueueStats stats;
+    SDL_EventTypeStats axis_stats, button_stats;
+    SDL_Event event;
+    Uint64 start;
+    double elapsed;
+    int num_pads = 0, i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_GAMECONTROLLER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    for (i = 0; i < SDL_NumJoysticks() && num_pads < MAX_PADS; ++i) {
+        if (SDL_IsGameController(i)) {
+            pads[num_pads] = SDL_GameControllerOpen(i);
+            if (pads[num_pads]) {
+                ids[num_pads] = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(pads[num_pads]));
+                SDL_Log("Opened %s\n", SDL_GameControllerName(pads[num_pads]));
+                ++num_pads;
+            }
+        }
+    }
+    if (num_pads == 0) {
+        SDL_Log("No game controllers attached, timing events for unopened joysticks\n");
+        for (i = 0; i < 4; ++i) {
+            ids[i] = 1000 + i;
+        }
+    }
+
+    /* Drain what the devices sent on open, then count only our events */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDL_ResetEventQueueStats();
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        const Uint32 k = ((Uint32) i * 2654435761u) >> 8;
+        const SDL_JoystickID which = ids[k % (num_pads ? num_pads : 4)];
+
+        SDL_zero(event);
+        switch (k % 4) {
+        case 0:
+        case 1:
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = which;
+            event.jaxis.axis = (Uint8) ((k >> 4) % 4);
+            event.jaxis.value = (Sint16) (k * 31);
+            break;
+        case 2:
+            event.type = (k & 16) ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+            event.jbutton.which = which;
+            event.jbutton.button = (Uint8) ((k >> 5) % 4);
+            event.jbutton.state = (k & 16) ? SDL_PRESSED : SDL_RELEASED;
+            break;
+        default:
+            event.type = SDL_JOYHATMOTION;
+            event.jhat.which = which;
+            event.jhat.value = (Uint8) ((k >> 6) & SDL_HAT_LEFTDOWN);
+            break;
+        }
+        SDL_PushEvent(&event);
+
+        /* Keep the queue from filling up, like an application would */
+        if ((i % 1024) == 1023) {
+            SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+        }
+    }
+    elapsed = ((double) (SDL_GetPerformanceCounter() - start) * 1000000000.0) /
+              (double) SDL_GetPerformanceFrequency();
+
+    SDL_GetEventQueueStats(&stats);
+    SDL_GetEventTypeStats(SDL_CONTROLLERAXISMOTION, &axis_stats);
+    SDL_GetEventTypeStats(SDL_CONTROLLERBUTTONDOWN, &button_stats);
+    SDL_Log("%d joystick events for %d controllers\n", count, num_pads);
+    SDL_Log("push      %8.1f ns each\n", elapsed / count);
+    if (stats.watcher_calls) {
+        SDL_Log("watchers  %8.1f ns each over %u calls\n",
+                (double) stats.watcher_ns / stats.watcher_calls, (unsigned int) stats.watcher_calls);
+    }
+    SDL_Log("generated %u axis and %u button down events\n",
+            (unsigned int) axis_stats.pushed, (unsigned int) button_stats.pushed);
+
+    for (i = 0; i < num_pads; ++i) {
+        SDL_GameControllerClose(pads[i]);
+    }
+    SDL_Quit();
+    return (0);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
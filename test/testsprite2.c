@@ -42,6 +42,10 @@ static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
 static int iterations = -1;
 
+/* Number of frames to draw before quitting, 0 to run until closed.
+   With the offscreen video driver this makes a repeatable benchmark. */
+static Uint32 max_frames = 0;
+
 int done;
 
 /* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
@@ -262,7 +266,8 @@ int
 main(int argc, char *argv[])
 {
     int i;
-    Uint32 then, now, frames;
+    Uint32 frames;
+    Uint64 then, now;
     Uint64 seed;
     const char *icon = "icon.bmp";
 
@@ -303,6 +308,11 @@ main(int argc, char *argv[])
                     if (iterations < -1) iterations = -1;
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--frames") == 0) {
+                if (argv[i + 1] && SDL_atoi(argv[i + 1]) > 0) {
+                    max_frames = (Uint32) SDL_atoi(argv[i + 1]);
+                    consumed = 2;
+                }
             } else if (SDL_strcasecmp(argv[i], "--cyclecolor") == 0) {
                 cycle_color = SDL_TRUE;
                 consumed = 1;
@@ -318,7 +328,7 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--iterations N] [num_sprites] [icon.bmp]\n",
+            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--iterations N] [--frames N] [num_sprites] [icon.bmp]\n",
                     argv[0], SDLTest_CommonUsage(state));
             quit(1);
         }
@@ -376,7 +386,7 @@ main(int argc, char *argv[])
 
     /* Main render loop */
     frames = 0;
-    then = SDL_GetTicks();
+    then = SDL_GetPerformanceCounter();
     done = 0;
 
 #ifdef __EMSCRIPTEN__
@@ -385,14 +395,19 @@ main(int argc, char *argv[])
     while (!done) {
         ++frames;
         loop();
+        if (frames == max_frames) {
+            done = 1;
+        }
     }
 #endif
 
     /* Print out some timing information */
-    now = SDL_GetTicks();
+    now = SDL_GetPerformanceCounter();
     if (now > then) {
-        double fps = ((double) frames * 1000) / (now - then);
-        SDL_Log("%2.2f frames per second\n", fps);
+        double seconds = (double) (now - then) / SDL_GetPerformanceFrequency();
+        SDL_Log("%2.2f frames per second\n", frames / seconds);
+        SDL_Log("%u frames in %.3f seconds, %.3f ms per frame\n",
+                (unsigned int) frames, seconds, (seconds * 1000.0) / frames);
     }
     quit(0);
     return 0;
@@ -0,0 +1,184 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how quickly SDL_WaitEvent() sees pushed events, and how often
+   the process wakes up while it has nothing to do */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#if defined(__LINUX__) || defined(__MACOSX__)
+#include <sys/resource.h>
+#define HAVE_GETRUSAGE 1
+#endif
+
+#define ITERATIONS  200
+#define IDLE_TIME   2000
+
+static Uint64 *sent;
+static Uint32 event_type;
+static int iterations = ITERATIONS;
+
+static void
+PushTimedEvent(int code)
+{
+    SDL_Event event;
+
+    SDL_zero(event);
+    event.type = event_type;
+    event.user.code = code;
+    sent[code] = SDL_GetPerformanceCounter();
+    SDL_PushEvent(&event);
+}
+
+static int SDLCALL
+PushThread(void *data)
+{
+    int i;
+
+    for (i = 0; i < iterations; ++i) {
+        SDL_Delay(2 + (i % 3));
+        PushTimedEvent(i);
+    }
+    return 0;
+}
+
+static int timer_code;
+
+static Uint32 SDLCALL
+PushTimer(Uint32 interval, void *param)
+{
+    PushTimedEvent(timer_code++);
+    return (timer_code < iterations) ? interval : 0;
+}
+
+static int SDLCALL
+CompareUint64(const void *a, const void *b)
+{
+    const Uint64 A = *(const Uint64 *) a;
+    const Uint64 B = *(const Uint64 *) b;
+    return (A < B) ? -1 : (A > B) ? 1 : 0;
+}
+
+static void
+ReceiveEvents(const char *name)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 *latency = (Uint64 *) SDL_malloc(iterations * sizeof(*latency));
+    Uint64 total = 0;
+    SDL_Event event;
+    int received = 0;
+
+    if (!latency) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return;
+    }
+
+    while (received < iterations && SDL_WaitEventTimeout(&event, 1000)) {
+        if (event.type == event_type) {
+            const Uint64 now = SDL_GetPerformanceCounter();
+            latency[received] = ((now - sent[event.user.code]) * 1000000) / freq;
+            total += latency[received];
+            ++received;
+        }
+    }
+    if (received == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: no events received\n", name);
+        SDL_free(latency);
+        return;
+    }
+    SDL_qsort(latency, received, sizeof(*latency), CompareUint64);
+
+    SDL_Log("%-8s %d events: push to receive mean %5d us, p50 %5d us, p99 %5d us, max %5d us\n",
+            name, received, (int) (total / received),
+            (int) latency[received / 2],
+            (int) latency[(received * 99) / 100],
+            (int) latency[received - 1]);
+
+    SDL_free(latency);
+}
+
+static void
+MeasureIdle(void)
+{
+    SDL_Event event;
+    Uint32 start = SDL_GetTicks();
+#if HAVE_GETRUSAGE
+    struct rusage before, after;
+    long wakeups;
+
+    getrusage(RUSAGE_SELF, &before);
+#endif
+    while (!SDL_TICKS_PASSED(SDL_GetTicks(), start + IDLE_TIME)) {
+        SDL_WaitEventTimeout(&event, (int) (start + IDLE_TIME - SDL_GetTicks()));
+    }
+#if HAVE_GETRUSAGE
+    getrusage(RUSAGE_SELF, &after);
+    wakeups = (after.ru_nvcsw - before.ru_nvcsw) + (after.ru_nivcsw - before.ru_nivcsw);
+    SDL_Log("idle     %d ms: %ld context switches, %ld per second\n",
+            IDLE_TIME, wakeups, (wakeups * 1000) / IDLE_TIME);
+#else
+    SDL_Log("idle     wakeups can't be measured on this platform\n");
+#endif
+}
+
+int
+main(int argc, char *argv[])
+{
+    Uint32 flags = SDL_INIT_EVENTS | SDL_INIT_TIMER;
+    SDL_Thread *thread;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcasecmp(argv[i], "--video") == 0) {
+            flags |= SDL_INIT_VIDEO;
+        } else if (SDL_atoi(argv[i]) > 0) {
+            iterations = SDL_atoi(argv[i]);
+        } else {
+            SDL_Log("Usage: %s [--video] [iterations]\n", argv[0]);
+            return (1);
+        }
+    }
+
+    if (SDL_Init(flags) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    sent = (Uint64 *) SDL_calloc(iterations, sizeof(*sent));
+    event_type = SDL_RegisterEvents(1);
+    if (!sent || event_type == (Uint32) -1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set up test: %s\n", SDL_GetError());
+        SDL_Quit();
+        return (1);
+    }
+
+    MeasureIdle();
+
+    thread = SDL_CreateThread(PushThread, "PushThread", NULL);
+    ReceiveEvents("thread");
+    SDL_WaitThread(thread, NULL);
+
+    SDL_AddTimer(3, PushTimer, NULL);
+    ReceiveEvents("timer");
+
+    SDL_free(sent);
+    SDL_Quit();
+    return (0);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
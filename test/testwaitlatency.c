@@ -0,0 +1,141 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how far the timed waits overshoot their targets */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define ITERATIONS  200
+
+static const Uint64 targets[] = {
+    100000, 250000, 500000, 1000000, 2000000, 5000000, 10000000
+};
+
+static SDL_sem *sem;
+static SDL_mutex *mutex;
+static SDL_cond *cond;
+
+static void
+WaitDelay(Uint64 ns)
+{
+    SDL_DelayNS(ns);
+}
+
+static void
+WaitDelayMS(Uint64 ns)
+{
+    SDL_Delay((Uint32) ((ns + 999999) / 1000000));
+}
+
+static void
+WaitSem(Uint64 ns)
+{
+    SDL_SemWaitTimeoutNS(sem, ns);
+}
+
+static void
+WaitCond(Uint64 ns)
+{
+    SDL_LockMutex(mutex);
+    SDL_CondWaitTimeoutNS(cond, mutex, ns);
+    SDL_UnlockMutex(mutex);
+}
+
+static int SDLCALL
+CompareUint64(const void *a, const void *b)
+{
+    const Uint64 A = *(const Uint64 *) a;
+    const Uint64 B = *(const Uint64 *) b;
+    return (A < B) ? -1 : (A > B) ? 1 : 0;
+}
+
+static void
+Measure(const char *name, void (*wait)(Uint64 ns), int iterations)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 *oversleep = (Uint64 *) SDL_malloc(iterations * sizeof(*oversleep));
+    int i, t;
+
+    if (!oversleep) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return;
+    }
+
+    for (t = 0; t < (int) SDL_arraysize(targets); ++t) {
+        Uint64 total = 0;
+
+        for (i = 0; i < iterations; ++i) {
+            const Uint64 start = SDL_GetPerformanceCounter();
+            Uint64 elapsed;
+            wait(targets[t]);
+            elapsed = ((SDL_GetPerformanceCounter() - start) * 1000000000) / freq;
+            oversleep[i] = (elapsed > targets[t]) ? (elapsed - targets[t]) : 0;
+            total += oversleep[i];
+        }
+        SDL_qsort(oversleep, iterations, sizeof(*oversleep), CompareUint64);
+
+        SDL_Log("%-16s target %6d us: oversleep mean %6d us, p50 %6d us, p99 %6d us, max %6d us\n",
+                name, (int) (targets[t] / 1000), (int) (total / iterations / 1000),
+                (int) (oversleep[iterations / 2] / 1000),
+                (int) (oversleep[(iterations * 99) / 100] / 1000),
+                (int) (oversleep[iterations - 1] / 1000));
+    }
+
+    SDL_free(oversleep);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int iterations = ITERATIONS;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+    }
+    if (iterations <= 0) {
+        iterations = ITERATIONS;
+    }
+
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    sem = SDL_CreateSemaphore(0);
+    mutex = SDL_CreateMutex();
+    cond = SDL_CreateCond();
+    if (!sem || !mutex || !cond) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create sync objects: %s\n", SDL_GetError());
+        SDL_Quit();
+        return (1);
+    }
+
+    SDL_Log("Measuring %d waits per target\n", iterations);
+    Measure("SDL_Delay", WaitDelayMS, iterations);
+    Measure("SDL_DelayNS", WaitDelay, iterations);
+    Measure("SemWaitTimeoutNS", WaitSem, iterations);
+    Measure("CondWaitTimeoutNS", WaitCond, iterations);
+
+    SDL_DestroyCond(cond);
+    SDL_DestroyMutex(mutex);
+    SDL_DestroySemaphore(sem);
+    SDL_Quit();
+    return (0);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
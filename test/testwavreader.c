@@ -0,0 +1,126 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compare SDL_LoadWAV() against the incremental SDL_OpenWAV()/SDL_ReadWAV()
+   path: time until the first buffer of audio is available, total decode
+   time, and how much memory each needs. The two must produce the same data. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define CHUNK_SIZE  4096
+#define PASSES      10
+
+static double
+Elapsed(Uint64 start)
+{
+    return ((double) (SDL_GetPerformanceCounter() - start) * 1000.0) /
+           (double) SDL_GetPerformanceFrequency();
+}
+
+static int
+BenchLoad(const char *file, Uint8 **sound, Uint32 *soundlen)
+{
+    SDL_AudioSpec spec;
+    double total = 0.0;
+    int i;
+
+    for (i = 0; i < PASSES; ++i) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (SDL_LoadWAV(file, &spec, sound, soundlen) == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s\n", file, SDL_GetError());
+            return -1;
+        }
+        total += Elapsed(start);
+        if (i < PASSES - 1) {
+            SDL_FreeWAV(*sound);
+        }
+    }
+    SDL_Log("SDL_LoadWAV   first audio %8.3f ms, total %8.3f ms, %u bytes held\n",
+            total / PASSES, total / PASSES, (unsigned int) *soundlen);
+    return 0;
+}
+
+static int
+BenchStream(const char *file, const Uint8 *sound, Uint32 soundlen)
+{
+    Uint8 chunk[CHUNK_SIZE];
+    double first = 0.0, total = 0.0;
+    int i;
+
+    for (i = 0; i < PASSES; ++i) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        SDL_AudioSpec spec;
+        SDL_WAVReader *reader = SDL_OpenWAV(file, &spec);
+        Uint32 pos = 0;
+        int amount;
+
+        if (reader == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+            return -1;
+        }
+        while ((amount = SDL_ReadWAV(reader, chunk, sizeof (chunk))) > 0) {
+            if (pos == 0) {
+                first += Elapsed(start);
+            }
+            if (pos + amount > soundlen || SDL_memcmp(sound + pos, chunk, amount) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Streamed data differs at offset %u\n", (unsigned int) pos);
+                SDL_CloseWAV(reader);
+                return -1;
+            }
+            pos += amount;
+        }
+        SDL_CloseWAV(reader);
+        total += Elapsed(start);
+
+        if (amount < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't read %s: %s\n", file, SDL_GetError());
+            return -1;
+        }
+        if (pos != soundlen) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Streamed %u bytes, expected %u\n", (unsigned int) pos, (unsigned int) soundlen);
+            return -1;
+        }
+    }
+    SDL_Log("SDL_ReadWAV   first audio %8.3f ms, total %8.3f ms, %u bytes held\n",
+            first / PASSES, total / PASSES, (unsigned int) sizeof (chunk));
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *file = (argc > 1) ? argv[1] : "sample.wav";
+    Uint8 *sound = NULL;
+    Uint32 soundlen = 0;
+    int status = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    if (BenchLoad(file, &sound, &soundlen) < 0 || BenchStream(file, sound, soundlen) < 0) {
+        status = 1;
+    }
+
+    SDL_FreeWAV(sound);
+    SDL_Quit();
+    return (status);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */